@@ -110,6 +110,21 @@ class Document::Cache
         }
     }
 
+    void invalidate()
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        valid = false;
+        if (!compiledGraphs.empty())
+        {
+            compiledGraphs.clear();
+        }
+        if (!flattenedInterfaces.empty())
+        {
+            flattenedInterfaces.clear();
+        }
+    }
+
   public:
     weak_ptr<Document> doc;
     std::mutex mutex;
@@ -117,6 +132,8 @@ class Document::Cache
     std::unordered_multimap<string, PortElementPtr> portElementMap;
     std::unordered_multimap<string, NodeDefPtr> nodeDefMap;
     std::unordered_multimap<string, InterfaceElementPtr> implementationMap;
+    std::unordered_map<const GraphElement*, ConstCompiledGraphPtr> compiledGraphs;
+    std::unordered_map<const InterfaceElement*, ConstFlattenedInterfacePtr> flattenedInterfaces;
 };
 
 //
@@ -125,7 +142,8 @@ class Document::Cache
 
 Document::Document(ElementPtr parent, const string& name) :
     GraphElement(parent, CATEGORY, name),
-    _cache(std::unique_ptr<Cache>(new Cache))
+    _cache(std::unique_ptr<Cache>(new Cache)),
+    _transactionDepth(0)
 {
 }
 
@@ -206,6 +224,44 @@ vector<PortElementPtr> Document::getMatchingPorts(const string& nodeName) const
     return ports;
 }
 
+ConstCompiledGraphPtr Document::getCompiledGraph(ConstGraphElementPtr graph) const
+{
+    {
+        std::lock_guard<std::mutex> guard(_cache->mutex);
+        auto it = _cache->compiledGraphs.find(graph.get());
+        if (it != _cache->compiledGraphs.end())
+        {
+            return it->second;
+        }
+    }
+
+    // Compile the graph outside of the lock, as resolving connections may
+    // itself require access to the document cache.
+    ConstCompiledGraphPtr compiled = CompiledGraph::create(graph);
+
+    std::lock_guard<std::mutex> guard(_cache->mutex);
+    return _cache->compiledGraphs.insert(std::make_pair(graph.get(), compiled)).first->second;
+}
+
+ConstFlattenedInterfacePtr Document::getFlattenedInterface(ConstInterfaceElementPtr interface) const
+{
+    {
+        std::lock_guard<std::mutex> guard(_cache->mutex);
+        auto it = _cache->flattenedInterfaces.find(interface.get());
+        if (it != _cache->flattenedInterfaces.end())
+        {
+            return it->second;
+        }
+    }
+
+    // Flatten the interface outside of the lock, as resolving inheritance may
+    // itself require access to the document cache.
+    ConstFlattenedInterfacePtr flattened = FlattenedInterface::create(interface);
+
+    std::lock_guard<std::mutex> guard(_cache->mutex);
+    return _cache->flattenedInterfaces.insert(std::make_pair(interface.get(), flattened)).first->second;
+}
+
 ValuePtr Document::getGeomAttrValue(const string& geomAttrName, const string& geom) const
 {
     ValuePtr value;
@@ -258,6 +314,26 @@ vector<InterfaceElementPtr> Document::getMatchingImplementations(const string& n
     return implementations;
 }
 
+void Document::beginTransaction()
+{
+    if (!_transactionDepth++)
+    {
+        onBeginTransaction();
+    }
+}
+
+void Document::commitTransaction()
+{
+    if (!_transactionDepth)
+    {
+        throw Exception("No open transaction to commit");
+    }
+    if (!--_transactionDepth)
+    {
+        onCommitTransaction();
+    }
+}
+
 bool Document::validate(string* message) const
 {
     bool res = true;
@@ -587,32 +663,32 @@ void Document::upgradeVersion()
 
 void Document::onAddElement(ElementPtr, ElementPtr)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 void Document::onRemoveElement(ElementPtr, ElementPtr)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 void Document::onSetAttribute(ElementPtr, const string&, const string&)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 void Document::onRemoveAttribute(ElementPtr, const string&)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 void Document::onCopyContent(ElementPtr)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 void Document::onClearContent(ElementPtr)
 {
-    _cache->valid = false;
+    _cache->invalidate();
 }
 
 } // namespace MaterialX
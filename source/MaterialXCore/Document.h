@@ -48,7 +48,8 @@ class Document : public GraphElement
     /// Initialize the document, removing any existing content.
     virtual void initialize();
 
-    /// Create a deep copy of the document.
+    /// Create a deep copy of the document.  Attribute storage is shared with
+    /// the original document until modified, as described in copyContentFrom.
     virtual DocumentPtr copy() const
     {
         DocumentPtr doc = createDocument<Document>();
@@ -102,6 +103,18 @@ class Document : public GraphElement
     /// nodes, and include both Input and Output elements.
     vector<PortElementPtr> getMatchingPorts(const string& nodeName) const;
 
+    /// Return a compiled view of the connections within the given graph
+    /// element of this document.  Compiled graphs are cached by the document,
+    /// and are invalidated whenever the document is modified.
+    /// @sa GraphElement::getCompiledGraph
+    ConstCompiledGraphPtr getCompiledGraph(ConstGraphElementPtr graph) const;
+
+    /// Return the flattened interface of the given interface element of this
+    /// document.  Flattened interfaces are cached by the document, and are
+    /// invalidated whenever the document is modified.
+    /// @sa InterfaceElement::getFlattenedInterface
+    ConstFlattenedInterfacePtr getFlattenedInterface(ConstInterfaceElementPtr interface) const;
+
     /// @}
     /// @name Material Elements
     /// @{
@@ -502,6 +515,28 @@ class Document : public GraphElement
         return getAttribute(CMS_CONFIG_ATTRIBUTE);
     }
 
+    /// @}
+    /// @name Transactions
+    /// @{
+
+    /// Begin a transaction on this document.  Changes made within a
+    /// transaction are applied to the document immediately, but their
+    /// notifications are collected into a single change set, which is
+    /// delivered when the outermost transaction is committed.  Transactions
+    /// may be nested.
+    /// @sa ScopedTransaction
+    void beginTransaction();
+
+    /// Commit the innermost open transaction on this document.
+    /// @throws Exception if no transaction is open.
+    void commitTransaction();
+
+    /// Return the number of nested transactions open on this document.
+    int getTransactionDepth() const
+    {
+        return _transactionDepth;
+    }
+
     /// @}
     /// @name Validation
     /// @{
@@ -547,6 +582,12 @@ class Document : public GraphElement
     /// Called after a set of document updates is performed.
     virtual void onEndUpdate() { }
 
+    /// Called when the outermost transaction on the document is begun.
+    virtual void onBeginTransaction() { }
+
+    /// Called when the outermost transaction on the document is committed.
+    virtual void onCommitTransaction() { }
+
     /// Enable observer callbacks		
     virtual void enableCallbacks() { }
     
@@ -563,6 +604,7 @@ class Document : public GraphElement
   private:
     class Cache;
     std::unique_ptr<Cache> _cache;
+    int _transactionDepth;
 };
 
 /// @class ScopedUpdate
@@ -587,6 +629,52 @@ class ScopedUpdate
     DocumentPtr _doc;
 };
 
+/// @class ScopedTransaction
+/// An RAII class for Document transactions.
+///
+/// A ScopedTransaction instance calls Document::beginTransaction when created,
+/// and Document::commitTransaction when committed or destroyed.  Exceptions
+/// thrown while committing are propagated by commit, but are discarded when
+/// the transaction is committed by the destructor.
+class ScopedTransaction
+{
+  public:
+    explicit ScopedTransaction(DocumentPtr doc) :
+        _doc(doc),
+        _committed(false)
+    {
+        _doc->beginTransaction();
+    }
+    ~ScopedTransaction()
+    {
+        if (!_committed)
+        {
+            try
+            {
+                _doc->commitTransaction();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    /// Commit the transaction.  This method may be called at most once.
+    void commit()
+    {
+        if (_committed)
+        {
+            throw Exception("Transaction has already been committed");
+        }
+        _committed = true;
+        _doc->commitTransaction();
+    }
+
+  private:
+    DocumentPtr _doc;
+    bool _committed;
+};
+
 /// @class ScopedDisableCallbacks
 /// An RAII class for disabling Document callbacks.
 ///
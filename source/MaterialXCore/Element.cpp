@@ -9,6 +9,8 @@
 #include <MaterialXCore/Node.h>
 #include <MaterialXCore/Util.h>
 
+#include <stdexcept>
+
 namespace MaterialX
 {
 
@@ -35,6 +37,12 @@ const string ValueElement::UI_MAX_ATTRIBUTE = "uimax";
 
 Element::CreatorMap Element::_creatorMap;
 
+namespace {
+
+const StringVec EMPTY_ATTRIBUTE_NAMES;
+
+} // anonymous namespace
+
 //
 // Element methods
 //
@@ -47,13 +55,16 @@ bool Element::operator==(const Element& rhs) const
         return false;
     }
 
-    // Compare attributes.
-    if (getAttributeNames() != rhs.getAttributeNames())
-        return false;
-    for (const string& attr : rhs.getAttributeNames())
+    // Compare attributes, unless their storage is shared.
+    if (_attributes != rhs._attributes)
     {
-        if (getAttribute(attr) != rhs.getAttribute(attr))
+        if (getAttributeNames() != rhs.getAttributeNames())
             return false;
+        for (const string& attr : rhs.getAttributeNames())
+        {
+            if (getAttribute(attr) != rhs.getAttribute(attr))
+                return false;
+        }
     }
 
     // Compare children.
@@ -178,6 +189,26 @@ void Element::unregisterChildElement(ElementPtr child)
         std::find(_childOrder.begin(), _childOrder.end(), child));
 }
 
+Element::AttributeStore& Element::getMutableAttributes()
+{
+    if (!_attributes)
+    {
+        _attributes = std::make_shared<AttributeStore>();
+    }
+    else if (_attributes.use_count() > 1)
+    {
+        // The copy does not include the cached typed value.
+        _attributes = std::make_shared<AttributeStore>(*_attributes);
+    }
+    else
+    {
+        // Clear the cached typed value, which may depend on the modified
+        // attributes.
+        _attributes->value.reset();
+    }
+    return *_attributes;
+}
+
 int Element::getChildIndex(const string& name) const
 {
     ElementPtr child = getChild(name);
@@ -226,17 +257,17 @@ void Element::setAttribute(const string& attrib, const string& value)
     ScopedUpdate update(doc);
     doc->onSetAttribute(getSelf(), attrib, value);
 
-    if (!_attributeMap.count(attrib))
+    AttributeStore& attributes = getMutableAttributes();
+    if (!attributes.map.count(attrib))
     {
-        _attributeOrder.push_back(attrib);
+        attributes.order.push_back(attrib);
     }
-    _attributeMap[attrib] = value;
+    attributes.map[attrib] = value;
 }
 
 void Element::removeAttribute(const string& attrib)
 {
-    StringMap::iterator it = _attributeMap.find(attrib);
-    if (it != _attributeMap.end())
+    if (hasAttribute(attrib))
     {
         DocumentPtr doc = getDocument();
 
@@ -244,12 +275,18 @@ void Element::removeAttribute(const string& attrib)
         ScopedUpdate update(doc);
         doc->onRemoveAttribute(getSelf(), attrib);
 
-        _attributeMap.erase(it);
-        _attributeOrder.erase(
-            std::find(_attributeOrder.begin(), _attributeOrder.end(), attrib));
+        AttributeStore& attributes = getMutableAttributes();
+        attributes.map.erase(attrib);
+        attributes.order.erase(
+            std::find(attributes.order.begin(), attributes.order.end(), attrib));
     }
 }
 
+const StringVec& Element::getAttributeNames() const
+{
+    return _attributes ? _attributes->order : EMPTY_ATTRIBUTE_NAMES;
+}
+
 template<class T> shared_ptr<T> Element::asA()
 {
     return std::dynamic_pointer_cast<T>(getSelf());
@@ -383,8 +420,7 @@ void Element::copyContentFrom(ConstElementPtr source, const CopyOptions* copyOpt
     doc->onCopyContent(getSelf());
 
     _sourceUri = source->_sourceUri;
-    _attributeMap = source->_attributeMap;
-    _attributeOrder = source->_attributeOrder;
+    _attributes = source->_attributes;
 
     for (ElementPtr child : source->getChildren())
     {
@@ -407,8 +443,7 @@ void Element::clearContent()
     doc->onClearContent(getSelf());
 
     _sourceUri = EMPTY_STRING;
-    _attributeMap.clear();
-    _attributeOrder.clear();
+    _attributes.reset();
 
     vector<ElementPtr> children = getChildren();
     for (ElementPtr child : children)
@@ -536,6 +571,41 @@ string ValueElement::getResolvedValueString(StringResolverPtr resolver) const
     return resolver->resolve(getValueString(), getType());
 }
 
+ValuePtr ValueElement::getValue() const
+{
+    if (!hasValue())
+    {
+        return ValuePtr();
+    }
+
+    // Attribute storage may be shared with copies of this element in other
+    // documents, so the cached value is accessed atomically.
+    ConstValuePtr value = std::atomic_load(&_attributes->value);
+    if (!value)
+    {
+        value = Value::createValueFromStrings(getValueString(), getType());
+        if (!value)
+        {
+            return ValuePtr();
+        }
+        std::atomic_store(&_attributes->value, value);
+    }
+    return value->copy();
+}
+
+ValuePtr ValueElement::getResolvedValue(StringResolverPtr resolver) const
+{
+    if (!hasValue())
+    {
+        return ValuePtr();
+    }
+    if (!StringResolver::isResolvedType(getType()))
+    {
+        return getValue();
+    }
+    return Value::createValueFromStrings(getResolvedValueString(resolver), getType());
+}
+
 ValuePtr ValueElement::getBoundValue(ConstMaterialPtr material) const
 {
     ElementPtr upstreamElem = getUpstreamElement(material);
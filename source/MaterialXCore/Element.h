@@ -514,25 +514,24 @@ class Element : public std::enable_shared_from_this<Element>
     /// Return true if the given attribute is present.
     bool hasAttribute(const string& attrib) const
     {
-        return _attributeMap.count(attrib) != 0;
+        return _attributes && _attributes->map.count(attrib) != 0;
     }
 
     /// Return the value string of the given attribute.  If the given attribute
     /// is not present, then an empty string is returned.
     const string& getAttribute(const string& attrib) const
     {
-        StringMap::const_iterator it = _attributeMap.find(attrib);
-        if (it == _attributeMap.end())
+        if (!_attributes)
+            return EMPTY_STRING;
+        StringMap::const_iterator it = _attributes->map.find(attrib);
+        if (it == _attributes->map.end())
             return EMPTY_STRING;
         else
             return it->second;
     }
 
     /// Return a vector of stored attribute names, in the order they were set.
-    const StringVec& getAttributeNames() const
-    {
-        return _attributeOrder;
-    }
+    const StringVec& getAttributeNames() const;
 
     /// Set the value of an implicitly typed attribute.  Since an attribute
     /// stores no explicit type, the same type argument must be used in
@@ -752,6 +751,10 @@ class Element : public std::enable_shared_from_this<Element>
     /// @{
 
     /// Copy all attributes and descendants from the given element to this one.
+    ///
+    /// Attribute storage is shared between the source and copied elements,
+    /// and is duplicated only when the attributes of either are modified, so
+    /// the cost of a copy is dominated by the creation of its elements.
     /// @param source The element from which content is copied.
     /// @param copyOptions An optional pointer to a CopyOptions object.
     ///    If provided, then the given options will affect the behavior of the
@@ -826,10 +829,40 @@ class Element : public std::enable_shared_from_this<Element>
     static const string INHERIT_ATTRIBUTE;
     static const string NAMESPACE_ATTRIBUTE;
 
+  protected:
+    // The attributes of an element, in the order they were set.  Attribute
+    // storage is shared between an element and its copies, and is duplicated
+    // by the first copy to modify its attributes.
+    struct AttributeStore
+    {
+        AttributeStore() { }
+
+        // The cached value is not copied, as it may be stored concurrently
+        // by readers of the elements that share the source storage.
+        AttributeStore(const AttributeStore& other) :
+            map(other.map),
+            order(other.order)
+        {
+        }
+        AttributeStore& operator=(const AttributeStore&) = delete;
+
+        StringMap map;
+        StringVec order;
+
+        // The typed value parsed from the value and type attributes, created
+        // on first access and cleared whenever the attributes are modified.
+        mutable ConstValuePtr value;
+    };
+    using AttributeStorePtr = shared_ptr<AttributeStore>;
+
   protected:
     virtual void registerChildElement(ElementPtr child);
     virtual void unregisterChildElement(ElementPtr child);
 
+    // Return attribute storage that is owned solely by this element, for
+    // modification.
+    AttributeStore& getMutableAttributes();
+
     // Return a non-const copy of our self pointer, for use in constructing
     // graph traversal objects that require non-const storage.
     ElementPtr getSelfNonConst() const
@@ -845,8 +878,7 @@ class Element : public std::enable_shared_from_this<Element>
     ElementMap _childMap;
     vector<ElementPtr> _childOrder;
 
-    StringMap _attributeMap;
-    StringVec _attributeOrder;
+    AttributeStorePtr _attributes;
 
     weak_ptr<Element> _parent;
     weak_ptr<Element> _root;
@@ -1028,14 +1060,13 @@ class ValueElement : public TypedElement
     /// Return the typed value of an element as a generic value object, which
     /// may be queried to access its data.
     ///
+    /// The value string is parsed on first access and cached until the
+    /// attributes of the element are modified, and each call returns a new
+    /// copy of the cached value.
+    ///
     /// @return A shared pointer to the typed value of this element, or an
     ///    empty shared pointer if no value is present.
-    ValuePtr getValue() const
-    {
-        if (!hasValue())
-            return ValuePtr();
-        return Value::createValueFromStrings(getValueString(), getType());
-    }
+    ValuePtr getValue() const;
 
     /// Return the resolved value of an element as a generic value object, which
     /// may be queried to access its data.
@@ -1045,12 +1076,7 @@ class ValueElement : public TypedElement
     ///    will be created at this scope and applied to the return value.
     /// @return A shared pointer to the typed value of this element, or an
     ///    empty shared pointer if no value is present.
-    ValuePtr getResolvedValue(StringResolverPtr resolver = nullptr) const
-    {
-        if (!hasValue())
-            return ValuePtr();
-        return Value::createValueFromStrings(getResolvedValueString(resolver), getType());
-    }
+    ValuePtr getResolvedValue(StringResolverPtr resolver = nullptr) const;
 
     /// @}
     /// @name Bound Value
@@ -25,13 +25,19 @@ const string Collection::INCLUDE_GEOM_ATTRIBUTE = "includegeom";
 const string Collection::EXCLUDE_GEOM_ATTRIBUTE = "excludegeom";
 const string Collection::INCLUDE_COLLECTION_ATTRIBUTE = "includecollection";
 
-bool geomStringsMatch(const string& geom1, const string& geom2, bool contains)
+vector<GeomPath> parseGeomString(const string& geom)
 {
-    vector<GeomPath> paths1;
-    for (const string& name1 : splitString(geom1, ARRAY_VALID_SEPARATORS))
+    vector<GeomPath> paths;
+    for (const string& name : splitString(geom, ARRAY_VALID_SEPARATORS))
     {
-        paths1.push_back(GeomPath(name1));
+        paths.push_back(GeomPath(name));
     }
+    return paths;
+}
+
+bool geomStringsMatch(const string& geom1, const string& geom2, bool contains)
+{
+    vector<GeomPath> paths1 = parseGeomString(geom1);
     for (const string& name2 : splitString(geom2, ARRAY_VALID_SEPARATORS))
     {
         GeomPath path2(name2);
@@ -179,4 +185,146 @@ bool Collection::validate(string* message) const
     return Element::validate(message) && res;
 }
 
+//
+// GeomStringMatcher methods
+//
+
+GeomStringMatcher::GeomStringMatcher(const string& geom) :
+    _nodes(1)
+{
+    addGeomString(geom);
+}
+
+void GeomStringMatcher::addGeomString(const string& geom)
+{
+    for (const GeomPath& path : parseGeomString(geom))
+    {
+        if (path.isEmpty())
+        {
+            continue;
+        }
+        size_t node = 0;
+        for (const string& name : path._vec)
+        {
+            auto it = _nodes[node].children.find(name);
+            if (it != _nodes[node].children.end())
+            {
+                node = it->second;
+            }
+            else
+            {
+                size_t child = _nodes.size();
+                _nodes[node].children[name] = child;
+                _nodes.push_back(Node());
+                node = child;
+            }
+        }
+        _nodes[node].terminal = true;
+    }
+}
+
+bool GeomStringMatcher::matchesGeomString(const string& geom, bool contains) const
+{
+    return matchesGeomPaths(parseGeomString(geom), contains);
+}
+
+bool GeomStringMatcher::matchesGeomPaths(const vector<GeomPath>& paths, bool contains) const
+{
+    for (const GeomPath& path : paths)
+    {
+        if (matchesGeomPath(path, contains))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GeomStringMatcher::matchesGeomPath(const GeomPath& path, bool contains) const
+{
+    if (path.isEmpty())
+    {
+        return false;
+    }
+
+    // A path in the tree that is a prefix of the given path is a match.
+    size_t node = 0;
+    for (const string& name : path._vec)
+    {
+        if (_nodes[node].terminal)
+        {
+            return true;
+        }
+        auto it = _nodes[node].children.find(name);
+        if (it == _nodes[node].children.end())
+        {
+            return false;
+        }
+        node = it->second;
+    }
+
+    // Unless containment is required, the given path also matches any path
+    // in the tree of which it is a prefix.
+    return _nodes[node].terminal || (!contains && !_nodes[node].children.empty());
+}
+
+//
+// CompiledCollection methods
+//
+
+CompiledCollectionPtr CompiledCollection::create(ConstCollectionPtr collection)
+{
+    vector<ConstCollectionPtr> members = { collection };
+    std::set<ConstCollectionPtr> includedSet;
+    vector<CollectionPtr> includedVec = collection->getIncludeCollections();
+    for (size_t i = 0; i < includedVec.size(); i++)
+    {
+        CollectionPtr included = includedVec[i];
+        if (includedSet.count(included))
+        {
+            throw ExceptionFoundCycle("Encountered a cycle in collection: " + collection->getName());
+        }
+        includedSet.insert(included);
+        members.push_back(included);
+        vector<CollectionPtr> appendVec = included->getIncludeCollections();
+        includedVec.insert(includedVec.end(), appendVec.begin(), appendVec.end());
+    }
+
+    CompiledCollectionPtr compiled = std::make_shared<CompiledCollection>();
+    compiled->_members.resize(members.size());
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        compiled->_members[i].include.addGeomString(members[i]->getActiveIncludeGeom());
+        compiled->_members[i].exclude.addGeomString(members[i]->getActiveExcludeGeom());
+    }
+    return compiled;
+}
+
+bool CompiledCollection::matchesGeomString(const string& geom) const
+{
+    return matchesGeomPaths(parseGeomString(geom));
+}
+
+bool CompiledCollection::matchesGeomPaths(const vector<GeomPath>& paths) const
+{
+    // An exclusion by the compiled collection itself takes precedence over
+    // all inclusions.
+    if (_members[0].exclude.matchesGeomPaths(paths, true))
+    {
+        return false;
+    }
+
+    // Each member collection contributes its own inclusions, less its own
+    // exclusions.
+    for (const Member& member : _members)
+    {
+        if (member.include.matchesGeomPaths(paths) &&
+            !member.exclude.matchesGeomPaths(paths, true))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace MaterialX
@@ -28,6 +28,7 @@ class GeomPropDef;
 class Collection;
 class CollectionAdd;
 class CollectionRemove;
+class CompiledCollection;
 
 /// A shared pointer to a GeomElement
 using GeomElementPtr = shared_ptr<GeomElement>;
@@ -54,6 +55,11 @@ using CollectionPtr = shared_ptr<Collection>;
 /// A shared pointer to a const Collection
 using ConstCollectionPtr = shared_ptr<const Collection>;
 
+/// A shared pointer to a CompiledCollection
+using CompiledCollectionPtr = shared_ptr<CompiledCollection>;
+/// A shared pointer to a const CompiledCollection
+using ConstCompiledCollectionPtr = shared_ptr<const CompiledCollection>;
+
 /// @class GeomPath
 /// A MaterialX geometry path, representing the hierarchical location
 /// expressed by a geometry name.
@@ -144,6 +150,8 @@ class GeomPath
   private:
     StringVec _vec;
     bool _empty;
+
+    friend class GeomStringMatcher;
 };
 
 /// @class GeomElement
@@ -610,6 +618,94 @@ template<class T> GeomAttrPtr GeomInfo::setGeomAttrValue(const string& name,
     return geomAttr;
 }
 
+/// @class GeomStringMatcher
+/// A prefix tree of the geometry paths in a geometry string, which supports
+/// repeated matching against other geometry strings without reparsing.
+///
+/// Matching a path against the tree takes time proportional to the depth of
+/// the path, rather than to the number of paths in the tree.
+class GeomStringMatcher
+{
+  public:
+    /// Construct a matcher for the paths of the given geometry string.
+    explicit GeomStringMatcher(const string& geom = EMPTY_STRING);
+    ~GeomStringMatcher() { }
+
+    /// Add the paths of the given geometry string to the matcher.
+    void addGeomString(const string& geom);
+
+    /// Return true if the matcher contains no paths.
+    bool isEmpty() const
+    {
+        return _nodes.size() == 1 && !_nodes[0].terminal;
+    }
+
+    /// Return true if the paths of the matcher and the given geometry string
+    /// have any geometries in common.  This is equivalent to geomStringsMatch,
+    /// with the geometry string of the matcher as its first argument.
+    bool matchesGeomString(const string& geom, bool contains = false) const;
+
+    /// Return true if the paths of the matcher and any of the given geometry
+    /// paths have any geometries in common.
+    bool matchesGeomPaths(const vector<GeomPath>& paths, bool contains = false) const;
+
+  private:
+    struct Node
+    {
+        Node() : terminal(false) { }
+        std::unordered_map<string, size_t> children;
+        bool terminal;
+    };
+
+    bool matchesGeomPath(const GeomPath& path, bool contains) const;
+
+  private:
+    vector<Node> _nodes;
+};
+
+/// @class CompiledCollection
+/// A snapshot of a Collection and all collections that it includes, compiled
+/// for fast matching against geometry strings.
+///
+/// Active include and exclude geometry strings are resolved and parsed once
+/// at creation time, and the include chain is flattened, so that each match
+/// is free of string resolution and element lookups.  The results of
+/// matchesGeomString are identical to those of Collection::matchesGeomString
+/// at the time of creation, while include cycles are reported on creation
+/// rather than on matching.
+class CompiledCollection
+{
+  public:
+    CompiledCollection() { }
+    ~CompiledCollection() { }
+
+    /// Create a compiled collection from the current state of the given
+    /// collection.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    static CompiledCollectionPtr create(ConstCollectionPtr collection);
+
+    /// Return true if this collection and the given geometry string have any
+    /// geometries in common.
+    bool matchesGeomString(const string& geom) const;
+
+    /// Return true if this collection and any of the given geometry paths
+    /// have any geometries in common.
+    bool matchesGeomPaths(const vector<GeomPath>& paths) const;
+
+  private:
+    struct Member
+    {
+        GeomStringMatcher include;
+        GeomStringMatcher exclude;
+    };
+
+    // The compiled collection followed by the collections it includes.
+    vector<Member> _members;
+};
+
+/// Return the vector of geometry paths in the given geometry string.
+vector<GeomPath> parseGeomString(const string& geom);
+
 /// Given two geometry strings, each containing an array of geom names, return
 /// true if they have any geometries in common.
 ///
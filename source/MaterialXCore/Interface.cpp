@@ -214,122 +214,102 @@ bool Output::validate(string* message) const
 
 ParameterPtr InterfaceElement::getActiveParameter(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
+    // Without inheritance, the active child is a direct child of this element.
+    if (!hasInheritString())
     {
-        ParameterPtr param = elem->asA<InterfaceElement>()->getParameter(name);
-        if (param)
-        {
-            return param;
-        }
+        return getParameter(name);
     }
-    return nullptr;
+    return getFlattenedInterface()->getParameter(name);
 }
 
 vector<ParameterPtr> InterfaceElement::getActiveParameters() const
 {
-    vector<ParameterPtr> activeParams;
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        vector<ParameterPtr> params = elem->asA<InterfaceElement>()->getParameters();
-        activeParams.insert(activeParams.end(), params.begin(), params.end());
+        return getParameters();
     }
-    return activeParams;
+    return getFlattenedInterface()->getParameters();
 }
 
 InputPtr InterfaceElement::getActiveInput(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        InputPtr input = elem->asA<InterfaceElement>()->getInput(name);
-        if (input)
-        {
-            return input;
-        }
+        return getInput(name);
     }
-    return nullptr;
+    return getFlattenedInterface()->getInput(name);
 }
 
 vector<InputPtr> InterfaceElement::getActiveInputs() const
 {
-    vector<InputPtr> activeInputs;
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        vector<InputPtr> inputs = elem->asA<InterfaceElement>()->getInputs();
-        activeInputs.insert(activeInputs.end(), inputs.begin(), inputs.end());
+        return getInputs();
     }
-    return activeInputs;
+    return getFlattenedInterface()->getInputs();
 }
 
 OutputPtr InterfaceElement::getActiveOutput(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        OutputPtr output = elem->asA<InterfaceElement>()->getOutput(name);
-        if (output)
-        {
-            return output;
-        }
+        return getOutput(name);
     }
-    return nullptr;
+    return getFlattenedInterface()->getOutput(name);
 }
 
 vector<OutputPtr> InterfaceElement::getActiveOutputs() const
 {
-    vector<OutputPtr> activeOutputs;
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        vector<OutputPtr> outputs = elem->asA<InterfaceElement>()->getOutputs();
-        activeOutputs.insert(activeOutputs.end(), outputs.begin(), outputs.end());
+        return getOutputs();
     }
-    return activeOutputs;
+    return getFlattenedInterface()->getOutputs();
 }
 
 TokenPtr InterfaceElement::getActiveToken(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        TokenPtr token = elem->asA<InterfaceElement>()->getToken(name);
-        if (token)
-        {
-            return token;
-        }
+        return getToken(name);
     }
-    return nullptr;
+    return getFlattenedInterface()->getToken(name);
 }
 
 vector<TokenPtr> InterfaceElement::getActiveTokens() const
 {
-    vector<TokenPtr> activeTokens;
-    for (ConstElementPtr elem : traverseInheritance())
+    if (!hasInheritString())
     {
-        vector<TokenPtr> tokens = elem->asA<InterfaceElement>()->getTokens();
-        activeTokens.insert(activeTokens.end(), tokens.begin(), tokens.end());
+        return getTokens();
     }
-    return activeTokens;
+    return getFlattenedInterface()->getTokens();
 }
 
 ValueElementPtr InterfaceElement::getActiveValueElement(const string& name) const
 {
-    for (ConstElementPtr interface : traverseInheritance())
+    if (!hasInheritString())
     {
-        ValueElementPtr valueElem = interface->getChildOfType<ValueElement>(name);
-        if (valueElem)
-        {
-            return valueElem;
-        }
+        return getChildOfType<ValueElement>(name);
     }
-    return nullptr;
+    return getFlattenedInterface()->getValueElement(name);
 }
 
 vector<ValueElementPtr> InterfaceElement::getActiveValueElements() const
 {
-    vector<ValueElementPtr> activeValueElems;
-    for (ConstElementPtr interface : traverseInheritance())
+    if (!hasInheritString())
     {
-        vector<ValueElementPtr> valueElems = interface->getChildrenOfType<ValueElement>();
-        activeValueElems.insert(activeValueElems.end(), valueElems.begin(), valueElems.end());
+        return getChildrenOfType<ValueElement>();
     }
-    return activeValueElems;
+    return getFlattenedInterface()->getValueElements();
+}
+
+ConstFlattenedInterfacePtr InterfaceElement::getFlattenedInterface() const
+{
+    // Orphaned elements have no document cache, and are flattened on demand.
+    ConstInterfaceElementPtr self = std::static_pointer_cast<const InterfaceElement>(getSelf());
+    ElementPtr root = _root.lock();
+    ConstDocumentPtr doc = root ? root->asA<Document>() : nullptr;
+    return doc ? doc->getFlattenedInterface(self) : FlattenedInterface::create(self);
 }
 
 ValuePtr InterfaceElement::getParameterValue(const string& name, const string& target) const
@@ -434,4 +414,43 @@ bool InterfaceElement::isTypeCompatible(ConstInterfaceElementPtr declaration) co
     return true;
 }
 
+//
+// FlattenedInterface methods
+//
+
+FlattenedInterfacePtr FlattenedInterface::create(ConstInterfaceElementPtr interface)
+{
+    FlattenedInterfacePtr flattened = std::make_shared<FlattenedInterface>();
+    for (ConstElementPtr elem : interface->traverseInheritance())
+    {
+        flattened->_chain.push_back(elem);
+        for (const ElementPtr& child : elem->getChildren())
+        {
+            ValueElementPtr valueElem = child->asA<ValueElement>();
+            if (!valueElem)
+            {
+                continue;
+            }
+            flattened->_valueElements.push_back(valueElem);
+            if (ParameterPtr param = child->asA<Parameter>())
+            {
+                flattened->_parameters.push_back(param);
+            }
+            else if (InputPtr input = child->asA<Input>())
+            {
+                flattened->_inputs.push_back(input);
+            }
+            else if (OutputPtr output = child->asA<Output>())
+            {
+                flattened->_outputs.push_back(output);
+            }
+            else if (TokenPtr token = child->asA<Token>())
+            {
+                flattened->_tokens.push_back(token);
+            }
+        }
+    }
+    return flattened;
+}
+
 } // namespace MaterialX
@@ -25,6 +25,7 @@ class Output;
 class InterfaceElement;
 class Node;
 class NodeDef;
+class FlattenedInterface;
 
 /// A shared pointer to a Parameter
 using ParameterPtr = shared_ptr<Parameter>;
@@ -51,6 +52,11 @@ using InterfaceElementPtr = shared_ptr<InterfaceElement>;
 /// A shared pointer to a const InterfaceElement
 using ConstInterfaceElementPtr = shared_ptr<const InterfaceElement>;
 
+/// A shared pointer to a FlattenedInterface
+using FlattenedInterfacePtr = shared_ptr<FlattenedInterface>;
+/// A shared pointer to a const FlattenedInterface
+using ConstFlattenedInterfacePtr = shared_ptr<const FlattenedInterface>;
+
 /// @class Parameter
 /// A parameter element within a Node or NodeDef.
 ///
@@ -533,6 +539,13 @@ class InterfaceElement : public TypedElement
     /// Examples of value elements are Parameter, Input, Output, and Token.
     vector<ValueElementPtr> getActiveValueElements() const;
 
+    /// Return the flattened interface of this element, which holds its active
+    /// value elements with interface inheritance taken into account.  The
+    /// flattened interface is cached by the owning document, and is rebuilt
+    /// on first use after any modification to the document.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    ConstFlattenedInterfacePtr getFlattenedInterface() const;
+
     /// @}
     /// @name Values
     /// @{
@@ -625,6 +638,128 @@ class InterfaceElement : public TypedElement
     size_t _outputCount;
 };
 
+/// @class FlattenedInterface
+/// The active value elements of an InterfaceElement, gathered from each
+/// element of its inheritance chain in traversal order.
+///
+/// Value elements are stored in vectors by type, matching the results of the
+/// getActive methods of InterfaceElement, and queries by name are answered
+/// from the resolved inheritance chain, so that neither requires a traversal
+/// of inheritance references.
+///
+/// A flattened interface is a snapshot of its source interface at creation
+/// time.  InterfaceElement::getFlattenedInterface returns a cached instance,
+/// which is invalidated whenever the owning document is modified.
+/// @sa InterfaceElement::getFlattenedInterface
+class FlattenedInterface
+{
+  public:
+    FlattenedInterface() { }
+    ~FlattenedInterface() { }
+
+    /// Create a flattened interface from the current state of the given
+    /// interface.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    static FlattenedInterfacePtr create(ConstInterfaceElementPtr interface);
+
+    /// Return the inheritance chain of the interface, starting with the
+    /// interface itself.
+    vector<ConstElementPtr> getInheritanceChain() const
+    {
+        vector<ConstElementPtr> chain;
+        for (const weak_ptr<const Element>& elem : _chain)
+        {
+            chain.push_back(elem.lock());
+        }
+        return chain;
+    }
+
+    /// Return the first Parameter with the given name.
+    ParameterPtr getParameter(const string& name) const
+    {
+        return getChildOfType<Parameter>(name);
+    }
+
+    /// Return a vector of all Parameter elements.
+    const vector<ParameterPtr>& getParameters() const
+    {
+        return _parameters;
+    }
+
+    /// Return the first Input with the given name.
+    InputPtr getInput(const string& name) const
+    {
+        return getChildOfType<Input>(name);
+    }
+
+    /// Return a vector of all Input elements.
+    const vector<InputPtr>& getInputs() const
+    {
+        return _inputs;
+    }
+
+    /// Return the first Output with the given name.
+    OutputPtr getOutput(const string& name) const
+    {
+        return getChildOfType<Output>(name);
+    }
+
+    /// Return a vector of all Output elements.
+    const vector<OutputPtr>& getOutputs() const
+    {
+        return _outputs;
+    }
+
+    /// Return the first Token with the given name.
+    TokenPtr getToken(const string& name) const
+    {
+        return getChildOfType<Token>(name);
+    }
+
+    /// Return a vector of all Token elements.
+    const vector<TokenPtr>& getTokens() const
+    {
+        return _tokens;
+    }
+
+    /// Return the first value element with the given name.
+    ValueElementPtr getValueElement(const string& name) const
+    {
+        return getChildOfType<ValueElement>(name);
+    }
+
+    /// Return a vector of all value elements.
+    const vector<ValueElementPtr>& getValueElements() const
+    {
+        return _valueElements;
+    }
+
+  private:
+    template<class T> shared_ptr<T> getChildOfType(const string& name) const
+    {
+        for (const weak_ptr<const Element>& weakElem : _chain)
+        {
+            ConstElementPtr elem = weakElem.lock();
+            shared_ptr<T> child = elem ? elem->getChildOfType<T>(name) : nullptr;
+            if (child)
+            {
+                return child;
+            }
+        }
+        return shared_ptr<T>();
+    }
+
+  private:
+    // The chain is held by weak reference, as its first element holds the
+    // cache that owns this object when the interface is a document.
+    vector<weak_ptr<const Element>> _chain;
+    vector<ParameterPtr> _parameters;
+    vector<InputPtr> _inputs;
+    vector<OutputPtr> _outputs;
+    vector<TokenPtr> _tokens;
+    vector<ValueElementPtr> _valueElements;
+};
+
 template<class T> ParameterPtr InterfaceElement::setParameterValue(const string& name,
                                                                    const T& value,
                                                                    const string& type)
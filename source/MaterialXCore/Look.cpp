@@ -5,6 +5,8 @@
 
 #include <MaterialXCore/Look.h>
 
+#include <thread>
+
 namespace MaterialX
 {
 
@@ -16,6 +18,94 @@ const string Visibility::VIEWER_COLLECTION_ATTRIBUTE = "viewercollection";
 const string Visibility::VISIBILITY_TYPE_ATTRIBUTE = "vistype";
 const string Visibility::VISIBLE_ATTRIBUTE = "visible";
 
+namespace {
+
+// An assignment that is pending resolution, with its geometry bindings
+// compiled for matching.
+struct PendingAssignment
+{
+    LookResolver::Assignment* assign;
+    GeomStringMatcher geom;
+    ConstCompiledCollectionPtr collection;
+};
+
+string getAssignGeom(ConstGeomElementPtr elem)
+{
+    return elem->getActiveGeom();
+}
+
+string getAssignGeom(ConstPropertyAssignPtr elem)
+{
+    return elem->getGeom();
+}
+
+// Return a string that identifies the geometry bindings of the given
+// collection, including those of the collections it includes.
+string getCollectionSignature(ConstCollectionPtr collection)
+{
+    string signature;
+    std::set<ConstCollectionPtr> visited;
+    vector<ConstCollectionPtr> collections = { collection };
+    for (size_t i = 0; i < collections.size(); i++)
+    {
+        if (!visited.insert(collections[i]).second)
+        {
+            continue;
+        }
+        signature += "\n" + collections[i]->getName() +
+                     "\n" + collections[i]->getActiveIncludeGeom() +
+                     "\n" + collections[i]->getActiveExcludeGeom();
+        for (CollectionPtr included : collections[i]->getIncludeCollections())
+        {
+            collections.push_back(included);
+        }
+    }
+    return signature;
+}
+
+// Rebuild the given assignment vector from the given active elements, keeping
+// the resolved bindings of elements whose signatures are unchanged, and
+// appending the remaining elements to the pending vector.
+template<class T> void updateAssignments(const vector<shared_ptr<T>>& elems,
+                                         LookResolver::AssignmentVec& assigns,
+                                         vector<PendingAssignment>& pending)
+{
+    std::unordered_map<const Element*, LookResolver::Assignment*> previous;
+    for (LookResolver::Assignment& assign : assigns)
+    {
+        previous[assign.elem.get()] = &assign;
+    }
+
+    LookResolver::AssignmentVec updated(elems.size());
+    for (size_t i = 0; i < elems.size(); i++)
+    {
+        string geom = getAssignGeom(elems[i]);
+        CollectionPtr collection = elems[i]->getCollection();
+        string signature = collection ? geom + getCollectionSignature(collection) : geom;
+
+        auto it = previous.find(elems[i].get());
+        if (it != previous.end() && it->second->signature == signature)
+        {
+            updated[i] = std::move(*it->second);
+            continue;
+        }
+        updated[i].elem = elems[i];
+        updated[i].signature = signature;
+
+        PendingAssignment entry;
+        entry.geom.addGeomString(geom);
+        if (collection)
+        {
+            entry.collection = CompiledCollection::create(collection);
+        }
+        pending.push_back(std::move(entry));
+        pending.back().assign = &updated[i];
+    }
+    assigns.swap(updated);
+}
+
+} // anonymous namespace
+
 //
 // MaterialAssign methods
 //
@@ -56,6 +146,50 @@ vector<MaterialAssignPtr> Look::getActiveMaterialAssigns() const
     return activeAssigns;
 }
 
+vector<vector<MaterialAssignPtr>> Look::getGeometryMaterialAssigns(const StringVec& geoms) const
+{
+    // Compile the geometry string and collection of each assignment, sharing
+    // compiled collections between assignments.
+    vector<MaterialAssignPtr> assigns = getActiveMaterialAssigns();
+    vector<GeomStringMatcher> geomMatchers;
+    vector<ConstCompiledCollectionPtr> compiledCollections;
+    std::unordered_map<CollectionPtr, ConstCompiledCollectionPtr> compiledMap;
+    geomMatchers.reserve(assigns.size());
+    compiledCollections.reserve(assigns.size());
+    for (MaterialAssignPtr assign : assigns)
+    {
+        geomMatchers.push_back(GeomStringMatcher(assign->getActiveGeom()));
+        CollectionPtr collection = assign->getCollection();
+        ConstCompiledCollectionPtr compiled;
+        if (collection)
+        {
+            ConstCompiledCollectionPtr& entry = compiledMap[collection];
+            if (!entry)
+            {
+                entry = CompiledCollection::create(collection);
+            }
+            compiled = entry;
+        }
+        compiledCollections.push_back(compiled);
+    }
+
+    // Match each geometry string against the compiled assignments.
+    vector<vector<MaterialAssignPtr>> geomAssigns(geoms.size());
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        vector<GeomPath> paths = parseGeomString(geoms[i]);
+        for (size_t j = 0; j < assigns.size(); j++)
+        {
+            if (geomMatchers[j].matchesGeomPaths(paths) ||
+                (compiledCollections[j] && compiledCollections[j]->matchesGeomPaths(paths)))
+            {
+                geomAssigns[i].push_back(assigns[j]);
+            }
+        }
+    }
+    return geomAssigns;
+}
+
 vector<PropertyAssignPtr> Look::getActivePropertyAssigns() const
 {
     vector<PropertyAssignPtr> activeAssigns;
@@ -109,4 +243,101 @@ MaterialPtr MaterialAssign::getReferencedMaterial() const
     return resolveRootNameReference<Material>(getMaterial());   
 }
 
+//
+// LookResolver methods
+//
+
+void LookResolver::setGeometries(const StringVec& geoms)
+{
+    _geoms = geoms;
+    _materialAssigns.clear();
+    _propertyAssigns.clear();
+    _propertySetAssigns.clear();
+    _visibilities.clear();
+}
+
+size_t LookResolver::update()
+{
+    // Gather the active assignments of the look, and compile the geometry
+    // bindings of those that are new or modified.
+    vector<PendingAssignment> pending;
+    try
+    {
+        updateAssignments(_look->getActiveMaterialAssigns(), _materialAssigns, pending);
+        updateAssignments(_look->getActivePropertyAssigns(), _propertyAssigns, pending);
+        updateAssignments(_look->getActivePropertySetAssigns(), _propertySetAssigns, pending);
+        updateAssignments(_look->getActiveVisibilities(), _visibilities, pending);
+    }
+    catch (Exception&)
+    {
+        // Discard partially updated assignments, so that the next update
+        // resolves all assignments.
+        _materialAssigns.clear();
+        _propertyAssigns.clear();
+        _propertySetAssigns.clear();
+        _visibilities.clear();
+        throw;
+    }
+    _variantAssigns = _look->getActiveVariantAssigns();
+    if (pending.empty())
+    {
+        return 0;
+    }
+
+    // Resolve pending assignments, dividing the geometry strings among threads
+    // in whole words of the bit vectors.
+    size_t wordCount = (_geoms.size() + 63) / 64;
+    for (PendingAssignment& entry : pending)
+    {
+        entry.assign->bits.assign(wordCount, 0);
+    }
+    unsigned int threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    size_t chunkCount = std::max(std::min((size_t) threadCount, wordCount), (size_t) 1);
+    auto resolveChunk = [this, &pending, wordCount, chunkCount](size_t chunk)
+    {
+        size_t begin = std::min(wordCount * chunk / chunkCount * 64, _geoms.size());
+        size_t end = std::min(wordCount * (chunk + 1) / chunkCount * 64, _geoms.size());
+        for (size_t i = begin; i < end; i++)
+        {
+            vector<GeomPath> paths = parseGeomString(_geoms[i]);
+            for (PendingAssignment& entry : pending)
+            {
+                if (entry.geom.matchesGeomPaths(paths) ||
+                    (entry.collection && entry.collection->matchesGeomPaths(paths)))
+                {
+                    entry.assign->bits[i / 64] |= (uint64_t) 1 << (i % 64);
+                }
+            }
+        }
+    };
+    vector<std::thread> threads;
+    for (size_t chunk = 1; chunk < chunkCount; chunk++)
+    {
+        threads.emplace_back(resolveChunk, chunk);
+    }
+    resolveChunk(0);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    return pending.size();
+}
+
+MaterialAssignPtr LookResolver::getMaterialAssign(size_t index) const
+{
+    if (index >= _geoms.size())
+    {
+        return MaterialAssignPtr();
+    }
+    for (const Assignment& assign : _materialAssigns)
+    {
+        if (assign.matches(index))
+        {
+            return std::static_pointer_cast<MaterialAssign>(assign.elem);
+        }
+    }
+    return MaterialAssignPtr();
+}
+
 } // namespace MaterialX
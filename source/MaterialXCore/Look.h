@@ -15,6 +15,8 @@
 #include <MaterialXCore/Property.h>
 #include <MaterialXCore/Variant.h>
 
+#include <cstdint>
+
 namespace MaterialX
 {
 
@@ -22,6 +24,7 @@ class Look;
 class LookInherit;
 class MaterialAssign;
 class Visibility;
+class LookResolver;
 
 /// A shared pointer to a Look
 using LookPtr = shared_ptr<Look>;
@@ -38,6 +41,9 @@ using VisibilityPtr = shared_ptr<Visibility>;
 /// A shared pointer to a const Visibility
 using ConstVisibilityPtr = shared_ptr<const Visibility>;
 
+/// A shared pointer to a LookResolver
+using LookResolverPtr = shared_ptr<LookResolver>;
+
 /// @class Look
 /// A look element within a Document.
 class Look : public Element
@@ -79,6 +85,18 @@ class Look : public Element
     /// taking look inheritance into account.
     vector<MaterialAssignPtr> getActiveMaterialAssigns() const;
 
+    /// Return the active MaterialAssign elements that bind to each of the
+    /// given geometry strings, taking look inheritance into account.
+    ///
+    /// The geometry strings and collections of the assignments are compiled
+    /// once for the whole batch, making this much faster than matching each
+    /// geometry string against each assignment separately.
+    /// @param geoms A vector of geometry strings to resolve.
+    /// @return A vector with one entry per geometry string, each holding the
+    ///    matching assignments in the order of getActiveMaterialAssigns.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    vector<vector<MaterialAssignPtr>> getGeometryMaterialAssigns(const StringVec& geoms) const;
+
     /// Remove the MaterialAssign, if any, with the given name.
     void removeMaterialAssign(const string& name)
     {
@@ -439,6 +457,173 @@ class Visibility : public GeomElement
     static const string VISIBLE_ATTRIBUTE;
 };
 
+/// @class LookResolver
+/// A table of the assignments of a Look that bind to each of a list of
+/// geometry strings.
+///
+/// The active assignments of the look are gathered once per update, with
+/// look inheritance taken into account, and each assignment stores the
+/// geometry strings it binds to as a bit vector.  On each call to update,
+/// only assignments that were added or whose geometry bindings changed since
+/// the previous call are resolved, with the geometry strings divided among
+/// a set of threads.
+class LookResolver
+{
+  public:
+    explicit LookResolver(ConstLookPtr look) :
+        _look(look),
+        _threadCount(0)
+    {
+    }
+    ~LookResolver() { }
+
+    /// Create a resolver for the given look.
+    static LookResolverPtr create(ConstLookPtr look)
+    {
+        return std::make_shared<LookResolver>(look);
+    }
+
+    /// Return the look resolved by this resolver.
+    ConstLookPtr getLook() const
+    {
+        return _look;
+    }
+
+    /// @name Settings
+    /// @{
+
+    /// Set the geometry strings to resolve, each of which becomes a row of
+    /// the table.  All assignments are resolved on the next update, and
+    /// queries return no assignments until then.
+    void setGeometries(const StringVec& geoms);
+
+    /// Return the geometry strings resolved by this resolver.
+    const StringVec& getGeometries() const
+    {
+        return _geoms;
+    }
+
+    /// Set the maximum number of threads used to resolve assignments.  A value
+    /// of zero uses one thread per hardware thread.  Defaults to zero.
+    void setThreadCount(unsigned int threadCount)
+    {
+        _threadCount = threadCount;
+    }
+
+    /// Return the maximum number of threads used to resolve assignments.
+    unsigned int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /// @}
+    /// @name Resolution
+    /// @{
+
+    /// Bring the table up to date with the current state of the look,
+    /// resolving only new and modified assignments.
+    /// @return The number of assignments that were resolved.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    size_t update();
+
+    /// Return the number of geometry strings in the table.
+    size_t getGeometryCount() const
+    {
+        return _geoms.size();
+    }
+
+    /// Return the first MaterialAssign that binds to the geometry string with
+    /// the given index, or an empty shared pointer if none was found or the
+    /// index is out of range.
+    MaterialAssignPtr getMaterialAssign(size_t index) const;
+
+    /// Return all MaterialAssign elements that bind to the geometry string
+    /// with the given index.  Indices out of range return an empty vector.
+    vector<MaterialAssignPtr> getMaterialAssigns(size_t index) const
+    {
+        return getMatches<MaterialAssign>(_materialAssigns, index);
+    }
+
+    /// Return all PropertyAssign elements that bind to the geometry string
+    /// with the given index.
+    vector<PropertyAssignPtr> getPropertyAssigns(size_t index) const
+    {
+        return getMatches<PropertyAssign>(_propertyAssigns, index);
+    }
+
+    /// Return all PropertySetAssign elements that bind to the geometry string
+    /// with the given index.
+    vector<PropertySetAssignPtr> getPropertySetAssigns(size_t index) const
+    {
+        return getMatches<PropertySetAssign>(_propertySetAssigns, index);
+    }
+
+    /// Return all Visibility elements that bind to the geometry string with
+    /// the given index.
+    vector<VisibilityPtr> getVisibilities(size_t index) const
+    {
+        return getMatches<Visibility>(_visibilities, index);
+    }
+
+    /// Return the active VariantAssign elements of the look.
+    const vector<VariantAssignPtr>& getVariantAssigns() const
+    {
+        return _variantAssigns;
+    }
+
+    /// @}
+
+  public:
+    /// An assignment element and the geometry strings it binds to.
+    struct Assignment
+    {
+        /// The assignment element.
+        ElementPtr elem;
+        /// The geometry bindings of the element at the time of resolution.
+        string signature;
+        /// One bit per geometry string, set if the element binds to it.
+        vector<uint64_t> bits;
+
+        /// Return true if the element binds to the geometry string with the
+        /// given index.  Indices outside the resolved table return false.
+        bool matches(size_t index) const
+        {
+            size_t word = index / 64;
+            return word < bits.size() && ((bits[word] >> (index % 64)) & 1);
+        }
+    };
+    using AssignmentVec = vector<Assignment>;
+
+  private:
+    template<class T> vector<shared_ptr<T>> getMatches(const AssignmentVec& assigns, size_t index) const
+    {
+        vector<shared_ptr<T>> matches;
+        if (index >= _geoms.size())
+        {
+            return matches;
+        }
+        for (const Assignment& assign : assigns)
+        {
+            if (assign.matches(index))
+            {
+                matches.push_back(std::static_pointer_cast<T>(assign.elem));
+            }
+        }
+        return matches;
+    }
+
+  private:
+    ConstLookPtr _look;
+    StringVec _geoms;
+    unsigned int _threadCount;
+
+    AssignmentVec _materialAssigns;
+    AssignmentVec _propertyAssigns;
+    AssignmentVec _propertySetAssigns;
+    AssignmentVec _visibilities;
+    vector<VariantAssignPtr> _variantAssigns;
+};
+
 } // namespace MaterialX
 
 #endif
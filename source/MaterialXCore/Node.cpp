@@ -8,11 +8,119 @@
 #include <MaterialXCore/Document.h>
 #include <MaterialXCore/Material.h>
 
-#include <deque>
+#include <unordered_set>
 
 namespace MaterialX
 {
 
+namespace {
+
+// A node with a graph-based implementation, which is replaced by the nodes
+// of its implementation when a graph is flattened.
+struct SubgraphInstance
+{
+    NodePtr node;
+    NodeGraphPtr graph;
+    ConstCompiledGraphPtr compiledGraph;
+    vector<PortElementPtr> downstreamPorts;
+    vector<NodePtr> destNodes;
+};
+
+// Return the subgraph instances among the given nodes of a compiled graph,
+// in topological order where the graph is acyclic.
+vector<SubgraphInstance> getSubgraphInstances(ConstCompiledGraphPtr graph,
+                                              const vector<NodePtr>& nodes,
+                                              const string& target)
+{
+    std::unordered_set<const Element*> nodeSet;
+    for (NodePtr node : nodes)
+    {
+        nodeSet.insert(node.get());
+    }
+
+    vector<size_t> order;
+    if (!graph->hasCycle())
+    {
+        order = graph->getTopologicalOrder();
+    }
+    else
+    {
+        for (size_t id = 0; id < graph->getElementCount(); id++)
+        {
+            order.push_back(id);
+        }
+    }
+
+    // Implementations and compiled subgraphs are shared by all instances
+    // of the same node definition.
+    std::unordered_map<NodeDefPtr, NodeGraphPtr> graphImplMap;
+    std::unordered_map<NodeGraphPtr, ConstCompiledGraphPtr> compiledGraphMap;
+
+    vector<SubgraphInstance> instances;
+    for (size_t id : order)
+    {
+        NodePtr node = graph->getElement(id)->asA<Node>();
+        if (!node || !nodeSet.count(node.get()))
+        {
+            continue;
+        }
+        NodeDefPtr nodeDef = node->getNodeDef(target);
+        if (!nodeDef)
+        {
+            continue;
+        }
+
+        auto implIt = graphImplMap.find(nodeDef);
+        if (implIt == graphImplMap.end())
+        {
+            InterfaceElementPtr implement = nodeDef->getImplementation(target);
+            NodeGraphPtr subNodeGraph = implement ? implement->asA<NodeGraph>() : NodeGraphPtr();
+            implIt = graphImplMap.insert({ nodeDef, subNodeGraph }).first;
+        }
+        if (!implIt->second)
+        {
+            continue;
+        }
+
+        SubgraphInstance instance;
+        instance.node = node;
+        instance.graph = implIt->second;
+        auto compiledIt = compiledGraphMap.find(instance.graph);
+        if (compiledIt == compiledGraphMap.end())
+        {
+            compiledIt = compiledGraphMap.insert({ instance.graph, instance.graph->getCompiledGraph() }).first;
+        }
+        instance.compiledGraph = compiledIt->second;
+        for (const CompiledGraph::Connection& connection : graph->getDownstream(id))
+        {
+            PortElementPtr port = graph->getPort(connection.port);
+            if (port)
+            {
+                instance.downstreamPorts.push_back(port);
+            }
+        }
+        instances.push_back(instance);
+    }
+    return instances;
+}
+
+// Return a unique child name for the given parent, starting from the last
+// name generated for the same prefix.
+string createFlattenedChildName(ElementPtr parent, const string& prefix,
+                                std::unordered_map<string, string>& lastNames)
+{
+    auto it = lastNames.find(prefix);
+    string name = (it != lastNames.end()) ? incrementName(it->second) : createValidName(prefix);
+    while (parent->getChild(name))
+    {
+        name = incrementName(name);
+    }
+    lastNames[prefix] = name;
+    return name;
+}
+
+} // anonymous namespace
+
 //
 // Node methods
 //
@@ -143,44 +251,48 @@ bool Node::validate(string* message) const
 
 void GraphElement::flattenSubgraphs(const string& target)
 {
+    DocumentPtr doc = getDocument();
     vector<NodePtr> processNodeVec = getNodes();
     while (!processNodeVec.empty())
     {
-        // Precompute graph implementations and downstream ports for this node vector.
-        using PortElementVec = vector<PortElementPtr>;
-        std::unordered_map<NodePtr, NodeGraphPtr> graphImplMap;
-        std::unordered_map<NodePtr, PortElementVec> downstreamPortMap;
-        for (NodePtr cacheNode : processNodeVec)
+        // Gather all instantiations for this pass before the graph is modified,
+        // so that document lookups are resolved against a single refresh of
+        // the document cache.
+        vector<SubgraphInstance> instances = getSubgraphInstances(getCompiledGraph(), processNodeVec, target);
+        processNodeVec.clear();
+        if (instances.empty())
         {
-            InterfaceElementPtr implement = cacheNode->getImplementation(target);
-            if (!implement || !implement->isA<NodeGraph>())
-            {
-                continue;
-            }
-            NodeGraphPtr subNodeGraph = implement->asA<NodeGraph>();
-            graphImplMap[cacheNode] = subNodeGraph;
-            downstreamPortMap[cacheNode] = cacheNode->getDownstreamPorts();
-            for (NodePtr subNode : subNodeGraph->getNodes())
-            {
-                downstreamPortMap[subNode] = subNode->getDownstreamPorts();
-            }
+            break;
         }
-        processNodeVec.clear();
 
-        // Iterate through nodes with graph implementations.
-        for (auto pair : graphImplMap)
+        ScopedUpdate update(doc);
+        std::unordered_map<string, string> lastChildNames;
+        std::unordered_map<const Element*, size_t> instanceIndices;
+        std::unordered_set<const Element*> newNodes;
+
+        // Instantiate each subgraph in topological order, so that the
+        // connections of an instance have been rewired before they are
+        // transferred to the instances downstream from it.
+        for (size_t index = 0; index < instances.size(); index++)
         {
-            NodePtr processNode = pair.first;
-            NodeGraphPtr sourceSubGraph = pair.second;
-            std::unordered_map<NodePtr, NodePtr> subNodeMap;
+            SubgraphInstance& instance = instances[index];
+            NodePtr processNode = instance.node;
+            const CompiledGraph& sourceGraph = *instance.compiledGraph;
+            const string& sourceGraphName = instance.graph->getName();
+            vector<NodePtr> destNodes(sourceGraph.getElementCount());
 
             // Create a new instance of each original subnode.
-            for (NodePtr sourceSubNode : sourceSubGraph->getNodes())
+            for (size_t id = 0; id < sourceGraph.getElementCount(); id++)
             {
-                string destName = createValidChildName(sourceSubGraph->getName() + "_" + sourceSubNode->getName());
+                NodePtr sourceSubNode = sourceGraph.getElement(id)->asA<Node>();
+                if (!sourceSubNode)
+                {
+                    continue;
+                }
+
+                string destName = createFlattenedChildName(getSelf(), sourceGraphName + "_" + sourceSubNode->getName(), lastChildNames);
                 NodePtr destSubNode = addNode(sourceSubNode->getCategory(), destName);
                 destSubNode->copyContentFrom(sourceSubNode);
-                setChildIndex(destSubNode->getName(), getChildIndex(processNode->getName()));
 
                 // Transfer interface properties from the reference node to the new subnode.
                 for (ValueElementPtr destValue : destSubNode->getChildrenOfType<ValueElement>())
@@ -214,31 +326,36 @@ void GraphElement::flattenSubgraphs(const string& target)
                     destValue->removeAttribute(ValueElement::INTERFACE_NAME_ATTRIBUTE);
                 }
 
-                // Store the mapping between subgraphs.
-                subNodeMap[sourceSubNode] = destSubNode;
+                destNodes[id] = destSubNode;
+                newNodes.insert(destSubNode.get());
+                instance.destNodes.push_back(destSubNode);
 
                 // Add the subnode to the queue, allowing processing of nested subgraphs.
                 processNodeVec.push_back(destSubNode);
             }
 
             // Transfer internal connections between subgraphs.
-            for (auto subNodePair : subNodeMap)
+            for (size_t id = 0; id < sourceGraph.getElementCount(); id++)
             {
-                NodePtr sourceSubNode = subNodePair.first;
-                NodePtr destSubNode = subNodePair.second;
-                for (PortElementPtr sourcePort : downstreamPortMap[sourceSubNode])
+                NodePtr destSubNode = destNodes[id];
+                if (!destSubNode)
                 {
+                    continue;
+                }
+                for (const CompiledGraph::Connection& connection : sourceGraph.getDownstream(id))
+                {
+                    PortElementPtr sourcePort = sourceGraph.getPort(connection.port);
                     if (sourcePort->isA<Input>())
                     {
-                        auto it = subNodeMap.find(sourcePort->getParent()->asA<Node>());
-                        if (it != subNodeMap.end())
+                        NodePtr downstreamNode = destNodes[connection.element];
+                        if (downstreamNode)
                         {
-                            it->second->setConnectedNode(sourcePort->getName(), destSubNode);
+                            downstreamNode->setConnectedNode(sourcePort->getName(), destSubNode);
                         }
                     }
                     else if (sourcePort->isA<Output>())
                     {
-                        for (PortElementPtr processNodePort : downstreamPortMap[processNode])
+                        for (PortElementPtr processNodePort : instance.downstreamPorts)
                         {
                             processNodePort->setConnectedNode(destSubNode);
                         }
@@ -246,85 +363,59 @@ void GraphElement::flattenSubgraphs(const string& target)
                 }
             }
 
-            // The processed node has been replaced, so remove it from the graph.
-            removeNode(processNode->getName());
+            instanceIndices[processNode.get()] = index;
         }
-    }
-}
-
-vector<ElementPtr> GraphElement::topologicalSort() const
-{
-    // Calculate a topological order of the children, using Kahn's algorithm
-    // to avoid recursion.
-    //
-    // Running time: O(numNodes + numEdges).
-
-    const vector<ElementPtr>& children = getChildren();
-
-    // Calculate in-degrees for all children.
-    std::unordered_map<ElementPtr, size_t> inDegree(children.size());
-    std::deque<ElementPtr> childQueue;
-    for (ElementPtr child : children)
-    {
-        size_t connectionCount = 0;
-        for (size_t i = 0; i < child->getUpstreamEdgeCount(); ++i)
-        {
-            if (child->getUpstreamEdge(nullptr, i))
-            {
-                connectionCount++;
-            }
-        }
-
-        inDegree[child] = connectionCount;
 
-        // Enqueue children with in-degree 0.
-        if (connectionCount == 0)
+        // Remove each processed node through the standard removal path, so
+        // that change notifications and child bookkeeping are applied, and
+        // then move its subnodes to the position that it held.
+        vector<ElementPtr> origChildOrder = _childOrder;
+        for (const SubgraphInstance& instance : instances)
         {
-            childQueue.push_back(child);
+            removeNode(instance.node->getName());
         }
-    }
-
-    size_t visitCount = 0;
-    vector<ElementPtr> result;
-
-    while (!childQueue.empty())
-    {
-        // Pop the queue and add to topological order.
-        ElementPtr child = childQueue.front();
-        childQueue.pop_front();
-        result.push_back(child);
-
-        // Find connected nodes and decrease their in-degree, 
-        // adding node to the queue if in-degrees becomes 0.
-        if (child->isA<Node>())
+        vector<ElementPtr> childOrder;
+        childOrder.reserve(_childOrder.size());
+        for (ElementPtr child : origChildOrder)
         {
-            for (PortElementPtr port : child->asA<Node>()->getDownstreamPorts())
+            auto it = instanceIndices.find(child.get());
+            if (it != instanceIndices.end())
             {
-                const ElementPtr downstreamElem = port->isA<Output>() ? port : port->getParent();
-                if (inDegree[downstreamElem] > 1)
-                {
-                    inDegree[downstreamElem]--;
-                }
-                else
-                {
-                    inDegree[downstreamElem] = 0;
-                    childQueue.push_back(downstreamElem);
-                }
+                const vector<NodePtr>& destNodes = instances[it->second].destNodes;
+                childOrder.insert(childOrder.end(), destNodes.begin(), destNodes.end());
+            }
+            else if (!newNodes.count(child.get()))
+            {
+                childOrder.push_back(child);
             }
         }
-
-        visitCount++;
+        _childOrder.swap(childOrder);
     }
+}
+
+vector<ElementPtr> GraphElement::topologicalSort() const
+{
+    // Sort the compiled graph, whose connections have been resolved to
+    // integer ids.
+    //
+    // Running time: O(numNodes + numEdges).
+    ConstCompiledGraphPtr graph = getCompiledGraph();
+    const vector<size_t>& order = graph->getTopologicalOrder();
 
-    // Check if there was a cycle.
-    if (visitCount != children.size())
+    vector<ElementPtr> result;
+    result.reserve(order.size());
+    for (size_t id : order)
     {
-        throw ExceptionFoundCycle("Encountered a cycle in graph: " + getName());
+        result.push_back(graph->getElement(id));
     }
-
     return result;
 }
 
+ConstCompiledGraphPtr GraphElement::getCompiledGraph() const
+{
+    return getDocument()->getCompiledGraph(getSelf()->asA<GraphElement>());
+}
+
 string GraphElement::asStringDot() const
 {
     string dot = "digraph {\n";
@@ -216,6 +216,10 @@ class GraphElement : public InterfaceElement
 
     /// Flatten any references to graph-based node definitions within this
     /// node graph, replacing each reference with the equivalent node network.
+    ///
+    /// Nested references are flattened one level per pass.  Within each pass,
+    /// all instantiations are resolved before the graph is modified, and the
+    /// rewrite is performed as a single document update.
     void flattenSubgraphs(const string& target = EMPTY_STRING);
 
     /// Return a vector of all children (nodes and outputs) sorted in
@@ -223,6 +227,11 @@ class GraphElement : public InterfaceElement
     /// @throws ExceptionFoundCycle if a cycle is encountered.
     vector<ElementPtr> topologicalSort() const;
 
+    /// Return a compiled view of the connections between the children of
+    /// this graph.  The compiled graph is cached by the owning document, and
+    /// is rebuilt on first use after any modification to the document.
+    ConstCompiledGraphPtr getCompiledGraph() const;
+
     /// Convert this graph to a string in the DOT language syntax.  This can be
     /// used to visualise the graph using GraphViz (http://www.graphviz.org).
     ///
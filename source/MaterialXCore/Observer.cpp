@@ -0,0 +1,208 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXCore/Observer.h>
+
+#include <algorithm>
+#include <set>
+
+namespace MaterialX
+{
+
+//
+// ChangeSet methods
+//
+
+void ChangeSet::addElement(ElementPtr parent, ElementPtr elem)
+{
+    addChange(ChangeAddElement, parent, elem);
+    _lastAdded = elem;
+}
+
+void ChangeSet::removeElement(ElementPtr parent, ElementPtr elem)
+{
+    addChange(ChangeRemoveElement, parent, elem);
+}
+
+void ChangeSet::setAttribute(ElementPtr elem, const string& attrib, const string& value)
+{
+    if (!isLastAdded(elem))
+    {
+        addChange(ChangeSetAttribute, nullptr, elem, attrib, value);
+    }
+}
+
+void ChangeSet::removeAttribute(ElementPtr elem, const string& attrib, const string& value)
+{
+    if (!isLastAdded(elem))
+    {
+        addChange(ChangeRemoveAttribute, nullptr, elem, attrib, value);
+    }
+}
+
+void ChangeSet::copyContent(ElementPtr elem)
+{
+    if (!isLastAdded(elem))
+    {
+        addChange(ChangeCopyContent, nullptr, elem);
+    }
+}
+
+void ChangeSet::clearContent(ElementPtr elem)
+{
+    if (!isLastAdded(elem))
+    {
+        addChange(ChangeClearContent, nullptr, elem);
+    }
+}
+
+void ChangeSet::coalesce()
+{
+    // Build sorted sets of the added and removed elements.
+    vector<const Element*> addedSet;
+    vector<const Element*> removedSet;
+    for (const Change& change : _changes)
+    {
+        if (change.type == ChangeAddElement)
+        {
+            addedSet.push_back(change.elem.get());
+        }
+        else if (change.type == ChangeRemoveElement)
+        {
+            removedSet.push_back(change.elem.get());
+        }
+    }
+    std::sort(addedSet.begin(), addedSet.end());
+    std::sort(removedSet.begin(), removedSet.end());
+
+    auto isAdded = [&addedSet](const ElementPtr& elem)
+    {
+        return std::binary_search(addedSet.begin(), addedSet.end(), elem.get());
+    };
+
+    // Return true if the given element or one of its ancestors was removed
+    // within the transaction.
+    auto isDetached = [&removedSet](ConstElementPtr elem)
+    {
+        if (removedSet.empty())
+        {
+            return false;
+        }
+        for (; elem; elem = elem->getParent())
+        {
+            if (std::binary_search(removedSet.begin(), removedSet.end(), elem.get()))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Mark the changes to omit, visiting them in reverse order so that the
+    // last change to each attribute or content is the one that is kept.
+    vector<bool> omitted(_changes.size(), false);
+    std::set<std::pair<const Element*, string>> attributeSet;
+    std::set<std::pair<const Element*, int>> contentSet;
+    for (size_t i = _changes.size(); i-- > 0;)
+    {
+        const Change& change = _changes[i];
+        switch (change.type)
+        {
+            case ChangeAddElement:
+                omitted[i] = isDetached(change.elem);
+                break;
+            case ChangeRemoveElement:
+                omitted[i] = isAdded(change.elem);
+                break;
+            case ChangeSetAttribute:
+            case ChangeRemoveAttribute:
+                omitted[i] = isAdded(change.elem) || isDetached(change.elem) ||
+                             !attributeSet.insert(std::make_pair(change.elem.get(), change.attrib)).second;
+                break;
+            case ChangeCopyContent:
+            case ChangeClearContent:
+                omitted[i] = isAdded(change.elem) || isDetached(change.elem) ||
+                             !contentSet.insert(std::make_pair(change.elem.get(), (int) change.type)).second;
+                break;
+        }
+    }
+
+    // Remove the omitted changes, preserving the order of the others.
+    size_t count = 0;
+    for (size_t i = 0; i < _changes.size(); i++)
+    {
+        if (!omitted[i])
+        {
+            if (count != i)
+            {
+                _changes[count] = std::move(_changes[i]);
+            }
+            count++;
+        }
+    }
+    _changes.resize(count);
+    _lastAdded = nullptr;
+}
+
+void ChangeSet::clear()
+{
+    _changes.clear();
+    _lastAdded = nullptr;
+}
+
+void ChangeSet::addChange(ChangeType type, ElementPtr parent, ElementPtr elem,
+                          const string& attrib, const string& value)
+{
+    Change change;
+    change.type = type;
+    change.parent = parent;
+    change.elem = elem;
+    change.attrib = attrib;
+    change.value = value;
+    _changes.push_back(std::move(change));
+}
+
+bool ChangeSet::isLastAdded(const ElementPtr& elem) const
+{
+    // Most changes to added elements immediately follow their addition, so
+    // they are dropped here rather than recorded for coalescing.
+    return _lastAdded && _lastAdded == elem;
+}
+
+//
+// Observer methods
+//
+
+void Observer::onCommitTransaction(const ChangeSet& changes)
+{
+    onBeginUpdate();
+    for (const ChangeSet::Change& change : changes.getChanges())
+    {
+        switch (change.type)
+        {
+            case ChangeSet::ChangeAddElement:
+                onAddElement(change.parent, change.elem);
+                break;
+            case ChangeSet::ChangeRemoveElement:
+                onRemoveElement(change.parent, change.elem);
+                break;
+            case ChangeSet::ChangeSetAttribute:
+                onSetAttribute(change.elem, change.attrib, change.value);
+                break;
+            case ChangeSet::ChangeRemoveAttribute:
+                onRemoveAttribute(change.elem, change.attrib);
+                break;
+            case ChangeSet::ChangeCopyContent:
+                onCopyContent(change.elem);
+                break;
+            case ChangeSet::ChangeClearContent:
+                onClearContent(change.elem);
+                break;
+        }
+    }
+    onEndUpdate();
+}
+
+} // namespace MaterialX
@@ -14,6 +14,7 @@
 namespace MaterialX
 {
 
+class ChangeSet;
 class Observer;
 class ObservedDocument;
 
@@ -27,6 +28,105 @@ using ObservedDocumentPtr = shared_ptr<ObservedDocument>;
 /// A shared pointer to a const ObservedDocument
 using ConstObservedDocumentPtr = shared_ptr<const ObservedDocument>;
 
+/// @class ChangeSet
+/// The set of changes made to a document within a transaction.
+///
+/// Changes are recorded as they are made, and coalesced when the transaction
+/// is committed, preserving the order in which they were made.  Elements that
+/// are added and then removed within the transaction are omitted, only the
+/// last change to each attribute is kept, and changes to the attributes or
+/// content of elements added within the transaction are implied by their
+/// addition.
+/// @sa Document::beginTransaction
+class ChangeSet
+{
+  public:
+    /// The kinds of change that may be recorded.
+    enum ChangeType
+    {
+        ChangeAddElement = 0,
+        ChangeRemoveElement = 1,
+        ChangeSetAttribute = 2,
+        ChangeRemoveAttribute = 3,
+        ChangeCopyContent = 4,
+        ChangeClearContent = 5
+    };
+
+    /// A single recorded change.
+    struct Change
+    {
+        /// The kind of change.
+        ChangeType type;
+        /// The parent of an added or removed element.
+        ElementPtr parent;
+        /// The element that was added, removed, or modified.
+        ElementPtr elem;
+        /// The name of a set or removed attribute.
+        string attrib;
+        /// The value to which an attribute was set, or for a removed
+        /// attribute, its value before removal.
+        string value;
+    };
+
+  public:
+    /// @name Changes
+    /// @{
+
+    /// Return the recorded changes, in the order in which they were made.
+    const vector<Change>& getChanges() const
+    {
+        return _changes;
+    }
+
+    /// Return true if the change set contains no changes.
+    bool empty() const
+    {
+        return _changes.empty();
+    }
+
+    /// @}
+    /// @name Recording
+    /// @{
+
+    /// Record the addition of an element.
+    void addElement(ElementPtr parent, ElementPtr elem);
+
+    /// Record the removal of an element.
+    void removeElement(ElementPtr parent, ElementPtr elem);
+
+    /// Record the setting of an attribute to the given value.
+    void setAttribute(ElementPtr elem, const string& attrib, const string& value);
+
+    /// Record the removal of an attribute, given its value before removal.
+    void removeAttribute(ElementPtr elem, const string& attrib, const string& value);
+
+    /// Record the copying of content into an element.
+    void copyContent(ElementPtr elem);
+
+    /// Record the clearing of content from an element.
+    void clearContent(ElementPtr elem);
+
+    /// Coalesce the recorded changes, omitting elements that were added and
+    /// then detached from the document, changes to elements that were added
+    /// or detached, and all but the last change to each attribute or
+    /// content.  The order of the remaining changes is preserved.
+    void coalesce();
+
+    /// Clear all recorded changes.
+    void clear();
+
+    /// @}
+
+  private:
+    void addChange(ChangeType type, ElementPtr parent, ElementPtr elem,
+                   const string& attrib = EMPTY_STRING, const string& value = EMPTY_STRING);
+    bool isLastAdded(const ElementPtr& elem) const;
+
+  private:
+    vector<Change> _changes;
+    ElementPtr _lastAdded;
+};
+
 /// @class Observer
 /// An observer of a MaterialX Document.
 ///
@@ -67,6 +167,15 @@ class Observer
 
     /// Called after a set of document updates is performed.
     virtual void onEndUpdate() { }
+
+    /// Called when a transaction on the document is committed, with the
+    /// coalesced set of changes made within the transaction.  The default
+    /// implementation reports each change through the callbacks above, in
+    /// the order in which the changes were made, within a single update.
+    /// Note that the document is already in its committed state when the
+    /// changes are reported, so the value of a removed attribute is only
+    /// available from the change set.
+    virtual void onCommitTransaction(const ChangeSet& changes);
 };
 
 /// @class ObservedDocument
@@ -148,7 +257,11 @@ class ObservedDocument : public Document
     {
         Document::onAddElement(parent, elem);
 
-        if (_callbacksEnabled)
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.addElement(parent, elem);
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -160,7 +273,11 @@ class ObservedDocument : public Document
     void onRemoveElement(ElementPtr parent, ElementPtr elem) override
     {
         Document::onRemoveElement(parent, elem);
-        if (_callbacksEnabled)
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.removeElement(parent, elem);
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -172,7 +289,11 @@ class ObservedDocument : public Document
     void onSetAttribute(ElementPtr elem, const string& attrib, const string& value) override
     {
         Document::onSetAttribute(elem, attrib, value);
-        if (_callbacksEnabled)
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.setAttribute(elem, attrib, value);
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -184,7 +305,11 @@ class ObservedDocument : public Document
     void onRemoveAttribute(ElementPtr elem, const string& attrib) override
     {
         Document::onRemoveAttribute(elem, attrib);
-        if (_callbacksEnabled)
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.removeAttribute(elem, attrib, elem->getAttribute(attrib));
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -195,7 +320,12 @@ class ObservedDocument : public Document
 
     void onCopyContent(ElementPtr elem) override
     {
-        if (_callbacksEnabled)
+        Document::onCopyContent(elem);
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.copyContent(elem);
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -206,7 +336,12 @@ class ObservedDocument : public Document
 
     void onClearContent(ElementPtr elem) override
     {
-        if (_callbacksEnabled)
+        Document::onClearContent(elem);
+        if (_callbacksEnabled && getTransactionDepth())
+        {
+            _changeSet.clearContent(elem);
+        }
+        else if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
             {
@@ -239,8 +374,9 @@ class ObservedDocument : public Document
 
     void onBeginUpdate() override
     {
-        // Only send notification for the outermost scope.
-        if (!getUpdateScope())
+        // Only send notification for the outermost scope, outside of
+        // transactions.
+        if (!getUpdateScope() && !getTransactionDepth())
         {
             if (_callbacksEnabled)
             {
@@ -258,8 +394,9 @@ class ObservedDocument : public Document
     {
         _updateScope = std::max(_updateScope - 1, 0);
 
-        // Only send notification for the outermost scope.
-        if (!getUpdateScope())
+        // Only send notification for the outermost scope, outside of
+        // transactions.
+        if (!getUpdateScope() && !getTransactionDepth())
         {
             if (_callbacksEnabled)
             {
@@ -271,6 +408,20 @@ class ObservedDocument : public Document
         }
     }
 
+    void onCommitTransaction() override
+    {
+        ChangeSet changes;
+        std::swap(changes, _changeSet);
+        changes.coalesce();
+        if (_callbacksEnabled && !changes.empty())
+        {
+            for (auto& item : _observerMap)
+            {
+                item.second->onCommitTransaction(changes);
+            }
+        }
+    }
+
     void enableCallbacks() override
     {
         _callbacksEnabled = true;
@@ -285,6 +436,7 @@ class ObservedDocument : public Document
 
   private:
     std::unordered_map<string, ObserverPtr> _observerMap;
+    ChangeSet _changeSet;
     int _updateScope;
     bool _callbacksEnabled;
 };
@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Node.h>
 
+#include <limits>
+
 namespace MaterialX
 {
 
@@ -16,6 +18,8 @@ const TreeIterator NULL_TREE_ITERATOR(nullptr);
 const GraphIterator NULL_GRAPH_ITERATOR(nullptr, nullptr);
 const InheritanceIterator NULL_INHERITANCE_ITERATOR(nullptr);
 
+const size_t CompiledGraph::INVALID_ID = std::numeric_limits<size_t>::max();
+
 //
 // Edge methods
 //
@@ -216,4 +220,112 @@ InheritanceIterator& InheritanceIterator::operator++()
     return *this;
 }
 
+//
+// CompiledGraph methods
+//
+
+CompiledGraphPtr CompiledGraph::create(ConstGraphElementPtr graph)
+{
+    CompiledGraphPtr compiled = std::make_shared<CompiledGraph>();
+    compiled->_graphName = graph->getName();
+    compiled->_elements = graph->getChildren();
+    const vector<ElementPtr>& elements = compiled->_elements;
+    size_t elementCount = elements.size();
+    compiled->_elementIds.reserve(elementCount);
+    for (size_t id = 0; id < elementCount; id++)
+    {
+        compiled->_elementIds[elements[id].get()] = id;
+    }
+
+    // Gather upstream connections between children, resolving each
+    // connection by name exactly once.
+    compiled->_upstreamOffsets.reserve(elementCount + 1);
+    compiled->_upstreamOffsets.push_back(0);
+    for (size_t id = 0; id < elementCount; id++)
+    {
+        ElementPtr elem = elements[id];
+        for (size_t i = 0; i < elem->getUpstreamEdgeCount(); i++)
+        {
+            Edge edge = elem->getUpstreamEdge(nullptr, i);
+            if (!edge)
+            {
+                continue;
+            }
+            auto it = compiled->_elementIds.find(edge.getUpstreamElement().get());
+            if (it == compiled->_elementIds.end())
+            {
+                continue;
+            }
+            ElementPtr connectingElem = edge.getConnectingElement();
+            PortElementPtr port = connectingElem ? connectingElem->asA<PortElement>() : elem->asA<PortElement>();
+            compiled->_upstream.push_back({ it->second, compiled->_ports.size() });
+            compiled->_ports.push_back(port);
+        }
+        compiled->_upstreamOffsets.push_back(compiled->_upstream.size());
+    }
+
+    // Build downstream connections by transposing the upstream connections.
+    vector<size_t>& downstreamOffsets = compiled->_downstreamOffsets;
+    downstreamOffsets.assign(elementCount + 1, 0);
+    for (const Connection& connection : compiled->_upstream)
+    {
+        downstreamOffsets[connection.element + 1]++;
+    }
+    for (size_t id = 0; id < elementCount; id++)
+    {
+        downstreamOffsets[id + 1] += downstreamOffsets[id];
+    }
+    compiled->_downstream.resize(compiled->_upstream.size());
+    vector<size_t> writeOffsets(downstreamOffsets.begin(), downstreamOffsets.end() - 1);
+    for (size_t id = 0; id < elementCount; id++)
+    {
+        for (const Connection& connection : compiled->getUpstream(id))
+        {
+            compiled->_downstream[writeOffsets[connection.element]++] = { id, connection.port };
+        }
+    }
+
+    // Calculate a topological order using Kahn's algorithm, detecting
+    // cycles as children that are never visited.
+    vector<size_t> inDegree(elementCount);
+    vector<size_t>& order = compiled->_topologicalOrder;
+    order.reserve(elementCount);
+    for (size_t id = 0; id < elementCount; id++)
+    {
+        inDegree[id] = compiled->getUpstream(id).size();
+        if (!inDegree[id])
+        {
+            order.push_back(id);
+        }
+    }
+    for (size_t head = 0; head < order.size(); head++)
+    {
+        for (const Connection& connection : compiled->getDownstream(order[head]))
+        {
+            if (--inDegree[connection.element] == 0)
+            {
+                order.push_back(connection.element);
+            }
+        }
+    }
+    compiled->_hasCycle = (order.size() != elementCount);
+
+    return compiled;
+}
+
+size_t CompiledGraph::getElementId(ConstElementPtr elem) const
+{
+    auto it = _elementIds.find(elem.get());
+    return (it != _elementIds.end()) ? it->second : INVALID_ID;
+}
+
+const vector<size_t>& CompiledGraph::getTopologicalOrder() const
+{
+    if (_hasCycle)
+    {
+        throw ExceptionFoundCycle("Encountered a cycle in graph: " + _graphName);
+    }
+    return _topologicalOrder;
+}
+
 } // namespace MaterialX
@@ -16,10 +16,20 @@ namespace MaterialX
 
 class Element;
 class Material;
+class GraphElement;
+class PortElement;
+class CompiledGraph;
 
 using ElementPtr = shared_ptr<Element>;
 using ConstElementPtr = shared_ptr<const Element>;
 using ConstMaterialPtr = shared_ptr<const Material>;
+using ConstGraphElementPtr = shared_ptr<const GraphElement>;
+using PortElementPtr = shared_ptr<PortElement>;
+
+/// A shared pointer to a CompiledGraph
+using CompiledGraphPtr = shared_ptr<CompiledGraph>;
+/// A shared pointer to a const CompiledGraph
+using ConstCompiledGraphPtr = shared_ptr<const CompiledGraph>;
 
 /// @class Edge
 /// An edge between two connected Elements, returned during graph traversal.
@@ -388,6 +398,148 @@ class InheritanceIterator
     size_t _holdCount;
 };
 
+/// @class CompiledGraph
+/// A flat, index-based view of the connections between the children of a
+/// GraphElement.
+///
+/// Each child of the graph is assigned an integer id in child order, and each
+/// connection between two children is assigned an integer port id.  The
+/// upstream and downstream connections of all children are stored in
+/// compressed sparse row arrays, so that traversals, topological sorts and
+/// cycle checks run on integers rather than element names.
+///
+/// A compiled graph is a snapshot of its source graph at creation time.
+/// GraphElement::getCompiledGraph returns a cached instance, which is
+/// invalidated whenever the owning document is modified.
+/// @sa GraphElement::getCompiledGraph
+class CompiledGraph
+{
+  public:
+    /// A connection to a neighboring child of the graph.
+    struct Connection
+    {
+        /// The id of the neighboring child.
+        size_t element;
+        /// The id of the port through which the connection is made.
+        size_t port;
+    };
+
+    /// An iteration range over the connections of a child.
+    class ConnectionRange
+    {
+      public:
+        ConnectionRange(const Connection* begin, const Connection* end) :
+            _begin(begin),
+            _end(end)
+        {
+        }
+
+        const Connection* begin() const { return _begin; }
+        const Connection* end() const { return _end; }
+        size_t size() const { return (size_t) (_end - _begin); }
+        bool empty() const { return _begin == _end; }
+
+      private:
+        const Connection* _begin;
+        const Connection* _end;
+    };
+
+  public:
+    CompiledGraph() :
+        _hasCycle(false)
+    {
+    }
+    ~CompiledGraph() { }
+
+    /// Create a compiled graph from the current state of the given graph.
+    static CompiledGraphPtr create(ConstGraphElementPtr graph);
+
+    /// @name Elements and Ports
+    /// @{
+
+    /// Return the number of children in the graph.
+    size_t getElementCount() const
+    {
+        return _elements.size();
+    }
+
+    /// Return the child with the given id.
+    ElementPtr getElement(size_t id) const
+    {
+        return _elements[id];
+    }
+
+    /// Return the id of the given child, or INVALID_ID if the element is not
+    /// a child of the graph.
+    size_t getElementId(ConstElementPtr elem) const;
+
+    /// Return the number of ports in the graph.
+    size_t getPortCount() const
+    {
+        return _ports.size();
+    }
+
+    /// Return the port with the given id.  For a connection to a node input,
+    /// this is the Input element, and for a connection to a graph output, it
+    /// is the Output element itself.
+    PortElementPtr getPort(size_t id) const
+    {
+        return _ports[id];
+    }
+
+    /// @}
+    /// @name Connections
+    /// @{
+
+    /// Return the connections from the given child to the children directly
+    /// upstream from it, in port order.
+    ConnectionRange getUpstream(size_t id) const
+    {
+        return ConnectionRange(_upstream.data() + _upstreamOffsets[id],
+                               _upstream.data() + _upstreamOffsets[id + 1]);
+    }
+
+    /// Return the connections from the given child to the children directly
+    /// downstream from it.
+    ConnectionRange getDownstream(size_t id) const
+    {
+        return ConnectionRange(_downstream.data() + _downstreamOffsets[id],
+                               _downstream.data() + _downstreamOffsets[id + 1]);
+    }
+
+    /// @}
+    /// @name Ordering
+    /// @{
+
+    /// Return true if the graph contains a cycle.
+    bool hasCycle() const
+    {
+        return _hasCycle;
+    }
+
+    /// Return the ids of all children in topological order, with each child
+    /// preceding the children downstream from it.
+    /// @throws ExceptionFoundCycle if the graph contains a cycle.
+    const vector<size_t>& getTopologicalOrder() const;
+
+    /// @}
+
+  public:
+    static const size_t INVALID_ID;
+
+  private:
+    string _graphName;
+    vector<ElementPtr> _elements;
+    std::unordered_map<const Element*, size_t> _elementIds;
+    vector<PortElementPtr> _ports;
+    vector<size_t> _upstreamOffsets;
+    vector<Connection> _upstream;
+    vector<size_t> _downstreamOffsets;
+    vector<Connection> _downstream;
+    vector<size_t> _topologicalOrder;
+    bool _hasCycle;
+};
+
 /// @class ExceptionFoundCycle
 /// An exception that is thrown when a traversal call encounters a cycle.
 class ExceptionFoundCycle : public Exception
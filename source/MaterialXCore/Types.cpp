@@ -7,6 +7,18 @@
 
 #include <cmath>
 
+// SIMD paths may be disabled by defining MATERIALX_NO_SIMD, in which case
+// the equivalent scalar code is used on all platforms.
+#if !defined(MATERIALX_NO_SIMD)
+    #if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #include <xmmintrin.h>
+        #define MATERIALX_SIMD_SSE
+    #elif defined(__ARM_NEON) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        #define MATERIALX_SIMD_NEON
+    #endif
+#endif
+
 namespace MaterialX
 {
 
@@ -33,6 +45,89 @@ const Matrix44 Matrix44::IDENTITY(1, 0, 0, 0,
                                   0, 0, 1, 0,
                                   0, 0, 0, 1);
 
+namespace {
+
+#if defined(MATERIALX_SIMD_SSE)
+
+using Float4 = __m128;
+inline Float4 load4(const float* p) { return _mm_loadu_ps(p); }
+inline void store4(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+inline Float4 splat4(float s) { return _mm_set1_ps(s); }
+inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+#elif defined(MATERIALX_SIMD_NEON)
+
+using Float4 = float32x4_t;
+inline Float4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, Float4 v) { vst1q_f32(p, v); }
+inline Float4 splat4(float s) { return vdupq_n_f32(s); }
+inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+#else
+
+// Scalar stand-in for a SIMD register, for platforms without SSE or NEON.
+struct Float4
+{
+    float v[4];
+};
+inline Float4 load4(const float* p) { return Float4{ { p[0], p[1], p[2], p[3] } }; }
+inline void store4(float* p, Float4 a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+inline Float4 splat4(float s) { return Float4{ { s, s, s, s } }; }
+inline Float4 add4(Float4 a, Float4 b) { return Float4{ { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+inline Float4 mul4(Float4 a, Float4 b) { return Float4{ { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+
+#endif
+
+// The rows of a Matrix44, held in registers for repeated transformations.
+struct MatrixRows
+{
+    explicit MatrixRows(const Matrix44& m) :
+        r0(load4(m[0].data())),
+        r1(load4(m[1].data())),
+        r2(load4(m[2].data())),
+        r3(load4(m[3].data()))
+    {
+    }
+
+    // Return the product of the row vector (x, y, z, w) and the matrix.
+    Float4 multiply(float x, float y, float z, float w) const
+    {
+        Float4 res = mul4(splat4(x), r0);
+        res = add4(res, mul4(splat4(y), r1));
+        res = add4(res, mul4(splat4(z), r2));
+        return add4(res, mul4(splat4(w), r3));
+    }
+
+    // Return the product of the row vector (x, y, z, 1) and the matrix.
+    Float4 multiplyPoint(float x, float y, float z) const
+    {
+        Float4 res = mul4(splat4(x), r0);
+        res = add4(res, mul4(splat4(y), r1));
+        res = add4(res, mul4(splat4(z), r2));
+        return add4(res, r3);
+    }
+
+    // Return the product of the row vector (x, y, z, 0) and the matrix.
+    Float4 multiplyVector(float x, float y, float z) const
+    {
+        Float4 res = mul4(splat4(x), r0);
+        res = add4(res, mul4(splat4(y), r1));
+        return add4(res, mul4(splat4(z), r2));
+    }
+
+    Float4 r0, r1, r2, r3;
+};
+
+Vector3 toVector3(Float4 v)
+{
+    float res[4];
+    store4(res, v);
+    return Vector3(res[0], res[1], res[2]);
+}
+
+} // anonymous namespace
 
 //
 // Vector methods
@@ -185,6 +280,59 @@ template <> Matrix44 MatrixN<Matrix44, float, 4>::getAdjugate() const
         _arr[0][0]*_arr[2][1]*_arr[1][2] - _arr[1][0]*_arr[0][1]*_arr[2][2] - _arr[2][0]*_arr[1][1]*_arr[0][2]);
 }
 
+template <> Matrix44 MatrixN<Matrix44, float, 4>::operator*(const Matrix44& rhs) const
+{
+    MatrixRows rows(rhs);
+    Matrix44 res(Uninit{});
+    for (size_t i = 0; i < 4; i++)
+    {
+        store4(res[i].data(), rows.multiply(_arr[i][0], _arr[i][1], _arr[i][2], _arr[i][3]));
+    }
+    return res;
+}
+
+template <> Matrix44 MatrixN<Matrix44, float, 4>::getInverse() const
+{
+    const float s0 = _arr[0][0] * _arr[1][1] - _arr[1][0] * _arr[0][1];
+    const float s1 = _arr[0][0] * _arr[1][2] - _arr[1][0] * _arr[0][2];
+    const float s2 = _arr[0][0] * _arr[1][3] - _arr[1][0] * _arr[0][3];
+    const float s3 = _arr[0][1] * _arr[1][2] - _arr[1][1] * _arr[0][2];
+    const float s4 = _arr[0][1] * _arr[1][3] - _arr[1][1] * _arr[0][3];
+    const float s5 = _arr[0][2] * _arr[1][3] - _arr[1][2] * _arr[0][3];
+
+    const float c5 = _arr[2][2] * _arr[3][3] - _arr[3][2] * _arr[2][3];
+    const float c4 = _arr[2][1] * _arr[3][3] - _arr[3][1] * _arr[2][3];
+    const float c3 = _arr[2][1] * _arr[3][2] - _arr[3][1] * _arr[2][2];
+    const float c2 = _arr[2][0] * _arr[3][3] - _arr[3][0] * _arr[2][3];
+    const float c1 = _arr[2][0] * _arr[3][2] - _arr[3][0] * _arr[2][2];
+    const float c0 = _arr[2][0] * _arr[3][1] - _arr[3][0] * _arr[2][1];
+
+    const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+    Matrix44 adj(
+         _arr[1][1] * c5 - _arr[1][2] * c4 + _arr[1][3] * c3,
+        -_arr[0][1] * c5 + _arr[0][2] * c4 - _arr[0][3] * c3,
+         _arr[3][1] * s5 - _arr[3][2] * s4 + _arr[3][3] * s3,
+        -_arr[2][1] * s5 + _arr[2][2] * s4 - _arr[2][3] * s3,
+
+        -_arr[1][0] * c5 + _arr[1][2] * c2 - _arr[1][3] * c1,
+         _arr[0][0] * c5 - _arr[0][2] * c2 + _arr[0][3] * c1,
+        -_arr[3][0] * s5 + _arr[3][2] * s2 - _arr[3][3] * s1,
+         _arr[2][0] * s5 - _arr[2][2] * s2 + _arr[2][3] * s1,
+
+         _arr[1][0] * c4 - _arr[1][1] * c2 + _arr[1][3] * c0,
+        -_arr[0][0] * c4 + _arr[0][1] * c2 - _arr[0][3] * c0,
+         _arr[3][0] * s4 - _arr[3][1] * s2 + _arr[3][3] * s0,
+        -_arr[2][0] * s4 + _arr[2][1] * s2 - _arr[2][3] * s0,
+
+        -_arr[1][0] * c3 + _arr[1][1] * c1 - _arr[1][2] * c0,
+         _arr[0][0] * c3 - _arr[0][1] * c1 + _arr[0][2] * c0,
+        -_arr[3][0] * s3 + _arr[3][1] * s1 - _arr[3][2] * s0,
+         _arr[2][0] * s3 - _arr[2][1] * s1 + _arr[2][2] * s0);
+
+    return adj / det;
+}
+
 Matrix44 Matrix44::createTranslation(const Vector3& v)
 {
     return Matrix44(1.0f, 0.0f, 0.0f, 0.0f,
@@ -234,4 +382,66 @@ Matrix44 Matrix44::createRotationZ(float angle)
                     0.0f, 0.0f, 0.0f, 1.0f);
 }
 
+Vector4 Matrix44::multiply(const Vector4& v) const
+{
+    Vector4 res(Uninit{});
+    store4(res.data(), MatrixRows(*this).multiply(v[0], v[1], v[2], v[3]));
+    return res;
+}
+
+Vector3 Matrix44::transformPoint(const Vector3& v) const
+{
+    return toVector3(MatrixRows(*this).multiplyPoint(v[0], v[1], v[2]));
+}
+
+Vector3 Matrix44::transformVector(const Vector3& v) const
+{
+    return toVector3(MatrixRows(*this).multiplyVector(v[0], v[1], v[2]));
+}
+
+void Matrix44::transformPoints(const Vector3* src, Vector3* dst, size_t count) const
+{
+    MatrixRows rows(*this);
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = toVector3(rows.multiplyPoint(src[i][0], src[i][1], src[i][2]));
+    }
+}
+
+void Matrix44::transformVectors(const Vector3* src, Vector3* dst, size_t count) const
+{
+    MatrixRows rows(*this);
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = toVector3(rows.multiplyVector(src[i][0], src[i][1], src[i][2]));
+    }
+}
+
+Matrix44 Matrix44::getAffineInverse() const
+{
+    // Invert the upper 3x3 block through its cofactors.
+    const float c00 = _arr[1][1] * _arr[2][2] - _arr[2][1] * _arr[1][2];
+    const float c01 = _arr[2][1] * _arr[0][2] - _arr[0][1] * _arr[2][2];
+    const float c02 = _arr[0][1] * _arr[1][2] - _arr[1][1] * _arr[0][2];
+    const float c10 = _arr[1][2] * _arr[2][0] - _arr[2][2] * _arr[1][0];
+    const float c11 = _arr[2][2] * _arr[0][0] - _arr[0][2] * _arr[2][0];
+    const float c12 = _arr[0][2] * _arr[1][0] - _arr[1][2] * _arr[0][0];
+    const float c20 = _arr[1][0] * _arr[2][1] - _arr[2][0] * _arr[1][1];
+    const float c21 = _arr[2][0] * _arr[0][1] - _arr[0][0] * _arr[2][1];
+    const float c22 = _arr[0][0] * _arr[1][1] - _arr[1][0] * _arr[0][1];
+    const float invDet = 1.0f / (_arr[0][0] * c00 + _arr[0][1] * c10 + _arr[0][2] * c20);
+
+    Matrix44 res(c00 * invDet, c01 * invDet, c02 * invDet, 0.0f,
+                 c10 * invDet, c11 * invDet, c12 * invDet, 0.0f,
+                 c20 * invDet, c21 * invDet, c22 * invDet, 0.0f,
+                 0.0f, 0.0f, 0.0f, 1.0f);
+
+    // Transform the negated translation by the inverted block.
+    for (size_t j = 0; j < 3; j++)
+    {
+        res[3][j] = -(_arr[3][0] * res[0][j] + _arr[3][1] * res[1][j] + _arr[3][2] * res[2][j]);
+    }
+    return res;
+}
+
 } // namespace MaterialX
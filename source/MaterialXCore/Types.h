@@ -69,11 +69,13 @@ template <class V, class S, size_t N> class VectorN : public VectorBase
     /// @name Indexing Operators
     /// @{
 
-    /// Return the scalar value at the given index.
-    S& operator[](size_t i) { return _arr.at(i); }
+    /// Return the scalar value at the given index.  The index is not
+    /// bounds-checked.
+    S& operator[](size_t i) { return _arr[i]; }
 
-    /// Return the const scalar value at the given index.
-    const S& operator[](size_t i) const { return _arr.at(i); }
+    /// Return the const scalar value at the given index.  The index is not
+    /// bounds-checked.
+    const S& operator[](size_t i) const { return _arr[i]; }
 
     /// @}
     /// @name Component-wise Operators
@@ -362,11 +364,13 @@ template <class M, class S, size_t N> class MatrixN : public MatrixBase
     /// @name Indexing Operators
     /// @{
 
-    /// Return the row array at the given index.
-    RowArray& operator[](size_t i) { return _arr.at(i); }
+    /// Return the row array at the given index.  The index is not
+    /// bounds-checked.
+    RowArray& operator[](size_t i) { return _arr[i]; }
 
-    /// Return the const row array at the given index.
-    const RowArray& operator[](size_t i) const { return _arr.at(i); }
+    /// Return the const row array at the given index.  The index is not
+    /// bounds-checked.
+    const RowArray& operator[](size_t i) const { return _arr[i]; }
 
     /// @}
     /// @name Component-wise Operators
@@ -605,11 +609,52 @@ class Matrix44 : public MatrixN<Matrix44, float, 4>
     static Matrix44 createRotationZ(float angle);
 
     /// @}
+    /// @name Vector Transformations
+    /// @{
+
+    /// Return the product of the given row vector and this matrix.
+    Vector4 multiply(const Vector4& v) const;
+
+    /// Transform the given 3D point, treating it as a row vector with an
+    /// implicit fourth component of one.
+    Vector3 transformPoint(const Vector3& v) const;
+
+    /// Transform the given 3D direction vector, ignoring the translation
+    /// of this matrix.
+    Vector3 transformVector(const Vector3& v) const;
+
+    /// Transform an array of 3D points.  The source and destination arrays
+    /// may be identical, but must not otherwise overlap.
+    void transformPoints(const Vector3* src, Vector3* dst, size_t count) const;
+
+    /// Transform an array of 3D direction vectors, ignoring the translation
+    /// of this matrix.  The source and destination arrays may be identical,
+    /// but must not otherwise overlap.
+    void transformVectors(const Vector3* src, Vector3* dst, size_t count) const;
+
+    /// @}
+    /// @name Affine Transformations
+    /// @{
+
+    /// Return the inverse of an affine matrix, whose last column is
+    /// (0, 0, 0, 1).  This is faster than the general inverse, but the
+    /// result is undefined if the matrix is not affine.
+    Matrix44 getAffineInverse() const;
+
+    /// @}
 
   public:
     static const Matrix44 IDENTITY;
 };
 
+/// Matrix product specialized for Matrix44, using SIMD instructions where
+/// available.
+template <> Matrix44 MatrixN<Matrix44, float, 4>::operator*(const Matrix44& rhs) const;
+
+/// Matrix inverse specialized for Matrix44, expanding the determinant and
+/// adjugate in terms of shared 2x2 minors.
+template <> Matrix44 MatrixN<Matrix44, float, 4>::getInverse() const;
+
 } // namespace MaterialX
 
 #endif
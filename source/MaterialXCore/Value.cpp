@@ -7,7 +7,11 @@
 
 #include <MaterialXCore/Util.h>
 
-#include <iomanip>
+#include <clocale>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <locale>
 #include <sstream>
 #include <type_traits>
 
@@ -15,8 +19,8 @@ namespace MaterialX
 {
 
 Value::CreatorMap Value::_creatorMap;
-Value::FloatFormat Value::_floatFormat = Value::FloatFormatDefault;
-int Value::_floatPrecision = 6;
+thread_local Value::FloatFormat Value::_floatFormat = Value::FloatFormatDefault;
+thread_local int Value::_floatPrecision = 6;
 
 namespace {
 
@@ -30,15 +34,148 @@ template <class T> class is_std_vector< vector<T> > : public std::true_type { };
 template <class T> using enable_if_std_vector_t =
     typename std::enable_if<is_std_vector<T>::value, T>::type;
 
-template <class T> void stringToData(const string& value, T& data)
+template <class T> using enable_if_integral_t =
+    typename std::enable_if<std::is_integral<T>::value, T>::type;
+template <class T> using enable_if_floating_point_t =
+    typename std::enable_if<std::is_floating_point<T>::value, T>::type;
+
+bool isArraySeparator(char c)
+{
+    return ARRAY_VALID_SEPARATORS.find(c) != string::npos;
+}
+
+// Call the given function with the range of each token in an array string,
+// splitting at the same separators as splitString.
+template <class F> void forEachToken(const string& str, F func)
+{
+    const char* it = str.data();
+    const char* end = it + str.size();
+    while (true)
+    {
+        while (it != end && isArraySeparator(*it))
+            it++;
+        if (it == end)
+            break;
+        const char* begin = it;
+        while (it != end && !isArraySeparator(*it))
+            it++;
+        func(begin, it);
+    }
+}
+
+// Parse a number through a stream in the classic locale.  This handles any
+// input that is not accepted by the direct parsers below.
+template <class T> bool parseNumberStream(const char* begin, const char* end, T& data)
+{
+    std::istringstream ss(string(begin, end));
+    ss.imbue(std::locale::classic());
+    return static_cast<bool>(ss >> data);
+}
+
+template <class T> bool parseNumber(const char* begin, const char* end, enable_if_integral_t<T>& data)
+{
+    const char* it = begin;
+    bool negative = (it != end && *it == '-');
+    if (it != end && (*it == '-' || *it == '+'))
+        it++;
+    if (it == end || end - it > std::numeric_limits<T>::digits10)
+        return parseNumberStream(begin, end, data);
+
+    T value = 0;
+    for (; it != end; it++)
+    {
+        if (*it < '0' || *it > '9')
+            return parseNumberStream(begin, end, data);
+        value = value * 10 + (*it - '0');
+    }
+    data = negative ? -value : value;
+    return true;
+}
+
+// Parse a floating-point number, computing simple decimal strings directly.
+// When the significand and power of ten are both exactly representable in
+// the destination type, a single multiplication or division yields the
+// correctly rounded result, so this matches the stream conversion exactly.
+template <class T> bool parseNumber(const char* begin, const char* end, enable_if_floating_point_t<T>& data)
+{
+    const uint64_t MAX_SIGNIFICAND = uint64_t(1) << std::numeric_limits<T>::digits;
+    const int MAX_EXPONENT = std::numeric_limits<T>::digits >= 53 ? 22 : 10;
+    static const T POWERS_OF_TEN[] =
+    {
+        T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7),
+        T(1e8), T(1e9), T(1e10), T(1e11), T(1e12), T(1e13), T(1e14), T(1e15),
+        T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22)
+    };
+
+    const char* it = begin;
+    bool negative = (it != end && *it == '-');
+    if (it != end && (*it == '-' || *it == '+'))
+        it++;
+
+    uint64_t significand = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; it != end && *it >= '0' && *it <= '9'; it++)
+    {
+        if (significand >= MAX_SIGNIFICAND)
+            return parseNumberStream(begin, end, data);
+        significand = significand * 10 + (*it - '0');
+        hasDigits = true;
+    }
+    if (it != end && *it == '.')
+    {
+        for (it++; it != end && *it >= '0' && *it <= '9'; it++)
+        {
+            if (significand >= MAX_SIGNIFICAND)
+                return parseNumberStream(begin, end, data);
+            significand = significand * 10 + (*it - '0');
+            exponent--;
+            hasDigits = true;
+        }
+    }
+    if (!hasDigits)
+        return parseNumberStream(begin, end, data);
+    if (it != end && (*it == 'e' || *it == 'E'))
+    {
+        const char* expBegin = ++it;
+        bool negativeExp = (it != end && *it == '-');
+        if (it != end && (*it == '-' || *it == '+'))
+            it++;
+        int exp = 0;
+        for (; it != end && *it >= '0' && *it <= '9' && exp < 1000; it++)
+            exp = exp * 10 + (*it - '0');
+        if (it == expBegin || it[-1] < '0' || it[-1] > '9')
+            return parseNumberStream(begin, end, data);
+        exponent += negativeExp ? -exp : exp;
+    }
+    if (it != end || significand > MAX_SIGNIFICAND ||
+        (significand && (exponent < -MAX_EXPONENT || exponent > MAX_EXPONENT)))
+    {
+        return parseNumberStream(begin, end, data);
+    }
+
+    T value = T(significand);
+    if (exponent < 0)
+        value /= POWERS_OF_TEN[-exponent];
+    else if (exponent > 0)
+        value *= POWERS_OF_TEN[exponent];
+    data = negative ? -value : value;
+    return true;
+}
+
+template <class T> void numberToData(const char* begin, const char* end, T& data)
 {
-    std::stringstream ss(value);
-    if (!(ss >> data))
+    if (!parseNumber<T>(begin, end, data))
     {
-        throw ExceptionTypeError("Type mismatch in generic stringToData: " + value);
+        throw ExceptionTypeError("Type mismatch in generic stringToData: " + string(begin, end));
     }
 }
 
+template <class T> void stringToData(const string& value, T& data)
+{
+    numberToData(value.data(), value.data() + value.size(), data);
+}
+
 template <> void stringToData(const string& str, bool& data)
 {
     if (str == VALUE_STRING_TRUE)
@@ -54,59 +191,114 @@ template <> void stringToData(const string& str, string& data)
     data = str;
 }
 
+// Convert a token of an array string to data.  Numeric tokens are parsed in
+// place, while other types are converted through their string overloads.
+template <class T> void tokenToData(const char* begin, const char* end, T& data)
+{
+    stringToData(string(begin, end), data);
+}
+
+template <> void tokenToData(const char* begin, const char* end, int& data)
+{
+    numberToData(begin, end, data);
+}
+
+template <> void tokenToData(const char* begin, const char* end, float& data)
+{
+    numberToData(begin, end, data);
+}
+
 template <class T> void stringToData(const string& str, enable_if_mx_vector_t<T>& data)
 {
-    StringVec tokens = splitString(str, ARRAY_VALID_SEPARATORS);
-    if (tokens.size() != data.numElements())
+    size_t count = 0;
+    forEachToken(str, [&](const char* begin, const char* end)
     {
-        throw ExceptionTypeError("Type mismatch in vector stringToData: " + str);
-    }
-    for (size_t i = 0; i < data.numElements(); i++)
+        if (count < data.numElements())
+        {
+            tokenToData(begin, end, data[count]);
+        }
+        count++;
+    });
+    if (count != data.numElements())
     {
-        stringToData(tokens[i], data[i]);
+        throw ExceptionTypeError("Type mismatch in vector stringToData: " + str);
     }
 }
 
 template <class T> void stringToData(const string& str, enable_if_mx_matrix_t<T>& data)
 {
-    StringVec tokens = splitString(str, ARRAY_VALID_SEPARATORS);
-    if (tokens.size() != data.numRows() * data.numColumns())
-    {
-        throw ExceptionTypeError("Type mismatch in matrix stringToData: " + str);
-    }
-    for (size_t i = 0; i < data.numRows(); i++)
+    size_t count = 0;
+    forEachToken(str, [&](const char* begin, const char* end)
     {
-        for (size_t j = 0; j < data.numColumns(); j++)
+        if (count < data.numRows() * data.numColumns())
         {
-            stringToData(tokens[i * data.numRows() + j], data[i][j]);
+            tokenToData(begin, end, data[count / data.numColumns()][count % data.numColumns()]);
         }
+        count++;
+    });
+    if (count != data.numRows() * data.numColumns())
+    {
+        throw ExceptionTypeError("Type mismatch in matrix stringToData: " + str);
     }
 }
 
 template <class T> void stringToData(const string& str, enable_if_std_vector_t<T>& data)
 {
-    for (const string& token : splitString(str, ARRAY_VALID_SEPARATORS))
+    forEachToken(str, [&data](const char* begin, const char* end)
     {
         typename T::value_type val;
-        stringToData(token, val);
+        tokenToData(begin, end, val);
         data.push_back(val);
-    }
+    });
 }
 
-template <class T> void dataToString(const T& data, string& str)
+template <class T> void formatNumber(const enable_if_integral_t<T>& data, string& str)
 {
-    std::stringstream ss;
+    str = std::to_string(data);
+}
 
-    // Set float format and precision for the stream
+// Format a floating-point number with the current float format and precision.
+// The conversions match those performed by an output stream with the same
+// settings, but the decimal point is independent of the current locale.
+template <class T> void formatNumber(const enable_if_floating_point_t<T>& data, string& str)
+{
     const Value::FloatFormat fmt = Value::getFloatFormat();
-    ss.setf(std::ios_base::fmtflags(
-            (fmt == Value::FloatFormatFixed ? std::ios_base::fixed :
-            (fmt == Value::FloatFormatScientific ? std::ios_base::scientific : 0))),
-        std::ios_base::floatfield);
-    ss.precision(Value::getFloatPrecision());
-
-    ss << data;
-    str = ss.str();
+    const char* spec = (fmt == Value::FloatFormatFixed) ? "%.*f" :
+                       (fmt == Value::FloatFormatScientific) ? "%.*e" : "%.*g";
+    const int precision = Value::getFloatPrecision();
+
+    char buffer[64];
+    int length = std::snprintf(buffer, sizeof(buffer), spec, precision, double(data));
+    if (length < 0)
+    {
+        str.clear();
+        return;
+    }
+    if (length < int(sizeof(buffer)))
+    {
+        str.assign(buffer, length);
+    }
+    else
+    {
+        str.resize(length + 1);
+        std::snprintf(&str[0], str.size(), spec, precision, double(data));
+        str.resize(length);
+    }
+
+    const char* point = std::localeconv()->decimal_point;
+    if (point[0] != '.' || point[1] != '\0')
+    {
+        size_t pos = str.find(point);
+        if (pos != string::npos)
+        {
+            str.replace(pos, std::char_traits<char>::length(point), 1, '.');
+        }
+    }
+}
+
+template <class T> void dataToString(const T& data, string& str)
+{
+    formatNumber<T>(data, str);
 }
 
 template <> void dataToString(const bool& data, string& str)
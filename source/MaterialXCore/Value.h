@@ -75,15 +75,15 @@ class Value
     /// Return the value string for this value.
     virtual string getValueString() const = 0;
 
-    /// Set float formatting for converting values to strings.
-    /// Formats to use are FloatFormatFixed, FloatFormatScientific 
-    /// or FloatFormatDefault to set default format.
+    /// Set float formatting for converting values to strings on the
+    /// calling thread. Formats to use are FloatFormatFixed,
+    /// FloatFormatScientific or FloatFormatDefault to set default format.
     static void setFloatFormat(FloatFormat format)
     {
         _floatFormat = format;
     }
 
-    /// Set float precision for converting values to strings.
+    /// Set float precision for converting values to strings on the calling thread.
     static void setFloatPrecision(int precision)
     {
         _floatPrecision = precision;
@@ -122,8 +122,8 @@ class Value
 
   private:
     static CreatorMap _creatorMap;
-    static FloatFormat _floatFormat;
-    static int _floatPrecision;
+    static thread_local FloatFormat _floatFormat;
+    static thread_local int _floatPrecision;
 };
 
 /// The class template for typed subclasses of Value
@@ -26,6 +26,7 @@
 #include <MaterialXGenGlsl/Nodes/NumLightsNodeGlsl.h>
 #include <MaterialXGenGlsl/Nodes/TransformNodeGlsl.h>
 
+#include <MaterialXGenShader/UniformBlockLayout.h>
 #include <MaterialXGenShader/Nodes/SourceCodeNode.h>
 #include <MaterialXGenShader/Nodes/SwizzleNode.h>
 #include <MaterialXGenShader/Nodes/ConvertNode.h>
@@ -293,8 +294,7 @@ void GlslShaderGenerator::emitVertexStage(const ShaderGraph& graph, GenContext&
         const VariableBlock& uniforms = *it.second;
         if (!uniforms.empty())
         {
-            emitComment("Uniform block: " + uniforms.getName(), stage);
-            emitVariableDeclarations(uniforms, _syntax->getUniformQualifier(), SEMICOLON, context, stage);
+            emitUniforms(uniforms, context, stage);
             emitLineBreak(stage);
         }
     }
@@ -361,8 +361,7 @@ void GlslShaderGenerator::emitPixelStage(const ShaderGraph& graph, GenContext& c
         // Skip light uniforms as they are handled separately
         if (!uniforms.empty() && uniforms.getName() != HW::LIGHT_DATA)
         {
-            emitComment("Uniform block: " + uniforms.getName(), stage);
-            emitVariableDeclarations(uniforms, _syntax->getUniformQualifier(), SEMICOLON, context, stage);
+            emitUniforms(uniforms, context, stage);
             emitLineBreak(stage);
         }
     }
@@ -510,6 +509,48 @@ void GlslShaderGenerator::emitPixelStage(const ShaderGraph& graph, GenContext& c
     emitLineBreak(stage);
 }
 
+void GlslShaderGenerator::emitUniforms(const VariableBlock& uniforms, GenContext& context, ShaderStage& stage) const
+{
+    emitComment("Uniform block: " + uniforms.getName(), stage);
+
+    if (!context.getOptions().hwUniformBlocks ||
+        (uniforms.getName() != HW::PUBLIC_UNIFORMS && uniforms.getName() != HW::PRIVATE_UNIFORMS))
+    {
+        emitVariableDeclarations(uniforms, _syntax->getUniformQualifier(), SEMICOLON, context, stage);
+        return;
+    }
+
+    // Uniforms which can't be stored in a block, such as samplers,
+    // are declared as loose uniforms.
+    for (const ShaderPort* variable : uniforms.getVariableOrder())
+    {
+        if (!UniformBlockLayout::isPackable(variable->getType()))
+        {
+            emitLineBegin(stage);
+            emitVariableDeclaration(variable, _syntax->getUniformQualifier(), context, stage);
+            emitString(SEMICOLON, stage);
+            emitLineEnd(stage, false);
+        }
+    }
+
+    // Block members can't have initializers, so their values are
+    // set by the application when the block is uploaded.
+    UniformBlockLayout layout(uniforms);
+    if (!layout.getMembers().empty())
+    {
+        emitLine("layout (std140) uniform " + uniforms.getName(), stage, false);
+        emitScopeBegin(stage);
+        for (const UniformBlockLayout::Member& member : layout.getMembers())
+        {
+            emitLineBegin(stage);
+            emitVariableDeclaration(member.port, EMPTY_STRING, context, stage, false);
+            emitString(SEMICOLON, stage);
+            emitLineEnd(stage, false);
+        }
+        emitScopeEnd(stage, true);
+    }
+}
+
 void GlslShaderGenerator::emitFunctionDefinitions(const ShaderGraph& graph, GenContext& context, ShaderStage& stage) const
 {
 BEGIN_SHADER_STAGE(stage, Stage::PIXEL)
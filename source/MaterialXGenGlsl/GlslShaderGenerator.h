@@ -120,6 +120,11 @@ class GlslShaderGenerator : public HwShaderGenerator
     virtual void emitVertexStage(const ShaderGraph& graph, GenContext& context, ShaderStage& stage) const;
     virtual void emitPixelStage(const ShaderGraph& graph, GenContext& context, ShaderStage& stage) const;
 
+    /// Emit the declarations of a block of uniforms. If uniform blocks are
+    /// enabled in the generation options, the public and private uniforms
+    /// are declared in a std140 uniform block.
+    virtual void emitUniforms(const VariableBlock& uniforms, GenContext& context, ShaderStage& stage) const;
+
     /// Override the compound implementation creator in order to handle light compounds.
     ShaderNodeImplPtr createCompoundImplementation(const NodeGraph& impl) const override;
 
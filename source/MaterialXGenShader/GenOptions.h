@@ -53,7 +53,8 @@ class GenOptions
         fileTextureVerticalFlip(false),
         hwTransparency(false),
         hwSpecularEnvironmentMethod(SPECULAR_ENVIRONMENT_PREFILTER),
-        hwMaxActiveLightSources(3)
+        hwMaxActiveLightSources(3),
+        hwUniformBlocks(false)
     {
     }
     virtual ~GenOptions() { }
@@ -90,6 +91,14 @@ class GenOptions
     /// Sets the maximum number of light sources that can
     /// be active at once.
     unsigned int hwMaxActiveLightSources;
+
+    /// If true, public and private uniforms of HW shaders are
+    /// declared in std140 uniform blocks rather than as loose
+    /// uniforms, so they can be uploaded with uniform buffers.
+    /// Uniforms that cannot be stored in a block, such as texture
+    /// samplers, are still declared as loose uniforms.
+    /// By default this option is false.
+    bool hwUniformBlocks;
 };
 
 } // namespace MaterialX
@@ -7,6 +7,7 @@
 
 #include <MaterialXGenShader/Nodes/HwSourceCodeNode.h>
 #include <MaterialXGenShader/Nodes/HwCompoundNode.h>
+#include <MaterialXGenShader/UniformBlockLayout.h>
 
 #include <MaterialXCore/Document.h>
 #include <MaterialXCore/Definition.h>
@@ -31,10 +32,31 @@ namespace HW
     const string LIGHT_DIR        = "L";
     const string VIEW_DIR         = "V";
     const string ATTR_TRANSPARENT = "transparent";
+    const string ATTR_UNIFORM_BLOCKS = "uniformblocks";
     const string USER_DATA_CLOSURE_CONTEXT = "udcc";
     const string USER_DATA_LIGHT_SHADERS   = "udls";
 }
 
+namespace {
+
+// Add copies of the packable variables of one block that are missing
+// from another.
+void addMissingUniforms(const VariableBlock& source, VariableBlock& dest)
+{
+    for (const ShaderPort* port : source.getVariableOrder())
+    {
+        if (UniformBlockLayout::isPackable(port->getType()) && !dest.find(port->getName()))
+        {
+            ShaderPort* copy = dest.add(port->getType(), port->getName(), port->getValue());
+            copy->setVariable(port->getVariable());
+            copy->setSemantic(port->getSemantic());
+            copy->setPath(port->getPath());
+        }
+    }
+}
+
+} // anonymous namespace
+
 //
 // HwShaderGenerator methods
 //
@@ -204,6 +226,22 @@ ShaderPtr HwShaderGenerator::createShader(const string& name, ElementPtr element
         shader->setAttribute(HW::ATTR_TRANSPARENT);
     }
 
+    if (context.getOptions().hwUniformBlocks)
+    {
+        // A uniform block must be declared identically in all stages,
+        // so share the packable uniforms of each block between stages.
+        for (const string& blockName : { HW::PUBLIC_UNIFORMS, HW::PRIVATE_UNIFORMS })
+        {
+            VariableBlock& vsUniforms = vs->getUniformBlock(blockName);
+            VariableBlock& psUniforms = ps->getUniformBlock(blockName);
+            addMissingUniforms(vsUniforms, psUniforms);
+            addMissingUniforms(psUniforms, vsUniforms);
+        }
+
+        // Flag the shader as using uniform blocks.
+        shader->setAttribute(HW::ATTR_UNIFORM_BLOCKS);
+    }
+
     return shader;
 }
 
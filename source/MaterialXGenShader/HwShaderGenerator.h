@@ -44,6 +44,7 @@ namespace HW
 
     /// Attribute names.
     extern const string ATTR_TRANSPARENT;
+    extern const string ATTR_UNIFORM_BLOCKS;
 
     /// User data names.
     extern const string USER_DATA_CLOSURE_CONTEXT;
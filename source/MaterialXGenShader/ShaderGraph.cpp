@@ -576,7 +576,8 @@ ShaderNode* ShaderGraph::addNode(const Node& node, GenContext& context)
 
     // Handle the "defaultgeomprop" directives on the nodedef inputs.
     // Create and connect default geometric nodes on unconnected inputs.
-    for (const InputPtr& nodeDefInput : nodeDef->getActiveInputs())
+    ConstFlattenedInterfacePtr nodeDefInterface = nodeDef->getFlattenedInterface();
+    for (const InputPtr& nodeDefInput : nodeDefInterface->getInputs())
     {
         ShaderInput* input = newNode->getInput(nodeDefInput->getName());
         InputPtr nodeInput = node.getInput(nodeDefInput->getName());
@@ -221,7 +221,8 @@ ShaderNodePtr ShaderNode::create(const ShaderGraph* parent, const string& name,
     }
 
     // Create interface from nodedef
-    for (const ValueElementPtr& port : nodeDef.getActiveValueElements())
+    ConstFlattenedInterfacePtr nodeDefInterface = nodeDef.getFlattenedInterface();
+    for (const ValueElementPtr& port : nodeDefInterface->getValueElements())
     {
         const TypeDesc* portType = TypeDesc::get(port->getType());
         if (port->isA<Output>())
@@ -342,7 +343,8 @@ ShaderNodePtr ShaderNode::create(const ShaderGraph* parent, const string& name,
 void ShaderNode::setPaths(const Node& node, const NodeDef& nodeDef, bool includeNodeDefInputs)
 {
     // Set element paths for children on the node
-    for (const ValueElementPtr& nodeValue : node.getActiveValueElements())
+    ConstFlattenedInterfacePtr nodeInterface = node.getFlattenedInterface();
+    for (const ValueElementPtr& nodeValue : nodeInterface->getValueElements())
     {
         ShaderInput* input = getInput(nodeValue->getName());
         if (input)
@@ -361,7 +363,8 @@ void ShaderNode::setPaths(const Node& node, const NodeDef& nodeDef, bool include
     // are no inputs/parameters specified on the node itself
     //
     const string& nodePath = node.getNamePath();
-    for (const ValueElementPtr& nodeInput : nodeDef.getActiveInputs())
+    ConstFlattenedInterfacePtr nodeDefInterface = nodeDef.getFlattenedInterface();
+    for (const InputPtr& nodeInput : nodeDefInterface->getInputs())
     {
         ShaderInput* input = getInput(nodeInput->getName());
         if (input && input->getPath().empty())
@@ -370,7 +373,7 @@ void ShaderNode::setPaths(const Node& node, const NodeDef& nodeDef, bool include
         }
     }
 
-    for (const ParameterPtr& nodeParameter : nodeDef.getActiveParameters())
+    for (const ParameterPtr& nodeParameter : nodeDefInterface->getParameters())
     {
         ShaderInput* input = getInput(nodeParameter->getName());
         if (input && input->getPath().empty())
@@ -383,10 +386,12 @@ void ShaderNode::setPaths(const Node& node, const NodeDef& nodeDef, bool include
 void ShaderNode::setValues(const Node& node, const NodeDef& nodeDef, GenContext& context)
 {
     // Copy input values from the given node
-    for (const ValueElementPtr& nodeValue : node.getActiveValueElements())
+    ConstFlattenedInterfacePtr nodeInterface = node.getFlattenedInterface();
+    ConstFlattenedInterfacePtr nodeDefInterface = nodeDef.getFlattenedInterface();
+    for (const ValueElementPtr& nodeValue : nodeInterface->getValueElements())
     {
         ShaderInput* input = getInput(nodeValue->getName());
-        ValueElementPtr nodeDefInput = nodeDef.getActiveValueElement(nodeValue->getName());
+        ValueElementPtr nodeDefInput = nodeDefInterface->getValueElement(nodeValue->getName());
         if (input && nodeDefInput)
         {
             const string& valueString = nodeValue->getValueString();
@@ -0,0 +1,245 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXGenShader/UniformBlockLayout.h>
+
+#include <MaterialXGenShader/ShaderNode.h>
+#include <MaterialXGenShader/TypeDesc.h>
+
+#include <MaterialXCore/Value.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace MaterialX
+{
+
+namespace {
+
+const size_t STD140_VEC4_SIZE = 4 * sizeof(float);
+const size_t MAX_MEMBER_SIZE = 4 * STD140_VEC4_SIZE;
+
+// Return the std140 base alignment and size of a packable type.
+void getStd140Layout(const TypeDesc* type, size_t& alignment, size_t& size)
+{
+    if (type == Type::MATRIX44)
+    {
+        alignment = STD140_VEC4_SIZE;
+        size = 4 * STD140_VEC4_SIZE;
+    }
+    else if (type == Type::MATRIX33)
+    {
+        // Each column is padded to the size of a vec4.
+        alignment = STD140_VEC4_SIZE;
+        size = 3 * STD140_VEC4_SIZE;
+    }
+    else if (type->isFloat3())
+    {
+        alignment = STD140_VEC4_SIZE;
+        size = 3 * sizeof(float);
+    }
+    else
+    {
+        alignment = type->getSize() * sizeof(float);
+        size = alignment;
+    }
+}
+
+size_t alignOffset(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <class T> bool copyVector(const Value& value, unsigned char* data)
+{
+    if (!value.isA<T>())
+    {
+        return false;
+    }
+    const T& v = value.asA<T>();
+    std::memcpy(data, v.data(), sizeof(float) * T::numElements());
+    return true;
+}
+
+template <class T> bool copyMatrix(const Value& value, unsigned char* data)
+{
+    if (!value.isA<T>())
+    {
+        return false;
+    }
+
+    // Rows are stored as std140 columns, matching the convention used when
+    // binding matrices without transposition.
+    const T& m = value.asA<T>();
+    for (size_t i = 0; i < T::numRows(); i++)
+    {
+        std::memcpy(data + i * STD140_VEC4_SIZE, &m[i][0], sizeof(float) * T::numColumns());
+    }
+    return true;
+}
+
+// Write a value in std140 form to the given data, returning false if
+// the value does not match the given type.
+bool copyValue(const TypeDesc* type, const Value& value, unsigned char* data)
+{
+    if (type == Type::FLOAT)
+    {
+        if (!value.isA<float>())
+        {
+            return false;
+        }
+        float v = value.asA<float>();
+        std::memcpy(data, &v, sizeof(v));
+        return true;
+    }
+    if (type == Type::INTEGER)
+    {
+        if (!value.isA<int>())
+        {
+            return false;
+        }
+        int32_t v = value.asA<int>();
+        std::memcpy(data, &v, sizeof(v));
+        return true;
+    }
+    if (type == Type::BOOLEAN)
+    {
+        if (!value.isA<bool>())
+        {
+            return false;
+        }
+        uint32_t v = value.asA<bool>() ? 1 : 0;
+        std::memcpy(data, &v, sizeof(v));
+        return true;
+    }
+    if (type == Type::MATRIX33)
+    {
+        return copyMatrix<Matrix33>(value, data);
+    }
+    if (type == Type::MATRIX44)
+    {
+        return copyMatrix<Matrix44>(value, data);
+    }
+    if (type->isFloat2())
+    {
+        return copyVector<Color2>(value, data) || copyVector<Vector2>(value, data);
+    }
+    if (type->isFloat3())
+    {
+        return copyVector<Color3>(value, data) || copyVector<Vector3>(value, data);
+    }
+    if (type->isFloat4())
+    {
+        return copyVector<Color4>(value, data) || copyVector<Vector4>(value, data);
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+//
+// UniformBlockLayout methods
+//
+
+UniformBlockLayout::UniformBlockLayout(const VariableBlock& block) :
+    _name(block.getName()),
+    _size(0)
+{
+    struct Entry
+    {
+        const ShaderPort* port;
+        size_t alignment;
+        size_t size;
+    };
+    vector<Entry> entries;
+    for (const ShaderPort* port : block.getVariableOrder())
+    {
+        if (isPackable(port->getType()))
+        {
+            Entry entry = { port, 0, 0 };
+            getStd140Layout(port->getType(), entry.alignment, entry.size);
+            entries.push_back(entry);
+        }
+    }
+
+    // Order by decreasing alignment to reduce padding, and by name for a
+    // layout that is independent of the order of the block.
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+    {
+        if (a.alignment != b.alignment)
+        {
+            return a.alignment > b.alignment;
+        }
+        return a.port->getVariable() < b.port->getVariable();
+    });
+
+    _members.reserve(entries.size());
+    for (const Entry& entry : entries)
+    {
+        Member member = { entry.port, entry.port->getType(), alignOffset(_size, entry.alignment), entry.size };
+        _size = member.offset + member.size;
+        _memberMap[entry.port->getVariable()] = _members.size();
+        _members.push_back(member);
+    }
+    _size = alignOffset(_size, STD140_VEC4_SIZE);
+}
+
+const UniformBlockLayout::Member* UniformBlockLayout::findMember(const string& name) const
+{
+    auto it = _memberMap.find(name);
+    return it != _memberMap.end() ? &_members[it->second] : nullptr;
+}
+
+void UniformBlockLayout::packValues(vector<unsigned char>& buffer) const
+{
+    buffer.assign(_size, 0);
+    for (const Member& member : _members)
+    {
+        ValuePtr value = member.port->getValue();
+        if (value)
+        {
+            packValue(member, *value, buffer.data());
+        }
+    }
+}
+
+bool UniformBlockLayout::isPackable(const TypeDesc* type)
+{
+    return type == Type::FLOAT ||
+           type == Type::INTEGER ||
+           type == Type::BOOLEAN ||
+           type == Type::MATRIX33 ||
+           type == Type::MATRIX44 ||
+           type->isFloat2() ||
+           type->isFloat3() ||
+           type->isFloat4();
+}
+
+bool UniformBlockLayout::packValue(const Member& member, const Value& value, unsigned char* buffer, bool* changed)
+{
+    if (changed)
+    {
+        *changed = false;
+    }
+    unsigned char data[MAX_MEMBER_SIZE] = {};
+    if (!copyValue(member.type, value, data))
+    {
+        return false;
+    }
+
+    unsigned char* dest = buffer + member.offset;
+    if (std::memcmp(dest, data, member.size) != 0)
+    {
+        std::memcpy(dest, data, member.size);
+        if (changed)
+        {
+            *changed = true;
+        }
+    }
+    return true;
+}
+
+} // namespace MaterialX
@@ -0,0 +1,106 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_UNIFORMBLOCKLAYOUT_H
+#define MATERIALX_UNIFORMBLOCKLAYOUT_H
+
+/// @file
+/// Packed layout of hardware uniform blocks
+
+#include <MaterialXGenShader/Library.h>
+
+#include <MaterialXGenShader/ShaderStage.h>
+
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+/// @class UniformBlockLayout
+/// The std140 layout of the variables in a uniform VariableBlock, describing
+/// how their values are packed into a CPU-side buffer for upload to a
+/// hardware uniform buffer.
+///
+/// Variables whose types cannot be stored in a uniform block, such as file
+/// textures, are not part of the layout. Packed variables are ordered by
+/// alignment and then by name, so blocks holding the same set of variables
+/// share a layout regardless of the order in which variables were added.
+/// The layout references the ports of the block it was created from, which
+/// must outlive it.
+class UniformBlockLayout
+{
+  public:
+    /// A variable packed into the block.
+    struct Member
+    {
+        /// Shader port of the variable.
+        const ShaderPort* port;
+        /// Type of the variable.
+        const TypeDesc* type;
+        /// Byte offset of the variable within the block.
+        size_t offset;
+        /// Byte size of the variable within the block.
+        size_t size;
+    };
+
+    /// Create an empty layout.
+    UniformBlockLayout() :
+        _size(0)
+    {
+    }
+
+    /// Create the layout of the given variable block.
+    explicit UniformBlockLayout(const VariableBlock& block);
+
+    /// Return the name of the block.
+    const string& getName() const
+    {
+        return _name;
+    }
+
+    /// Return the members of the block, in layout order.
+    const vector<Member>& getMembers() const
+    {
+        return _members;
+    }
+
+    /// Return the member with the given variable name, or nullptr
+    /// if no such member exists.
+    const Member* findMember(const string& name) const;
+
+    /// Return the byte size of the block.
+    size_t getSize() const
+    {
+        return _size;
+    }
+
+    /// Pack the values of all members into the given buffer, resizing it
+    /// to the size of the block. Members without a value are zero-filled.
+    void packValues(vector<unsigned char>& buffer) const;
+
+    /// Return true if variables of the given type can be stored in a
+    /// uniform block.
+    static bool isPackable(const TypeDesc* type);
+
+    /// Pack a value into the storage of a member within the given buffer.
+    /// @param member Member to assign.
+    /// @param value Value to pack, which must match the type of the member.
+    /// @param buffer Buffer of at least getSize() bytes.
+    /// @param changed If provided, set to true if the packed data differs from
+    ///    the previous contents of the buffer, and false otherwise.
+    /// @return False if the value does not match the type of the member, in
+    ///    which case the buffer is left unchanged.
+    static bool packValue(const Member& member, const Value& value, unsigned char* buffer, bool* changed = nullptr);
+
+  private:
+    string _name;
+    vector<Member> _members;
+    std::unordered_map<string, size_t> _memberMap;
+    size_t _size;
+};
+
+} // namespace MaterialX
+
+#endif
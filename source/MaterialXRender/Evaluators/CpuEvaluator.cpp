@@ -0,0 +1,1808 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Evaluators/CpuEvaluator.h>
+
+#include <MaterialXGenShader/Library.h>
+#include <MaterialXGenShader/ShaderGraph.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+const size_t CpuEvaluator::BATCH_SIZE;
+
+namespace {
+
+const size_t BATCH_SIZE = CpuEvaluator::BATCH_SIZE;
+const size_t MAX_INPUTS = 6;
+
+const float PI = 3.14159265358979323846f;
+
+// Instructions, each of which evaluates one node for a batch of points.
+enum class Op
+{
+    // Componentwise math
+    ABSVAL, FLOOR, CEIL, SIN, COS, TAN, ASIN, ACOS, SQRT, LN, EXP, SIGN,
+    ADD, SUBTRACT, MULTIPLY, DIVIDE, MODULO, POWER, ATAN2, MIN, MAX,
+    INVERT, CLAMP, SMOOTHSTEP, REMAP, MIX,
+
+    // Compositing
+    BURN, DODGE, SCREEN, OVERLAY, PLUS, MINUS, DIFFERENCE, INSIDE, OUTSIDE,
+    ALPHA_OVER, ALPHA_IN, ALPHA_OUT, ALPHA_MASK, ALPHA_MATTE, ALPHA_DISJOINTOVER,
+
+    // Vector math
+    MAGNITUDE, NORMALIZE, DOTPRODUCT, CROSSPRODUCT, ROTATE2D, ROTATE3D,
+
+    // Color
+    LUMINANCE, SATURATE, RGBTOHSV, HSVTORGB, PREMULT, UNPREMULT,
+    SRGB_TO_LINEAR, GAMMA_TO_LINEAR, ACESCG_TO_LINEAR,
+
+    // Channels, copying each output channel from an input channel or a constant
+    GATHER,
+
+    // Conditionals
+    COMPARE, SWITCH,
+
+    // Procedurals
+    RAMPLR, RAMPTB, RAMP4, SPLITLR, SPLITTB,
+    NOISE2D, NOISE3D, FRACTAL3D, CELLNOISE2D, CELLNOISE3D,
+
+    // Geometric and application
+    POSITION, NORMAL, TANGENT, BITANGENT, TEXCOORD, GEOMCOLOR, FRAME, TIME, VIEWDIRECTION,
+
+    // Textures
+    IMAGE
+};
+
+struct OpSignature
+{
+    Op op;
+    StringVec inputs;
+};
+
+// Nodes which compile to a single instruction, keyed by node category, with
+// the names of the inputs in the order the instruction expects them.
+const std::unordered_map<string, OpSignature> OP_SIGNATURES =
+{
+    { "absval", { Op::ABSVAL, { "in" } } },
+    { "floor", { Op::FLOOR, { "in" } } },
+    { "ceil", { Op::CEIL, { "in" } } },
+    { "sin", { Op::SIN, { "in" } } },
+    { "cos", { Op::COS, { "in" } } },
+    { "tan", { Op::TAN, { "in" } } },
+    { "asin", { Op::ASIN, { "in" } } },
+    { "acos", { Op::ACOS, { "in" } } },
+    { "sqrt", { Op::SQRT, { "in" } } },
+    { "ln", { Op::LN, { "in" } } },
+    { "exp", { Op::EXP, { "in" } } },
+    { "sign", { Op::SIGN, { "in" } } },
+    { "add", { Op::ADD, { "in1", "in2" } } },
+    { "subtract", { Op::SUBTRACT, { "in1", "in2" } } },
+    { "multiply", { Op::MULTIPLY, { "in1", "in2" } } },
+    { "divide", { Op::DIVIDE, { "in1", "in2" } } },
+    { "modulo", { Op::MODULO, { "in1", "in2" } } },
+    { "power", { Op::POWER, { "in1", "in2" } } },
+    { "atan2", { Op::ATAN2, { "in1", "in2" } } },
+    { "min", { Op::MIN, { "in1", "in2" } } },
+    { "max", { Op::MAX, { "in1", "in2" } } },
+    { "invert", { Op::INVERT, { "in", "amount" } } },
+    { "clamp", { Op::CLAMP, { "in", "low", "high" } } },
+    { "smoothstep", { Op::SMOOTHSTEP, { "in", "low", "high" } } },
+    { "remap", { Op::REMAP, { "in", "inlow", "inhigh", "outlow", "outhigh" } } },
+    { "mix", { Op::MIX, { "fg", "bg", "mix" } } },
+
+    { "burn", { Op::BURN, { "fg", "bg", "mix" } } },
+    { "dodge", { Op::DODGE, { "fg", "bg", "mix" } } },
+    { "screen", { Op::SCREEN, { "fg", "bg", "mix" } } },
+    { "overlay", { Op::OVERLAY, { "fg", "bg", "mix" } } },
+    { "plus", { Op::PLUS, { "fg", "bg", "mix" } } },
+    { "minus", { Op::MINUS, { "fg", "bg", "mix" } } },
+    { "difference", { Op::DIFFERENCE, { "fg", "bg", "mix" } } },
+    { "inside", { Op::INSIDE, { "in", "mask" } } },
+    { "outside", { Op::OUTSIDE, { "in", "mask" } } },
+    { "over", { Op::ALPHA_OVER, { "fg", "bg" } } },
+    { "in", { Op::ALPHA_IN, { "fg", "bg", "mix" } } },
+    { "out", { Op::ALPHA_OUT, { "fg", "bg", "mix" } } },
+    { "mask", { Op::ALPHA_MASK, { "fg", "bg", "mix" } } },
+    { "matte", { Op::ALPHA_MATTE, { "fg", "bg", "mix" } } },
+    { "disjointover", { Op::ALPHA_DISJOINTOVER, { "fg", "bg", "mix" } } },
+
+    { "magnitude", { Op::MAGNITUDE, { "in" } } },
+    { "normalize", { Op::NORMALIZE, { "in" } } },
+    { "dotproduct", { Op::DOTPRODUCT, { "in1", "in2" } } },
+    { "crossproduct", { Op::CROSSPRODUCT, { "in1", "in2" } } },
+
+    { "luminance", { Op::LUMINANCE, { "in", "lumacoeffs" } } },
+    { "saturate", { Op::SATURATE, { "in", "amount", "lumacoeffs" } } },
+    { "rgbtohsv", { Op::RGBTOHSV, { "in" } } },
+    { "hsvtorgb", { Op::HSVTORGB, { "in" } } },
+    { "srgb_texture_to_linear", { Op::SRGB_TO_LINEAR, { "in" } } },
+    { "acescg_to_linear", { Op::ACESCG_TO_LINEAR, { "in" } } },
+
+    { "compare", { Op::COMPARE, { "intest", "cutoff", "in1", "in2" } } },
+    { "switch", { Op::SWITCH, { "in1", "in2", "in3", "in4", "in5", "which" } } },
+
+    { "ramplr", { Op::RAMPLR, { "valuel", "valuer", "texcoord" } } },
+    { "ramptb", { Op::RAMPTB, { "valuet", "valueb", "texcoord" } } },
+    { "ramp4", { Op::RAMP4, { "valuetl", "valuetr", "valuebl", "valuebr", "texcoord" } } },
+    { "splitlr", { Op::SPLITLR, { "valuel", "valuer", "center", "texcoord" } } },
+    { "splittb", { Op::SPLITTB, { "valuet", "valueb", "center", "texcoord" } } },
+    { "noise2d", { Op::NOISE2D, { "amplitude", "pivot", "texcoord" } } },
+    { "noise3d", { Op::NOISE3D, { "amplitude", "pivot", "position" } } },
+    { "fractal3d", { Op::FRACTAL3D, { "amplitude", "octaves", "lacunarity", "diminish", "position" } } },
+    { "cellnoise2d", { Op::CELLNOISE2D, { "texcoord" } } },
+    { "cellnoise3d", { Op::CELLNOISE3D, { "position" } } },
+
+    { "position", { Op::POSITION, { } } },
+    { "normal", { Op::NORMAL, { } } },
+    { "tangent", { Op::TANGENT, { } } },
+    { "bitangent", { Op::BITANGENT, { } } },
+    { "texcoord", { Op::TEXCOORD, { } } },
+    { "geomcolor", { Op::GEOMCOLOR, { } } },
+    { "frame", { Op::FRAME, { } } },
+    { "time", { Op::TIME, { "fps" } } },
+    { "viewdirection", { Op::VIEWDIRECTION, { } } }
+};
+
+const StringVec ADDRESS_MODES = { "black", "clamp", "periodic" };
+const StringVec FILTER_TYPES = { "closest", "linear", "cubic" };
+
+const int ADDRESS_BLACK = 0;
+const int ADDRESS_CLAMP = 1;
+const int ADDRESS_PERIODIC = 2;
+const int FILTER_CLOSEST = 0;
+
+struct Instruction
+{
+    Op op;
+    int output;
+    vector<int> inputs;
+    vector<int> params;
+};
+
+// A value known when compiling: the register holding it, and for values
+// given in the document, the value itself. String values have no register.
+struct Source
+{
+    int reg = -1;
+    ValuePtr value;
+};
+
+using SourceMap = std::unordered_map<const ShaderOutput*, Source>;
+
+struct Texture
+{
+    unsigned int width = 0;
+    unsigned int height = 0;
+    // RGBA texels, in rows of increasing v
+    vector<float> texels;
+};
+
+// The storage for a batch of points, with one array of BATCH_SIZE floats
+// for each channel of each register.
+class RegisterFile
+{
+  public:
+    RegisterFile(const vector<size_t>& channelCounts, const vector<size_t>& offsets, size_t totalChannels) :
+        _channelCounts(channelCounts),
+        _offsets(offsets),
+        _data(totalChannels * BATCH_SIZE, 0.0f)
+    {
+    }
+
+    size_t getChannelCount(int reg) const
+    {
+        return _channelCounts[reg];
+    }
+
+    // Return a channel of a register. Single channel registers return their
+    // only channel for every channel index, so that scalars broadcast.
+    float* get(int reg, size_t channel)
+    {
+        channel = std::min(channel, _channelCounts[reg] - 1);
+        return &_data[(_offsets[reg] + channel) * BATCH_SIZE];
+    }
+
+  private:
+    const vector<size_t>& _channelCounts;
+    const vector<size_t>& _offsets;
+    vector<float> _data;
+};
+
+size_t getTypeChannelCount(const TypeDesc* type)
+{
+    if (type->getBaseType() == TypeDesc::BASETYPE_STRING)
+    {
+        return 0;
+    }
+    if (type == Type::FLOAT || type == Type::INTEGER || type == Type::BOOLEAN)
+    {
+        return 1;
+    }
+    if (type->isFloat2() || type->isFloat3() || type->isFloat4())
+    {
+        return type->getSize();
+    }
+    throw ExceptionShaderGenError("Type '" + type->getName() + "' is not supported by the CPU evaluator");
+}
+
+template <class T> bool getVectorData(const Value& value, vector<float>& data)
+{
+    if (!value.isA<T>())
+    {
+        return false;
+    }
+    const T& vec = value.asA<T>();
+    for (size_t i = 0; i < std::min(data.size(), T::numElements()); i++)
+    {
+        data[i] = vec[i];
+    }
+    return true;
+}
+
+// Return the channels of a value, or zeros for values of other types.
+vector<float> getValueData(ValuePtr value, size_t channelCount)
+{
+    vector<float> data(channelCount, 0.0f);
+    if (!value || !channelCount)
+    {
+        return data;
+    }
+    if (value->isA<float>())
+    {
+        data[0] = value->asA<float>();
+    }
+    else if (value->isA<int>())
+    {
+        data[0] = (float) value->asA<int>();
+    }
+    else if (value->isA<bool>())
+    {
+        data[0] = value->asA<bool>() ? 1.0f : 0.0f;
+    }
+    else
+    {
+        getVectorData<Color2>(*value, data) ||
+        getVectorData<Color3>(*value, data) ||
+        getVectorData<Color4>(*value, data) ||
+        getVectorData<Vector2>(*value, data) ||
+        getVectorData<Vector3>(*value, data) ||
+        getVectorData<Vector4>(*value, data);
+    }
+    return data;
+}
+
+// Return the index of an enumerated value, which shader generators may have
+// already replaced with its index.
+int getEnumIndex(const Source& source, const StringVec& names, int defaultIndex)
+{
+    if (!source.value)
+    {
+        return defaultIndex;
+    }
+    if (source.value->isA<int>())
+    {
+        return source.value->asA<int>();
+    }
+    auto it = std::find(names.begin(), names.end(), source.value->getValueString());
+    return it != names.end() ? (int) (it - names.begin()) : defaultIndex;
+}
+
+//
+// Kernels, applying a function to each channel of each point of a batch
+//
+
+template <class F> void map1(RegisterFile& regs, const Instruction& inst, F f)
+{
+    for (size_t c = 0; c < regs.getChannelCount(inst.output); c++)
+    {
+        const float* a = regs.get(inst.inputs[0], c);
+        float* out = regs.get(inst.output, c);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+        {
+            out[i] = f(a[i]);
+        }
+    }
+}
+
+template <class F> void map2(RegisterFile& regs, const Instruction& inst, F f)
+{
+    for (size_t c = 0; c < regs.getChannelCount(inst.output); c++)
+    {
+        const float* a = regs.get(inst.inputs[0], c);
+        const float* b = regs.get(inst.inputs[1], c);
+        float* out = regs.get(inst.output, c);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+        {
+            out[i] = f(a[i], b[i]);
+        }
+    }
+}
+
+template <class F> void map3(RegisterFile& regs, const Instruction& inst, F f)
+{
+    for (size_t c = 0; c < regs.getChannelCount(inst.output); c++)
+    {
+        const float* a = regs.get(inst.inputs[0], c);
+        const float* b = regs.get(inst.inputs[1], c);
+        const float* d = regs.get(inst.inputs[2], c);
+        float* out = regs.get(inst.output, c);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+        {
+            out[i] = f(a[i], b[i], d[i]);
+        }
+    }
+}
+
+// Apply a compositing operator of the form f(fg, bg), blended with the
+// background by the mix input.
+template <class F> void mapComposite(RegisterFile& regs, const Instruction& inst, F f)
+{
+    map3(regs, inst, [f](float fg, float bg, float mix)
+    {
+        return mix * f(fg, bg) + (1.0f - mix) * bg;
+    });
+}
+
+// Apply an alpha compositing operator of the form f(fg, bg, fgAlpha, bgAlpha,
+// isAlpha), blended with the background by the mix input. The alpha is the
+// last channel of the foreground and background.
+template <class F> void mapAlphaComposite(RegisterFile& regs, const Instruction& inst, F f)
+{
+    const size_t channelCount = regs.getChannelCount(inst.output);
+    const float* fgAlpha = regs.get(inst.inputs[0], channelCount - 1);
+    const float* bgAlpha = regs.get(inst.inputs[1], channelCount - 1);
+    const float* mix = regs.get(inst.inputs[2], 0);
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        const bool isAlpha = (c == channelCount - 1);
+        const float* fg = regs.get(inst.inputs[0], c);
+        const float* bg = regs.get(inst.inputs[1], c);
+        float* out = regs.get(inst.output, c);
+        for (size_t i = 0; i < BATCH_SIZE; i++)
+        {
+            out[i] = mix[i] * f(fg[i], bg[i], fgAlpha[i], bgAlpha[i], isAlpha) + (1.0f - mix[i]) * bg[i];
+        }
+    }
+}
+
+// Apply a color transform to the first three channels, passing through alpha.
+template <class F> void mapColorChannels(RegisterFile& regs, const Instruction& inst, F f)
+{
+    const size_t channelCount = regs.getChannelCount(inst.output);
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        const float* in = regs.get(inst.inputs[0], c);
+        float* out = regs.get(inst.output, c);
+        if (c < 3)
+        {
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                out[i] = f(in[i]);
+            }
+        }
+        else
+        {
+            std::copy(in, in + BATCH_SIZE, out);
+        }
+    }
+}
+
+//
+// Noise functions, matching the hardware and OSL noise libraries
+//
+
+int noiseFloor(float x)
+{
+    return x < 0.0f ? (int) x - 1 : (int) x;
+}
+
+float floorFrac(float x, int& i)
+{
+    i = noiseFloor(x);
+    return x - (float) i;
+}
+
+uint32_t rotl32(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+uint32_t bjfinal(uint32_t a, uint32_t b, uint32_t c)
+{
+    c ^= b; c -= rotl32(b, 14);
+    a ^= c; a -= rotl32(c, 11);
+    b ^= a; b -= rotl32(a, 25);
+    c ^= b; c -= rotl32(b, 16);
+    a ^= c; a -= rotl32(c, 4);
+    b ^= a; b -= rotl32(a, 14);
+    c ^= b; c -= rotl32(b, 24);
+    return c;
+}
+
+uint32_t hashInt(int x, int y)
+{
+    uint32_t seed = 0xdeadbeef + (2u << 2) + 13;
+    return bjfinal(seed + (uint32_t) x, seed + (uint32_t) y, seed);
+}
+
+uint32_t hashInt(int x, int y, int z)
+{
+    uint32_t seed = 0xdeadbeef + (3u << 2) + 13;
+    return bjfinal(seed + (uint32_t) x, seed + (uint32_t) y, seed + (uint32_t) z);
+}
+
+float fade(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+float bilerp(float v0, float v1, float v2, float v3, float s, float t)
+{
+    float s1 = 1.0f - s;
+    return (1.0f - t) * (v0 * s1 + v1 * s) + t * (v2 * s1 + v3 * s);
+}
+
+float trilerp(float v0, float v1, float v2, float v3, float v4, float v5, float v6, float v7, float s, float t, float r)
+{
+    float s1 = 1.0f - s;
+    float t1 = 1.0f - t;
+    float r1 = 1.0f - r;
+    return (r1 * (t1 * (v0 * s1 + v1 * s) + t * (v2 * s1 + v3 * s)) +
+            r * (t1 * (v4 * s1 + v5 * s) + t * (v6 * s1 + v7 * s)));
+}
+
+float gradient(uint32_t hash, float x, float y)
+{
+    uint32_t h = hash & 7;
+    float u = h < 4 ? x : y;
+    float v = 2.0f * (h < 4 ? y : x);
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+float gradient(uint32_t hash, float x, float y, float z)
+{
+    uint32_t h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : ((h == 12 || h == 14) ? x : z);
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+// Perlin noise of the given number of channels, from one to three. Vector
+// noise takes each channel from a different byte of the same hash.
+void perlinNoise(float px, float py, size_t channelCount, float* result)
+{
+    int X, Y;
+    float fx = floorFrac(px, X);
+    float fy = floorFrac(py, Y);
+    float u = fade(fx);
+    float v = fade(fy);
+    uint32_t h[4] = { hashInt(X, Y), hashInt(X + 1, Y), hashInt(X, Y + 1), hashInt(X + 1, Y + 1) };
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        int shift = channelCount > 1 ? (int) c * 8 : 0;
+        float value = bilerp(gradient(h[0] >> shift, fx, fy),
+                             gradient(h[1] >> shift, fx - 1.0f, fy),
+                             gradient(h[2] >> shift, fx, fy - 1.0f),
+                             gradient(h[3] >> shift, fx - 1.0f, fy - 1.0f),
+                             u, v);
+        result[c] = 0.6616f * value;
+    }
+}
+
+void perlinNoise(float px, float py, float pz, size_t channelCount, float* result)
+{
+    int X, Y, Z;
+    float fx = floorFrac(px, X);
+    float fy = floorFrac(py, Y);
+    float fz = floorFrac(pz, Z);
+    float u = fade(fx);
+    float v = fade(fy);
+    float w = fade(fz);
+    uint32_t h[8] = { hashInt(X, Y, Z), hashInt(X + 1, Y, Z), hashInt(X, Y + 1, Z), hashInt(X + 1, Y + 1, Z),
+                      hashInt(X, Y, Z + 1), hashInt(X + 1, Y, Z + 1), hashInt(X, Y + 1, Z + 1), hashInt(X + 1, Y + 1, Z + 1) };
+    for (size_t c = 0; c < channelCount; c++)
+    {
+        int shift = channelCount > 1 ? (int) c * 8 : 0;
+        float value = trilerp(gradient(h[0] >> shift, fx, fy, fz),
+                              gradient(h[1] >> shift, fx - 1.0f, fy, fz),
+                              gradient(h[2] >> shift, fx, fy - 1.0f, fz),
+                              gradient(h[3] >> shift, fx - 1.0f, fy - 1.0f, fz),
+                              gradient(h[4] >> shift, fx, fy, fz - 1.0f),
+                              gradient(h[5] >> shift, fx - 1.0f, fy, fz - 1.0f),
+                              gradient(h[6] >> shift, fx, fy - 1.0f, fz - 1.0f),
+                              gradient(h[7] >> shift, fx - 1.0f, fy - 1.0f, fz - 1.0f),
+                              u, v, w);
+        result[c] = 0.9820f * value;
+    }
+}
+
+// Perlin noise of up to four channels, with the fourth channel taken from
+// scalar noise at an offset position.
+void perlinNoise4(float px, float py, size_t channelCount, float* result)
+{
+    perlinNoise(px, py, std::min(channelCount, (size_t) 3), result);
+    if (channelCount == 4)
+    {
+        perlinNoise(px + 19.0f, py + 73.0f, 1, result + 3);
+    }
+}
+
+void perlinNoise4(float px, float py, float pz, size_t channelCount, const Vector3& offset, float* result)
+{
+    perlinNoise(px, py, pz, std::min(channelCount, (size_t) 3), result);
+    if (channelCount == 4)
+    {
+        perlinNoise(px + offset[0], py + offset[1], pz + offset[2], 1, result + 3);
+    }
+}
+
+float cellNoise(float px, float py)
+{
+    return (float) hashInt(noiseFloor(px), noiseFloor(py)) / (float) 0xffffffffu;
+}
+
+float cellNoise(float px, float py, float pz)
+{
+    return (float) hashInt(noiseFloor(px), noiseFloor(py), noiseFloor(pz)) / (float) 0xffffffffu;
+}
+
+//
+// Color functions
+//
+
+void rgbToHsv(const float* rgb, float* hsv)
+{
+    float p[4], q[4];
+    if (rgb[1] >= rgb[2])
+    {
+        p[0] = rgb[1]; p[1] = rgb[2]; p[2] = 0.0f; p[3] = -1.0f / 3.0f;
+    }
+    else
+    {
+        p[0] = rgb[2]; p[1] = rgb[1]; p[2] = -1.0f; p[3] = 2.0f / 3.0f;
+    }
+    if (rgb[0] >= p[0])
+    {
+        q[0] = rgb[0]; q[1] = p[1]; q[2] = p[2]; q[3] = p[0];
+    }
+    else
+    {
+        q[0] = p[0]; q[1] = p[1]; q[2] = p[3]; q[3] = rgb[0];
+    }
+    float d = q[0] - std::min(q[3], q[1]);
+    float e = 1.0e-10f;
+    hsv[0] = std::abs(q[2] + (q[3] - q[1]) / (6.0f * d + e));
+    hsv[1] = d / (q[0] + e);
+    hsv[2] = q[0];
+}
+
+void hsvToRgb(const float* hsv, float* rgb)
+{
+    const float K[3] = { 1.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    for (size_t c = 0; c < 3; c++)
+    {
+        float x = hsv[0] + K[c];
+        float p = std::abs((x - std::floor(x)) * 6.0f - 3.0f);
+        float clamped = std::max(0.0f, std::min(p - 1.0f, 1.0f));
+        rgb[c] = hsv[2] * (1.0f + (clamped - 1.0f) * hsv[1]);
+    }
+}
+
+//
+// Texture sampling, matching the hardware texture handlers
+//
+
+// Apply an address mode to a texel index. Returns false for texels in the
+// border of black address mode.
+bool resolveAddress(int& index, unsigned int size, int addressMode)
+{
+    const int count = (int) size;
+    if (addressMode == ADDRESS_PERIODIC)
+    {
+        index %= count;
+        index += index < 0 ? count : 0;
+        return true;
+    }
+    if (index >= 0 && index < count)
+    {
+        return true;
+    }
+    if (addressMode == ADDRESS_CLAMP)
+    {
+        index = std::max(0, std::min(index, count - 1));
+        return true;
+    }
+    return false;
+}
+
+const float* getTexel(const Texture& texture, int x, int y, int uAddressMode, int vAddressMode, const float* border)
+{
+    if (!resolveAddress(x, texture.width, uAddressMode) || !resolveAddress(y, texture.height, vAddressMode))
+    {
+        return border;
+    }
+    return &texture.texels[((size_t) y * texture.width + x) * 4];
+}
+
+void sampleTexture(const Texture& texture, float u, float v, const vector<int>& params, const float* border, float* result)
+{
+    const int uAddressMode = params[1];
+    const int vAddressMode = params[2];
+    const float x = std::max(-1.0e6f, std::min(u * texture.width, 1.0e6f));
+    const float y = std::max(-1.0e6f, std::min(v * texture.height, 1.0e6f));
+    if (params[3] == FILTER_CLOSEST)
+    {
+        const float* texel = getTexel(texture, (int) std::floor(x), (int) std::floor(y), uAddressMode, vAddressMode, border);
+        std::copy(texel, texel + 4, result);
+        return;
+    }
+
+    const float sx = x - 0.5f;
+    const float sy = y - 0.5f;
+    const int x0 = (int) std::floor(sx);
+    const int y0 = (int) std::floor(sy);
+    const float fx = sx - (float) x0;
+    const float fy = sy - (float) y0;
+    const float* t00 = getTexel(texture, x0, y0, uAddressMode, vAddressMode, border);
+    const float* t10 = getTexel(texture, x0 + 1, y0, uAddressMode, vAddressMode, border);
+    const float* t01 = getTexel(texture, x0, y0 + 1, uAddressMode, vAddressMode, border);
+    const float* t11 = getTexel(texture, x0 + 1, y0 + 1, uAddressMode, vAddressMode, border);
+    for (size_t c = 0; c < 4; c++)
+    {
+        result[c] = bilerp(t00[c], t10[c], t01[c], t11[c], fx, fy);
+    }
+}
+
+} // anonymous namespace
+
+//
+// ShadingPoints methods
+//
+
+void ShadingPoints::resize(size_t count)
+{
+    for (size_t c = 0; c < 3; c++)
+    {
+        position[c].resize(count, 0.0f);
+        normal[c].resize(count, c == 2 ? 1.0f : 0.0f);
+        tangent[c].resize(count, c == 0 ? 1.0f : 0.0f);
+        bitangent[c].resize(count, c == 1 ? 1.0f : 0.0f);
+    }
+    for (size_t c = 0; c < 2; c++)
+    {
+        texcoord[c].resize(count, 0.0f);
+    }
+    for (size_t c = 0; c < 4; c++)
+    {
+        color[c].resize(count, 1.0f);
+    }
+}
+
+ShadingPoints ShadingPoints::createGrid(unsigned int width, unsigned int height)
+{
+    ShadingPoints points;
+    points.resize((size_t) width * height);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            const size_t i = (size_t) y * width + x;
+            points.texcoord[0][i] = points.position[0][i] = (x + 0.5f) / width;
+            points.texcoord[1][i] = points.position[1][i] = (y + 0.5f) / height;
+        }
+    }
+    return points;
+}
+
+//
+// CpuEvaluator::Program methods
+//
+
+class CpuEvaluator::Program
+{
+  public:
+    Program(ConstDocumentPtr document, ImageHandlerPtr imageHandler, bool flipTextures) :
+        _document(document),
+        _imageHandler(imageHandler),
+        _flipTextures(flipTextures),
+        _totalChannels(0),
+        _zeroRegister(-1),
+        outputRegister(-1),
+        outputType(nullptr)
+    {
+    }
+
+    // Compile the nodes of a graph, given the sources of its input sockets.
+    void compileGraph(const ShaderGraph& graph, SourceMap& sources)
+    {
+        for (const ShaderNode* node : graph.getNodes())
+        {
+            compileNode(*node, sources);
+        }
+    }
+
+    // Return the source of a graph output socket, or of a node input.
+    Source resolveInput(const ShaderInput& input, const SourceMap& sources)
+    {
+        const ShaderOutput* connection = input.getConnection();
+        if (connection)
+        {
+            auto it = sources.find(connection);
+            if (it != sources.end())
+            {
+                return it->second;
+            }
+
+            // Graph input sockets without a source hold their own values.
+            return addConstant(connection->getType(), connection->getValue());
+        }
+        return addConstant(input.getType(), input.getValue());
+    }
+
+    // Return the register holding the given source.
+    int requireRegister(const Source& source, const ShaderNode& node) const
+    {
+        if (source.reg < 0)
+        {
+            throw ExceptionShaderGenError("Node '" + node.getName() + "' has a string input which is not supported by the CPU evaluator");
+        }
+        return source.reg;
+    }
+
+    void evaluate(const ShadingPoints& points, vector<float>& results) const;
+
+  protected:
+    void compileNode(const ShaderNode& node, SourceMap& sources);
+
+    string getCategory(const ShaderNode& node) const;
+
+    Source getInputSource(const ShaderNode& node, const string& inputName, const SourceMap& sources)
+    {
+        const ShaderInput* input = node.getInput(inputName);
+        if (!input)
+        {
+            Source zero;
+            zero.reg = getZeroRegister();
+            return zero;
+        }
+        return resolveInput(*input, sources);
+    }
+
+    int addRegister(size_t channelCount)
+    {
+        _channelCounts.push_back(channelCount);
+        _offsets.push_back(_totalChannels);
+        _totalChannels += channelCount;
+        return (int) _channelCounts.size() - 1;
+    }
+
+    Source addConstant(const TypeDesc* type, ValuePtr value)
+    {
+        Source source;
+        source.value = value;
+        const size_t channelCount = getTypeChannelCount(type);
+        if (channelCount)
+        {
+            source.reg = addRegister(channelCount);
+            _constants.push_back(std::make_pair(source.reg, getValueData(value, channelCount)));
+        }
+        return source;
+    }
+
+    int getZeroRegister()
+    {
+        if (_zeroRegister < 0)
+        {
+            _zeroRegister = addConstant(Type::FLOAT, nullptr).reg;
+        }
+        return _zeroRegister;
+    }
+
+    int addInstruction(Op op, size_t channelCount, const vector<int>& inputs, const vector<int>& params = vector<int>())
+    {
+        Instruction inst;
+        inst.op = op;
+        inst.output = addRegister(channelCount);
+        inst.inputs = inputs;
+        inst.params = params;
+        _instructions.push_back(inst);
+        return inst.output;
+    }
+
+    int loadTexture(const string& fileName);
+
+    void execute(const Instruction& inst, RegisterFile& regs, const ShadingPoints& points, size_t start, size_t count) const;
+
+  protected:
+    ConstDocumentPtr _document;
+    ImageHandlerPtr _imageHandler;
+    bool _flipTextures;
+
+    vector<size_t> _channelCounts;
+    vector<size_t> _offsets;
+    size_t _totalChannels;
+    vector<std::pair<int, vector<float>>> _constants;
+    int _zeroRegister;
+
+    vector<Instruction> _instructions;
+    vector<Texture> _textures;
+    std::unordered_map<string, int> _textureIndices;
+
+  public:
+    int outputRegister;
+    const TypeDesc* outputType;
+};
+
+string CpuEvaluator::Program::getCategory(const ShaderNode& node) const
+{
+    const string& implName = node.getImplementation().getName();
+    ImplementationPtr impl = _document->getImplementation(implName);
+    if (!impl)
+    {
+        throw ExceptionShaderGenError("Node '" + node.getName() + "' has no implementation '" + implName + "' in its document");
+    }
+    NodeDefPtr nodeDef = impl->getNodeDef();
+    if (nodeDef)
+    {
+        return nodeDef->getNodeString();
+    }
+
+    // Color transforms have no nodedefs, and are identified by their
+    // function names, of the form mx_<transform>_<type>.
+    string function = impl->getFunction();
+    if (function.compare(0, 3, "mx_") == 0)
+    {
+        function = function.substr(3);
+    }
+    return function.substr(0, function.rfind('_'));
+}
+
+void CpuEvaluator::Program::compileNode(const ShaderNode& node, SourceMap& sources)
+{
+    // Flatten compound nodes, evaluating the nodes of their graphs with
+    // sources given by the inputs of this node.
+    const ShaderGraph* subgraph = node.getImplementation().getGraph();
+    if (subgraph)
+    {
+        SourceMap subgraphSources;
+        for (const ShaderInput* input : node.getInputs())
+        {
+            const ShaderGraphInputSocket* socket = subgraph->getInputSocket(input->getName());
+            if (socket)
+            {
+                subgraphSources[socket] = resolveInput(*input, sources);
+            }
+        }
+        compileGraph(*subgraph, subgraphSources);
+
+        // Node outputs correspond to graph outputs by position, as in the
+        // functions generated for compound nodes.
+        const vector<ShaderGraphOutputSocket*>& sockets = subgraph->getOutputSockets();
+        if (sockets.size() != node.numOutputs())
+        {
+            throw ExceptionShaderGenError("Node '" + node.getName() + "' does not match the outputs of its graph");
+        }
+        for (size_t i = 0; i < sockets.size(); i++)
+        {
+            sources[node.getOutput(i)] = resolveInput(*sockets[i], subgraphSources);
+        }
+        return;
+    }
+
+    const string category = getCategory(node);
+    if (node.numOutputs() != 1)
+    {
+        throw ExceptionShaderGenError("Node '" + node.getName() + "' of category '" + category + "' is not supported by the CPU evaluator");
+    }
+    const ShaderOutput* output = node.getOutput();
+
+    // Nodes which pass their input through. Transforms between named spaces
+    // are included, as all spaces coincide.
+    if (category == "constant" || category == "dot" ||
+        ((category == "transformpoint" || category == "transformvector" || category == "transformnormal") && !node.getInput("mat")))
+    {
+        sources[output] = getInputSource(node, category == "constant" ? "value" : "in", sources);
+        return;
+    }
+
+    const size_t channelCount = getTypeChannelCount(output->getType());
+    Source result;
+
+    auto it = OP_SIGNATURES.find(category);
+    if (it != OP_SIGNATURES.end())
+    {
+        vector<int> inputs;
+        for (const string& inputName : it->second.inputs)
+        {
+            inputs.push_back(requireRegister(getInputSource(node, inputName, sources), node));
+        }
+        result.reg = addInstruction(it->second.op, channelCount, inputs);
+    }
+    else if (category == "premult" || category == "unpremult")
+    {
+        // Colors without alpha take it from a separate input.
+        const bool hasAlpha = node.getInput("alpha") != nullptr;
+        const Op op = category == "premult" ? (hasAlpha ? Op::MULTIPLY : Op::PREMULT) : (hasAlpha ? Op::DIVIDE : Op::UNPREMULT);
+        vector<int> inputs = { requireRegister(getInputSource(node, "in", sources), node) };
+        if (hasAlpha)
+        {
+            inputs.push_back(requireRegister(getInputSource(node, "alpha", sources), node));
+        }
+        result.reg = addInstruction(op, channelCount, inputs);
+    }
+    else if (category == "rotate")
+    {
+        vector<int> inputs = { requireRegister(getInputSource(node, "in", sources), node),
+                               requireRegister(getInputSource(node, "amount", sources), node) };
+        if (channelCount == 3)
+        {
+            inputs.push_back(requireRegister(getInputSource(node, "axis", sources), node));
+        }
+        result.reg = addInstruction(channelCount == 3 ? Op::ROTATE3D : Op::ROTATE2D, channelCount, inputs);
+    }
+    else if (category.compare(0, 5, "gamma") == 0 && category.size() == 17 && category.compare(7, 10, "_to_linear") == 0)
+    {
+        const float gamma = std::stof(category.substr(5, 2)) / 10.0f;
+        vector<int> inputs = { requireRegister(getInputSource(node, "in", sources), node),
+                               addConstant(Type::FLOAT, Value::createValue(gamma)).reg };
+        result.reg = addInstruction(Op::GAMMA_TO_LINEAR, channelCount, inputs);
+    }
+    else if (category == "swizzle" || category == "convert" || category == "combine")
+    {
+        // Each output channel is given by an input index and channel, or by
+        // an input index of -1 and a constant value.
+        vector<int> inputs;
+        vector<int> params;
+        if (category == "combine")
+        {
+            for (const ShaderInput* input : node.getInputs())
+            {
+                const int reg = requireRegister(resolveInput(*input, sources), node);
+                for (size_t c = 0; c < _channelCounts[reg]; c++)
+                {
+                    params.push_back((int) inputs.size());
+                    params.push_back((int) c);
+                }
+                inputs.push_back(reg);
+            }
+        }
+        else
+        {
+            const ShaderInput* input = node.getInput("in");
+            if (!input)
+            {
+                throw ExceptionShaderGenError("Node '" + node.getName() + "' has no input to " + category);
+            }
+            const Source source = resolveInput(*input, sources);
+            inputs.push_back(requireRegister(source, node));
+            const size_t inputChannelCount = _channelCounts[inputs[0]];
+
+            if (category == "swizzle")
+            {
+                const ShaderInput* channelsInput = node.getInput("channels");
+                const string channels = channelsInput && channelsInput->getValue() ? channelsInput->getValue()->getValueString() : EMPTY_STRING;
+                if (channels.empty())
+                {
+                    sources[output] = source;
+                    return;
+                }
+                const TypeDesc* inputType = input->getConnection() ? input->getConnection()->getType() : input->getType();
+                for (char channel : channels)
+                {
+                    if (channel == '0' || channel == '1')
+                    {
+                        params.push_back(-1);
+                        params.push_back(channel == '1' ? 1 : 0);
+                        continue;
+                    }
+                    int index = inputChannelCount == 1 ? 0 : inputType->getChannelIndex(channel);
+                    if (string("rgbaxyzw").find(channel) == string::npos || index < 0 || index >= (int) inputChannelCount)
+                    {
+                        throw ExceptionShaderGenError("Invalid channel pattern '" + channels + "' on node '" + node.getName() + "'");
+                    }
+                    params.push_back(0);
+                    params.push_back(index);
+                }
+            }
+            else
+            {
+                // Scalars are copied to every channel. Vectors keep their
+                // channels in order, padding a third channel with zero and
+                // a fourth with one.
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    const bool fromInput = inputChannelCount == 1 || c < inputChannelCount;
+                    params.push_back(fromInput ? 0 : -1);
+                    params.push_back(fromInput ? (inputChannelCount == 1 ? 0 : (int) c) : (c == 3 ? 1 : 0));
+                }
+            }
+        }
+        params.resize(std::min(params.size(), channelCount * 2), 0);
+        while (params.size() < channelCount * 2)
+        {
+            params.push_back(-1);
+            params.push_back(0);
+        }
+        result.reg = addInstruction(Op::GATHER, channelCount, inputs, params);
+    }
+    else if (category == "image")
+    {
+        const Source file = getInputSource(node, "file", sources);
+        const string fileName = file.value ? file.value->getValueString() : EMPTY_STRING;
+        vector<int> inputs = { requireRegister(getInputSource(node, "default", sources), node),
+                               requireRegister(getInputSource(node, "texcoord", sources), node) };
+        vector<int> params = { loadTexture(fileName),
+                               getEnumIndex(getInputSource(node, "uaddressmode", sources), ADDRESS_MODES, ADDRESS_PERIODIC),
+                               getEnumIndex(getInputSource(node, "vaddressmode", sources), ADDRESS_MODES, ADDRESS_PERIODIC),
+                               getEnumIndex(getInputSource(node, "filtertype", sources), FILTER_TYPES, 1) };
+        result.reg = addInstruction(Op::IMAGE, channelCount, inputs, params);
+    }
+    else if (category == "geomattrvalue")
+    {
+        // No named attributes are available.
+        result = addConstant(output->getType(), nullptr);
+    }
+    else
+    {
+        throw ExceptionShaderGenError("Node '" + node.getName() + "' of category '" + category + "' is not supported by the CPU evaluator");
+    }
+
+    sources[output] = result;
+}
+
+int CpuEvaluator::Program::loadTexture(const string& fileName)
+{
+    if (fileName.empty() || !_imageHandler)
+    {
+        return -1;
+    }
+    auto it = _textureIndices.find(fileName);
+    if (it != _textureIndices.end())
+    {
+        return it->second;
+    }
+
+    // Read the image through the loaders alone, as derived handlers may
+    // upload and release the buffer.
+    int index = -1;
+    ImageDesc desc;
+    if (_imageHandler->ImageHandler::acquireImage(FilePath(fileName), desc, false, nullptr) && desc.resourceBuffer)
+    {
+        if (desc.width && desc.height && desc.channelCount >= 1 && desc.channelCount <= 4)
+        {
+            // Expand to RGBA as the hardware texture handlers do.
+            static const int CHANNEL_MAPS[4][4] = { { 0, 0, 0, -1 }, { 0, 0, 0, 1 }, { 0, 1, 2, -1 }, { 0, 1, 2, 3 } };
+            const int* channelMap = CHANNEL_MAPS[desc.channelCount - 1];
+
+            Texture texture;
+            texture.width = desc.width;
+            texture.height = desc.height;
+            const size_t texelCount = (size_t) desc.width * desc.height;
+            texture.texels.resize(texelCount * 4);
+            for (size_t i = 0; i < texelCount; i++)
+            {
+                for (size_t c = 0; c < 4; c++)
+                {
+                    const int channel = channelMap[c];
+                    float value = 1.0f;
+                    if (channel >= 0)
+                    {
+                        const size_t offset = i * desc.channelCount + channel;
+                        value = desc.floatingPoint ? static_cast<const float*>(desc.resourceBuffer)[offset] :
+                                                     static_cast<const unsigned char*>(desc.resourceBuffer)[offset] / 255.0f;
+                    }
+                    texture.texels[i * 4 + c] = value;
+                }
+            }
+            index = (int) _textures.size();
+            _textures.push_back(texture);
+        }
+        free(desc.resourceBuffer);
+    }
+    _textureIndices[fileName] = index;
+    return index;
+}
+
+void CpuEvaluator::Program::execute(const Instruction& inst, RegisterFile& regs, const ShadingPoints& points, size_t start, size_t count) const
+{
+    const size_t channelCount = regs.getChannelCount(inst.output);
+    const vector<int>& in = inst.inputs;
+
+    // Copy a per-point attribute to the output.
+    auto copyAttribute = [&](const vector<float>* attribute, size_t attributeChannels)
+    {
+        for (size_t c = 0; c < channelCount; c++)
+        {
+            float* out = regs.get(inst.output, c);
+            if (c < attributeChannels)
+            {
+                std::copy(attribute[c].begin() + start, attribute[c].begin() + start + count, out);
+            }
+            else
+            {
+                std::fill(out, out + BATCH_SIZE, 0.0f);
+            }
+        }
+    };
+
+    switch (inst.op)
+    {
+        case Op::ABSVAL: map1(regs, inst, [](float a) { return std::abs(a); }); break;
+        case Op::FLOOR: map1(regs, inst, [](float a) { return std::floor(a); }); break;
+        case Op::CEIL: map1(regs, inst, [](float a) { return std::ceil(a); }); break;
+        case Op::SIN: map1(regs, inst, [](float a) { return std::sin(a); }); break;
+        case Op::COS: map1(regs, inst, [](float a) { return std::cos(a); }); break;
+        case Op::TAN: map1(regs, inst, [](float a) { return std::tan(a); }); break;
+        case Op::ASIN: map1(regs, inst, [](float a) { return std::asin(a); }); break;
+        case Op::ACOS: map1(regs, inst, [](float a) { return std::acos(a); }); break;
+        case Op::SQRT: map1(regs, inst, [](float a) { return std::sqrt(a); }); break;
+        case Op::LN: map1(regs, inst, [](float a) { return std::log(a); }); break;
+        case Op::EXP: map1(regs, inst, [](float a) { return std::exp(a); }); break;
+        case Op::SIGN: map1(regs, inst, [](float a) { return a > 0.0f ? 1.0f : (a < 0.0f ? -1.0f : 0.0f); }); break;
+        case Op::ADD: map2(regs, inst, [](float a, float b) { return a + b; }); break;
+        case Op::SUBTRACT: map2(regs, inst, [](float a, float b) { return a - b; }); break;
+        case Op::MULTIPLY: map2(regs, inst, [](float a, float b) { return a * b; }); break;
+        case Op::DIVIDE: map2(regs, inst, [](float a, float b) { return a / b; }); break;
+        case Op::MODULO: map2(regs, inst, [](float a, float b) { return a - b * std::floor(a / b); }); break;
+        case Op::POWER: map2(regs, inst, [](float a, float b) { return std::pow(a, b); }); break;
+        case Op::ATAN2: map2(regs, inst, [](float a, float b) { return std::atan2(a, b); }); break;
+        case Op::MIN: map2(regs, inst, [](float a, float b) { return std::min(a, b); }); break;
+        case Op::MAX: map2(regs, inst, [](float a, float b) { return std::max(a, b); }); break;
+        case Op::INVERT: map2(regs, inst, [](float a, float amount) { return amount - a; }); break;
+        case Op::CLAMP: map3(regs, inst, [](float a, float low, float high) { return std::min(std::max(a, low), high); }); break;
+        case Op::SMOOTHSTEP:
+            map3(regs, inst, [](float a, float low, float high)
+            {
+                if (a >= high)
+                {
+                    return 1.0f;
+                }
+                if (a <= low)
+                {
+                    return 0.0f;
+                }
+                float t = (a - low) / (high - low);
+                return t * t * (3.0f - 2.0f * t);
+            });
+            break;
+        case Op::REMAP:
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                const float* inLow = regs.get(in[1], c);
+                const float* inHigh = regs.get(in[2], c);
+                const float* outLow = regs.get(in[3], c);
+                const float* outHigh = regs.get(in[4], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = outLow[i] + (a[i] - inLow[i]) * (outHigh[i] - outLow[i]) / (inHigh[i] - inLow[i]);
+                }
+            }
+            break;
+        case Op::MIX: map3(regs, inst, [](float fg, float bg, float mix) { return bg * (1.0f - mix) + fg * mix; }); break;
+
+        case Op::BURN: mapComposite(regs, inst, [](float fg, float bg) { return 1.0f - (1.0f - bg) / fg; }); break;
+        case Op::DODGE: mapComposite(regs, inst, [](float fg, float bg) { return bg / (1.0f - fg); }); break;
+        // The genglsl screen computes (1 - (1 - fg)) * (1 - bg), which is matched here.
+        case Op::SCREEN: mapComposite(regs, inst, [](float fg, float bg) { return fg * (1.0f - bg); }); break;
+        case Op::OVERLAY:
+            mapComposite(regs, inst, [](float fg, float bg)
+            {
+                return fg < 0.5f ? 2.0f * fg * bg : 1.0f - (1.0f - fg) * (1.0f - bg);
+            });
+            break;
+        case Op::PLUS: mapComposite(regs, inst, [](float fg, float bg) { return bg + fg; }); break;
+        case Op::MINUS: mapComposite(regs, inst, [](float fg, float bg) { return bg - fg; }); break;
+        case Op::DIFFERENCE: mapComposite(regs, inst, [](float fg, float bg) { return std::abs(bg - fg); }); break;
+        case Op::INSIDE: map2(regs, inst, [](float a, float mask) { return a * mask; }); break;
+        case Op::OUTSIDE: map2(regs, inst, [](float a, float mask) { return a * (1.0f - mask); }); break;
+        case Op::ALPHA_OVER:
+        {
+            // As in genglsl, over ignores its mix input.
+            const float* fgAlpha = regs.get(in[0], channelCount - 1);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* fg = regs.get(in[0], c);
+                const float* bg = regs.get(in[1], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = fg[i] + bg[i] * (1.0f - fgAlpha[i]);
+                }
+            }
+            break;
+        }
+        case Op::ALPHA_IN: mapAlphaComposite(regs, inst, [](float fg, float, float, float bgAlpha, bool) { return fg * bgAlpha; }); break;
+        case Op::ALPHA_OUT: mapAlphaComposite(regs, inst, [](float fg, float, float, float bgAlpha, bool) { return fg * (1.0f - bgAlpha); }); break;
+        case Op::ALPHA_MASK: mapAlphaComposite(regs, inst, [](float, float bg, float fgAlpha, float, bool) { return bg * fgAlpha; }); break;
+        case Op::ALPHA_MATTE:
+            mapAlphaComposite(regs, inst, [](float fg, float bg, float fgAlpha, float, bool isAlpha)
+            {
+                return isAlpha ? fg + bg * (1.0f - fgAlpha) : fg * fgAlpha + bg * (1.0f - fgAlpha);
+            });
+            break;
+        case Op::ALPHA_DISJOINTOVER:
+            mapAlphaComposite(regs, inst, [](float fg, float bg, float fgAlpha, float bgAlpha, bool isAlpha)
+            {
+                if (isAlpha)
+                {
+                    return std::min(fgAlpha + bgAlpha, 1.0f);
+                }
+                return fgAlpha + bgAlpha < 1.0f ? fg + bg : fg + bg * (1.0f - fgAlpha) / bgAlpha;
+            });
+            break;
+
+        case Op::MAGNITUDE:
+        case Op::NORMALIZE:
+        case Op::DOTPRODUCT:
+        {
+            const size_t inputChannels = regs.getChannelCount(in[0]);
+            float sum[BATCH_SIZE] = { };
+            for (size_t c = 0; c < inputChannels; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                const float* b = regs.get(in[inst.op == Op::DOTPRODUCT ? 1 : 0], c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    sum[i] += a[i] * b[i];
+                }
+            }
+            if (inst.op == Op::DOTPRODUCT)
+            {
+                std::copy(sum, sum + BATCH_SIZE, regs.get(inst.output, 0));
+                break;
+            }
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                sum[i] = std::sqrt(sum[i]);
+            }
+            if (inst.op == Op::MAGNITUDE)
+            {
+                std::copy(sum, sum + BATCH_SIZE, regs.get(inst.output, 0));
+                break;
+            }
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = a[i] / sum[i];
+                }
+            }
+            break;
+        }
+        case Op::CROSSPRODUCT:
+        {
+            const float* a[3] = { regs.get(in[0], 0), regs.get(in[0], 1), regs.get(in[0], 2) };
+            const float* b[3] = { regs.get(in[1], 0), regs.get(in[1], 1), regs.get(in[1], 2) };
+            for (size_t c = 0; c < 3; c++)
+            {
+                const size_t c1 = (c + 1) % 3;
+                const size_t c2 = (c + 2) % 3;
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = a[c1][i] * b[c2][i] - a[c2][i] * b[c1][i];
+                }
+            }
+            break;
+        }
+        case Op::ROTATE2D:
+        {
+            const float* x = regs.get(in[0], 0);
+            const float* y = regs.get(in[0], 1);
+            const float* amount = regs.get(in[1], 0);
+            float* outX = regs.get(inst.output, 0);
+            float* outY = regs.get(inst.output, 1);
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                const float angle = amount[i] * PI / 180.0f;
+                const float sa = std::sin(angle);
+                const float ca = std::cos(angle);
+                outX[i] = ca * x[i] + sa * y[i];
+                outY[i] = -sa * x[i] + ca * y[i];
+            }
+            break;
+        }
+        case Op::ROTATE3D:
+        {
+            const float* v[3] = { regs.get(in[0], 0), regs.get(in[0], 1), regs.get(in[0], 2) };
+            const float* amount = regs.get(in[1], 0);
+            const float* axis[3] = { regs.get(in[2], 0), regs.get(in[2], 1), regs.get(in[2], 2) };
+            float* out[3] = { regs.get(inst.output, 0), regs.get(inst.output, 1), regs.get(inst.output, 2) };
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                const float length = std::sqrt(axis[0][i] * axis[0][i] + axis[1][i] * axis[1][i] + axis[2][i] * axis[2][i]);
+                const float x = axis[0][i] / length;
+                const float y = axis[1][i] / length;
+                const float z = axis[2][i] / length;
+                const float angle = amount[i] * PI / 180.0f;
+                const float s = std::sin(angle);
+                const float c = std::cos(angle);
+                const float oc = 1.0f - c;
+                out[0][i] = (oc * x * x + c) * v[0][i] + (oc * x * y + z * s) * v[1][i] + (oc * z * x - y * s) * v[2][i];
+                out[1][i] = (oc * x * y - z * s) * v[0][i] + (oc * y * y + c) * v[1][i] + (oc * y * z + x * s) * v[2][i];
+                out[2][i] = (oc * z * x + y * s) * v[0][i] + (oc * y * z - x * s) * v[1][i] + (oc * z * z + c) * v[2][i];
+            }
+            break;
+        }
+
+        case Op::LUMINANCE:
+        case Op::SATURATE:
+        {
+            const int coeffsInput = inst.op == Op::LUMINANCE ? 1 : 2;
+            float luma[BATCH_SIZE] = { };
+            for (size_t c = 0; c < 3; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                const float* coeff = regs.get(in[coeffsInput], c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    luma[i] += a[i] * coeff[i];
+                }
+            }
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                float* out = regs.get(inst.output, c);
+                if (c == 3)
+                {
+                    std::copy(a, a + BATCH_SIZE, out);
+                }
+                else if (inst.op == Op::LUMINANCE)
+                {
+                    std::copy(luma, luma + BATCH_SIZE, out);
+                }
+                else
+                {
+                    const float* amount = regs.get(in[1], 0);
+                    for (size_t i = 0; i < BATCH_SIZE; i++)
+                    {
+                        out[i] = luma[i] + (a[i] - luma[i]) * amount[i];
+                    }
+                }
+            }
+            break;
+        }
+        case Op::RGBTOHSV:
+        case Op::HSVTORGB:
+        {
+            const float* a[3] = { regs.get(in[0], 0), regs.get(in[0], 1), regs.get(in[0], 2) };
+            float* out[3] = { regs.get(inst.output, 0), regs.get(inst.output, 1), regs.get(inst.output, 2) };
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                const float color[3] = { a[0][i], a[1][i], a[2][i] };
+                float converted[3];
+                if (inst.op == Op::RGBTOHSV)
+                {
+                    rgbToHsv(color, converted);
+                }
+                else
+                {
+                    hsvToRgb(color, converted);
+                }
+                out[0][i] = converted[0];
+                out[1][i] = converted[1];
+                out[2][i] = converted[2];
+            }
+            // The genglsl color4 conversions output an alpha of one.
+            if (channelCount == 4)
+            {
+                std::fill(regs.get(inst.output, 3), regs.get(inst.output, 3) + BATCH_SIZE, 1.0f);
+            }
+            break;
+        }
+        case Op::PREMULT:
+        case Op::UNPREMULT:
+        {
+            const float* alpha = regs.get(in[0], channelCount - 1);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* a = regs.get(in[0], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = c == channelCount - 1 ? a[i] : (inst.op == Op::PREMULT ? a[i] * alpha[i] : a[i] / alpha[i]);
+                }
+            }
+            break;
+        }
+        case Op::SRGB_TO_LINEAR:
+            mapColorChannels(regs, inst, [](float a)
+            {
+                return a > 0.03928571566939354f ? std::pow(std::max(0.0f, 0.9478672742843628f * a + 0.05213269963860512f), 2.4f) :
+                                                  a * 0.07738015800714493f;
+            });
+            break;
+        case Op::GAMMA_TO_LINEAR:
+        {
+            const float gamma = regs.get(in[1], 0)[0];
+            mapColorChannels(regs, inst, [gamma](float a) { return std::pow(std::max(0.0f, a), gamma); });
+            break;
+        }
+        case Op::ACESCG_TO_LINEAR:
+        {
+            static const float M[3][3] =
+            {
+                { 1.705079555511475f, -0.6242334842681885f, -0.0808461606502533f },
+                { -0.1297005265951157f, 1.138468623161316f, -0.008768022060394287f },
+                { -0.02416634373366833f, -0.1246141716837883f, 1.148780584335327f }
+            };
+            const float* a[3] = { regs.get(in[0], 0), regs.get(in[0], 1), regs.get(in[0], 2) };
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                float* out = regs.get(inst.output, c);
+                if (c == 3)
+                {
+                    const float* alpha = regs.get(in[0], 3);
+                    std::copy(alpha, alpha + BATCH_SIZE, out);
+                    continue;
+                }
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = M[c][0] * a[0][i] + M[c][1] * a[1][i] + M[c][2] * a[2][i];
+                }
+            }
+            break;
+        }
+
+        case Op::GATHER:
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const int input = inst.params[c * 2];
+                const int channel = inst.params[c * 2 + 1];
+                float* out = regs.get(inst.output, c);
+                if (input < 0)
+                {
+                    std::fill(out, out + BATCH_SIZE, (float) channel);
+                }
+                else
+                {
+                    const float* a = regs.get(in[input], channel);
+                    std::copy(a, a + BATCH_SIZE, out);
+                }
+            }
+            break;
+
+        case Op::COMPARE:
+        {
+            const float* intest = regs.get(in[0], 0);
+            const float* cutoff = regs.get(in[1], 0);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* in1 = regs.get(in[2], c);
+                const float* in2 = regs.get(in[3], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = intest[i] <= cutoff[i] ? in1[i] : in2[i];
+                }
+            }
+            break;
+        }
+        case Op::SWITCH:
+        {
+            const float* which = regs.get(in[5], 0);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* branches[5];
+                for (size_t b = 0; b < 5; b++)
+                {
+                    branches[b] = regs.get(in[b], c);
+                }
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = which[i] < 5.0f ? branches[(int) std::max(std::floor(which[i]), 0.0f)][i] : 0.0f;
+                }
+            }
+            break;
+        }
+
+        case Op::RAMPLR:
+        case Op::RAMPTB:
+        {
+            const float* coord = regs.get(in[2], inst.op == Op::RAMPLR ? 0 : 1);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* first = regs.get(in[0], c);
+                const float* second = regs.get(in[1], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    const float t = std::min(std::max(coord[i], 0.0f), 1.0f);
+                    out[i] = first[i] * (1.0f - t) + second[i] * t;
+                }
+            }
+            break;
+        }
+        case Op::RAMP4:
+        {
+            const float* s = regs.get(in[4], 0);
+            const float* t = regs.get(in[4], 1);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* tl = regs.get(in[0], c);
+                const float* tr = regs.get(in[1], c);
+                const float* bl = regs.get(in[2], c);
+                const float* br = regs.get(in[3], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    const float ss = std::min(std::max(s[i], 0.0f), 1.0f);
+                    const float tt = std::min(std::max(t[i], 0.0f), 1.0f);
+                    const float top = tl[i] * (1.0f - ss) + tr[i] * ss;
+                    const float bottom = bl[i] * (1.0f - ss) + br[i] * ss;
+                    out[i] = top * (1.0f - tt) + bottom * tt;
+                }
+            }
+            break;
+        }
+        case Op::SPLITLR:
+        case Op::SPLITTB:
+        {
+            // Split without antialiasing, as points have no derivatives.
+            const float* center = regs.get(in[2], 0);
+            const float* coord = regs.get(in[3], inst.op == Op::SPLITLR ? 0 : 1);
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* first = regs.get(in[0], c);
+                const float* second = regs.get(in[1], c);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = coord[i] < center[i] ? first[i] : second[i];
+                }
+            }
+            break;
+        }
+        case Op::NOISE2D:
+        case Op::NOISE3D:
+        case Op::FRACTAL3D:
+        {
+            const bool isFractal = inst.op == Op::FRACTAL3D;
+            const int positionInput = isFractal ? 4 : 2;
+            const size_t positionChannels = inst.op == Op::NOISE2D ? 2 : 3;
+            const float* p[3] = { regs.get(in[positionInput], 0), regs.get(in[positionInput], 1), regs.get(in[positionInput], 2) };
+            const Vector3 offset = isFractal ? Vector3(19.0f, 193.0f, 17.0f) : Vector3(19.0f, 73.0f, 29.0f);
+            float noise[4][BATCH_SIZE];
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                float value[4] = { };
+                if (positionChannels == 2)
+                {
+                    perlinNoise4(p[0][i], p[1][i], channelCount, value);
+                }
+                else if (!isFractal)
+                {
+                    perlinNoise4(p[0][i], p[1][i], p[2][i], channelCount, offset, value);
+                }
+                else
+                {
+                    // As in genglsl, the fourth channel is the fractal noise of
+                    // the offset position, so its octaves scale the offset too.
+                    const int octaves = (int) regs.get(in[1], 0)[i];
+                    const float lacunarity = regs.get(in[2], 0)[i];
+                    const float diminish = regs.get(in[3], 0)[i];
+                    const size_t xyzChannels = std::min(channelCount, (size_t) 3);
+                    float amplitude = 1.0f;
+                    float position[3] = { p[0][i], p[1][i], p[2][i] };
+                    float offsetPosition[3] = { p[0][i] + offset[0], p[1][i] + offset[1], p[2][i] + offset[2] };
+                    for (int octave = 0; octave < octaves; octave++)
+                    {
+                        float octaveValue[4];
+                        perlinNoise(position[0], position[1], position[2], xyzChannels, octaveValue);
+                        if (channelCount == 4)
+                        {
+                            perlinNoise(offsetPosition[0], offsetPosition[1], offsetPosition[2], 1, octaveValue + 3);
+                        }
+                        for (size_t c = 0; c < channelCount; c++)
+                        {
+                            value[c] += amplitude * octaveValue[c];
+                        }
+                        amplitude *= diminish;
+                        for (size_t c = 0; c < 3; c++)
+                        {
+                            position[c] *= lacunarity;
+                            offsetPosition[c] *= lacunarity;
+                        }
+                    }
+                }
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    noise[c][i] = value[c];
+                }
+            }
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                const float* amplitude = regs.get(in[0], c);
+                const float* pivot = isFractal ? nullptr : regs.get(in[1], 0);
+                float* out = regs.get(inst.output, c);
+                for (size_t i = 0; i < BATCH_SIZE; i++)
+                {
+                    out[i] = noise[c][i] * amplitude[i] + (pivot ? pivot[i] : 0.0f);
+                }
+            }
+            break;
+        }
+        case Op::CELLNOISE2D:
+        case Op::CELLNOISE3D:
+        {
+            const float* p[3] = { regs.get(in[0], 0), regs.get(in[0], 1), regs.get(in[0], 2) };
+            float* out = regs.get(inst.output, 0);
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                out[i] = inst.op == Op::CELLNOISE2D ? cellNoise(p[0][i], p[1][i]) : cellNoise(p[0][i], p[1][i], p[2][i]);
+            }
+            break;
+        }
+
+        case Op::POSITION: copyAttribute(points.position, 3); break;
+        case Op::NORMAL: copyAttribute(points.normal, 3); break;
+        case Op::TANGENT: copyAttribute(points.tangent, 3); break;
+        case Op::BITANGENT: copyAttribute(points.bitangent, 3); break;
+        case Op::TEXCOORD: copyAttribute(points.texcoord, 2); break;
+        case Op::GEOMCOLOR: copyAttribute(points.color, 4); break;
+        case Op::FRAME: std::fill(regs.get(inst.output, 0), regs.get(inst.output, 0) + BATCH_SIZE, points.frame); break;
+        case Op::TIME:
+        {
+            const float* fps = regs.get(in[0], 0);
+            float* out = regs.get(inst.output, 0);
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                out[i] = points.frame / fps[i];
+            }
+            break;
+        }
+        case Op::VIEWDIRECTION:
+        {
+            copyAttribute(points.position, 3);
+            float* out[3] = { regs.get(inst.output, 0), regs.get(inst.output, 1), regs.get(inst.output, 2) };
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                const float x = out[0][i] - points.viewPosition[0];
+                const float y = out[1][i] - points.viewPosition[1];
+                const float z = out[2][i] - points.viewPosition[2];
+                const float length = std::sqrt(x * x + y * y + z * z);
+                out[0][i] = x / length;
+                out[1][i] = y / length;
+                out[2][i] = z / length;
+            }
+            break;
+        }
+
+        case Op::IMAGE:
+        {
+            const int textureIndex = inst.params[0];
+            const float* defaults[4];
+            float* out[4];
+            for (size_t c = 0; c < channelCount; c++)
+            {
+                defaults[c] = regs.get(in[0], c);
+                out[c] = regs.get(inst.output, c);
+            }
+            if (textureIndex < 0)
+            {
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    std::copy(defaults[c], defaults[c] + BATCH_SIZE, out[c]);
+                }
+                break;
+            }
+            const Texture& texture = _textures[textureIndex];
+            const float* u = regs.get(in[1], 0);
+            const float* v = regs.get(in[1], 1);
+            for (size_t i = 0; i < BATCH_SIZE; i++)
+            {
+                float border[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    border[c] = defaults[c][i];
+                }
+                float texel[4];
+                sampleTexture(texture, u[i], _flipTextures ? 1.0f - v[i] : v[i], inst.params, border, texel);
+                for (size_t c = 0; c < channelCount; c++)
+                {
+                    out[c][i] = texel[c];
+                }
+            }
+            break;
+        }
+    }
+}
+
+void CpuEvaluator::Program::evaluate(const ShadingPoints& points, vector<float>& results) const
+{
+    RegisterFile regs(_channelCounts, _offsets, _totalChannels);
+    for (const auto& constant : _constants)
+    {
+        for (size_t c = 0; c < constant.second.size(); c++)
+        {
+            float* data = regs.get(constant.first, c);
+            std::fill(data, data + BATCH_SIZE, constant.second[c]);
+        }
+    }
+
+    const size_t pointCount = points.size();
+    const size_t channelCount = _channelCounts[outputRegister];
+    results.resize(pointCount * channelCount);
+    for (size_t start = 0; start < pointCount; start += BATCH_SIZE)
+    {
+        const size_t count = std::min(BATCH_SIZE, pointCount - start);
+        for (const Instruction& inst : _instructions)
+        {
+            execute(inst, regs, points, start, count);
+        }
+        for (size_t c = 0; c < channelCount; c++)
+        {
+            const float* data = regs.get(outputRegister, c);
+            for (size_t i = 0; i < count; i++)
+            {
+                results[(start + i) * channelCount + c] = data[i];
+            }
+        }
+    }
+}
+
+//
+// CpuEvaluator methods
+//
+
+CpuEvaluatorPtr CpuEvaluator::create(ElementPtr element, GenContext& context, ImageHandlerPtr imageHandler)
+{
+    ShaderGraphPtr graph = ShaderGraph::create(nullptr, element->getName(), element, context);
+    const ShaderGraphOutputSocket* outputSocket = graph->getOutputSocket();
+    if (!outputSocket)
+    {
+        throw ExceptionShaderGenError("Element '" + element->getNamePath() + "' has no output to evaluate");
+    }
+
+    std::unique_ptr<Program> program(new Program(element->getDocument(), imageHandler,
+                                                 context.getOptions().fileTextureVerticalFlip));
+    SourceMap sources;
+    program->compileGraph(*graph, sources);
+    program->outputType = outputSocket->getType();
+    getTypeChannelCount(program->outputType);
+    Source output = program->resolveInput(*outputSocket, sources);
+    program->outputRegister = program->requireRegister(output, *graph);
+
+    CpuEvaluatorPtr evaluator(new CpuEvaluator());
+    evaluator->_program = std::move(program);
+    return evaluator;
+}
+
+CpuEvaluator::CpuEvaluator()
+{
+}
+
+CpuEvaluator::~CpuEvaluator()
+{
+}
+
+const TypeDesc* CpuEvaluator::getOutputType() const
+{
+    return _program->outputType;
+}
+
+size_t CpuEvaluator::getChannelCount() const
+{
+    return getTypeChannelCount(_program->outputType);
+}
+
+void CpuEvaluator::evaluate(const ShadingPoints& points, vector<float>& results) const
+{
+    _program->evaluate(points, results);
+}
+
+} // namespace MaterialX
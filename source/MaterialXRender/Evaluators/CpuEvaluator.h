@@ -0,0 +1,131 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_CPUEVALUATOR_H
+#define MATERIALX_CPUEVALUATOR_H
+
+/// @file
+/// Evaluation of node graphs on the CPU
+
+#include <MaterialXRender/Handlers/ImageHandler.h>
+
+#include <MaterialXGenShader/GenContext.h>
+
+namespace MaterialX
+{
+
+/// Shared pointer to a CpuEvaluator
+using CpuEvaluatorPtr = std::shared_ptr<class CpuEvaluator>;
+
+/// @class ShadingPoints
+/// A set of points at which to evaluate a graph. The geometric attributes
+/// of the points are stored in structure-of-arrays layout, with one array
+/// per component, and all arrays must have the same length.
+///
+class ShadingPoints
+{
+  public:
+    /// Resize to the given number of points. Points which are added take
+    /// the default attributes: a position and texture coordinates of zero,
+    /// a normal of +Z, a tangent of +X, a bitangent of +Y and a color of one.
+    void resize(size_t count);
+
+    /// Return the number of points.
+    size_t size() const
+    {
+        return position[0].size();
+    }
+
+    /// Create a grid of points covering the unit square, with one point at
+    /// the center of each cell, in rows of increasing v. Each point takes
+    /// its texture coordinates as the x and y of its position.
+    static ShadingPoints createGrid(unsigned int width, unsigned int height);
+
+    /// Position, in the space shared by object, model and world
+    vector<float> position[3];
+    /// Normal
+    vector<float> normal[3];
+    /// Tangent
+    vector<float> tangent[3];
+    /// Bitangent
+    vector<float> bitangent[3];
+    /// Texture coordinates, shared by all texture coordinate indices
+    vector<float> texcoord[2];
+    /// Geometric color, shared by all color indices
+    vector<float> color[4];
+
+    /// Current frame, from which the time is derived
+    float frame = 1.0f;
+    /// Position of the viewer, from which view directions are derived
+    Vector3 viewPosition = Vector3(0.0f, 0.0f, 1.0f);
+};
+
+/// @class CpuEvaluator
+/// Evaluates the output of a node graph numerically on the CPU, providing a
+/// reference for hardware and OSL rendering without a GPU or an OSL build.
+///
+/// The evaluator is built from the ShaderGraph which a shader generator
+/// creates for an element, so that it sees the same graph as the generated
+/// code: the same node implementations, default geometric nodes, color
+/// transforms and optimizations. Compound nodes are flattened into their
+/// nodes, and the result is compiled into a list of instructions for the
+/// standard library nodes, which is then run over batches of BATCH_SIZE
+/// points at a time. Each value is held in structure-of-arrays layout with
+/// one array of BATCH_SIZE floats per channel, so that the instructions
+/// reduce to simple loops which the compiler can vectorize.
+///
+/// The standard library math, adjustment, channel, compositing, conditional,
+/// procedural, noise, geometric, application and image nodes are supported,
+/// as are the default color transforms. Nodes without a CPU equivalent, such
+/// as convolutions, matrices and closures, cause creation to fail.
+///
+/// Coordinate spaces all coincide, and file textures are read through the
+/// loaders of an ImageHandler and sampled as the hardware generators do.
+///
+class CpuEvaluator
+{
+  public:
+    /// Number of points evaluated together
+    static const size_t BATCH_SIZE = 64;
+
+    /// Create an evaluator for the given element.
+    /// An exception is thrown if the graph of the element contains nodes
+    /// which cannot be evaluated.
+    /// @param element Output or shader reference to evaluate. Its document
+    ///    must include the libraries which define and implement its nodes.
+    /// @param context Context of the shader generator whose node
+    ///    implementations are used to build the graph.
+    /// @param imageHandler Handler whose loaders are used to read file
+    ///    textures. If null, image nodes return their default values.
+    static CpuEvaluatorPtr create(ElementPtr element, GenContext& context, ImageHandlerPtr imageHandler = nullptr);
+
+    /// Destructor
+    virtual ~CpuEvaluator();
+
+    /// Return the type of the evaluated output.
+    const TypeDesc* getOutputType() const;
+
+    /// Return the number of channels in each result.
+    size_t getChannelCount() const;
+
+    /// Evaluate the output at the given points. May be called concurrently
+    /// from multiple threads.
+    /// @param points Points at which to evaluate
+    /// @param results Returned results, with getChannelCount() values per
+    ///    point, interleaved in the order of the points
+    void evaluate(const ShadingPoints& points, vector<float>& results) const;
+
+  protected:
+    /// Constructor
+    CpuEvaluator();
+
+  private:
+    class Program;
+    std::unique_ptr<Program> _program;
+};
+
+} // namespace MaterialX
+
+#endif
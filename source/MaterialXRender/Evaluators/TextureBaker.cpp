@@ -0,0 +1,328 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Evaluators/TextureBaker.h>
+
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+
+#include <MaterialXGenShader/TypeDesc.h>
+#include <MaterialXGenShader/Util.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace MaterialX
+{
+
+namespace {
+
+const unsigned int DEFAULT_RESOLUTION = 1024;
+
+// Number of rows of texels evaluated together, bounding the memory used
+// for shading points and results.
+const unsigned int ROWS_PER_BAND = 64;
+
+struct Tile
+{
+    string udim;
+    unsigned int u = 0;
+    unsigned int v = 0;
+};
+
+Tile parseUdim(const string& udim)
+{
+    bool valid = udim.size() == 4 && std::all_of(udim.begin(), udim.end(), [](char c) { return std::isdigit((unsigned char) c) != 0; });
+    int index = valid ? std::stoi(udim) - 1001 : -1;
+    if (index < 0)
+    {
+        throw Exception("Invalid UDIM tile '" + udim + "'");
+    }
+    Tile tile;
+    tile.udim = udim;
+    tile.u = (unsigned int) index % 10;
+    tile.v = (unsigned int) index / 10;
+    return tile;
+}
+
+// Remove the nodes of a graph which are not upstream of any of its outputs.
+void removeUnusedNodes(NodeGraphPtr graph)
+{
+    std::set<string> usedNodes;
+    for (OutputPtr output : graph->getOutputs())
+    {
+        for (Edge edge : output->traverseGraph())
+        {
+            ElementPtr upstream = edge.getUpstreamElement();
+            if (upstream && upstream->isA<Node>() && upstream->getParent() == graph)
+            {
+                usedNodes.insert(upstream->getName());
+            }
+        }
+    }
+    for (NodePtr node : graph->getNodes())
+    {
+        if (!usedNodes.count(node->getName()))
+        {
+            graph->removeNode(node->getName());
+        }
+    }
+}
+
+} // anonymous namespace
+
+//
+// TextureBaker methods
+//
+
+TextureBaker::TextureBaker(GenContextPtr context, ImageHandlerPtr imageHandler) :
+    _context(context),
+    _imageHandler(imageHandler),
+    _imageLoader(StbImageLoader::create()),
+    _width(DEFAULT_RESOLUTION),
+    _height(DEFAULT_RESOLUTION),
+    _outputPath(FilePath::getCurrentPath()),
+    _threadCount(0)
+{
+}
+
+vector<OutputPtr> TextureBaker::findBakeableOutputs(DocumentPtr doc)
+{
+    vector<OutputPtr> outputs;
+    std::set<OutputPtr> found;
+    for (MaterialPtr material : doc->getMaterials())
+    {
+        for (ShaderRefPtr shaderRef : material->getShaderRefs())
+        {
+            for (BindInputPtr bindInput : shaderRef->getBindInputs())
+            {
+                OutputPtr output = bindInput->getConnectedOutput();
+                NodeGraphPtr graph = output ? output->getParent()->asA<NodeGraph>() : nullptr;
+                if (graph && !graph->hasNodeDefString() && !found.count(output))
+                {
+                    found.insert(output);
+                    outputs.push_back(output);
+                }
+            }
+        }
+    }
+    return outputs;
+}
+
+vector<TextureBaker::BakedOutput> TextureBaker::bake(const vector<OutputPtr>& outputs)
+{
+    vector<Tile> tiles;
+    for (const string& udim : _udims)
+    {
+        tiles.push_back(parseUdim(udim));
+    }
+    if (tiles.empty())
+    {
+        tiles.push_back(Tile());
+    }
+    if (!_width || !_height)
+    {
+        throw Exception("Baked images must have a nonzero resolution");
+    }
+    if (!_outputPath.isEmpty() && !_outputPath.exists())
+    {
+        makeDirectory(_outputPath.asString());
+    }
+
+    // Create the evaluators on this thread, as the context may not be
+    // shared between threads.
+    vector<BakedOutput> results(outputs.size());
+    vector<CpuEvaluatorPtr> evaluators(outputs.size());
+    vector<bool> floatOutputs(outputs.size());
+    vector<std::pair<size_t, size_t>> jobs;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        BakedOutput& result = results[i];
+        result.output = outputs[i];
+
+        // Colors are baked to 8-bit images by default, and other values,
+        // which need not lie in the unit range, to floating-point images.
+        const TypeDesc* type = TypeDesc::get(outputs[i]->getType());
+        const bool isColor = type == Type::COLOR3 || type == Type::COLOR4;
+        string extension = _extension;
+        if (extension.empty())
+        {
+            extension = isColor ? ImageLoader::PNG_EXTENSION : ImageLoader::HDR_EXTENSION;
+        }
+        floatOutputs[i] = extension == ImageLoader::HDR_EXTENSION;
+        if (isColor)
+        {
+            const string& targetColorSpace = _context->getOptions().targetColorSpaceOverride;
+            result.colorSpace = targetColorSpace.empty() ? outputs[i]->getDocument()->getActiveColorSpace() : targetColorSpace;
+        }
+
+        const string baseName = createValidName(outputs[i]->getParent()->getName() + "_" + outputs[i]->getName());
+        const string tileToken = _udims.empty() ? EMPTY_STRING : "." + UDIM_TOKEN;
+        result.fileName = (_outputPath / FilePath(baseName + tileToken + "." + extension)).asString();
+        try
+        {
+            evaluators[i] = CpuEvaluator::create(outputs[i], *_context, _imageHandler);
+        }
+        catch (std::exception& e)
+        {
+            result.errors.push_back(e.what());
+            continue;
+        }
+        for (size_t t = 0; t < tiles.size(); t++)
+        {
+            jobs.push_back(std::make_pair(i, t));
+        }
+    }
+    if (jobs.empty())
+    {
+        return results;
+    }
+
+    // Evaluate and write each tile of each output as a separate job.
+    std::mutex errorMutex;
+    std::atomic<size_t> nextJob(0);
+    auto runJobs = [&]()
+    {
+        ShadingPoints points;
+        vector<float> values;
+        for (size_t j = nextJob++; j < jobs.size(); j = nextJob++)
+        {
+            BakedOutput& result = results[jobs[j].first];
+            const CpuEvaluator& evaluator = *evaluators[jobs[j].first];
+            const Tile& tile = tiles[jobs[j].second];
+            const size_t channelCount = evaluator.getChannelCount();
+            const bool isFloat = floatOutputs[jobs[j].first];
+            bool clamped = false;
+
+            vector<float> floatTexels;
+            vector<unsigned char> byteTexels;
+            const size_t texelCount = (size_t) _width * _height * 4;
+            if (isFloat)
+            {
+                floatTexels.resize(texelCount);
+            }
+            else
+            {
+                byteTexels.resize(texelCount);
+            }
+
+            for (unsigned int y0 = 0; y0 < _height; y0 += ROWS_PER_BAND)
+            {
+                const unsigned int y1 = std::min(y0 + ROWS_PER_BAND, _height);
+                points.resize(0);
+                points.resize((size_t) _width * (y1 - y0));
+                for (unsigned int y = y0; y < y1; y++)
+                {
+                    for (unsigned int x = 0; x < _width; x++)
+                    {
+                        const size_t i = (size_t) (y - y0) * _width + x;
+                        points.texcoord[0][i] = points.position[0][i] = tile.u + (x + 0.5f) / _width;
+                        points.texcoord[1][i] = points.position[1][i] = tile.v + (y + 0.5f) / _height;
+                    }
+                }
+                evaluator.evaluate(points, values);
+
+                for (unsigned int y = y0; y < y1; y++)
+                {
+                    // The image loaders place the top row of 8-bit images at
+                    // the top of the texture, and the first row of HDR images
+                    // at the bottom, so rows are written to match.
+                    const size_t row = isFloat ? y : _height - 1 - y;
+                    for (unsigned int x = 0; x < _width; x++)
+                    {
+                        const float* value = &values[((size_t) (y - y0) * _width + x) * channelCount];
+                        const size_t texel = (row * _width + x) * 4;
+                        for (size_t c = 0; c < 4; c++)
+                        {
+                            // Scalars fill the color channels, and other
+                            // values are padded with zero and an alpha of one.
+                            float channel = c < channelCount ? value[c] : (c == 3 ? 1.0f : 0.0f);
+                            channel = channelCount == 1 && c < 3 ? value[0] : channel;
+                            if (isFloat)
+                            {
+                                floatTexels[texel + c] = channel;
+                            }
+                            else
+                            {
+                                clamped = clamped || channel < 0.0f || channel > 1.0f;
+                                byteTexels[texel + c] = (unsigned char) (std::max(0.0f, std::min(channel, 1.0f)) * 255.0f + 0.5f);
+                            }
+                        }
+                    }
+                }
+            }
+
+            ImageDesc desc;
+            desc.width = _width;
+            desc.height = _height;
+            desc.channelCount = 4;
+            desc.floatingPoint = isFloat;
+            desc.resourceBuffer = isFloat ? (void*) floatTexels.data() : (void*) byteTexels.data();
+            const string filePath = replaceSubstrings(result.fileName, { { UDIM_TOKEN, tile.udim } });
+            if (!_imageLoader || !_imageLoader->saveImage(FilePath(filePath), desc))
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                result.errors.push_back("Failed to write image " + filePath);
+            }
+            else if (clamped)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                result.warnings.push_back("Values outside the unit range were clamped in 8-bit image " + filePath);
+            }
+        }
+    };
+
+    unsigned int threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = (unsigned int) std::min((size_t) threadCount, jobs.size());
+    vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++)
+    {
+        threads.push_back(std::thread(runJobs));
+    }
+    runJobs();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+vector<TextureBaker::BakedOutput> TextureBaker::bakeDocument(DocumentPtr doc)
+{
+    vector<BakedOutput> results = bake(findBakeableOutputs(doc));
+    for (const BakedOutput& result : results)
+    {
+        if (result.errors.empty())
+        {
+            replaceWithImage(result);
+        }
+    }
+    return results;
+}
+
+void TextureBaker::replaceWithImage(const BakedOutput& bakedOutput)
+{
+    OutputPtr output = bakedOutput.output;
+    NodeGraphPtr graph = output->getParent()->asA<NodeGraph>();
+    if (!graph)
+    {
+        throw Exception("Output '" + output->getNamePath() + "' is not within a node graph");
+    }
+
+    NodePtr image = graph->addNode("image", graph->createValidChildName(output->getName() + "_baked"), output->getType());
+    ParameterPtr file = image->setParameterValue("file", bakedOutput.fileName, FILENAME_TYPE_STRING);
+    if (!bakedOutput.colorSpace.empty())
+    {
+        file->setColorSpace(bakedOutput.colorSpace);
+    }
+    output->removeAttribute(PortElement::OUTPUT_ATTRIBUTE);
+    output->setConnectedNode(image);
+    removeUnusedNodes(graph);
+}
+
+} // namespace MaterialX
@@ -0,0 +1,193 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_TEXTUREBAKER_H
+#define MATERIALX_TEXTUREBAKER_H
+
+/// @file
+/// Baking of node graph outputs to textures
+
+#include <MaterialXRender/Evaluators/CpuEvaluator.h>
+
+#include <MaterialXCore/Document.h>
+
+namespace MaterialX
+{
+
+/// Shared pointer to a TextureBaker
+using TextureBakerPtr = std::shared_ptr<class TextureBaker>;
+
+/// @class TextureBaker
+/// Bakes node graph outputs to image files in texture space, and rewrites
+/// documents to read the baked images in place of the graphs.
+///
+/// Each output is evaluated with a CpuEvaluator over a grid of points at the
+/// center of each texel of each UDIM tile, so that baking requires no GPU.
+/// The tiles of all outputs are evaluated and written in parallel.
+///
+class TextureBaker
+{
+  public:
+    /// The outcome of baking an output
+    struct BakedOutput
+    {
+        /// Baked output
+        OutputPtr output;
+        /// File name of the baked images, as referenced by the rewritten
+        /// document. Contains the UDIM token when baking to UDIM tiles.
+        string fileName;
+        /// Color space of the baked values, for color outputs. Empty for
+        /// other outputs.
+        string colorSpace;
+        /// Errors from baking the output. Empty if baking succeeded.
+        StringVec errors;
+        /// Warnings from baking the output, such as values which were
+        /// clamped to the range of 8-bit images.
+        StringVec warnings;
+    };
+
+    /// Create a texture baker
+    /// @param context Context of the shader generator whose node
+    ///    implementations are used to evaluate outputs
+    /// @param imageHandler Handler whose loaders are used to read file
+    ///    textures within baked graphs
+    static TextureBakerPtr create(GenContextPtr context, ImageHandlerPtr imageHandler = nullptr)
+    {
+        return std::make_shared<TextureBaker>(context, imageHandler);
+    }
+
+    /// Constructor
+    TextureBaker(GenContextPtr context, ImageHandlerPtr imageHandler = nullptr);
+
+    /// Destructor
+    virtual ~TextureBaker() { }
+
+    /// Set the width and height in texels of each baked image. Defaults to
+    /// 1024 by 1024.
+    void setResolution(unsigned int width, unsigned int height)
+    {
+        _width = width;
+        _height = height;
+    }
+
+    /// Return the width in texels of each baked image.
+    unsigned int getWidth() const
+    {
+        return _width;
+    }
+
+    /// Return the height in texels of each baked image.
+    unsigned int getHeight() const
+    {
+        return _height;
+    }
+
+    /// Set the UDIM tiles to bake, such as "1001" and "1002". If empty, the
+    /// single tile covering the unit square is baked to an image without a
+    /// UDIM token. Defaults to empty.
+    void setUdims(const StringVec& udims)
+    {
+        _udims = udims;
+    }
+
+    /// Return the UDIM tiles to bake.
+    const StringVec& getUdims() const
+    {
+        return _udims;
+    }
+
+    /// Set the directory to which baked images are written. Defaults to the
+    /// current directory.
+    void setOutputPath(const FilePath& outputPath)
+    {
+        _outputPath = outputPath;
+    }
+
+    /// Return the directory to which baked images are written.
+    const FilePath& getOutputPath() const
+    {
+        return _outputPath;
+    }
+
+    /// Set the extension of baked images, which selects their format. PNG
+    /// images hold eight bits per channel, clamped to the unit range, and
+    /// HDR images hold unclamped floats. If empty, color outputs are baked
+    /// to PNG images and other outputs to HDR images. Defaults to empty.
+    void setFileExtension(const string& extension)
+    {
+        _extension = extension;
+    }
+
+    /// Return the extension of baked images, or an empty string if it is
+    /// chosen by the type of each output.
+    const string& getFileExtension() const
+    {
+        return _extension;
+    }
+
+    /// Set the loader used to write baked images. Defaults to an
+    /// StbImageLoader.
+    void setImageLoader(ImageLoaderPtr imageLoader)
+    {
+        _imageLoader = imageLoader;
+    }
+
+    /// Return the loader used to write baked images.
+    ImageLoaderPtr getImageLoader() const
+    {
+        return _imageLoader;
+    }
+
+    /// Set the number of threads used to evaluate and write tiles. A value
+    /// of zero uses one thread per hardware thread. Defaults to zero.
+    void setThreadCount(unsigned int threadCount)
+    {
+        _threadCount = threadCount;
+    }
+
+    /// Return the number of threads used to evaluate and write tiles.
+    unsigned int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /// Return the node graph outputs which are bound to the inputs of shader
+    /// references in the given document, each listed once.
+    static vector<OutputPtr> findBakeableOutputs(DocumentPtr doc);
+
+    /// Bake the given node graph outputs to images, leaving their documents
+    /// unchanged.
+    /// @param outputs Outputs to bake
+    /// @return The outcome for each output, in the order given
+    vector<BakedOutput> bake(const vector<OutputPtr>& outputs);
+
+    /// Bake the bakeable outputs of a document, and rewrite the document so
+    /// that each output which was baked reads its images. Nodes which no
+    /// longer contribute to any output are removed.
+    /// @param doc Document to bake and rewrite
+    /// @return The outcome for each bakeable output
+    vector<BakedOutput> bakeDocument(DocumentPtr doc);
+
+    /// Rewrite a baked output to read its images through a new image node,
+    /// whose file takes the color space of the baked values. Nodes of its
+    /// graph which no longer contribute to any output of the graph are
+    /// removed.
+    static void replaceWithImage(const BakedOutput& bakedOutput);
+
+  protected:
+    GenContextPtr _context;
+    ImageHandlerPtr _imageHandler;
+    ImageLoaderPtr _imageLoader;
+    unsigned int _width;
+    unsigned int _height;
+    StringVec _udims;
+    FilePath _outputPath;
+    string _extension;
+    unsigned int _threadCount;
+};
+
+} // namespace MaterialX
+
+#endif
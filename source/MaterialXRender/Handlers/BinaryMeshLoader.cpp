@@ -0,0 +1,449 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Handlers/BinaryMeshLoader.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace MaterialX
+{
+const string BinaryMeshLoader::EXTENSION = "mxmesh";
+
+namespace
+{
+
+const char FILE_MAGIC[8] = { 'M', 'X', 'M', 'E', 'S', 'H', '\0', '\0' };
+const uint32_t FILE_VERSION = 2;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t sourceStamp;
+    uint32_t meshCount;
+    uint32_t reserved;
+};
+
+// Return a stamp identifying the current version of a file on disk, combining
+// its size and modification time, or zero if the file cannot be found.
+uint64_t getSourceStamp(const FilePath& filePath)
+{
+#if defined(_WIN32)
+    struct _stat64 sb;
+    if (_stat64(filePath.asString().c_str(), &sb) != 0)
+    {
+        return 0;
+    }
+#else
+    struct stat sb;
+    if (stat(filePath.asString().c_str(), &sb) != 0)
+    {
+        return 0;
+    }
+#endif
+    uint64_t stamp = (uint64_t) sb.st_size;
+    stamp ^= (uint64_t) sb.st_mtime * 0x9E3779B97F4A7C15ull;
+    return stamp ? stamp : 1;
+}
+
+size_t alignOffset(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+// Sequential writer into a memory buffer
+class BufferWriter
+{
+  public:
+    void write(const void* data, size_t size)
+    {
+        if (size)
+        {
+            const char* bytes = static_cast<const char*>(data);
+            _buffer.insert(_buffer.end(), bytes, bytes + size);
+        }
+    }
+
+    template<class T> void write(const T& value)
+    {
+        write(&value, sizeof(T));
+    }
+
+    void writeString(const string& str)
+    {
+        write((uint32_t) str.size());
+        write(str.data(), str.size());
+        align(sizeof(uint32_t));
+    }
+
+    void align(size_t alignment)
+    {
+        _buffer.resize(alignOffset(_buffer.size(), alignment), 0);
+    }
+
+    const vector<char>& getBuffer() const
+    {
+        return _buffer;
+    }
+
+  private:
+    vector<char> _buffer;
+};
+
+// Sequential, bounds-checked reader from a memory buffer
+class BufferReader
+{
+  public:
+    BufferReader(const vector<char>& buffer) :
+        _buffer(buffer),
+        _offset(0)
+    {
+    }
+
+    bool read(void* data, size_t size)
+    {
+        if (size > _buffer.size() - _offset)
+        {
+            return false;
+        }
+        if (size)
+        {
+            std::memcpy(data, &_buffer[_offset], size);
+            _offset += size;
+        }
+        return true;
+    }
+
+    template<class T> bool read(T& value)
+    {
+        return read(&value, sizeof(T));
+    }
+
+    bool readString(string& str)
+    {
+        uint32_t length = 0;
+        if (!read(length) || length > _buffer.size() - _offset)
+        {
+            return false;
+        }
+        str.assign(_buffer.data() + _offset, length);
+        _offset += length;
+        return align(sizeof(uint32_t));
+    }
+
+    bool align(size_t alignment)
+    {
+        size_t offset = alignOffset(_offset, alignment);
+        if (offset > _buffer.size())
+        {
+            return false;
+        }
+        _offset = offset;
+        return true;
+    }
+
+  private:
+    const vector<char>& _buffer;
+    size_t _offset;
+};
+
+bool readVector3(BufferReader& reader, Vector3& vec)
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        if (!reader.read(vec[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeVector3(BufferWriter& writer, const Vector3& vec)
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        writer.write(vec[i]);
+    }
+}
+
+} // anonymous namespace
+
+bool BinaryMeshLoader::load(const FilePath& filePath, MeshList& meshList)
+{
+    return read(filePath, meshList, nullptr, nullptr);
+}
+
+bool BinaryMeshLoader::save(const FilePath& filePath, const MeshList& meshList)
+{
+    return write(filePath, meshList, 0, EMPTY_STRING);
+}
+
+bool BinaryMeshLoader::loadCache(const FilePath& cachePath, const FilePath& sourcePath, const string& cacheKey, MeshList& meshList)
+{
+    uint64_t sourceStamp = getSourceStamp(sourcePath);
+    if (!sourceStamp)
+    {
+        return false;
+    }
+    return read(cachePath, meshList, &sourceStamp, &cacheKey);
+}
+
+bool BinaryMeshLoader::saveCache(const FilePath& cachePath, const FilePath& sourcePath, const string& cacheKey, const MeshList& meshList)
+{
+    uint64_t sourceStamp = getSourceStamp(sourcePath);
+    if (!sourceStamp)
+    {
+        return false;
+    }
+    return write(cachePath, meshList, sourceStamp, cacheKey);
+}
+
+bool BinaryMeshLoader::read(const FilePath& filePath, MeshList& meshList, const uint64_t* sourceStamp, const string* cacheKey)
+{
+    std::ifstream file(filePath.asString(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    std::streamoff fileSize = file.tellg();
+    if (fileSize < (std::streamoff) sizeof(FileHeader))
+    {
+        return false;
+    }
+    vector<char> buffer((size_t) fileSize);
+    file.seekg(0, std::ios::beg);
+    if (!file.read(buffer.data(), fileSize))
+    {
+        return false;
+    }
+
+    BufferReader reader(buffer);
+    FileHeader header;
+    reader.read(header);
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.version != FILE_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK)
+    {
+        return false;
+    }
+    if (sourceStamp && header.sourceStamp != *sourceStamp)
+    {
+        return false;
+    }
+    string fileCacheKey;
+    if (!reader.readString(fileCacheKey) || (cacheKey && fileCacheKey != *cacheKey))
+    {
+        return false;
+    }
+
+    // Read into a local list so that a truncated file leaves the
+    // caller's list untouched.
+    MeshList loadedMeshes;
+    for (uint32_t m = 0; m < header.meshCount; m++)
+    {
+        string identifier;
+        uint64_t vertexCount = 0;
+        Vector3 minimumBounds, maximumBounds, sphereCenter;
+        float sphereRadius = 0.0f;
+        uint32_t streamCount = 0;
+        uint32_t partitionCount = 0;
+        if (!reader.readString(identifier) ||
+            !reader.read(vertexCount) ||
+            !readVector3(reader, minimumBounds) ||
+            !readVector3(reader, maximumBounds) ||
+            !readVector3(reader, sphereCenter) ||
+            !reader.read(sphereRadius) ||
+            !reader.read(streamCount) ||
+            !reader.read(partitionCount))
+        {
+            return false;
+        }
+
+        MeshPtr mesh = Mesh::create(identifier);
+        mesh->setSourceUri(filePath);
+        mesh->setVertexCount((size_t) vertexCount);
+        mesh->setMinimumBounds(minimumBounds);
+        mesh->setMaximumBounds(maximumBounds);
+        mesh->setSphereCenter(sphereCenter);
+        mesh->setSphereRadius(sphereRadius);
+
+        for (uint32_t s = 0; s < streamCount; s++)
+        {
+            string name, type;
+            uint32_t index = 0;
+            uint32_t stride = 0;
+            uint64_t floatCount = 0;
+            if (!reader.readString(name) ||
+                !reader.readString(type) ||
+                !reader.read(index) ||
+                !reader.read(stride) ||
+                !reader.read(floatCount) ||
+                !reader.align(BLOCK_ALIGNMENT) ||
+                floatCount > buffer.size() / sizeof(float) ||
+                floatCount < vertexCount * stride)
+            {
+                return false;
+            }
+
+            MeshStreamPtr stream = MeshStream::create(name, type, index);
+            stream->setStride(stride);
+            MeshFloatBuffer& data = stream->getData();
+            data.resize((size_t) floatCount);
+            if (!reader.read(data.data(), data.size() * sizeof(float)) ||
+                !reader.align(BLOCK_ALIGNMENT))
+            {
+                return false;
+            }
+            mesh->addStream(stream);
+        }
+
+        for (uint32_t p = 0; p < partitionCount; p++)
+        {
+            string partIdentifier;
+            uint64_t faceCount = 0;
+            uint64_t indexCount = 0;
+            if (!reader.readString(partIdentifier) ||
+                !reader.read(faceCount) ||
+                !reader.read(indexCount) ||
+                !reader.align(BLOCK_ALIGNMENT) ||
+                indexCount > buffer.size() / sizeof(uint32_t))
+            {
+                return false;
+            }
+
+            MeshPartitionPtr part = MeshPartition::create();
+            part->setIdentifier(partIdentifier);
+            part->setFaceCount((size_t) faceCount);
+            MeshIndexBuffer& indices = part->getIndices();
+            indices.resize((size_t) indexCount);
+            if (!reader.read(indices.data(), indices.size() * sizeof(uint32_t)) ||
+                !reader.align(BLOCK_ALIGNMENT))
+            {
+                return false;
+            }
+
+            // Reject corrupt indices, which would address past the streams.
+            for (uint32_t index : indices)
+            {
+                if (index >= vertexCount)
+                {
+                    return false;
+                }
+            }
+            mesh->addPartition(part);
+        }
+
+        loadedMeshes.push_back(mesh);
+    }
+
+    meshList.insert(meshList.end(), loadedMeshes.begin(), loadedMeshes.end());
+    return true;
+}
+
+bool BinaryMeshLoader::write(const FilePath& filePath, const MeshList& meshList, uint64_t sourceStamp, const string& cacheKey)
+{
+    BufferWriter writer;
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.sourceStamp = sourceStamp;
+    header.meshCount = (uint32_t) meshList.size();
+    header.reserved = 0;
+    writer.write(header);
+    writer.writeString(cacheKey);
+
+    for (MeshPtr mesh : meshList)
+    {
+        writer.writeString(mesh->getIdentifier());
+        writer.write((uint64_t) mesh->getVertexCount());
+        writeVector3(writer, mesh->getMinimumBounds());
+        writeVector3(writer, mesh->getMaximumBounds());
+        writeVector3(writer, mesh->getSphereCenter());
+        writer.write(mesh->getSphereRadius());
+        writer.write((uint32_t) mesh->getStreams().size());
+        writer.write((uint32_t) mesh->getPartitionCount());
+
+        for (MeshStreamPtr stream : mesh->getStreams())
+        {
+            const MeshFloatBuffer& data = stream->getData();
+            writer.writeString(stream->getName());
+            writer.writeString(stream->getType());
+            writer.write((uint32_t) stream->getIndex());
+            writer.write((uint32_t) stream->getStride());
+            writer.write((uint64_t) data.size());
+            writer.align(BLOCK_ALIGNMENT);
+            writer.write(data.data(), data.size() * sizeof(float));
+            writer.align(BLOCK_ALIGNMENT);
+        }
+
+        for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+        {
+            MeshPartitionPtr part = mesh->getPartition(p);
+            const MeshIndexBuffer& indices = part->getIndices();
+            writer.writeString(part->getIdentifier());
+            writer.write((uint64_t) part->getFaceCount());
+            writer.write((uint64_t) indices.size());
+            writer.align(BLOCK_ALIGNMENT);
+            writer.write(indices.data(), indices.size() * sizeof(uint32_t));
+            writer.align(BLOCK_ALIGNMENT);
+        }
+    }
+
+    // Write under a name unique to this process and thread, then move into
+    // place, so that concurrent readers never see a partially written file.
+#if defined(_WIN32)
+    const long processId = (long) _getpid();
+#else
+    const long processId = (long) getpid();
+#endif
+    const string path = filePath.asString();
+    const string tempPath = path + "." + std::to_string(processId) + "." +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        const vector<char>& buffer = writer.getBuffer();
+        file.write(buffer.data(), buffer.size());
+        if (!file.good())
+        {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+#if defined(_WIN32)
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace MaterialX
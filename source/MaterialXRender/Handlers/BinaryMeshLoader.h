@@ -0,0 +1,86 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_BINARYMESHLOADER_H
+#define MATERIALX_BINARYMESHLOADER_H
+
+/// @file
+/// Binary mesh cache format loader
+
+#include <MaterialXRender/Handlers/GeometryHandler.h>
+
+namespace MaterialX
+{
+/// Shared pointer to a BinaryMeshLoader
+using BinaryMeshLoaderPtr = std::shared_ptr<class BinaryMeshLoader>;
+
+/// @class BinaryMeshLoader
+/// Geometry loader for a compact binary mesh format which stores mesh streams
+/// and partitions directly, so that they can be read back without any parsing
+/// or attribute generation.
+///
+/// All data blocks in the file are aligned to BLOCK_ALIGNMENT bytes relative to the
+/// start of the file, so that a memory mapped file may be used in place.
+///
+class BinaryMeshLoader : public GeometryLoader
+{
+  public:
+    /// File extension for the binary mesh format
+    static const string EXTENSION;
+
+    /// Byte alignment of each data block in the file
+    static const size_t BLOCK_ALIGNMENT = 16;
+
+    /// Static instance create function
+    static BinaryMeshLoaderPtr create() { return std::make_shared<BinaryMeshLoader>(); }
+
+    /// Default constructor
+    BinaryMeshLoader()
+    {
+        _extensions = { EXTENSION };
+    }
+
+    /// Default destructor
+    virtual ~BinaryMeshLoader() {}
+
+    /// Load geometry from disk
+    bool load(const FilePath& filePath, MeshList& meshList) override;
+
+    /// Save geometry to disk
+    bool save(const FilePath& filePath, const MeshList& meshList) override;
+
+    /// Load geometry from a cache file, if the cache was written from the
+    /// current version of the given source file with the given cache key.
+    /// @param cachePath Path to the binary cache file
+    /// @param sourcePath Path to the source file the cache was created from
+    /// @param cacheKey Key identifying how the meshes were produced from the
+    ///    source file, such as the loader and optimizer which were used
+    /// @param meshList List of meshes to update
+    /// @return True if the cache was valid and loaded successfully
+    bool loadCache(const FilePath& cachePath, const FilePath& sourcePath, const string& cacheKey, MeshList& meshList);
+
+    /// Save geometry to a cache file, recording the current version of the given
+    /// source file and the given cache key so that stale caches can be detected
+    /// on load. The file is written under a temporary name and then moved into
+    /// place, so that readers never see a partially written cache.
+    /// @param cachePath Path to the binary cache file
+    /// @param sourcePath Path to the source file the meshes were loaded from
+    /// @param cacheKey Key identifying how the meshes were produced from the
+    ///    source file
+    /// @param meshList List of meshes to write
+    /// @return True if the cache was written successfully
+    bool saveCache(const FilePath& cachePath, const FilePath& sourcePath, const string& cacheKey, const MeshList& meshList);
+
+  protected:
+    /// Read meshes from a file, optionally requiring a given source stamp
+    /// and cache key.
+    bool read(const FilePath& filePath, MeshList& meshList, const uint64_t* sourceStamp, const string* cacheKey);
+
+    /// Write meshes to a file with the given source stamp and cache key.
+    bool write(const FilePath& filePath, const MeshList& meshList, uint64_t sourceStamp, const string& cacheKey);
+};
+
+} // namespace MaterialX
+#endif
@@ -5,6 +5,9 @@
 
 #include <MaterialXGenShader/Util.h>
 #include <MaterialXRender/Handlers/GeometryHandler.h>
+#include <MaterialXRender/Handlers/BinaryMeshLoader.h>
+
+#include <limits>
 
 namespace MaterialX
 {
@@ -82,15 +85,36 @@ bool GeometryHandler::loadGeometry(const FilePath& filePath)
     if (hasGeometry(filePath))
         return true;
 
+    // Use the sidecar cache if it is valid for the current source file
+    bool useCache = _meshCacheEnabled &&
+                    MaterialX::getFileExtension(filePath) != BinaryMeshLoader::EXTENSION;
+    FilePath cachePath = getMeshCachePath(filePath);
+    string cacheKey = useCache ? getMeshCacheKey(MaterialX::getFileExtension(filePath)) : EMPTY_STRING;
+    useCache = useCache && !cacheKey.empty();
+    size_t firstMesh = _meshes.size();
+    if (useCache)
+    {
+        BinaryMeshLoader cacheLoader;
+        if (cacheLoader.loadCache(cachePath, filePath, cacheKey, _meshes))
+        {
+            for (size_t i = firstMesh; i < _meshes.size(); i++)
+            {
+                _meshes[i]->setSourceUri(filePath);
+            }
+            computeBounds();
+            return true;
+        }
+    }
+
     bool loaded = false;
 
     std::pair <GeometryLoaderMap::iterator, GeometryLoaderMap::iterator> range;
     string extension = MaterialX::getFileExtension(filePath);
     range = _geometryLoaders.equal_range(extension);
-    GeometryLoaderMap::iterator first = --range.second;
-    GeometryLoaderMap::iterator last = --range.first;
-    for (auto it = first; it != last; --it)
+    for (auto it = range.second; it != range.first; )
     {
+        // Loaders added last take precedence
+        --it;
         loaded = it->second->load(filePath, _meshes);
         if (loaded)
         {
@@ -101,10 +125,65 @@ bool GeometryHandler::loadGeometry(const FilePath& filePath)
     // Recompute bounds if load was successful
     if (loaded)
     {
+        if (_meshOptimizer)
+        {
+            for (size_t i = firstMesh; i < _meshes.size(); i++)
+            {
+                _meshOptimizer->optimize(_meshes[i]);
+            }
+        }
+
         computeBounds();
+
+        // Write the sidecar cache for subsequent loads
+        if (useCache)
+        {
+            MeshList loadedMeshes(_meshes.begin() + firstMesh, _meshes.end());
+            BinaryMeshLoader cacheLoader;
+            cacheLoader.saveCache(cachePath, filePath, cacheKey, loadedMeshes);
+        }
     }
 
     return loaded;
 }
 
+bool GeometryHandler::saveGeometry(const FilePath& filePath, const MeshList& meshList)
+{
+    std::pair <GeometryLoaderMap::iterator, GeometryLoaderMap::iterator> range;
+    string extension = MaterialX::getFileExtension(filePath);
+    range = _geometryLoaders.equal_range(extension);
+    for (auto it = range.second; it != range.first; )
+    {
+        --it;
+        if (it->second->save(filePath, meshList))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+FilePath GeometryHandler::getMeshCachePath(const FilePath& filePath)
+{
+    return FilePath(filePath.asString() + "." + BinaryMeshLoader::EXTENSION);
+}
+
+string GeometryHandler::getMeshCacheKey(const string& extension) const
+{
+    // The loader added last takes precedence, so it identifies the cache.
+    auto range = _geometryLoaders.equal_range(extension);
+    if (range.first == range.second)
+    {
+        return EMPTY_STRING;
+    }
+    auto it = range.second;
+    --it;
+    string key = it->second->getCacheIdentifier();
+    if (_meshOptimizer)
+    {
+        key += "|" + _meshOptimizer->getCacheIdentifier();
+    }
+    return key;
+}
+
 }
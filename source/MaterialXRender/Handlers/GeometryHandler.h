@@ -10,9 +10,10 @@
 /// Geometry loader interfaces
 
 #include <MaterialXFormat/File.h>
-#include <MaterialXRender/Handlers/Mesh.h>
+#include <MaterialXRender/Handlers/MeshOptimizer.h>
 #include <memory>
 #include <map>
+#include <typeinfo>
 
 namespace MaterialX
 {
@@ -45,6 +46,25 @@ class GeometryLoader
     /// @return True if load was successful
     virtual bool load(const FilePath& filePath, MeshList& meshList) = 0;
 
+    /// Save geometry to disk. The default implementation does not support saving.
+    /// @param filePath Path to file to save
+    /// @param meshList List of meshes to save
+    /// @return True if save was successful
+    virtual bool save(const FilePath& /*filePath*/, const MeshList& /*meshList*/)
+    {
+        return false;
+    }
+
+    /// Return a string identifying the meshes this loader produces, which is
+    /// stored in sidecar mesh caches so that caches written by a different
+    /// loader are not reused. The default implementation returns the dynamic
+    /// type name of the loader; derived classes whose output depends on
+    /// settings should include those settings.
+    virtual string getCacheIdentifier() const
+    {
+        return typeid(*this).name();
+    }
+
   protected:
     /// List of supported string extensions
     StringVec _extensions;
@@ -63,7 +83,10 @@ class GeometryHandler
 {
   public:
     /// Default constructor
-    GeometryHandler() {};
+    GeometryHandler() :
+        _meshCacheEnabled(false)
+    {
+    }
 
     /// Default destructor
     virtual ~GeometryHandler() {};
@@ -84,9 +107,49 @@ class GeometryHandler
     /// Clear geometry with a given location
     void clearGeometry(const string& location);
 
-    /// Load geometry from a given location
+    /// Load geometry from a given location. If the mesh cache is enabled then
+    /// meshes are read from a valid sidecar cache file when one exists, and a
+    /// new cache file is written after loading from the source file otherwise.
     bool loadGeometry(const FilePath& filePath);
 
+    /// Save a list of meshes to a given location. The first loader which
+    /// supports the file extension and saving will be used.
+    /// @param filePath Path to file to save
+    /// @param meshList List of meshes to save
+    /// @return True if save was successful
+    bool saveGeometry(const FilePath& filePath, const MeshList& meshList);
+
+    /// Set whether a binary sidecar cache file is used when loading geometry.
+    /// Defaults to false.
+    void setMeshCacheEnabled(bool enabled)
+    {
+        _meshCacheEnabled = enabled;
+    }
+
+    /// Return true if a binary sidecar cache file is used when loading geometry.
+    bool getMeshCacheEnabled() const
+    {
+        return _meshCacheEnabled;
+    }
+
+    /// Return the path of the sidecar cache file for a given geometry file.
+    static FilePath getMeshCachePath(const FilePath& filePath);
+
+    /// Set an optimizer to be applied to each mesh after it is loaded from a
+    /// geometry loader. The optimizer is part of the sidecar cache key, so
+    /// meshes read from a cache were optimized with the same settings before
+    /// the cache was written, and are not optimized again. Defaults to null.
+    void setMeshOptimizer(MeshOptimizerPtr optimizer)
+    {
+        _meshOptimizer = optimizer;
+    }
+
+    /// Return the optimizer applied to each mesh after it is loaded.
+    MeshOptimizerPtr getMeshOptimizer() const
+    {
+        return _meshOptimizer;
+    }
+
     /// Get list of meshes
     const MeshList& getMeshes() const
     {
@@ -109,10 +172,17 @@ class GeometryHandler
     /// Recompute bounds for all stored geometry
     void computeBounds();
 
+    /// Return the key identifying sidecar caches for a given file extension,
+    /// combining the preferred loader and the mesh optimizer, or an empty
+    /// string if no loader supports the extension.
+    string getMeshCacheKey(const string& extension) const;
+
     GeometryLoaderMap _geometryLoaders;
     MeshList _meshes;
     Vector3 _minimumBounds;
     Vector3 _maximumBounds;
+    bool _meshCacheEnabled;
+    MeshOptimizerPtr _meshOptimizer;
 };
 
 } // namespace MaterialX
@@ -0,0 +1,591 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Handlers/ImageComparator.h>
+
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+
+#include <MaterialXGenShader/Util.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace MaterialX
+{
+
+namespace {
+
+const float DEFAULT_PERCEPTUAL_THRESHOLD = 2.3f;
+const float DEFAULT_DIFFERENCE_SCALE = 10.0f;
+
+// Number of rows compared together as a single job.
+const unsigned int ROWS_PER_BAND = 16;
+
+const string DIFFERENCE_SUFFIX = "_diff";
+
+// Error statistics accumulated over a band of rows.
+struct BandStatistics
+{
+    double squaredError[4] = { 0.0, 0.0, 0.0, 0.0 };
+    float maxError[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    double deltaE = 0.0;
+    float maxDeltaE = 0.0f;
+    size_t perceptibleCount = 0;
+};
+
+// Channels of a row of an image in structure-of-arrays layout.
+struct RowPlanes
+{
+    void resize(unsigned int width)
+    {
+        for (vector<float>& plane : value)
+        {
+            plane.resize(width);
+        }
+        for (vector<float>& plane : linear)
+        {
+            plane.resize(width);
+        }
+    }
+
+    // Channel values, normalized to the unit range for 8-bit images
+    vector<float> value[4];
+    // Linear RGB color
+    vector<float> linear[3];
+};
+
+float srgbToLinear(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+const float* getSrgbToLinearTable()
+{
+    struct Table
+    {
+        Table()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                values[i] = srgbToLinear(i / 255.0f);
+            }
+        }
+        float values[256];
+    };
+    static const Table table;
+    return table.values;
+}
+
+float labFunction(float t)
+{
+    const float DELTA = 6.0f / 29.0f;
+    return t > DELTA * DELTA * DELTA ? std::cbrt(t) : t / (3.0f * DELTA * DELTA) + 4.0f / 29.0f;
+}
+
+// Read a row of an image into planes, comparing the given number of channels.
+// Channel values are interpreted in the same way for 8-bit and floating-point
+// images, and decoded to linear color if they are sRGB-encoded.
+void readRow(const ImageDesc& image, unsigned int y, unsigned int channelCount, bool srgbEncoded, RowPlanes& planes)
+{
+    const unsigned int width = image.width;
+    const size_t stride = image.channelCount;
+    const size_t offset = (size_t) y * width * stride;
+    const unsigned int colorChannels = channelCount >= 3 ? 3 : 1;
+    if (image.floatingPoint)
+    {
+        const float* texels = (const float*) image.resourceBuffer + offset;
+        for (unsigned int c = 0; c < channelCount; c++)
+        {
+            float* value = planes.value[c].data();
+            for (unsigned int x = 0; x < width; x++)
+            {
+                value[x] = texels[x * stride + c];
+            }
+        }
+        for (unsigned int c = 0; c < colorChannels; c++)
+        {
+            const float* value = planes.value[c].data();
+            float* linear = planes.linear[c].data();
+            for (unsigned int x = 0; x < width; x++)
+            {
+                const float v = std::max(value[x], 0.0f);
+                linear[x] = srgbEncoded ? srgbToLinear(v) : v;
+            }
+        }
+    }
+    else
+    {
+        const unsigned char* texels = (const unsigned char*) image.resourceBuffer + offset;
+        for (unsigned int c = 0; c < channelCount; c++)
+        {
+            float* value = planes.value[c].data();
+            for (unsigned int x = 0; x < width; x++)
+            {
+                value[x] = texels[x * stride + c] * (1.0f / 255.0f);
+            }
+        }
+        for (unsigned int c = 0; c < colorChannels; c++)
+        {
+            float* linear = planes.linear[c].data();
+            if (srgbEncoded)
+            {
+                const float* srgbTable = getSrgbToLinearTable();
+                for (unsigned int x = 0; x < width; x++)
+                {
+                    linear[x] = srgbTable[texels[x * stride + c]];
+                }
+            }
+            else
+            {
+                std::copy(planes.value[c].begin(), planes.value[c].end(), linear);
+            }
+        }
+    }
+    if (colorChannels == 1)
+    {
+        planes.linear[1] = planes.linear[0];
+        planes.linear[2] = planes.linear[0];
+    }
+}
+
+// Convert a linear color with sRGB primaries to CIE L*a*b*, relative to a
+// D65 white point.
+void linearToLab(float r, float g, float b, float lab[3])
+{
+    const float fx = labFunction((0.4124f * r + 0.3576f * g + 0.1805f * b) / 0.9505f);
+    const float fy = labFunction(0.2126f * r + 0.7152f * g + 0.0722f * b);
+    const float fz = labFunction((0.0193f * r + 0.1192f * g + 0.9505f * b) / 1.0890f);
+    lab[0] = 116.0f * fy - 16.0f;
+    lab[1] = 500.0f * (fx - fy);
+    lab[2] = 200.0f * (fy - fz);
+}
+
+void checkImage(const ImageDesc& image, const string& label)
+{
+    if (!image.resourceBuffer || !image.width || !image.height || !image.channelCount)
+    {
+        throw Exception("The " + label + " image has no pixels to compare");
+    }
+}
+
+// Save an image held in the row order in which it was loaded, converting it
+// to floating-point for HDR files and to 8-bit otherwise. StbImageLoader
+// flips 8-bit images vertically on load but not on save, so their rows are
+// reversed before saving, and the image reads back as it was.
+bool saveLoadedImage(ImageLoaderPtr loader, const FilePath& filePath, const ImageDesc& image)
+{
+    const string path = filePath.asString();
+    const bool floatFile = path.substr(path.find_last_of('.') + 1) == ImageLoader::HDR_EXTENSION;
+    const size_t rowSize = (size_t) image.width * image.channelCount;
+    ImageDesc converted = image;
+    if (floatFile)
+    {
+        if (image.floatingPoint)
+        {
+            return loader->saveImage(filePath, image);
+        }
+        const unsigned char* texels = static_cast<const unsigned char*>(image.resourceBuffer);
+        vector<float> floats(rowSize * image.height);
+        for (size_t i = 0; i < floats.size(); i++)
+        {
+            floats[i] = texels[i] * (1.0f / 255.0f);
+        }
+        converted.floatingPoint = true;
+        converted.resourceBuffer = floats.data();
+        return loader->saveImage(filePath, converted);
+    }
+
+    vector<unsigned char> flipped(rowSize * image.height);
+    for (unsigned int y = 0; y < image.height; y++)
+    {
+        const size_t source = (size_t) (image.height - 1 - y) * rowSize;
+        unsigned char* row = &flipped[y * rowSize];
+        if (image.floatingPoint)
+        {
+            const float* texels = static_cast<const float*>(image.resourceBuffer) + source;
+            for (size_t i = 0; i < rowSize; i++)
+            {
+                row[i] = (unsigned char) (std::min(std::max(texels[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+            }
+        }
+        else
+        {
+            const unsigned char* texels = static_cast<const unsigned char*>(image.resourceBuffer) + source;
+            std::copy(texels, texels + rowSize, row);
+        }
+    }
+    converted.floatingPoint = false;
+    converted.resourceBuffer = flipped.data();
+    return loader->saveImage(filePath, converted);
+}
+
+} // anonymous namespace
+
+//
+// ImageDifference methods
+//
+
+float ImageDifference::getMaxRmse() const
+{
+    return rmse.empty() ? 0.0f : *std::max_element(rmse.begin(), rmse.end());
+}
+
+float ImageDifference::getMaxError() const
+{
+    return maxError.empty() ? 0.0f : *std::max_element(maxError.begin(), maxError.end());
+}
+
+ImageDesc ImageDifference::getDifferenceImageDesc() const
+{
+    ImageDesc desc;
+    if (!differenceImage.empty())
+    {
+        desc.width = width;
+        desc.height = height;
+        desc.channelCount = 4;
+        desc.floatingPoint = false;
+        desc.resourceBuffer = (void*) differenceImage.data();
+    }
+    return desc;
+}
+
+//
+// ImageComparator methods
+//
+
+ImageComparator::ImageComparator() :
+    _perceptualThreshold(DEFAULT_PERCEPTUAL_THRESHOLD),
+    _createDifferenceImage(false),
+    _differenceScale(DEFAULT_DIFFERENCE_SCALE),
+    _srgbEncoded(true),
+    _threadCount(0)
+{
+}
+
+ImageDifference ImageComparator::compare(const ImageDesc& image, const ImageDesc& reference) const
+{
+    checkImage(image, "compared");
+    checkImage(reference, "reference");
+    if (image.width != reference.width || image.height != reference.height)
+    {
+        throw Exception("Image resolution " + std::to_string(image.width) + "x" + std::to_string(image.height) +
+                        " differs from reference resolution " + std::to_string(reference.width) + "x" + std::to_string(reference.height));
+    }
+
+    const unsigned int width = image.width;
+    const unsigned int height = image.height;
+    const unsigned int channelCount = std::min(std::min(image.channelCount, reference.channelCount), 4u);
+
+    ImageDifference difference;
+    difference.width = width;
+    difference.height = height;
+    if (_createDifferenceImage)
+    {
+        difference.differenceImage.resize((size_t) width * height * 4);
+    }
+
+    // Compare bands of rows in parallel, and combine their statistics in
+    // order so that results do not depend on the number of threads.
+    const size_t bandCount = (height + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+    vector<BandStatistics> bands(bandCount);
+    std::atomic<size_t> nextBand(0);
+    auto compareBands = [&]()
+    {
+        RowPlanes imagePlanes, referencePlanes;
+        imagePlanes.resize(width);
+        referencePlanes.resize(width);
+        vector<float> deltaE(width);
+        for (size_t band = nextBand++; band < bandCount; band = nextBand++)
+        {
+            BandStatistics& stats = bands[band];
+            const unsigned int y0 = (unsigned int) band * ROWS_PER_BAND;
+            const unsigned int y1 = std::min(y0 + ROWS_PER_BAND, height);
+            for (unsigned int y = y0; y < y1; y++)
+            {
+                readRow(image, y, channelCount, _srgbEncoded, imagePlanes);
+                readRow(reference, y, channelCount, _srgbEncoded, referencePlanes);
+
+                for (unsigned int c = 0; c < channelCount; c++)
+                {
+                    const float* a = imagePlanes.value[c].data();
+                    const float* b = referencePlanes.value[c].data();
+                    float squaredError = 0.0f;
+                    float maxError = stats.maxError[c];
+                    for (unsigned int x = 0; x < width; x++)
+                    {
+                        const float d = a[x] - b[x];
+                        squaredError += d * d;
+                        maxError = std::max(maxError, std::abs(d));
+                    }
+                    stats.squaredError[c] += squaredError;
+                    stats.maxError[c] = maxError;
+                }
+
+                // Regression images mostly match, so the color conversion
+                // is skipped for pixels of equal color.
+                float rowDeltaE = 0.0f;
+                for (unsigned int x = 0; x < width; x++)
+                {
+                    const float r = imagePlanes.linear[0][x], g = imagePlanes.linear[1][x], b = imagePlanes.linear[2][x];
+                    const float rr = referencePlanes.linear[0][x], rg = referencePlanes.linear[1][x], rb = referencePlanes.linear[2][x];
+                    deltaE[x] = 0.0f;
+                    if (r != rr || g != rg || b != rb)
+                    {
+                        float lab[3], referenceLab[3];
+                        linearToLab(r, g, b, lab);
+                        linearToLab(rr, rg, rb, referenceLab);
+                        const float dl = lab[0] - referenceLab[0];
+                        const float da = lab[1] - referenceLab[1];
+                        const float db = lab[2] - referenceLab[2];
+                        deltaE[x] = std::sqrt(dl * dl + da * da + db * db);
+                    }
+                    rowDeltaE += deltaE[x];
+                }
+                stats.deltaE += rowDeltaE;
+                for (unsigned int x = 0; x < width; x++)
+                {
+                    stats.maxDeltaE = std::max(stats.maxDeltaE, deltaE[x]);
+                    stats.perceptibleCount += deltaE[x] > _perceptualThreshold ? 1 : 0;
+                }
+
+                if (_createDifferenceImage)
+                {
+                    unsigned char* texels = &difference.differenceImage[(size_t) y * width * 4];
+                    for (unsigned int c = 0; c < 3; c++)
+                    {
+                        const unsigned int source = channelCount >= 3 ? c : 0;
+                        const float* a = imagePlanes.value[source].data();
+                        const float* b = referencePlanes.value[source].data();
+                        for (unsigned int x = 0; x < width; x++)
+                        {
+                            const float scaled = std::min(std::abs(a[x] - b[x]) * _differenceScale, 1.0f);
+                            texels[x * 4 + c] = (unsigned char) (scaled * 255.0f + 0.5f);
+                        }
+                    }
+                    for (unsigned int x = 0; x < width; x++)
+                    {
+                        texels[x * 4 + 3] = 255;
+                    }
+                }
+            }
+        }
+    };
+
+    unsigned int threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = (unsigned int) std::min((size_t) threadCount, bandCount);
+    vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++)
+    {
+        threads.push_back(std::thread(compareBands));
+    }
+    compareBands();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    BandStatistics total;
+    for (const BandStatistics& stats : bands)
+    {
+        for (unsigned int c = 0; c < channelCount; c++)
+        {
+            total.squaredError[c] += stats.squaredError[c];
+            total.maxError[c] = std::max(total.maxError[c], stats.maxError[c]);
+        }
+        total.deltaE += stats.deltaE;
+        total.maxDeltaE = std::max(total.maxDeltaE, stats.maxDeltaE);
+        total.perceptibleCount += stats.perceptibleCount;
+    }
+    const double pixelCount = (double) width * height;
+    for (unsigned int c = 0; c < channelCount; c++)
+    {
+        difference.rmse.push_back((float) std::sqrt(total.squaredError[c] / pixelCount));
+        difference.maxError.push_back(total.maxError[c]);
+    }
+    difference.meanDeltaE = (float) (total.deltaE / pixelCount);
+    difference.maxDeltaE = total.maxDeltaE;
+    difference.perceptibleFraction = (float) (total.perceptibleCount / pixelCount);
+    return difference;
+}
+
+bool ImageComparator::isWithinTolerance(const ImageDifference& difference) const
+{
+    return difference.getMaxRmse() <= _tolerance.rmse &&
+           difference.getMaxError() <= _tolerance.maxError &&
+           difference.perceptibleFraction <= _tolerance.perceptibleFraction;
+}
+
+//
+// GoldenImageStore methods
+//
+
+GoldenImageStore::GoldenImageStore(const FilePath& rootPath, ImageLoaderPtr imageLoader) :
+    _rootPath(rootPath),
+    _imageLoader(imageLoader ? imageLoader : StbImageLoader::create()),
+    _comparator(ImageComparator::create()),
+    _extension(ImageLoader::PNG_EXTENSION),
+    _update(false)
+{
+}
+
+FilePath GoldenImageStore::getGoldenPath(const string& name) const
+{
+    return createFilePath(_rootPath, name + "." + _extension);
+}
+
+GoldenImageStore::Result GoldenImageStore::compare(const string& name, const ImageDesc& image) const
+{
+    return compareImage(name, image, [&](const FilePath& goldenPath)
+    {
+        makeParentDirectories(goldenPath);
+        return saveLoadedImage(_imageLoader, goldenPath, image);
+    });
+}
+
+GoldenImageStore::Result GoldenImageStore::compare(const string& name, const FilePath& imagePath) const
+{
+    ImageDesc image;
+    if (!_imageLoader->acquireImage(imagePath, image, false))
+    {
+        Result result;
+        result.status = FAILED;
+        result.message = "Failed to read image " + imagePath.asString();
+        return result;
+    }
+
+    // Golden images are updated by writing the image in the format of the
+    // store, which may differ from that of the image file.
+    Result result = compare(name, image);
+    free(image.resourceBuffer);
+    return result;
+}
+
+GoldenImageStore::Result GoldenImageStore::compareImage(const string& name, const ImageDesc& image,
+                                                        const std::function<bool(const FilePath&)>& writeGolden) const
+{
+    Result result;
+    const FilePath goldenPath = getGoldenPath(name);
+    auto update = [&](const string& reason)
+    {
+        if (writeGolden(goldenPath))
+        {
+            result.status = UPDATED;
+            result.message = reason + ", so it was written from the compared image: " + goldenPath.asString();
+        }
+        else
+        {
+            result.status = FAILED;
+            result.message = reason + ", and it could not be written: " + goldenPath.asString();
+        }
+    };
+
+    ImageDesc golden;
+    if (!goldenPath.exists() || !_imageLoader->acquireImage(goldenPath, golden, false))
+    {
+        const string reason = "No golden image was found for '" + name + "'";
+        if (_update)
+        {
+            update(reason);
+        }
+        else
+        {
+            result.status = MISSING;
+            result.message = reason + " at " + goldenPath.asString();
+        }
+        return result;
+    }
+
+    try
+    {
+        result.difference = _comparator->compare(image, golden);
+    }
+    catch (Exception& e)
+    {
+        free(golden.resourceBuffer);
+        if (_update)
+        {
+            update("The golden image for '" + name + "' could not be compared");
+        }
+        else
+        {
+            result.status = FAILED;
+            result.message = "Failed to compare with golden image " + goldenPath.asString() + ": " + e.what();
+        }
+        return result;
+    }
+
+    if (_comparator->isWithinTolerance(result.difference))
+    {
+        free(golden.resourceBuffer);
+        result.status = PASSED;
+        return result;
+    }
+    if (_update)
+    {
+        free(golden.resourceBuffer);
+        update("The golden image for '" + name + "' differs from the compared image");
+        return result;
+    }
+
+    std::ostringstream message;
+    message << "Image '" << name << "' differs from its golden image " << goldenPath.asString()
+            << ": RMSE " << result.difference.getMaxRmse()
+            << ", max error " << result.difference.getMaxError()
+            << ", mean delta E " << result.difference.meanDeltaE
+            << ", perceptible pixels " << result.difference.perceptibleFraction * 100.0f << "%";
+    result.status = FAILED;
+
+    if (!_differencePath.isEmpty())
+    {
+        ImageDifference difference = result.difference;
+        if (difference.differenceImage.empty())
+        {
+            ImageComparator comparator(*_comparator);
+            comparator.setCreateDifferenceImage(true);
+            difference = comparator.compare(image, golden);
+        }
+        const FilePath differencePath = createFilePath(_differencePath, name + DIFFERENCE_SUFFIX + "." + ImageLoader::PNG_EXTENSION);
+        makeParentDirectories(differencePath);
+        if (saveLoadedImage(_imageLoader, differencePath, difference.getDifferenceImageDesc()))
+        {
+            result.differencePath = differencePath;
+            message << ". Difference image: " << differencePath.asString();
+        }
+    }
+    free(golden.resourceBuffer);
+
+    result.message = message.str();
+    return result;
+}
+
+FilePath GoldenImageStore::createFilePath(const FilePath& directory, const string& name)
+{
+    FilePath path = directory;
+    for (const string& part : splitString(name, "/"))
+    {
+        path = path / FilePath(part);
+    }
+    return path;
+}
+
+void GoldenImageStore::makeParentDirectories(const FilePath& filePath)
+{
+    // Create each missing directory on the path, skipping the file itself.
+    const string path = filePath.asString(FilePath::FormatPosix);
+    for (size_t separator = path.find('/', 1); separator != string::npos; separator = path.find('/', separator + 1))
+    {
+        FilePath directory;
+        directory.assign(path.substr(0, separator), FilePath::FormatPosix);
+        if (!directory.exists())
+        {
+            makeDirectory(directory.asString());
+        }
+    }
+}
+
+} // namespace MaterialX
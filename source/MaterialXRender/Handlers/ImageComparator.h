@@ -0,0 +1,343 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_IMAGECOMPARATOR_H
+#define MATERIALX_IMAGECOMPARATOR_H
+
+/// @file
+/// Comparison of rendered images against reference images
+
+#include <MaterialXRender/Handlers/ImageHandler.h>
+
+#include <functional>
+
+namespace MaterialX
+{
+
+/// Shared pointer to an ImageComparator
+using ImageComparatorPtr = std::shared_ptr<class ImageComparator>;
+
+/// Shared pointer to a GoldenImageStore
+using GoldenImageStorePtr = std::shared_ptr<class GoldenImageStore>;
+
+/// @class ImageDifference
+/// The difference between an image and a reference image. Channel values of
+/// 8-bit images are normalized to the unit range before comparison, so that
+/// they compare directly with floating-point images.
+///
+class ImageDifference
+{
+  public:
+    /// Return the largest root mean square error over all channels.
+    float getMaxRmse() const;
+
+    /// Return the largest absolute error over all channels.
+    float getMaxError() const;
+
+    /// Return a description of the difference image. The description refers
+    /// to the buffer of this object, so must not outlive it.
+    ImageDesc getDifferenceImageDesc() const;
+
+    /// Root mean square error of each compared channel
+    vector<float> rmse;
+    /// Maximum absolute error of each compared channel
+    vector<float> maxError;
+
+    /// Mean CIE76 color difference (delta E) over all pixels
+    float meanDeltaE = 0.0f;
+    /// Maximum CIE76 color difference over all pixels
+    float maxDeltaE = 0.0f;
+    /// Fraction of pixels whose color difference is above the perceptual
+    /// threshold of the comparator
+    float perceptibleFraction = 0.0f;
+
+    /// Width of the compared images
+    unsigned int width = 0;
+    /// Height of the compared images
+    unsigned int height = 0;
+    /// Difference image, as 8-bit RGBA texels holding the scaled absolute
+    /// difference of each color channel. Empty unless requested from the
+    /// comparator.
+    vector<unsigned char> differenceImage;
+};
+
+/// @class ImageComparator
+/// Compares images held in ImageDesc buffers, returning per-channel error
+/// statistics and a perceptual color difference.
+///
+/// The perceptual metric is the CIE76 color difference (delta E) between the
+/// L*a*b* colors of corresponding pixels, so that a difference of about 2.3
+/// is just noticeable. Channel values are decoded to linear color in the same
+/// way for 8-bit and floating-point images, as set by setSrgbEncoded(). Comparisons are split into bands of rows
+/// which are processed in parallel, and each band is converted to
+/// structure-of-arrays layout so that the error loops can be vectorized.
+///
+class ImageComparator
+{
+  public:
+    /// Limits on the difference between images which compare as equal
+    struct Tolerance
+    {
+        /// Maximum root mean square error of any channel
+        float rmse = 0.01f;
+        /// Maximum absolute error of any channel at any pixel
+        float maxError = 1.0f;
+        /// Maximum fraction of pixels with a perceptible color difference
+        float perceptibleFraction = 0.01f;
+    };
+
+    /// Create an image comparator
+    static ImageComparatorPtr create()
+    {
+        return std::make_shared<ImageComparator>();
+    }
+
+    /// Constructor
+    ImageComparator();
+
+    /// Destructor
+    virtual ~ImageComparator() { }
+
+    /// Set the tolerance applied by isWithinTolerance().
+    void setTolerance(const Tolerance& tolerance)
+    {
+        _tolerance = tolerance;
+    }
+
+    /// Return the tolerance applied by isWithinTolerance().
+    const Tolerance& getTolerance() const
+    {
+        return _tolerance;
+    }
+
+    /// Set the color difference above which a pixel difference is counted as
+    /// perceptible. Defaults to 2.3, the just noticeable CIE76 difference.
+    void setPerceptualThreshold(float threshold)
+    {
+        _perceptualThreshold = threshold;
+    }
+
+    /// Return the color difference above which a pixel difference is
+    /// counted as perceptible.
+    float getPerceptualThreshold() const
+    {
+        return _perceptualThreshold;
+    }
+
+    /// Set whether comparisons create a difference image. Defaults to false.
+    void setCreateDifferenceImage(bool create)
+    {
+        _createDifferenceImage = create;
+    }
+
+    /// Return whether comparisons create a difference image.
+    bool getCreateDifferenceImage() const
+    {
+        return _createDifferenceImage;
+    }
+
+    /// Set the scale applied to absolute differences in difference images,
+    /// so that small differences are visible. Defaults to 10.
+    void setDifferenceScale(float scale)
+    {
+        _differenceScale = scale;
+    }
+
+    /// Return the scale applied to absolute differences in difference images.
+    float getDifferenceScale() const
+    {
+        return _differenceScale;
+    }
+
+    /// Set whether the channel values of compared images are sRGB-encoded,
+    /// rather than linear. This applies to 8-bit and floating-point images
+    /// alike, and affects only the perceptual metric. Defaults to true.
+    void setSrgbEncoded(bool srgbEncoded)
+    {
+        _srgbEncoded = srgbEncoded;
+    }
+
+    /// Return whether the channel values of compared images are sRGB-encoded.
+    bool getSrgbEncoded() const
+    {
+        return _srgbEncoded;
+    }
+
+    /// Set the number of threads used for each comparison. A value of zero
+    /// uses one thread per hardware thread. Defaults to zero.
+    void setThreadCount(unsigned int threadCount)
+    {
+        _threadCount = threadCount;
+    }
+
+    /// Return the number of threads used for each comparison.
+    unsigned int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /// Compare an image against a reference image. The images must have the
+    /// same resolution, and the channels which they have in common are
+    /// compared. Images of one or two channels are compared as gray.
+    /// An exception is thrown if the images cannot be compared.
+    /// @param image Image to compare
+    /// @param reference Reference image
+    /// @return The difference between the images
+    ImageDifference compare(const ImageDesc& image, const ImageDesc& reference) const;
+
+    /// Return true if the given difference is within the tolerance of
+    /// this comparator.
+    bool isWithinTolerance(const ImageDifference& difference) const;
+
+  protected:
+    Tolerance _tolerance;
+    float _perceptualThreshold;
+    bool _createDifferenceImage;
+    float _differenceScale;
+    bool _srgbEncoded;
+    unsigned int _threadCount;
+};
+
+/// @class GoldenImageStore
+/// A directory of golden images, against which rendered images are compared
+/// in regression tests.
+///
+/// Golden images are identified by relative names, such as
+/// "stdlib/math/add_float", which may include directories.
+///
+class GoldenImageStore
+{
+  public:
+    /// The outcome of comparing an image against its golden image
+    enum Status
+    {
+        /// The image matches its golden image within tolerance.
+        PASSED,
+        /// The image differs from its golden image beyond tolerance.
+        FAILED,
+        /// No golden image exists for the image.
+        MISSING,
+        /// The golden image was created or replaced by the image.
+        UPDATED
+    };
+
+    /// The result of comparing an image against its golden image
+    struct Result
+    {
+        /// Outcome of the comparison
+        Status status = MISSING;
+        /// Difference from the golden image, if one was read
+        ImageDifference difference;
+        /// Description of the outcome
+        string message;
+        /// Path of the difference image written on failure, if any
+        FilePath differencePath;
+    };
+
+    /// Create a golden image store
+    /// @param rootPath Directory holding the golden images
+    /// @param imageLoader Loader used to read and write images. If null, an
+    ///    StbImageLoader is used.
+    static GoldenImageStorePtr create(const FilePath& rootPath, ImageLoaderPtr imageLoader = nullptr)
+    {
+        return std::make_shared<GoldenImageStore>(rootPath, imageLoader);
+    }
+
+    /// Constructor
+    GoldenImageStore(const FilePath& rootPath, ImageLoaderPtr imageLoader = nullptr);
+
+    /// Destructor
+    virtual ~GoldenImageStore() { }
+
+    /// Return the directory holding the golden images.
+    const FilePath& getRootPath() const
+    {
+        return _rootPath;
+    }
+
+    /// Set the comparator used to compare images.
+    void setComparator(ImageComparatorPtr comparator)
+    {
+        _comparator = comparator;
+    }
+
+    /// Return the comparator used to compare images.
+    ImageComparatorPtr getComparator() const
+    {
+        return _comparator;
+    }
+
+    /// Set the extension of golden images. Defaults to PNG.
+    void setFileExtension(const string& extension)
+    {
+        _extension = extension;
+    }
+
+    /// Return the extension of golden images.
+    const string& getFileExtension() const
+    {
+        return _extension;
+    }
+
+    /// Set whether golden images which are missing or which differ from the
+    /// compared image are replaced by it. Defaults to false.
+    void setUpdate(bool update)
+    {
+        _update = update;
+    }
+
+    /// Return whether golden images are replaced by compared images.
+    bool getUpdate() const
+    {
+        return _update;
+    }
+
+    /// Set the directory to which difference images of failed comparisons
+    /// are written, by the name of the golden image with a "_diff" suffix.
+    /// If empty, no difference images are written. Defaults to empty.
+    void setDifferencePath(const FilePath& differencePath)
+    {
+        _differencePath = differencePath;
+    }
+
+    /// Return the directory to which difference images are written.
+    const FilePath& getDifferencePath() const
+    {
+        return _differencePath;
+    }
+
+    /// Return the path of the golden image with the given name.
+    FilePath getGoldenPath(const string& name) const;
+
+    /// Compare an image against the golden image with the given name. The
+    /// image is taken to be in the row order in which the image loader
+    /// returns images, and is written so that it reads back unchanged,
+    /// converted to floating-point for HDR golden images and to 8-bit
+    /// otherwise.
+    Result compare(const string& name, const ImageDesc& image) const;
+
+    /// Read an image from disk and compare it against the golden image with
+    /// the given name. Golden images are written from the image as read,
+    /// in the format given by the file extension of the store.
+    Result compare(const string& name, const FilePath& imagePath) const;
+
+  protected:
+    Result compareImage(const string& name, const ImageDesc& image,
+                        const std::function<bool(const FilePath&)>& writeGolden) const;
+
+    static FilePath createFilePath(const FilePath& directory, const string& name);
+    static void makeParentDirectories(const FilePath& filePath);
+
+    FilePath _rootPath;
+    ImageLoaderPtr _imageLoader;
+    ImageComparatorPtr _comparator;
+    string _extension;
+    bool _update;
+    FilePath _differencePath;
+};
+
+} // namespace MaterialX
+
+#endif
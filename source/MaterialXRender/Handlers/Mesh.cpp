@@ -5,7 +5,9 @@
 
 #include <MaterialXRender/Handlers/Mesh.h>
 
+#include <limits>
 #include <map>
+#include <thread>
 
 namespace MaterialX
 {
@@ -19,6 +21,45 @@ const string MeshStream::GEOMETRY_PROPERTY_ATTRIBUTE("geomprop");
 
 const float MAX_FLOAT = std::numeric_limits<float>::max();
 
+MeshInterleavedBufferPtr MeshInterleavedBuffer::create(const MeshStreamList& streams)
+{
+    MeshInterleavedBufferPtr buffer = std::make_shared<MeshInterleavedBuffer>();
+    if (streams.empty())
+    {
+        return buffer;
+    }
+
+    size_t vertexCount = streams[0]->getData().size() / streams[0]->getStride();
+    unsigned int stride = 0;
+    for (MeshStreamPtr stream : streams)
+    {
+        if (stream->getData().size() != vertexCount * stream->getStride())
+        {
+            buffer->_attributes.clear();
+            return buffer;
+        }
+        buffer->_attributes.push_back({ stream, stride });
+        stride += stream->getStride();
+    }
+
+    buffer->_stride = stride;
+    buffer->_vertexCount = vertexCount;
+    buffer->_data.resize(vertexCount * stride);
+    for (const Attribute& attribute : buffer->_attributes)
+    {
+        const float* source = attribute.stream->getData().data();
+        unsigned int streamStride = attribute.stream->getStride();
+        float* dest = buffer->_data.data() + attribute.offset;
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            std::copy(source, source + streamStride, dest);
+            source += streamStride;
+            dest += stride;
+        }
+    }
+    return buffer;
+}
+
 Mesh::Mesh(const string& identifier) :
     _identifier(identifier),
     _minimumBounds(MAX_FLOAT, MAX_FLOAT, MAX_FLOAT),
@@ -29,8 +70,93 @@ Mesh::Mesh(const string& identifier) :
 {
 }
 
+namespace
+{
+
+// Minimum number of faces assigned to each thread in tangent generation
+const size_t MIN_FACES_PER_THREAD = 16384;
+
+// A contiguous range of faces within a mesh partition
+struct FaceRange
+{
+    const MeshIndexBuffer* indices;
+    size_t begin;
+    size_t end;
+};
+
+// Accumulate tangent directions for a range of faces into the given buffer,
+// based on Eric Lengyel at http://www.terathon.com/code/tangent.html
+void accumulateTangents(const FaceRange& range,
+                        const float* positions, unsigned int positionStride,
+                        const float* texcoords, unsigned int texcoordStride,
+                        float* tangents, unsigned int tangentStride)
+{
+    const MeshIndexBuffer& indices = *range.indices;
+    for (size_t faceIndex = range.begin; faceIndex < range.end; faceIndex++)
+    {
+        unsigned int i1 = indices[faceIndex * 3 + 0];
+        unsigned int i2 = indices[faceIndex * 3 + 1];
+        unsigned int i3 = indices[faceIndex * 3 + 2];
+
+        const float* v1 = positions + i1 * positionStride;
+        const float* v2 = positions + i2 * positionStride;
+        const float* v3 = positions + i3 * positionStride;
+
+        const float* w1 = texcoords + i1 * texcoordStride;
+        const float* w2 = texcoords + i2 * texcoordStride;
+        const float* w3 = texcoords + i3 * texcoordStride;
+
+        float x1 = v2[0] - v1[0];
+        float x2 = v3[0] - v1[0];
+        float y1 = v2[1] - v1[1];
+        float y2 = v3[1] - v1[1];
+        float z1 = v2[2] - v1[2];
+        float z2 = v3[2] - v1[2];
+
+        float s1 = w2[0] - w1[0];
+        float s2 = w3[0] - w1[0];
+        float t1 = w2[1] - w1[1];
+        float t2 = w3[1] - w1[1];
+
+        float denom = s1 * t2 - s2 * t1;
+        float r = denom ? 1.0f / denom : 0.0f;
+        float dir[3] = { (t2 * x1 - t1 * x2) * r,
+                         (t2 * y1 - t1 * y2) * r,
+                         (t2 * z1 - t1 * z2) * r };
+
+        float* tan1 = tangents + i1 * tangentStride;
+        float* tan2 = tangents + i2 * tangentStride;
+        float* tan3 = tangents + i3 * tangentStride;
+        for (size_t k = 0; k < 3; k++)
+        {
+            tan1[k] += dir[k];
+            tan2[k] += dir[k];
+            tan3[k] += dir[k];
+        }
+    }
+}
+
+// Run a function over the given number of threads, with the calling thread
+// acting as thread zero.
+template<class F> void runThreads(size_t threadCount, const F& func)
+{
+    vector<std::thread> threads;
+    for (size_t t = 1; t < threadCount; t++)
+    {
+        threads.emplace_back(func, t);
+    }
+    func(0);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // anonymous namespace
+
 bool Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr texcoordStream, MeshStreamPtr normalStream,
-                            MeshStreamPtr tangentStream, MeshStreamPtr bitangentStream)
+                            MeshStreamPtr tangentStream, MeshStreamPtr bitangentStream,
+                            unsigned int threadCount)
 {
     MeshFloatBuffer& positions = positionStream->getData();
     unsigned int positionStride = positionStream->getStride();
@@ -55,54 +181,6 @@ bool Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr texcoord
     const unsigned int tangentStride = 3;
     tangentStream->setStride(tangentStride);
 
-    for (size_t i = 0; i < getPartitionCount(); i++)
-    {
-        auto part = getPartition(i);
-
-        // Based on Eric Lengyel at http://www.terathon.com/code/tangent.html
-
-        const MeshIndexBuffer& indicies = part->getIndices();
-        for (size_t faceIndex = 0; faceIndex < part->getFaceCount(); faceIndex++)
-        {
-            int i1 = indicies[faceIndex * 3 + 0];
-            int i2 = indicies[faceIndex * 3 + 1];
-            int i3 = indicies[faceIndex * 3 + 2];
-
-            Vector3& v1 = *reinterpret_cast<Vector3*>(&(positions[i1 * positionStride]));
-            Vector3& v2 = *reinterpret_cast<Vector3*>(&(positions[i2 * positionStride]));
-            Vector3& v3 = *reinterpret_cast<Vector3*>(&(positions[i3 * positionStride]));
-
-            Vector2& w1 = *reinterpret_cast<Vector2*>(&(texcoords[i1 * texcoordStride]));
-            Vector2& w2 = *reinterpret_cast<Vector2*>(&(texcoords[i2 * texcoordStride]));
-            Vector2& w3 = *reinterpret_cast<Vector2*>(&(texcoords[i3 * texcoordStride]));
-
-            float x1 = v2[0] - v1[0];
-            float x2 = v3[0] - v1[0];
-            float y1 = v2[1] - v1[1];
-            float y2 = v3[1] - v1[1];
-            float z1 = v2[2] - v1[2];
-            float z2 = v3[2] - v1[2];
-
-            float s1 = w2[0] - w1[0];
-            float s2 = w3[0] - w1[0];
-            float t1 = w2[1] - w1[1];
-            float t2 = w3[1] - w1[1];
-
-            float denom = s1 * t2 - s2 * t1;
-            float r = denom ? 1.0f / denom : 0.0f;
-            Vector3 dir((t2 * x1 - t1 * x2) * r,
-                (t2 * y1 - t1 * y2) * r,
-                (t2 * z1 - t1 * z2) * r);
-
-            Vector3& tan1 = *reinterpret_cast<Vector3*>(&(tangents[i1 * tangentStride]));
-            Vector3& tan2 = *reinterpret_cast<Vector3*>(&(tangents[i2 * tangentStride]));
-            Vector3& tan3 = *reinterpret_cast<Vector3*>(&(tangents[i3 * tangentStride]));
-            tan1 += dir;
-            tan2 += dir;
-            tan3 += dir;
-        }
-    }
-
     // Prepare bitangent stream data
     MeshFloatBuffer* bitangents = nullptr;
     unsigned int bitangentStride = 0;
@@ -114,22 +192,92 @@ bool Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr texcoord
         bitangentStride = bitangentStream->getStride();
     }
 
-    for (size_t v = 0; v < vertexCount; v++)
+    // Determine the number of threads to use
+    size_t totalFaceCount = 0;
+    for (size_t i = 0; i < getPartitionCount(); i++)
+    {
+        totalFaceCount += getPartition(i)->getFaceCount();
+    }
+    if (!threadCount)
     {
-        Vector3& n = *reinterpret_cast<Vector3*>(&(normals[v * normalStride]));
-        Vector3& t = *reinterpret_cast<Vector3*>(&(tangents[v * tangentStride]));
-        Vector3* b = bitangents ? reinterpret_cast<Vector3*>(&((*bitangents)[v * bitangentStride])) : nullptr;
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    size_t activeThreads = std::min((size_t) threadCount,
+                                    std::max(totalFaceCount / MIN_FACES_PER_THREAD, (size_t) 1));
 
-        // Gram-Schmidt orthogonalize
-        if (t != Vector3(0.0f))
+    // Split faces across threads in contiguous ranges, which may span partitions.
+    vector<vector<FaceRange>> threadRanges(activeThreads);
+    size_t facesPerThread = (totalFaceCount + activeThreads - 1) / activeThreads;
+    size_t faceOffset = 0;
+    for (size_t i = 0; i < getPartitionCount(); i++)
+    {
+        MeshPartitionPtr part = getPartition(i);
+        size_t partFaceCount = part->getFaceCount();
+        size_t partFace = 0;
+        while (partFace < partFaceCount)
         {
-            t = (t - n * n.dot(t)).getNormalized();
-            if (b)
+            size_t thread = faceOffset / facesPerThread;
+            size_t count = std::min(partFaceCount - partFace, (thread + 1) * facesPerThread - faceOffset);
+            threadRanges[thread].push_back({ &part->getIndices(), partFace, partFace + count });
+            partFace += count;
+            faceOffset += count;
+        }
+    }
+
+    // Accumulate face tangents. The first thread accumulates directly into the
+    // tangent stream, while additional threads use private buffers to avoid
+    // write conflicts on shared vertices.
+    vector<MeshFloatBuffer> threadTangents(activeThreads - 1);
+    runThreads(activeThreads, [&](size_t thread)
+    {
+        float* target = tangents.data();
+        if (thread > 0)
+        {
+            MeshFloatBuffer& buffer = threadTangents[thread - 1];
+            buffer.assign(tangents.size(), 0.0f);
+            target = buffer.data();
+        }
+        for (const FaceRange& range : threadRanges[thread])
+        {
+            accumulateTangents(range, positions.data(), positionStride,
+                               texcoords.data(), texcoordStride,
+                               target, tangentStride);
+        }
+    });
+
+    // Reduce thread buffers and orthogonalize, split across threads by vertex range.
+    size_t verticesPerThread = (vertexCount + activeThreads - 1) / activeThreads;
+    runThreads(activeThreads, [&](size_t thread)
+    {
+        size_t vertexBegin = std::min(thread * verticesPerThread, vertexCount);
+        size_t vertexEnd = std::min(vertexBegin + verticesPerThread, vertexCount);
+        for (const MeshFloatBuffer& buffer : threadTangents)
+        {
+            for (size_t i = vertexBegin * tangentStride; i < vertexEnd * tangentStride; i++)
             {
-                *b = n.cross(t);
+                tangents[i] += buffer[i];
             }
         }
-    }
+
+        for (size_t v = vertexBegin; v < vertexEnd; v++)
+        {
+            Vector3& n = *reinterpret_cast<Vector3*>(&(normals[v * normalStride]));
+            Vector3& t = *reinterpret_cast<Vector3*>(&(tangents[v * tangentStride]));
+            Vector3* b = bitangents ? reinterpret_cast<Vector3*>(&((*bitangents)[v * bitangentStride])) : nullptr;
+
+            // Gram-Schmidt orthogonalize
+            if (t != Vector3(0.0f))
+            {
+                t = (t - n * n.dot(t)).getNormalized();
+                if (b)
+                {
+                    *b = n.cross(t);
+                }
+            }
+        }
+    });
+
+    clearInterleavedBuffer();
     return true;
 }
 
@@ -194,6 +194,83 @@ class MeshPartition
 };
 
 
+/// Shared pointer to an interleaved mesh buffer
+using MeshInterleavedBufferPtr = shared_ptr<class MeshInterleavedBuffer>;
+
+/// @class MeshInterleavedBuffer
+/// Class which holds the data of a set of mesh streams in a single buffer,
+/// with the values for each vertex stored contiguously. Each stream is
+/// described by an attribute giving its offset within a vertex.
+class MeshInterleavedBuffer
+{
+  public:
+    /// Description of a stream within the interleaved buffer
+    struct Attribute
+    {
+        /// Source stream
+        MeshStreamPtr stream;
+        /// Offset of the stream within each vertex, in floats
+        unsigned int offset;
+    };
+
+    /// Create an interleaved buffer from a list of streams. All streams must
+    /// hold the same number of vertices, otherwise an empty buffer is returned.
+    static MeshInterleavedBufferPtr create(const MeshStreamList& streams);
+
+    /// Default constructor
+    MeshInterleavedBuffer() :
+        _stride(0),
+        _vertexCount(0)
+    {
+    }
+
+    /// Default destructor
+    ~MeshInterleavedBuffer() { }
+
+    /// Return the interleaved data
+    const MeshFloatBuffer& getData() const
+    {
+        return _data;
+    }
+
+    /// Return the number of floats per vertex
+    unsigned int getStride() const
+    {
+        return _stride;
+    }
+
+    /// Return the number of vertices
+    size_t getVertexCount() const
+    {
+        return _vertexCount;
+    }
+
+    /// Return the list of attributes in the buffer
+    const vector<Attribute>& getAttributes() const
+    {
+        return _attributes;
+    }
+
+    /// Return the attribute for a stream of the given name, or null if none is found.
+    const Attribute* getAttribute(const string& name) const
+    {
+        for (const Attribute& attribute : _attributes)
+        {
+            if (attribute.stream->getName() == name)
+            {
+                return &attribute;
+            }
+        }
+        return nullptr;
+    }
+
+  private:
+    MeshFloatBuffer _data;
+    unsigned int _stride;
+    size_t _vertexCount;
+    vector<Attribute> _attributes;
+};
+
 /// Shader pointer to a GeometryMesh
 using MeshPtr = shared_ptr<class Mesh>;
 
@@ -277,6 +354,31 @@ class Mesh
     void addStream(MeshStreamPtr stream)
     {
         _streams.push_back(stream);
+        _interleavedBuffer = nullptr;
+    }
+
+    /// Return the list of mesh streams
+    const MeshStreamList& getStreams() const
+    {
+        return _streams;
+    }
+
+    /// Return an interleaved buffer holding the data of all mesh streams.
+    /// The buffer is generated on first access and then cached, so must be
+    /// cleared with clearInterleavedBuffer() if stream data is modified.
+    MeshInterleavedBufferPtr getInterleavedBuffer()
+    {
+        if (!_interleavedBuffer)
+        {
+            _interleavedBuffer = MeshInterleavedBuffer::create(_streams);
+        }
+        return _interleavedBuffer;
+    }
+
+    /// Clear the cached interleaved buffer.
+    void clearInterleavedBuffer()
+    {
+        _interleavedBuffer = nullptr;
     }
 
     /// Set vertex count
@@ -364,9 +466,14 @@ class Mesh
     /// @param normalStream Normals to use
     /// @param tangentStream Tangents to produce
     /// @param bitangentStream Bitangents to produce.
+    /// @param threadCount Maximum number of threads to use. A value of zero uses
+    ///    the hardware concurrency, and a value of one runs the serial reference path.
+    ///    Results from parallel runs match the serial path within floating-point
+    ///    summation tolerance.
     /// Returns true if successful.
     bool generateTangents(MeshStreamPtr positionStream, MeshStreamPtr texcoordStream, MeshStreamPtr normalStream,
-                          MeshStreamPtr tangentStream, MeshStreamPtr bitangentStream);   
+                          MeshStreamPtr tangentStream, MeshStreamPtr bitangentStream,
+                          unsigned int threadCount = 0);
 
     /// Merge all mesh partitions into one.
     void mergePartitions();
@@ -385,6 +492,7 @@ class Mesh
     float _sphereRadius;
 
     MeshStreamList _streams;
+    MeshInterleavedBufferPtr _interleavedBuffer;
     size_t _vertexCount;
     vector<MeshPartitionPtr> _partitions;
 };
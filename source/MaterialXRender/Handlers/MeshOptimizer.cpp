@@ -0,0 +1,407 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Handlers/MeshOptimizer.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace MaterialX
+{
+
+namespace
+{
+
+const unsigned int INVALID_INDEX = std::numeric_limits<unsigned int>::max();
+
+// Parameters of the vertex cache optimization, from Tom Forsyth's
+// "Linear-Speed Vertex Cache Optimisation".
+const size_t FORSYTH_CACHE_SIZE = 32;
+const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+const float FORSYTH_LAST_FACE_SCORE = 0.75f;
+const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+// Return the number of vertices in the mesh streams, or zero if the
+// streams do not agree on a vertex count.
+size_t getStreamVertexCount(MeshPtr mesh)
+{
+    size_t vertexCount = 0;
+    bool first = true;
+    for (MeshStreamPtr stream : mesh->getStreams())
+    {
+        size_t count = stream->getData().size() / stream->getStride();
+        if (first)
+        {
+            vertexCount = count;
+            first = false;
+        }
+        else if (count != vertexCount)
+        {
+            return 0;
+        }
+    }
+    return vertexCount;
+}
+
+// Rewrite stream data and partition indices, given a mapping from old to new
+// vertex indices. Vertices mapped to INVALID_INDEX are discarded, and when
+// several old vertices map to the same new vertex the first is kept.
+void remapVertices(MeshPtr mesh, const vector<unsigned int>& remap, size_t newVertexCount)
+{
+    for (MeshStreamPtr stream : mesh->getStreams())
+    {
+        const MeshFloatBuffer& oldData = stream->getData();
+        unsigned int stride = stream->getStride();
+        MeshFloatBuffer newData(newVertexCount * stride);
+        vector<bool> written(newVertexCount, false);
+        for (size_t v = 0; v < remap.size(); v++)
+        {
+            unsigned int target = remap[v];
+            if (target != INVALID_INDEX && !written[target])
+            {
+                std::copy(oldData.begin() + v * stride, oldData.begin() + (v + 1) * stride,
+                          newData.begin() + target * stride);
+                written[target] = true;
+            }
+        }
+        stream->getData().swap(newData);
+    }
+
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        for (unsigned int& index : mesh->getPartition(p)->getIndices())
+        {
+            index = remap[index];
+        }
+    }
+
+    mesh->setVertexCount(newVertexCount);
+    mesh->clearInterleavedBuffer();
+}
+
+float computeVertexScore(int cachePosition, unsigned int remainingValence)
+{
+    if (!remainingValence)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            // Vertices of the most recent face receive a fixed score, so that
+            // strips are not favored over fans.
+            score = FORSYTH_LAST_FACE_SCORE;
+        }
+        else
+        {
+            float scale = 1.0f / (float) (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (float) (cachePosition - 3) * scale, FORSYTH_CACHE_DECAY_POWER);
+        }
+    }
+
+    // Boost vertices with few remaining faces, to finish them off early.
+    score += FORSYTH_VALENCE_BOOST_SCALE * std::pow((float) remainingValence, -FORSYTH_VALENCE_BOOST_POWER);
+    return score;
+}
+
+// Reorder the faces of an index buffer for vertex cache locality.
+void optimizeFaceOrder(MeshIndexBuffer& indices, size_t faceCount, size_t vertexCount)
+{
+    if (faceCount < 2)
+    {
+        return;
+    }
+
+    // Build vertex to face adjacency.
+    vector<unsigned int> remainingValence(vertexCount, 0);
+    for (size_t i = 0; i < faceCount * 3; i++)
+    {
+        remainingValence[indices[i]]++;
+    }
+    vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingValence[v];
+    }
+    vector<unsigned int> adjacency(faceCount * 3);
+    vector<unsigned int> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t f = 0; f < faceCount; f++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            adjacency[adjacencyFill[indices[f * 3 + k]]++] = (unsigned int) f;
+        }
+    }
+
+    // Initialize scores.
+    vector<int> cachePosition(vertexCount, -1);
+    vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        vertexScore[v] = computeVertexScore(-1, remainingValence[v]);
+    }
+    vector<float> faceScore(faceCount);
+    vector<bool> faceAdded(faceCount, false);
+    unsigned int bestFace = 0;
+    for (size_t f = 0; f < faceCount; f++)
+    {
+        faceScore[f] = vertexScore[indices[f * 3 + 0]] +
+                       vertexScore[indices[f * 3 + 1]] +
+                       vertexScore[indices[f * 3 + 2]];
+        if (faceScore[f] > faceScore[bestFace])
+        {
+            bestFace = (unsigned int) f;
+        }
+    }
+
+    MeshIndexBuffer newIndices;
+    newIndices.reserve(faceCount * 3);
+    vector<unsigned int> cache;
+    vector<unsigned int> newCache;
+    size_t nextFace = 0;
+    while (newIndices.size() < faceCount * 3)
+    {
+        // When no candidate remains in the cache, continue with the next
+        // face in the original order.
+        if (bestFace == INVALID_INDEX)
+        {
+            while (faceAdded[nextFace])
+            {
+                nextFace++;
+            }
+            bestFace = (unsigned int) nextFace;
+        }
+
+        // Emit the face and push its vertices to the front of the cache.
+        faceAdded[bestFace] = true;
+        newCache.clear();
+        for (size_t k = 0; k < 3; k++)
+        {
+            unsigned int v = indices[bestFace * 3 + k];
+            newIndices.push_back(v);
+            remainingValence[v]--;
+            newCache.push_back(v);
+        }
+        for (unsigned int v : cache)
+        {
+            if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+            {
+                newCache.push_back(v);
+            }
+        }
+
+        // Update scores of vertices in the cache, including those just evicted.
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            unsigned int v = newCache[i];
+            cachePosition[v] = i < FORSYTH_CACHE_SIZE ? (int) i : -1;
+            vertexScore[v] = computeVertexScore(cachePosition[v], remainingValence[v]);
+        }
+        for (unsigned int v : newCache)
+        {
+            for (unsigned int a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+            {
+                unsigned int f = adjacency[a];
+                if (!faceAdded[f])
+                {
+                    faceScore[f] = vertexScore[indices[f * 3 + 0]] +
+                                   vertexScore[indices[f * 3 + 1]] +
+                                   vertexScore[indices[f * 3 + 2]];
+                }
+            }
+        }
+        if (newCache.size() > FORSYTH_CACHE_SIZE)
+        {
+            newCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(newCache);
+
+        // Select the best scoring face which touches the cache.
+        bestFace = INVALID_INDEX;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (unsigned int v : cache)
+        {
+            for (unsigned int a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+            {
+                unsigned int f = adjacency[a];
+                if (!faceAdded[f] && faceScore[f] > bestScore)
+                {
+                    bestScore = faceScore[f];
+                    bestFace = f;
+                }
+            }
+        }
+    }
+
+    std::copy(newIndices.begin(), newIndices.end(), indices.begin());
+}
+
+} // anonymous namespace
+
+MeshOptimizer::Statistics MeshOptimizer::optimize(MeshPtr mesh) const
+{
+    Statistics stats;
+    stats.vertexCountBefore = getStreamVertexCount(mesh);
+    stats.acmrBefore = computeACMR(mesh);
+
+    weldVertices(mesh);
+    optimizeVertexCache(mesh);
+    optimizeVertexFetch(mesh);
+
+    stats.vertexCountAfter = getStreamVertexCount(mesh);
+    stats.acmrAfter = computeACMR(mesh);
+    return stats;
+}
+
+size_t MeshOptimizer::weldVertices(MeshPtr mesh) const
+{
+    size_t vertexCount = getStreamVertexCount(mesh);
+    const MeshStreamList& streams = mesh->getStreams();
+    if (!vertexCount)
+    {
+        return vertexCount;
+    }
+
+    auto hashVertex = [&streams](size_t v)
+    {
+        // FNV-1a over the bit patterns of all stream values
+        uint64_t hash = 14695981039346656037ull;
+        for (MeshStreamPtr stream : streams)
+        {
+            unsigned int stride = stream->getStride();
+            const float* data = &stream->getData()[v * stride];
+            for (unsigned int i = 0; i < stride; i++)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &data[i], sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+        }
+        return hash;
+    };
+    auto equalVertices = [&streams](size_t v1, size_t v2)
+    {
+        for (MeshStreamPtr stream : streams)
+        {
+            unsigned int stride = stream->getStride();
+            const float* data = stream->getData().data();
+            if (std::memcmp(data + v1 * stride, data + v2 * stride, stride * sizeof(float)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Open addressing hash table of unique vertices
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2)
+    {
+        tableSize *= 2;
+    }
+    vector<unsigned int> table(tableSize, INVALID_INDEX);
+    vector<unsigned int> remap(vertexCount);
+    size_t uniqueCount = 0;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        size_t slot = (size_t) hashVertex(v) & (tableSize - 1);
+        while (table[slot] != INVALID_INDEX && !equalVertices(table[slot], v))
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == INVALID_INDEX)
+        {
+            table[slot] = (unsigned int) v;
+            remap[v] = (unsigned int) uniqueCount++;
+        }
+        else
+        {
+            remap[v] = remap[table[slot]];
+        }
+    }
+
+    if (uniqueCount != vertexCount)
+    {
+        remapVertices(mesh, remap, uniqueCount);
+    }
+    return uniqueCount;
+}
+
+void MeshOptimizer::optimizeVertexCache(MeshPtr mesh) const
+{
+    size_t vertexCount = getStreamVertexCount(mesh);
+    if (!vertexCount)
+    {
+        return;
+    }
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        MeshPartitionPtr part = mesh->getPartition(p);
+        optimizeFaceOrder(part->getIndices(), part->getFaceCount(), vertexCount);
+    }
+}
+
+size_t MeshOptimizer::optimizeVertexFetch(MeshPtr mesh) const
+{
+    size_t vertexCount = getStreamVertexCount(mesh);
+    if (!vertexCount)
+    {
+        return vertexCount;
+    }
+
+    vector<unsigned int> remap(vertexCount, INVALID_INDEX);
+    size_t newVertexCount = 0;
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        for (unsigned int index : mesh->getPartition(p)->getIndices())
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = (unsigned int) newVertexCount++;
+            }
+        }
+    }
+
+    remapVertices(mesh, remap, newVertexCount);
+    return newVertexCount;
+}
+
+float MeshOptimizer::computeACMR(MeshPtr mesh) const
+{
+    size_t vertexCount = getStreamVertexCount(mesh);
+    size_t faceCount = 0;
+    size_t missCount = 0;
+    vector<size_t> cacheTime(vertexCount, 0);
+    size_t time = 0;
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        // Each partition is drawn separately, so starts with an empty cache.
+        time += _cacheSize + 1;
+
+        MeshPartitionPtr part = mesh->getPartition(p);
+        const MeshIndexBuffer& indices = part->getIndices();
+        faceCount += part->getFaceCount();
+        for (size_t i = 0; i < part->getFaceCount() * 3; i++)
+        {
+            // A vertex is in the FIFO cache if fewer than cacheSize misses
+            // have occurred since it was inserted.
+            unsigned int v = indices[i];
+            if (!cacheTime[v] || time - cacheTime[v] >= _cacheSize)
+            {
+                time++;
+                cacheTime[v] = time;
+                missCount++;
+            }
+        }
+    }
+    return faceCount ? (float) missCount / (float) faceCount : 0.0f;
+}
+
+} // namespace MaterialX
@@ -0,0 +1,108 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_MESHOPTIMIZER_H
+#define MATERIALX_MESHOPTIMIZER_H
+
+/// @file
+/// Mesh vertex and index optimization
+
+#include <MaterialXRender/Handlers/Mesh.h>
+
+namespace MaterialX
+{
+/// Shared pointer to a MeshOptimizer
+using MeshOptimizerPtr = std::shared_ptr<class MeshOptimizer>;
+
+/// @class MeshOptimizer
+/// Utility class which optimizes the vertex and index data of a mesh for
+/// rendering. Optimization consists of three stages:
+///   - Welding of vertices whose data is identical across all mesh streams.
+///   - Reordering of the faces in each partition for post-transform vertex
+///     cache locality, using Tom Forsyth's linear-speed algorithm.
+///   - Reordering of vertices into first-use order for vertex fetch locality.
+///
+/// All stages preserve the set of faces in each partition and the data
+/// referenced by each face.
+///
+class MeshOptimizer
+{
+  public:
+    /// Statistics reported by an optimization pass
+    struct Statistics
+    {
+        /// Vertex count before optimization
+        size_t vertexCountBefore = 0;
+        /// Vertex count after optimization
+        size_t vertexCountAfter = 0;
+        /// Average cache miss ratio before optimization
+        float acmrBefore = 0.0f;
+        /// Average cache miss ratio after optimization
+        float acmrAfter = 0.0f;
+    };
+
+    /// Default size of the FIFO vertex cache used to compute ACMR
+    static const unsigned int DEFAULT_CACHE_SIZE = 16;
+
+    /// Static instance create function
+    static MeshOptimizerPtr create() { return std::make_shared<MeshOptimizer>(); }
+
+    /// Default constructor
+    MeshOptimizer() :
+        _cacheSize(DEFAULT_CACHE_SIZE)
+    {
+    }
+
+    /// Default destructor
+    virtual ~MeshOptimizer() {}
+
+    /// Set the size of the FIFO vertex cache used to compute ACMR.
+    void setCacheSize(unsigned int cacheSize)
+    {
+        _cacheSize = cacheSize;
+    }
+
+    /// Return the size of the FIFO vertex cache used to compute ACMR.
+    unsigned int getCacheSize() const
+    {
+        return _cacheSize;
+    }
+
+    /// Return a string identifying the optimization this instance applies,
+    /// which is stored in sidecar mesh caches so that caches written with
+    /// different optimization settings are not reused.
+    virtual string getCacheIdentifier() const
+    {
+        return "MeshOptimizer:" + std::to_string(_cacheSize);
+    }
+
+    /// Run all optimization stages on the given mesh.
+    /// @param mesh Mesh to optimize
+    /// @return Vertex counts and average cache miss ratios before and after optimization.
+    Statistics optimize(MeshPtr mesh) const;
+
+    /// Merge vertices whose data is identical across all streams of the mesh,
+    /// and remap partition indices accordingly.
+    /// @return The number of vertices after welding.
+    size_t weldVertices(MeshPtr mesh) const;
+
+    /// Reorder the faces of each partition for post-transform vertex cache locality.
+    void optimizeVertexCache(MeshPtr mesh) const;
+
+    /// Reorder vertices into the order in which they are first referenced by
+    /// the mesh partitions. Vertices which are not referenced are removed.
+    /// @return The number of vertices after reordering.
+    size_t optimizeVertexFetch(MeshPtr mesh) const;
+
+    /// Return the average cache miss ratio of the mesh, which is the number of
+    /// vertex shader invocations per face for a FIFO cache of the current size.
+    float computeACMR(MeshPtr mesh) const;
+
+  protected:
+    unsigned int _cacheSize;
+};
+
+} // namespace MaterialX
+#endif
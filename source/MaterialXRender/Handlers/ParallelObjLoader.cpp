@@ -0,0 +1,816 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/Handlers/ParallelObjLoader.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace MaterialX
+{
+namespace
+{
+
+const float MAX_FLOAT = std::numeric_limits<float>::max();
+
+// Maximum number of significant decimal digits accumulated when parsing a
+// floating-point value, which is the most that fit in a 64-bit integer.
+const int MAX_SIGNIFICANT_DIGITS = 19;
+
+// Powers of ten which are exactly representable as doubles
+const double POWERS_OF_TEN[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int MAX_EXACT_POWER_OF_TEN = 22;
+
+// Read-only view of the contents of a file, which is memory mapped where
+// possible and read into memory otherwise.
+class MappedFile
+{
+  public:
+    MappedFile() :
+        _data(nullptr),
+        _size(0),
+        _mapping(nullptr)
+    {
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    bool open(const FilePath& filePath)
+    {
+        close();
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filePath.asString().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping)
+            {
+                _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+            _size = (size_t) fileSize.QuadPart;
+        }
+        CloseHandle(file);
+#else
+        int file = ::open(filePath.asString().c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+        struct stat sb;
+        if (fstat(file, &sb) == 0 && sb.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
+            {
+                _mapping = mapping;
+            }
+            _size = (size_t) sb.st_size;
+        }
+        ::close(file);
+#endif
+        if (_mapping)
+        {
+            _data = static_cast<const char*>(_mapping);
+            return true;
+        }
+
+        // Fall back to reading the file into memory.
+        _size = 0;
+        std::ifstream stream(filePath.asString(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+        std::streamoff fileSize = stream.tellg();
+        _buffer.resize((size_t) std::max(fileSize, (std::streamoff) 0));
+        stream.seekg(0, std::ios::beg);
+        if (!stream.read(_buffer.data(), _buffer.size()))
+        {
+            _buffer.clear();
+            return false;
+        }
+        _data = _buffer.data();
+        _size = _buffer.size();
+        return true;
+    }
+
+    void close()
+    {
+        if (_mapping)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(_mapping);
+#else
+            munmap(_mapping, _size);
+#endif
+            _mapping = nullptr;
+        }
+        _buffer.clear();
+        _data = nullptr;
+        _size = 0;
+    }
+
+    const char* getData() const
+    {
+        return _data;
+    }
+
+    size_t getSize() const
+    {
+        return _size;
+    }
+
+  private:
+    const char* _data;
+    size_t _size;
+    void* _mapping;
+    vector<char> _buffer;
+};
+
+// Relative face index, which is resolved once the number of vertices in
+// preceding chunks is known.
+struct RelativeIndex
+{
+    // Location of the index in the chunk corner data
+    size_t slot;
+    // Zero-based index relative to the start of the chunk
+    int64_t localIndex;
+};
+
+// Data parsed from a single chunk of an OBJ file
+struct ObjChunk
+{
+    MeshFloatBuffer positions;
+    MeshFloatBuffer texcoords;
+    MeshFloatBuffer normals;
+
+    // Position, texture coordinate and normal index of each face corner,
+    // one-based, with zero for a missing index.
+    vector<int> corners;
+    vector<RelativeIndex> relativeIndices;
+    vector<unsigned int> faceSizes;
+
+    // Group statements, given by the chunk triangle count at which they occur
+    vector<std::pair<size_t, string>> groups;
+
+    size_t triangleCount = 0;
+    size_t texcoordCorners = 0;
+
+    // True if every face corner uses a single index for all attributes
+    bool sharedIndices = true;
+    bool valid = true;
+};
+
+template<class F> void runThreads(size_t threadCount, const F& func)
+{
+    vector<std::thread> threads;
+    for (size_t t = 1; t < threadCount; t++)
+    {
+        threads.emplace_back(func, t);
+    }
+    func(0);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline void skipSpace(const char*& p, const char* end)
+{
+    while (p < end && isSpace(*p))
+    {
+        p++;
+    }
+}
+
+// Parse a floating-point value independently of the current locale.
+bool parseFloat(const char*& p, const char* end, float& value)
+{
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int significantDigits = 0;
+    bool hasDigits = false;
+    for (; p < end && isDigit(*p); p++)
+    {
+        hasDigits = true;
+        if (significantDigits < MAX_SIGNIFICANT_DIGITS)
+        {
+            mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+            significantDigits += (mantissa != 0);
+        }
+        else
+        {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && isDigit(*p); p++)
+        {
+            hasDigits = true;
+            if (significantDigits < MAX_SIGNIFICANT_DIGITS)
+            {
+                mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+                significantDigits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+
+    if (!hasDigits)
+    {
+        // Fall back to the standard library for special values such as inf and nan.
+        char token[64];
+        size_t length = 0;
+        for (p = start; p < end && !isSpace(*p) && length + 1 < sizeof(token); p++)
+        {
+            token[length++] = *p;
+        }
+        token[length] = '\0';
+        char* tokenEnd = nullptr;
+        double result = std::strtod(token, &tokenEnd);
+        p = start + (tokenEnd - token);
+        value = (float) result;
+        return tokenEnd != token;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* exponentStart = p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = (*p == '-');
+            p++;
+        }
+        if (p < end && isDigit(*p))
+        {
+            int exponentValue = 0;
+            for (; p < end && isDigit(*p); p++)
+            {
+                if (exponentValue < 10000)
+                {
+                    exponentValue = exponentValue * 10 + (*p - '0');
+                }
+            }
+            exponent += negativeExponent ? -exponentValue : exponentValue;
+        }
+        else
+        {
+            p = exponentStart;
+        }
+    }
+
+    double result = (double) mantissa;
+    if (mantissa && exponent)
+    {
+        if (exponent > 0 && exponent <= MAX_EXACT_POWER_OF_TEN)
+        {
+            result *= POWERS_OF_TEN[exponent];
+        }
+        else if (exponent < 0 && exponent >= -MAX_EXACT_POWER_OF_TEN)
+        {
+            result /= POWERS_OF_TEN[-exponent];
+        }
+        else
+        {
+            result *= std::pow(10.0, (double) exponent);
+        }
+    }
+    value = (float) (negative ? -result : result);
+    return true;
+}
+
+// Parse a signed integer value.
+bool parseInt(const char*& p, const char* end, int& value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p >= end || !isDigit(*p))
+    {
+        return false;
+    }
+    int64_t result = 0;
+    for (; p < end && isDigit(*p); p++)
+    {
+        result = result * 10 + (*p - '0');
+        if (result > std::numeric_limits<int>::max())
+        {
+            return false;
+        }
+    }
+    value = (int) (negative ? -result : result);
+    return true;
+}
+
+// Parse a vertex attribute statement with the given number of values, where
+// values after the first are optional and default to zero.
+void parseValues(const char* p, const char* end, size_t count, MeshFloatBuffer& buffer, ObjChunk& chunk)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        skipSpace(p, end);
+        float value = 0.0f;
+        if (i > 0 && p >= end)
+        {
+            buffer.push_back(value);
+            continue;
+        }
+        if (!parseFloat(p, end, value))
+        {
+            chunk.valid = false;
+        }
+        buffer.push_back(value);
+    }
+}
+
+// Parse a face statement into the corner data of the chunk.
+void parseFace(const char* p, const char* end, ObjChunk& chunk)
+{
+    const size_t attributeCounts[3] =
+    {
+        chunk.positions.size() / 3,
+        chunk.texcoords.size() / 2,
+        chunk.normals.size() / 3
+    };
+    size_t firstCorner = chunk.corners.size();
+    size_t firstRelativeIndex = chunk.relativeIndices.size();
+    unsigned int cornerCount = 0;
+    while (true)
+    {
+        skipSpace(p, end);
+        if (p >= end)
+        {
+            break;
+        }
+
+        // Parse a corner of the form v, v/vt, v//vn or v/vt/vn.
+        int indices[3] = { 0, 0, 0 };
+        for (int component = 0; component < 3; component++)
+        {
+            if (component > 0)
+            {
+                if (p >= end || *p != '/')
+                {
+                    break;
+                }
+                p++;
+                if (component == 1 && p < end && *p == '/')
+                {
+                    continue;
+                }
+            }
+            if (!parseInt(p, end, indices[component]) || indices[component] == 0)
+            {
+                chunk.valid = false;
+                return;
+            }
+        }
+        if (p < end && !isSpace(*p))
+        {
+            chunk.valid = false;
+            return;
+        }
+
+        for (int component = 0; component < 3; component++)
+        {
+            int index = indices[component];
+            if (index < 0)
+            {
+                chunk.relativeIndices.push_back({ chunk.corners.size(), (int64_t) attributeCounts[component] + index });
+                chunk.sharedIndices = false;
+            }
+            chunk.corners.push_back(index);
+        }
+        if (indices[2] != indices[0] || (indices[1] && indices[1] != indices[0]))
+        {
+            chunk.sharedIndices = false;
+        }
+        chunk.texcoordCorners += (indices[1] != 0);
+        cornerCount++;
+    }
+
+    if (cornerCount < 3)
+    {
+        // Skip points and lines.
+        for (size_t i = firstCorner; i < chunk.corners.size(); i += 3)
+        {
+            chunk.texcoordCorners -= (chunk.corners[i + 1] != 0);
+        }
+        chunk.corners.resize(firstCorner);
+        chunk.relativeIndices.resize(firstRelativeIndex);
+        return;
+    }
+    chunk.faceSizes.push_back(cornerCount);
+    chunk.triangleCount += cornerCount - 2;
+}
+
+// Parse a range of complete lines from an OBJ file.
+void parseChunk(const char* begin, const char* end, ObjChunk& chunk)
+{
+    const char* p = begin;
+    while (p < end && chunk.valid)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!lineEnd)
+        {
+            lineEnd = end;
+        }
+
+        skipSpace(p, lineEnd);
+        const char* keyword = p;
+        while (p < lineEnd && !isSpace(*p))
+        {
+            p++;
+        }
+        size_t keywordLength = p - keyword;
+        if (keywordLength == 1 && keyword[0] == 'v')
+        {
+            parseValues(p, lineEnd, 3, chunk.positions, chunk);
+        }
+        else if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 't')
+        {
+            parseValues(p, lineEnd, 2, chunk.texcoords, chunk);
+        }
+        else if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 'n')
+        {
+            parseValues(p, lineEnd, 3, chunk.normals, chunk);
+        }
+        else if (keywordLength == 1 && keyword[0] == 'f')
+        {
+            parseFace(p, lineEnd, chunk);
+        }
+        else if (keywordLength == 1 && (keyword[0] == 'g' || keyword[0] == 'o'))
+        {
+            skipSpace(p, lineEnd);
+            const char* name = p;
+            while (p < lineEnd && !isSpace(*p))
+            {
+                p++;
+            }
+            chunk.groups.push_back({ chunk.triangleCount, string(name, p) });
+        }
+
+        p = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+}
+
+} // anonymous namespace
+
+bool ParallelObjLoader::load(const FilePath& filePath, MeshList& meshList)
+{
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        return false;
+    }
+    const char* data = file.getData();
+    size_t size = file.getSize();
+
+    // Split the file into chunks at line boundaries.
+    unsigned int threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    size_t chunkCount = std::min((size_t) threadCount, size / std::max(_chunkSize, (size_t) 1));
+    chunkCount = std::max(chunkCount, (size_t) 1);
+    vector<const char*> chunkStarts(chunkCount + 1);
+    chunkStarts[0] = data;
+    chunkStarts[chunkCount] = data + size;
+    for (size_t c = 1; c < chunkCount; c++)
+    {
+        const char* start = std::max(data + size * c / chunkCount, chunkStarts[c - 1]);
+        const char* lineEnd = static_cast<const char*>(std::memchr(start, '\n', data + size - start));
+        chunkStarts[c] = lineEnd ? lineEnd + 1 : data + size;
+    }
+
+    // Parse chunks concurrently.
+    vector<ObjChunk> chunks(chunkCount);
+    runThreads(chunkCount, [&](size_t c)
+    {
+        parseChunk(chunkStarts[c], chunkStarts[c + 1], chunks[c]);
+    });
+
+    // Compute the offset of each chunk within the combined attribute and face data.
+    vector<size_t> positionOffsets(chunkCount + 1, 0);
+    vector<size_t> texcoordOffsets(chunkCount + 1, 0);
+    vector<size_t> normalOffsets(chunkCount + 1, 0);
+    vector<size_t> triangleOffsets(chunkCount + 1, 0);
+    size_t cornerCount = 0;
+    size_t texcoordCorners = 0;
+    bool sharedIndices = true;
+    for (size_t c = 0; c < chunkCount; c++)
+    {
+        const ObjChunk& chunk = chunks[c];
+        if (!chunk.valid)
+        {
+            return false;
+        }
+        positionOffsets[c + 1] = positionOffsets[c] + chunk.positions.size() / 3;
+        texcoordOffsets[c + 1] = texcoordOffsets[c] + chunk.texcoords.size() / 2;
+        normalOffsets[c + 1] = normalOffsets[c] + chunk.normals.size() / 3;
+        triangleOffsets[c + 1] = triangleOffsets[c] + chunk.triangleCount;
+        cornerCount += chunk.corners.size() / 3;
+        texcoordCorners += chunk.texcoordCorners;
+        sharedIndices = sharedIndices && chunk.sharedIndices;
+    }
+    size_t positionCount = positionOffsets[chunkCount];
+    size_t texcoordCount = texcoordOffsets[chunkCount];
+    size_t normalCount = normalOffsets[chunkCount];
+    size_t triangleCount = triangleOffsets[chunkCount];
+    if (!triangleCount)
+    {
+        return false;
+    }
+
+    // Index the mesh directly by the vertices of the file where possible, and
+    // otherwise create a vertex for each face corner.
+    bool indexed = sharedIndices && normalCount == positionCount &&
+                   (!texcoordCorners || (texcoordCorners == cornerCount && texcoordCount == positionCount));
+    size_t vertexCount = indexed ? positionCount : triangleCount * 3;
+    if (vertexCount > (size_t) std::numeric_limits<unsigned int>::max())
+    {
+        return false;
+    }
+
+    // Create partitions from group statements, in file order.
+    vector<std::pair<size_t, string>> groupStarts;
+    for (size_t c = 0; c < chunkCount; c++)
+    {
+        for (const auto& group : chunks[c].groups)
+        {
+            groupStarts.push_back({ triangleOffsets[c] + group.first, group.second });
+        }
+    }
+    if (groupStarts.empty() || groupStarts[0].first > 0)
+    {
+        groupStarts.insert(groupStarts.begin(), { 0, EMPTY_STRING });
+    }
+    vector<MeshPartitionPtr> partitions;
+    vector<size_t> partitionStarts;
+    for (size_t i = 0; i < groupStarts.size(); i++)
+    {
+        size_t start = groupStarts[i].first;
+        size_t end = (i + 1 < groupStarts.size()) ? groupStarts[i + 1].first : triangleCount;
+        if (end > start)
+        {
+            const string& name = groupStarts[i].second;
+            MeshPartitionPtr part = MeshPartition::create();
+            part->setIdentifier(name.empty() ? "Partition" + std::to_string(partitions.size()) : name);
+            part->setFaceCount(end - start);
+            part->getIndices().resize((end - start) * 3);
+            partitions.push_back(part);
+            partitionStarts.push_back(start);
+        }
+    }
+
+    MeshPtr mesh = Mesh::create(filePath);
+    mesh->setSourceUri(filePath);
+    MeshStreamPtr positionStream = MeshStream::create("i_" + MeshStream::POSITION_ATTRIBUTE, MeshStream::POSITION_ATTRIBUTE, 0);
+    MeshFloatBuffer& positions = positionStream->getData();
+    mesh->addStream(positionStream);
+
+    MeshStreamPtr normalStream = MeshStream::create("i_" + MeshStream::NORMAL_ATTRIBUTE, MeshStream::NORMAL_ATTRIBUTE, 0);
+    MeshFloatBuffer& normals = normalStream->getData();
+    mesh->addStream(normalStream);
+
+    MeshStreamPtr texCoordStream = MeshStream::create("i_" + MeshStream::TEXCOORD_ATTRIBUTE + "_0", MeshStream::TEXCOORD_ATTRIBUTE, 0);
+    texCoordStream->setStride(2);
+    MeshFloatBuffer& texcoords = texCoordStream->getData();
+    mesh->addStream(texCoordStream);
+
+    MeshStreamPtr tangentStream = MeshStream::create("i_" + MeshStream::TANGENT_ATTRIBUTE, MeshStream::TANGENT_ATTRIBUTE, 0);
+    tangentStream->setStride(3);
+    mesh->addStream(tangentStream);
+
+    // When indexed, the combined attribute data forms the mesh streams directly.
+    // Texcoords which no face references are not combined, since an indexed
+    // mesh may then have more texcoords in the file than vertices.
+    bool combineTexcoords = !indexed || texcoordCorners;
+    MeshFloatBuffer filePositions, fileTexcoords, fileNormals;
+    MeshFloatBuffer& combinedPositions = indexed ? positions : filePositions;
+    MeshFloatBuffer& combinedTexcoords = indexed ? texcoords : fileTexcoords;
+    MeshFloatBuffer& combinedNormals = indexed ? normals : fileNormals;
+    combinedPositions.resize(positionCount * 3);
+    combinedTexcoords.resize(indexed ? positionCount * 2 : texcoordCount * 2);
+    combinedNormals.resize(normalCount * 3);
+
+    // Combine attribute data and resolve relative indices.
+    runThreads(chunkCount, [&](size_t c)
+    {
+        ObjChunk& chunk = chunks[c];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), combinedPositions.begin() + positionOffsets[c] * 3);
+        if (combineTexcoords)
+        {
+            std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), combinedTexcoords.begin() + texcoordOffsets[c] * 2);
+        }
+        std::copy(chunk.normals.begin(), chunk.normals.end(), combinedNormals.begin() + normalOffsets[c] * 3);
+        MeshFloatBuffer().swap(chunk.positions);
+        MeshFloatBuffer().swap(chunk.texcoords);
+        MeshFloatBuffer().swap(chunk.normals);
+
+        const size_t* offsets[3] = { &positionOffsets[c], &texcoordOffsets[c], &normalOffsets[c] };
+        for (const RelativeIndex& relative : chunk.relativeIndices)
+        {
+            int64_t index = (int64_t) *offsets[relative.slot % 3] + relative.localIndex;
+            if (index < 0 || index >= std::numeric_limits<int>::max())
+            {
+                chunk.valid = false;
+                return;
+            }
+            chunk.corners[relative.slot] = (int) index + 1;
+        }
+    });
+
+    // Write triangle indices and vertex data, computing bounds for each chunk.
+    if (!indexed)
+    {
+        positions.resize(vertexCount * 3);
+        texcoords.resize(vertexCount * 2);
+        normals.resize(vertexCount * 3);
+    }
+    vector<Vector3> chunkMinimums(chunkCount, Vector3(MAX_FLOAT));
+    vector<Vector3> chunkMaximums(chunkCount, Vector3(-MAX_FLOAT));
+    runThreads(chunkCount, [&](size_t c)
+    {
+        ObjChunk& chunk = chunks[c];
+        if (!chunk.valid)
+        {
+            return;
+        }
+        Vector3& boxMin = chunkMinimums[c];
+        Vector3& boxMax = chunkMaximums[c];
+        size_t triangle = triangleOffsets[c];
+        size_t part = std::upper_bound(partitionStarts.begin(), partitionStarts.end(), triangle) - partitionStarts.begin() - 1;
+        const int* faceCorners = chunk.corners.data();
+        for (unsigned int faceSize : chunk.faceSizes)
+        {
+            for (unsigned int k = 1; k + 1 < faceSize; k++, triangle++)
+            {
+                const int* corners[3] = { faceCorners, faceCorners + k * 3, faceCorners + (k + 1) * 3 };
+                bool hasNormals = true;
+                for (const int* corner : corners)
+                {
+                    if (corner[0] < 1 || (size_t) corner[0] > positionCount ||
+                        (size_t) corner[1] > texcoordCount ||
+                        (size_t) corner[2] > normalCount)
+                    {
+                        chunk.valid = false;
+                        return;
+                    }
+                    hasNormals = hasNormals && corner[2];
+                }
+
+                while (part + 1 < partitions.size() && triangle >= partitionStarts[part + 1])
+                {
+                    part++;
+                }
+                unsigned int* indices = &partitions[part]->getIndices()[(triangle - partitionStarts[part]) * 3];
+
+                Vector3 v[3];
+                for (int j = 0; j < 3; j++)
+                {
+                    const float* position = &combinedPositions[(size_t) (corners[j][0] - 1) * 3];
+                    for (int i = 0; i < 3; i++)
+                    {
+                        v[j][i] = position[i];
+                        boxMin[i] = std::min(v[j][i], boxMin[i]);
+                        boxMax[i] = std::max(v[j][i], boxMax[i]);
+                    }
+                }
+
+                if (indexed)
+                {
+                    for (int j = 0; j < 3; j++)
+                    {
+                        indices[j] = (unsigned int) (corners[j][0] - 1);
+                    }
+                    continue;
+                }
+
+                // Copy or compute normals.
+                Vector3 n[3];
+                if (hasNormals)
+                {
+                    for (int j = 0; j < 3; j++)
+                    {
+                        const float* normal = &combinedNormals[(size_t) (corners[j][2] - 1) * 3];
+                        n[j] = Vector3(normal[0], normal[1], normal[2]);
+                    }
+                }
+                else
+                {
+                    Vector3 faceNorm = (v[1] - v[0]).cross(v[2] - v[0]);
+                    float length = faceNorm.getMagnitude();
+                    faceNorm = (length > 0.0f) ? faceNorm / length : Vector3(0.0f, 0.0f, 1.0f);
+                    n[0] = n[1] = n[2] = faceNorm;
+                }
+
+                for (int j = 0; j < 3; j++)
+                {
+                    size_t vertex = triangle * 3 + j;
+                    indices[j] = (unsigned int) vertex;
+                    for (int i = 0; i < 3; i++)
+                    {
+                        positions[vertex * 3 + i] = v[j][i];
+                        normals[vertex * 3 + i] = n[j][i];
+                    }
+                    if (corners[j][1])
+                    {
+                        const float* texcoord = &combinedTexcoords[(size_t) (corners[j][1] - 1) * 2];
+                        texcoords[vertex * 2] = texcoord[0];
+                        texcoords[vertex * 2 + 1] = texcoord[1];
+                    }
+                }
+            }
+            faceCorners += faceSize * 3;
+        }
+    });
+
+    Vector3 boxMin(MAX_FLOAT);
+    Vector3 boxMax(-MAX_FLOAT);
+    for (size_t c = 0; c < chunkCount; c++)
+    {
+        if (!chunks[c].valid)
+        {
+            return false;
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            boxMin[i] = std::min(chunkMinimums[c][i], boxMin[i]);
+            boxMax[i] = std::max(chunkMaximums[c][i], boxMax[i]);
+        }
+    }
+    chunks.clear();
+    MeshFloatBuffer().swap(filePositions);
+    MeshFloatBuffer().swap(fileTexcoords);
+    MeshFloatBuffer().swap(fileNormals);
+
+    for (MeshPartitionPtr part : partitions)
+    {
+        mesh->addPartition(part);
+    }
+    mesh->setVertexCount(vertexCount);
+    mesh->setMinimumBounds(boxMin);
+    mesh->setMaximumBounds(boxMax);
+    Vector3 sphereCenter = (boxMax + boxMin) / 2.0;
+    mesh->setSphereCenter(sphereCenter);
+    mesh->setSphereRadius((sphereCenter - boxMin).getMagnitude());
+
+    mesh->generateTangents(positionStream, texCoordStream, normalStream, tangentStream, nullptr, _threadCount);
+
+    meshList.push_back(mesh);
+    return true;
+}
+
+} // namespace MaterialX
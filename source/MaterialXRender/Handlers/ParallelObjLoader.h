@@ -0,0 +1,86 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_PARALLELOBJLOADER_H
+#define MATERIALX_PARALLELOBJLOADER_H
+
+/// @file
+/// Multi-threaded OBJ geometry loader
+
+#include <MaterialXRender/Handlers/GeometryHandler.h>
+
+namespace MaterialX
+{
+/// Shared pointer to a ParallelObjLoader
+using ParallelObjLoaderPtr = std::shared_ptr<class ParallelObjLoader>;
+
+/// @class ParallelObjLoader
+/// Geometry loader for large OBJ files. The file is memory mapped and split
+/// at line boundaries into chunks, which are parsed concurrently and then
+/// stitched together in file order, so that the resulting mesh does not
+/// depend on the number of threads used.
+///
+/// Each group or object statement in the file starts a new mesh partition,
+/// and polygons are triangulated as fans. If every face corner shares a single
+/// index for its position, texture coordinate and normal, then the mesh is
+/// indexed directly by these vertices. Otherwise, a vertex is created for
+/// each face corner, and MeshOptimizer may be used to weld the result.
+///
+class ParallelObjLoader : public GeometryLoader
+{
+  public:
+    /// Default minimum size in bytes of each chunk of the file
+    static const size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    /// Static instance create function
+    static ParallelObjLoaderPtr create() { return std::make_shared<ParallelObjLoader>(); }
+
+    /// Default constructor
+    ParallelObjLoader() :
+        _threadCount(0),
+        _chunkSize(DEFAULT_CHUNK_SIZE)
+    {
+        _extensions = { "obj", "OBJ" };
+    }
+
+    /// Default destructor
+    virtual ~ParallelObjLoader() {}
+
+    /// Load geometry from disk
+    bool load(const FilePath& filePath, MeshList& meshList) override;
+
+    /// Set the maximum number of threads used to parse a file. A value of
+    /// zero uses one thread per hardware thread. Defaults to zero.
+    void setThreadCount(unsigned int threadCount)
+    {
+        _threadCount = threadCount;
+    }
+
+    /// Return the maximum number of threads used to parse a file.
+    unsigned int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /// Set the minimum size in bytes of the chunk of a file parsed by each
+    /// thread. Defaults to DEFAULT_CHUNK_SIZE.
+    void setChunkSize(size_t chunkSize)
+    {
+        _chunkSize = chunkSize;
+    }
+
+    /// Return the minimum size in bytes of the chunk of a file parsed by each thread.
+    size_t getChunkSize() const
+    {
+        return _chunkSize;
+    }
+
+  protected:
+    unsigned int _threadCount;
+    size_t _chunkSize;
+};
+
+} // namespace MaterialX
+#endif
@@ -55,7 +55,7 @@ bool StbImageLoader::saveImage(const FilePath& filePath,
     std::string extension = (filePathName.substr(filePathName.find_last_of(".") + 1));
     if (extension == PNG_EXTENSION)
     {
-        returnValue = stbi_write_png(filePathName.c_str(), w, h, channels, data, w * 4);
+        returnValue = stbi_write_png(filePathName.c_str(), w, h, channels, data, w * channels);
     }
     else if (extension == BMP_EXTENSION)
     {
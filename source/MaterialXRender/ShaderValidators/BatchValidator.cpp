@@ -0,0 +1,446 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRender/ShaderValidators/BatchValidator.h>
+
+#include <MaterialXGenShader/ShaderGenerator.h>
+#include <MaterialXGenShader/Util.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace MaterialX
+{
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+double elapsedSince(const Clock::time_point& start)
+{
+    return Milliseconds(Clock::now() - start).count();
+}
+
+void appendErrors(const std::exception& e, StringVec& errors)
+{
+    const ExceptionShaderValidationError* validationError = dynamic_cast<const ExceptionShaderValidationError*>(&e);
+    errors.push_back(e.what());
+    if (validationError)
+    {
+        const ShaderValidationErrorList& errorLog = validationError->errorLog();
+        errors.insert(errors.end(), errorLog.begin(), errorLog.end());
+    }
+}
+
+void writeJsonString(std::ostream& stream, const string& str)
+{
+    stream << '"';
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\r': stream << "\\r"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20)
+                {
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c << std::dec << std::setfill(' ');
+                }
+                else
+                {
+                    stream << c;
+                }
+        }
+    }
+    stream << '"';
+}
+
+// Stops and joins a set of worker threads on every exit from its scope,
+// including exceptions thrown on the calling thread.
+class WorkerJoiner
+{
+  public:
+    explicit WorkerJoiner(const std::function<void()>& stop) :
+        _stop(stop)
+    {
+    }
+    ~WorkerJoiner()
+    {
+        join();
+    }
+
+    void add(std::thread&& worker)
+    {
+        _workers.push_back(std::move(worker));
+    }
+
+    void join()
+    {
+        _stop();
+        for (std::thread& worker : _workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+  private:
+    std::function<void()> _stop;
+    vector<std::thread> _workers;
+};
+
+void writeJsonErrors(std::ostream& stream, const StringVec& errors)
+{
+    stream << "[";
+    for (size_t i = 0; i < errors.size(); i++)
+    {
+        stream << (i ? ", " : "");
+        writeJsonString(stream, errors[i]);
+    }
+    stream << "]";
+}
+
+} // anonymous namespace
+
+//
+// BatchValidator::Report methods
+//
+
+size_t BatchValidator::Report::getFailureCount() const
+{
+    size_t count = 0;
+    for (const DocumentReport& document : documents)
+    {
+        count += document.errors.empty() ? 0 : 1;
+    }
+    for (const ElementReport& element : elements)
+    {
+        count += element.errors.empty() ? 0 : 1;
+    }
+    return count;
+}
+
+string BatchValidator::Report::asJson() const
+{
+    double loadTime = 0.0, generateTime = 0.0, compileTime = 0.0, renderTime = 0.0, saveTime = 0.0;
+    for (const DocumentReport& document : documents)
+    {
+        loadTime += document.loadTime;
+    }
+    for (const ElementReport& element : elements)
+    {
+        generateTime += element.generateTime;
+        compileTime += element.compileTime;
+        renderTime += element.renderTime;
+        saveTime += element.saveTime;
+    }
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\n";
+    stream << "  \"threadCount\": " << threadCount << ",\n";
+    stream << "  \"failureCount\": " << getFailureCount() << ",\n";
+    stream << "  \"totalTime\": " << totalTime << ",\n";
+    stream << "  \"stageTimes\": {\"load\": " << loadTime << ", \"generate\": " << generateTime <<
+              ", \"compile\": " << compileTime << ", \"render\": " << renderTime << ", \"save\": " << saveTime << "},\n";
+
+    stream << "  \"documents\": [";
+    for (size_t i = 0; i < documents.size(); i++)
+    {
+        const DocumentReport& document = documents[i];
+        stream << (i ? ",\n" : "\n") << "    {\"path\": ";
+        writeJsonString(stream, document.path);
+        stream << ", \"load\": " << document.loadTime << ", \"errors\": ";
+        writeJsonErrors(stream, document.errors);
+        stream << "}";
+    }
+    stream << (documents.empty() ? "],\n" : "\n  ],\n");
+
+    stream << "  \"elements\": [";
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+        const ElementReport& element = elements[i];
+        stream << (i ? ",\n" : "\n") << "    {\"document\": ";
+        writeJsonString(stream, element.documentPath);
+        stream << ", \"element\": ";
+        writeJsonString(stream, element.elementPath);
+        stream << ", \"shader\": ";
+        writeJsonString(stream, element.shaderName);
+        stream << ", \"generate\": " << element.generateTime << ", \"compile\": " << element.compileTime <<
+                  ", \"render\": " << element.renderTime << ", \"save\": " << element.saveTime << ", \"errors\": ";
+        writeJsonErrors(stream, element.errors);
+        stream << "}";
+    }
+    stream << (elements.empty() ? "]\n" : "\n  ]\n");
+    stream << "}\n";
+    return stream.str();
+}
+
+bool BatchValidator::Report::writeJson(const FilePath& filePath) const
+{
+    std::ofstream file(filePath.asString());
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file << asJson();
+    return file.good();
+}
+
+//
+// BatchValidator methods
+//
+
+const size_t BatchValidator::DEFAULT_QUEUE_CAPACITY;
+
+BatchValidator::BatchValidator(GenContextCreator contextCreator, ShaderValidatorPtr validator) :
+    _contextCreator(contextCreator),
+    _validator(validator),
+    _threadCount(0),
+    _queueCapacity(DEFAULT_QUEUE_CAPACITY)
+{
+}
+
+void BatchValidator::validate(const StringVec& documentPaths, Report& report)
+{
+    Clock::time_point batchStart = Clock::now();
+
+    report = Report();
+    report.documents.resize(documentPaths.size());
+    if (documentPaths.empty())
+    {
+        return;
+    }
+
+    unsigned int threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = (unsigned int) std::min((size_t) threadCount, documentPaths.size());
+    report.threadCount = threadCount;
+
+    // Each worker imports from a copy of the libraries of its own, so that
+    // no document is read by several workers at once.
+    vector<GenContextPtr> contexts;
+    vector<ConstDocumentPtr> libraries;
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        contexts.push_back(_contextCreator());
+        libraries.push_back(_libraries ? _libraries->copy() : nullptr);
+    }
+    if (_validator && !_outputPath.isEmpty() && !_outputPath.exists())
+    {
+        makeDirectory(_outputPath.asString());
+    }
+
+    // Shaders generated by the workers, waiting to be validated on this thread.
+    // Workers wait for space when the queue is full, and give up once the
+    // batch is stopping.
+    std::mutex mutex;
+    std::condition_variable queuedCondition;
+    std::condition_variable spaceCondition;
+    std::deque<PendingShader> queue;
+    unsigned int activeWorkers = threadCount;
+    std::atomic<bool> stopping(false);
+    const size_t queueCapacity = _queueCapacity;
+
+    auto emit = [&](PendingShader& pending)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceCondition.wait(lock, [&]()
+            {
+                return queue.size() < queueCapacity || stopping;
+            });
+            if (stopping)
+            {
+                return;
+            }
+            queue.push_back(std::move(pending));
+        }
+        queuedCondition.notify_one();
+    };
+
+    std::atomic<size_t> nextDocument(0);
+    auto runWorker = [&](GenContextPtr context, ConstDocumentPtr workerLibraries)
+    {
+        for (size_t i = nextDocument++; i < documentPaths.size() && !stopping; i = nextDocument++)
+        {
+            try
+            {
+                generateShaders(documentPaths[i], *context, workerLibraries, report.documents[i], emit);
+            }
+            catch (std::exception& e)
+            {
+                appendErrors(e, report.documents[i].errors);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        queuedCondition.notify_one();
+    };
+
+    {
+        WorkerJoiner workers([&]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            spaceCondition.notify_all();
+        });
+        for (unsigned int i = 0; i < threadCount; i++)
+        {
+            workers.add(std::thread(runWorker, contexts[i], libraries[i]));
+        }
+
+        while (true)
+        {
+            PendingShader pending;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                queuedCondition.wait(lock, [&]()
+                {
+                    return !queue.empty() || activeWorkers == 0;
+                });
+                if (queue.empty())
+                {
+                    break;
+                }
+                pending = std::move(queue.front());
+                queue.pop_front();
+            }
+            spaceCondition.notify_one();
+            validateShader(pending);
+            report.elements.push_back(std::move(pending.report));
+        }
+        workers.join();
+    }
+
+    std::sort(report.elements.begin(), report.elements.end(), [](const ElementReport& a, const ElementReport& b)
+    {
+        return a.documentPath != b.documentPath ? a.documentPath < b.documentPath : a.elementPath < b.elementPath;
+    });
+    report.totalTime = elapsedSince(batchStart);
+}
+
+void BatchValidator::generateShaders(const string& documentPath, GenContext& context, ConstDocumentPtr libraries,
+                                     DocumentReport& documentReport, const std::function<void(PendingShader&)>& emit) const
+{
+    documentReport.path = documentPath;
+
+    Clock::time_point loadStart = Clock::now();
+    DocumentPtr doc = createDocument();
+    vector<TypedElementPtr> elements;
+    try
+    {
+        readFromXmlFile(doc, documentPath);
+        if (libraries)
+        {
+            CopyOptions copyOptions;
+            copyOptions.skipDuplicateElements = true;
+            doc->importLibrary(libraries, &copyOptions);
+        }
+        findRenderableElements(doc, elements);
+    }
+    catch (std::exception& e)
+    {
+        appendErrors(e, documentReport.errors);
+        elements.clear();
+    }
+    documentReport.loadTime = elapsedSince(loadStart);
+
+    ShaderGenerator& shadergen = context.getShaderGenerator();
+    const string documentName = removeExtension(FilePath(documentPath).getBaseName());
+    for (TypedElementPtr element : elements)
+    {
+        // Skip elements without an implementation for the generator's target.
+        OutputPtr output = element->asA<Output>();
+        ShaderRefPtr shaderRef = element->asA<ShaderRef>();
+        NodePtr connectedNode = output ? output->getConnectedNode() : nullptr;
+        NodeDefPtr nodeDef = connectedNode ? connectedNode->getNodeDef() : (shaderRef ? shaderRef->getNodeDef() : nullptr);
+        if (!nodeDef || !nodeDef->getImplementation(shadergen.getTarget(), shadergen.getLanguage()))
+        {
+            continue;
+        }
+
+        PendingShader pending;
+        pending.report.documentPath = documentPath;
+        pending.report.elementPath = element->getNamePath();
+        pending.report.shaderName = createValidName(documentName + "_" + pending.report.elementPath);
+        pending.requiresShading = elementRequiresShading(element);
+
+        Clock::time_point generateStart = Clock::now();
+        try
+        {
+            context.getOptions().hwTransparency = isTransparentSurface(element, shadergen);
+            pending.shader = shadergen.generate(pending.report.shaderName, element, context);
+        }
+        catch (std::exception& e)
+        {
+            appendErrors(e, pending.report.errors);
+            pending.shader = nullptr;
+        }
+        pending.report.generateTime = elapsedSince(generateStart);
+
+        emit(pending);
+    }
+}
+
+void BatchValidator::validateShader(PendingShader& pending)
+{
+    ShaderPtr shader = pending.shader;
+    pending.shader = nullptr;
+    if (!shader || !_validator)
+    {
+        return;
+    }
+
+    ElementReport& report = pending.report;
+    Clock::time_point stageStart = Clock::now();
+    double* stageTime = &report.compileTime;
+    try
+    {
+        _validator->validateCreation(shader);
+        report.compileTime = elapsedSince(stageStart);
+
+        stageStart = Clock::now();
+        stageTime = &report.renderTime;
+        _validator->validateInputs();
+        _validator->validateRender(!pending.requiresShading);
+        report.renderTime = elapsedSince(stageStart);
+
+        if (!_outputPath.isEmpty())
+        {
+            stageStart = Clock::now();
+            stageTime = &report.saveTime;
+            _validator->save(_outputPath / FilePath(report.shaderName + ".png"), false);
+            report.saveTime = elapsedSince(stageStart);
+        }
+    }
+    catch (std::exception& e)
+    {
+        *stageTime = elapsedSince(stageStart);
+        appendErrors(e, report.errors);
+    }
+}
+
+} // namespace MaterialX
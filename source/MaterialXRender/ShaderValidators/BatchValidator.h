@@ -0,0 +1,213 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_BATCHVALIDATOR_H
+#define MATERIALX_BATCHVALIDATOR_H
+
+/// @file
+/// Pipelined validation of batches of documents
+
+#include <MaterialXRender/ShaderValidators/ShaderValidator.h>
+
+#include <MaterialXGenShader/GenContext.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace MaterialX
+{
+
+/// Shared pointer to a BatchValidator
+using BatchValidatorPtr = std::shared_ptr<class BatchValidator>;
+
+/// @class BatchValidator
+/// Validates the renderable elements of a batch of documents, overlapping the
+/// loading of documents and the generation of shaders with the validation of
+/// the shaders already generated.
+///
+/// Documents are loaded and their shaders generated on a pool of worker
+/// threads, each of which uses a GenContext of its own. Generated shaders are
+/// passed through a queue of bounded capacity to the calling thread, which
+/// compiles, renders and saves them with a single ShaderValidator, so that
+/// only the calling thread needs a current rendering context.
+///
+/// The results are gathered into a Report which records the time spent in
+/// each stage, and which may be written out as JSON for use by other tools.
+///
+class BatchValidator
+{
+  public:
+    /// Function returning a new GenContext, called on the calling thread
+    /// once for each worker
+    using GenContextCreator = std::function<GenContextPtr()>;
+
+    /// The outcome of loading a document
+    struct DocumentReport
+    {
+        /// Path to the document
+        string path;
+        /// Time in milliseconds spent reading the document, importing
+        /// libraries and finding renderable elements
+        double loadTime = 0.0;
+        /// Errors from loading the document. Empty if loading succeeded.
+        StringVec errors;
+    };
+
+    /// The outcome of validating a renderable element
+    struct ElementReport
+    {
+        /// Path to the document containing the element
+        string documentPath;
+        /// Name path of the element within its document
+        string elementPath;
+        /// Name of the generated shader, formed from the document and element names
+        string shaderName;
+        /// Time in milliseconds spent in each stage. Stages which were not
+        /// run are left at zero.
+        double generateTime = 0.0;
+        double compileTime = 0.0;
+        double renderTime = 0.0;
+        double saveTime = 0.0;
+        /// Errors from validating the element. Empty if validation succeeded.
+        StringVec errors;
+    };
+
+    /// The outcome of validating a batch
+    struct Report
+    {
+        /// Documents in the order given, one per path
+        vector<DocumentReport> documents;
+        /// Elements ordered by document and by element path
+        vector<ElementReport> elements;
+        /// Number of worker threads used
+        unsigned int threadCount = 0;
+        /// Wall clock time in milliseconds for the whole batch
+        double totalTime = 0.0;
+
+        /// Return the number of documents and elements with errors.
+        size_t getFailureCount() const;
+
+        /// Return the report as a JSON string.
+        string asJson() const;
+
+        /// Write the report as JSON to the given file.
+        /// @return True if the file was written.
+        bool writeJson(const FilePath& filePath) const;
+    };
+
+    /// Default number of generated shaders which may wait to be validated
+    static const size_t DEFAULT_QUEUE_CAPACITY = 16;
+
+    /// Create a batch validator
+    /// @param contextCreator Function returning a new GenContext for each worker
+    /// @param validator Validator used to compile, render and save shaders. If
+    ///    null, shaders are only generated.
+    static BatchValidatorPtr create(GenContextCreator contextCreator, ShaderValidatorPtr validator = nullptr)
+    {
+        return std::make_shared<BatchValidator>(contextCreator, validator);
+    }
+
+    /// Constructor
+    BatchValidator(GenContextCreator contextCreator, ShaderValidatorPtr validator = nullptr);
+
+    /// Destructor
+    virtual ~BatchValidator() { }
+
+    /// Set the document of libraries to import into each document loaded.
+    /// Each worker thread imports from a copy of the libraries made when
+    /// validation starts.
+    void setLibraries(ConstDocumentPtr libraries)
+    {
+        _libraries = libraries;
+    }
+
+    /// Return the document of libraries imported into each document loaded.
+    ConstDocumentPtr getLibraries() const
+    {
+        return _libraries;
+    }
+
+    /// Set the number of worker threads used to load documents and generate
+    /// shaders. A value of zero uses one thread per hardware thread. Defaults
+    /// to zero.
+    void setThreadCount(unsigned int threadCount)
+    {
+        _threadCount = threadCount;
+    }
+
+    /// Return the number of worker threads used to load documents and
+    /// generate shaders.
+    unsigned int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /// Set the number of generated shaders which may wait to be validated.
+    /// Workers which generate shaders faster than the calling thread
+    /// validates them wait for space in the queue. Defaults to
+    /// DEFAULT_QUEUE_CAPACITY.
+    void setQueueCapacity(size_t capacity)
+    {
+        _queueCapacity = std::max(capacity, (size_t) 1);
+    }
+
+    /// Return the number of generated shaders which may wait to be validated.
+    size_t getQueueCapacity() const
+    {
+        return _queueCapacity;
+    }
+
+    /// Set the directory to which rendered images are saved, as PNG files
+    /// named after their shaders. If empty, images are not saved. Defaults
+    /// to empty.
+    void setOutputPath(const FilePath& outputPath)
+    {
+        _outputPath = outputPath;
+    }
+
+    /// Return the directory to which rendered images are saved.
+    const FilePath& getOutputPath() const
+    {
+        return _outputPath;
+    }
+
+    /// Validate the renderable elements of the given documents.
+    /// Must be called on the thread of the validator's rendering context.
+    /// If an exception escapes the validator, the workers are stopped and
+    /// joined before the exception is rethrown.
+    /// @param documentPaths Paths to the documents to validate
+    /// @param report Returned report
+    void validate(const StringVec& documentPaths, Report& report);
+
+  protected:
+    // A generated shader waiting to be validated
+    struct PendingShader
+    {
+        ShaderPtr shader;
+        ElementReport report;
+        bool requiresShading = false;
+    };
+
+    /// Load a document, importing the given libraries, and generate the
+    /// shaders for its renderable elements, passing each to the given function.
+    void generateShaders(const string& documentPath, GenContext& context, ConstDocumentPtr libraries,
+                         DocumentReport& documentReport, const std::function<void(PendingShader&)>& emit) const;
+
+    /// Compile, render and save a generated shader. Shaders for elements
+    /// which do not require shading are rendered with an orthographic view.
+    void validateShader(PendingShader& pending);
+
+  protected:
+    GenContextCreator _contextCreator;
+    ShaderValidatorPtr _validator;
+    ConstDocumentPtr _libraries;
+    unsigned int _threadCount;
+    size_t _queueCapacity;
+    FilePath _outputPath;
+};
+
+} // namespace MaterialX
+
+#endif
@@ -12,6 +12,11 @@
 #include <dlfcn.h> // For dlopen
 #include <MaterialXRenderGlsl/External/GLew/glxew.h>
 #include <X11/Intrinsic.h>
+#if defined(MATERIALX_BUILD_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
 
 #elif defined(OSMac_)
 #include <MaterialXRenderHw/Window/WindowCocoaWrappers.h>
@@ -101,6 +106,9 @@ GLUtilityContext::GLUtilityContext(const WindowWrapper& windowWrapper,
     HardwareContextHandle sharedWithContext)
 {
     _isValid = false;
+    _eglDisplay = nullptr;
+    _eglContext = nullptr;
+    _eglSurface = nullptr;
 
     //
     // Unix implementation
@@ -237,6 +245,133 @@ GLUtilityContext::GLUtilityContext(const WindowWrapper& windowWrapper,
     }
 }
 
+#if defined(MATERIALX_BUILD_EGL)
+
+namespace {
+
+EGLDisplay initializeDisplay(EGLDisplay display)
+{
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+    {
+        return display;
+    }
+    return EGL_NO_DISPLAY;
+}
+
+bool hasExtension(const char* extensions, const char* extension)
+{
+    return extensions && std::strstr(extensions, extension);
+}
+
+// Find and initialize an EGL display which needs no display server,
+// preferring the Mesa surfaceless platform, then the platform of each EGL
+// device, as offered by drivers for headless GPUs, then the default display.
+EGLDisplay findHeadlessDisplay()
+{
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        EGLDisplay display = initializeDisplay(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+        if (display != EGL_NO_DISPLAY)
+        {
+            return display;
+        }
+    }
+
+    PFNEGLQUERYDEVICESEXTPROC queryDevices =
+        (PFNEGLQUERYDEVICESEXTPROC) eglGetProcAddress("eglQueryDevicesEXT");
+    if (getPlatformDisplay && queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device"))
+    {
+        const EGLint MAX_DEVICES = 16;
+        EGLDeviceEXT devices[MAX_DEVICES];
+        EGLint deviceCount = 0;
+        if (queryDevices(MAX_DEVICES, devices, &deviceCount))
+        {
+            for (EGLint i = 0; i < deviceCount; i++)
+            {
+                EGLDisplay display = initializeDisplay(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr));
+                if (display != EGL_NO_DISPLAY)
+                {
+                    return display;
+                }
+            }
+        }
+    }
+
+    return initializeDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+}
+
+} // anonymous namespace
+
+void GLUtilityContext::initializeHeadless(void* sharedContext)
+{
+    // The display is shared by all headless contexts, and is never
+    // terminated, as terminating it would destroy every context on it.
+    static EGLDisplay display = findHeadlessDisplay();
+    if (display == EGL_NO_DISPLAY || !eglBindAPI(EGL_OPENGL_API))
+    {
+        return;
+    }
+
+    const EGLint configAttributes[] =
+    {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount < 1)
+    {
+        return;
+    }
+
+    // Validation relies on fixed function state, so request a compatibility
+    // profile, falling back to the default context of the driver.
+    const EGLint contextAttributes[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 4,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 0,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    EGLContext shareContext = sharedContext ? (EGLContext) sharedContext : EGL_NO_CONTEXT;
+    EGLContext context = eglCreateContext(display, config, shareContext, contextAttributes);
+    if (context == EGL_NO_CONTEXT)
+    {
+        context = eglCreateContext(display, config, shareContext, nullptr);
+        if (context == EGL_NO_CONTEXT)
+        {
+            return;
+        }
+    }
+
+    // Rendering is to framebuffer objects, so a minimal surface suffices.
+    const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE)
+    {
+        eglDestroyContext(display, context);
+        return;
+    }
+
+    if (!eglMakeCurrent(display, surface, surface, context))
+    {
+        eglDestroySurface(display, surface);
+        eglDestroyContext(display, context);
+        return;
+    }
+
+    _eglDisplay = display;
+    _eglContext = context;
+    _eglSurface = surface;
+    _isValid = true;
+}
+
+#endif
+
 //
 // OSX implementation
 //
@@ -275,17 +410,31 @@ GLUtilityContext::~GLUtilityContext()
         wglDeleteContext(_contextHandle);
 
 #elif defined(OSLinux_)
-        glXMakeCurrent(_display, None, NULL);
-
-        // This needs to be done after all the GL object
-        // created with this context are destroyed.
-        if (_contextHandle != 0)
+        if (_eglContext)
         {
-            glXDestroyContext(_display, _contextHandle);
+#if defined(MATERIALX_BUILD_EGL)
+            if (eglGetCurrentContext() == _eglContext)
+            {
+                eglMakeCurrent(_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            }
+            eglDestroySurface(_eglDisplay, _eglSurface);
+            eglDestroyContext(_eglDisplay, _eglContext);
+#endif
         }
-        if (_dummyWindow != 0)
+        else
         {
-            XDestroyWindow(_display, _dummyWindow);
+            glXMakeCurrent(_display, None, NULL);
+
+            // This needs to be done after all the GL object
+            // created with this context are destroyed.
+            if (_contextHandle != 0)
+            {
+                glXDestroyContext(_display, _contextHandle);
+            }
+            if (_dummyWindow != 0)
+            {
+                XDestroyWindow(_display, _dummyWindow);
+            }
         }
 
 #elif defined(OSMac_)
@@ -310,7 +459,18 @@ int GLUtilityContext::makeCurrent()
 #if defined(OSWin_)
     makeCurrentOk = wglMakeCurrent(_dummyWindow.windowWrapper().internalHandle(), _contextHandle);
 #elif defined(OSLinux_)
-    makeCurrentOk = glXMakeCurrent(_display, _dummyWindow, _contextHandle);
+    if (_eglContext)
+    {
+#if defined(MATERIALX_BUILD_EGL)
+        // The client API is a per-thread setting, so bind it on each call.
+        eglBindAPI(EGL_OPENGL_API);
+        makeCurrentOk = eglMakeCurrent(_eglDisplay, _eglSurface, _eglSurface, _eglContext);
+#endif
+    }
+    else
+    {
+        makeCurrentOk = glXMakeCurrent(_display, _dummyWindow, _contextHandle);
+    }
 #elif defined(OSMac_)
     NSOpenGLMakeCurrent(_contextHandle);
     if (NSOpenGLGetCurrentContextWrapper() == _contextHandle)
@@ -331,4 +491,32 @@ GLUtilityContextPtr GLUtilityContext::create(const WindowWrapper& windowWrapper,
     return std::shared_ptr<GLUtilityContext>(new GLUtilityContext(windowWrapper, context));
 }
 
+GLUtilityContextPtr GLUtilityContext::createHeadless(GLUtilityContextPtr sharedContext)
+{
+    GLUtilityContextPtr context(new GLUtilityContext());
+#if defined(OSLinux_) && defined(MATERIALX_BUILD_EGL)
+    if (sharedContext && !sharedContext->isHeadless())
+    {
+        return context;
+    }
+    context->initializeHeadless(sharedContext ? sharedContext->_eglContext : nullptr);
+#else
+    (void) sharedContext;
+#endif
+    return context;
+}
+
+GLUtilityContext::GLUtilityContext() :
+#if defined(OSLinux_)
+    _dummyWindow(0),
+    _display(nullptr),
+    _eglDisplay(nullptr),
+    _eglContext(nullptr),
+    _eglSurface(nullptr),
+#endif
+    _contextHandle(0),
+    _isValid(false)
+{
+}
+
 }
@@ -49,10 +49,19 @@ class GLUtilityContext
     /// Create a utility context
     static GLUtilityContextPtr create(const WindowWrapper& windowWrapper, HardwareContextHandle context = 0);
 
+    /// Create a headless utility context, which requires no window or
+    /// display server and so can only render to framebuffer objects.
+    /// The new context is made current on the calling thread.
+    /// Headless contexts are supported on Linux builds with
+    /// MATERIALX_BUILD_EGL, and are invalid elsewhere.
+    /// @param sharedContext A headless context to share objects with. If
+    ///    null, the new context is independent of all others.
+    static GLUtilityContextPtr createHeadless(GLUtilityContextPtr sharedContext = nullptr);
+
     /// Default destructor
     virtual ~GLUtilityContext();
 
-    /// Return OpenGL context handle
+    /// Return OpenGL context handle. Headless contexts return a null handle.
     HardwareContextHandle contextHandle() const
     {
         return _contextHandle;
@@ -69,6 +78,16 @@ class GLUtilityContext
         return _isValid;
     }
 
+    /// Return if context is headless
+    bool isHeadless() const
+    {
+#if defined(OSLinux_)
+        return _eglContext != nullptr;
+#else
+        return false;
+#endif
+    }
+
     /// Make the context "current" before execution of OpenGL operations
     int makeCurrent();
 
@@ -81,6 +100,15 @@ class GLUtilityContext
     /// Create the base context. A OpenGL context to share with can be passed in.
     GLUtilityContext(const WindowWrapper& windowWrapper, HardwareContextHandle context = 0);
 
+    /// Create an invalid context, to be initialized as a headless context.
+    GLUtilityContext();
+
+#if defined(OSLinux_)
+    /// Create an EGL context and surface on a display which needs no display
+    /// server, sharing objects with the given EGL context if it is not null.
+    void initializeHeadless(void* sharedContext);
+#endif
+
 #if defined(OSWin_)
     /// Offscreen window required for context operations
     SimpleWindow _dummyWindow;
@@ -91,6 +119,12 @@ class GLUtilityContext
     Display *_display;
     /// Window wrapper used by context operations
     WindowWrapper _windowWrapper;
+    /// EGL display of a headless context
+    void* _eglDisplay;
+    /// EGL context of a headless context
+    void* _eglContext;
+    /// EGL pixel buffer surface of a headless context
+    void* _eglSurface;
 #endif
 
     /// Context handle
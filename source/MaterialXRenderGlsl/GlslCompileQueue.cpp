@@ -0,0 +1,185 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRenderGlsl/External/GLew/glew.h>
+#include <MaterialXRenderGlsl/GlslCompileQueue.h>
+
+namespace MaterialX
+{
+
+//
+// GlslCompileQueue methods
+//
+
+GlslCompileQueue::GlslCompileQueue(const vector<GLUtilityContextPtr>& workerContexts) :
+    _workerPendingCount(0),
+    _stopping(false)
+{
+    for (GLUtilityContextPtr context : workerContexts)
+    {
+        _workers.push_back(std::thread(&GlslCompileQueue::runWorker, this, context));
+    }
+}
+
+GlslCompileQueue::~GlslCompileQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _queuedCondition.notify_all();
+    for (std::thread& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+void GlslCompileQueue::submit(GlslProgramPtr program)
+{
+    if (_workers.empty())
+    {
+        program->startBuild();
+        _started.push_back(program);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queued.push_back(program);
+        _workerPendingCount++;
+    }
+    _queuedCondition.notify_one();
+}
+
+size_t GlslCompileQueue::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _started.size() + _workerPendingCount;
+}
+
+size_t GlslCompileQueue::poll(ResultList& results)
+{
+    if (!_workers.empty())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _workerPendingCount -= _completed.size();
+        results.insert(results.end(), _completed.begin(), _completed.end());
+        _completed.clear();
+        return _workerPendingCount;
+    }
+
+    if (_started.empty())
+    {
+        return 0;
+    }
+    if (!GlslProgram::isParallelCompileSupported())
+    {
+        results.push_back(finish(_started.front()));
+        _started.pop_front();
+        return _started.size();
+    }
+
+    std::deque<GlslProgramPtr> stillStarted;
+    for (GlslProgramPtr program : _started)
+    {
+        if (program->isBuildComplete())
+        {
+            results.push_back(finish(program));
+        }
+        else
+        {
+            stillStarted.push_back(program);
+        }
+    }
+    _started.swap(stillStarted);
+    return _started.size();
+}
+
+void GlslCompileQueue::wait(ResultList& results)
+{
+    if (!_workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _completedCondition.wait(lock, [this]()
+        {
+            return _completed.size() == _workerPendingCount;
+        });
+        _workerPendingCount = 0;
+        results.insert(results.end(), _completed.begin(), _completed.end());
+        _completed.clear();
+        return;
+    }
+
+    for (GlslProgramPtr program : _started)
+    {
+        results.push_back(finish(program));
+    }
+    _started.clear();
+}
+
+GlslCompileQueue::Result GlslCompileQueue::finish(GlslProgramPtr program)
+{
+    Result result;
+    result.program = program;
+    try
+    {
+        program->finishBuild();
+    }
+    catch (ExceptionShaderValidationError& e)
+    {
+        result.errors = e.errorLog();
+        if (result.errors.empty())
+        {
+            result.errors.push_back(e.what());
+        }
+    }
+    return result;
+}
+
+void GlslCompileQueue::runWorker(GLUtilityContextPtr context)
+{
+    bool isCurrent = context && context->makeCurrent();
+    while (true)
+    {
+        GlslProgramPtr program;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queuedCondition.wait(lock, [this]()
+            {
+                return _stopping || !_queued.empty();
+            });
+            if (_queued.empty())
+            {
+                return;
+            }
+            program = _queued.front();
+            _queued.pop_front();
+        }
+
+        Result result;
+        if (isCurrent)
+        {
+            program->startBuild();
+            result = finish(program);
+
+            // Make the program and its buffers visible to the other contexts
+            // of the share group before reporting the result.
+            glFinish();
+        }
+        else
+        {
+            result.program = program;
+            result.errors.push_back("Unable to make the worker context current.");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _completed.push_back(result);
+        }
+        _completedCondition.notify_all();
+    }
+}
+
+} // namespace MaterialX
@@ -0,0 +1,113 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_GLSLCOMPILEQUEUE_H
+#define MATERIALX_GLSLCOMPILEQUEUE_H
+
+/// @file
+/// Queue of GLSL programs building concurrently
+
+#include <MaterialXRenderGlsl/GLUtilityContext.h>
+#include <MaterialXRenderGlsl/GlslProgram.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace MaterialX
+{
+
+/// Shared pointer to a GlslCompileQueue
+using GlslCompileQueuePtr = std::shared_ptr<class GlslCompileQueue>;
+
+/// @class GlslCompileQueue
+/// A queue of GlslPrograms whose builds overlap one another and the work of
+/// the calling thread.
+///
+/// A queue builds programs in one of two ways:
+///     - Without worker contexts, the stages of submitted programs are compiled
+///       and linked without waiting on the driver. When the driver supports
+///       parallel shader compilation, the work proceeds on driver threads and
+///       finished programs are collected by polling their completion status.
+///       Otherwise programs are finished one at a time in submission order.
+///     - With worker contexts, each context is made current on a worker thread
+///       of its own, and submitted programs are built on the first available
+///       worker. The contexts must share objects with the context in which the
+///       programs are used. This is intended for drivers which do not support
+///       parallel shader compilation.
+///
+/// Submitting programs and collecting results must be done on the thread of
+/// the OpenGL context in which the programs are used.
+///
+class GlslCompileQueue
+{
+  public:
+    /// The outcome of a program build
+    struct Result
+    {
+        /// Program which was built
+        GlslProgramPtr program;
+        /// Program creation errors. Empty if the build succeeded.
+        ShaderValidationErrorList errors;
+    };
+    /// List of build results
+    using ResultList = vector<Result>;
+
+    /// Create a compile queue
+    /// @param workerContexts Contexts in which to build programs on worker threads.
+    ///    If empty, programs are built in the current context.
+    static GlslCompileQueuePtr create(const vector<GLUtilityContextPtr>& workerContexts = vector<GLUtilityContextPtr>())
+    {
+        return std::make_shared<GlslCompileQueue>(workerContexts);
+    }
+
+    /// Constructor
+    explicit GlslCompileQueue(const vector<GLUtilityContextPtr>& workerContexts = vector<GLUtilityContextPtr>());
+
+    /// Destructor. Waits for the worker threads to finish any builds in progress.
+    virtual ~GlslCompileQueue();
+
+    /// Start building a program from its current stages.
+    void submit(GlslProgramPtr program);
+
+    /// Return the number of programs whose results have not yet been collected.
+    size_t getPendingCount() const;
+
+    /// Collect the results of programs whose builds have completed, appending
+    /// them to the given list. When building in the current context on a driver
+    /// without parallel shader compilation, the oldest pending program is
+    /// finished instead.
+    /// @return The number of programs still pending.
+    size_t poll(ResultList& results);
+
+    /// Finish all pending programs, appending their results to the given list.
+    void wait(ResultList& results);
+
+  protected:
+    /// Finish building a program and return its result.
+    static Result finish(GlslProgramPtr program);
+
+    /// Build queued programs in the given context until the queue is destroyed.
+    void runWorker(GLUtilityContextPtr context);
+
+  private:
+    // Programs started in the current context
+    std::deque<GlslProgramPtr> _started;
+
+    // Worker threads, with the state they share with the calling thread
+    vector<std::thread> _workers;
+    mutable std::mutex _mutex;
+    std::condition_variable _queuedCondition;
+    std::condition_variable _completedCondition;
+    std::deque<GlslProgramPtr> _queued;
+    ResultList _completed;
+    size_t _workerPendingCount;
+    bool _stopping;
+};
+
+} // namespace MaterialX
+
+#endif
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace MaterialX
 {
@@ -24,11 +25,58 @@ int GlslProgram::Input::INVALID_OPENGL_TYPE = -1;
 static string RADIANCE_ENV_UNIFORM_NAME("u_envRadiance");
 static string IRRADIANCE_ENV_UNIFORM_NAME("u_envIrradiance");
 
+/// Prefix for the attribute buffer key of an interleaved vertex buffer
+static string INTERLEAVED_BUFFER_PREFIX("interleaved:");
+
 /// Sampling constants
 static string UADDRESS_MODE_POST_FIX("_uaddressmode");
 static string VADDRESS_MODE_POST_FIX("_vaddressmode");
 static string FILTER_TYPE_POST_FIX("_filterType");
 static string DEFAULT_COLOR_POST_FIX("_default");
+static string IMAGE_SEPARATOR("_");
+
+/// Return true if the current context can retrieve and reload program binaries
+static bool isProgramBinarySupported()
+{
+    if (!glGetProgramBinary || !glProgramBinary)
+    {
+        return false;
+    }
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+/// Create and compile a shader of the given type, without waiting for the
+/// result. Returns UNDEFINED_OPENGL_RESOURCE_ID for an empty source.
+static GLuint compileShader(GLenum type, const string& source)
+{
+    if (source.empty())
+    {
+        return GlslProgram::UNDEFINED_OPENGL_RESOURCE_ID;
+    }
+    GLuint shaderId = glCreateShader(type);
+    const char* sourceChar = source.c_str();
+    glShaderSource(shaderId, 1, &sourceChar, NULL);
+    glCompileShader(shaderId);
+    return shaderId;
+}
+
+/// Return a string identifying the driver of the current context
+static string getDriverIdentity()
+{
+    string identity;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        const GLubyte* value = glGetString(name);
+        if (value)
+        {
+            identity += reinterpret_cast<const char*>(value);
+        }
+        identity += "\n";
+    }
+    return identity;
+}
 
 //
 // Creator
@@ -40,10 +88,12 @@ GlslProgramPtr GlslProgram::create()
 
 GlslProgram::GlslProgram() :
     _programId(UNDEFINED_OPENGL_RESOURCE_ID),
+    _bindingPlanValid(false),
     _shader(nullptr),
     _indexBuffer(0),
     _indexBufferSize(0),
-    _vertexArray(0)
+    _vertexArray(0),
+    _interleavedStreams(false)
 {
 }
 
@@ -101,12 +151,18 @@ void GlslProgram::clearStages()
 
 void GlslProgram::deleteProgram()
 {
+    if (_buildState.pending)
+    {
+        deleteBuildState();
+        _buildState.cacheKey.clear();
+    }
     if (_programId > UNDEFINED_OPENGL_RESOURCE_ID)
     {
         glUseProgram(0);
         glDeleteObjectARB(_programId);
         _programId = UNDEFINED_OPENGL_RESOURCE_ID;
     }
+    deleteUniformBuffers();
 
     // Program deleted, so also clear cached input lists
     clearInputLists();
@@ -114,10 +170,74 @@ void GlslProgram::deleteProgram()
 
 unsigned int GlslProgram::build()
 {
-    ShaderValidationErrorList errors;
-    const std::string errorType("GLSL program creation error.");
+    startBuild();
+    return finishBuild();
+}
 
+void GlslProgram::startBuild()
+{
     deleteProgram();
+    _buildState.pending = true;
+
+    // Reload a previously linked binary of the same stages, if available
+    if (_programCache && isProgramBinarySupported())
+    {
+        _buildState.cacheKey = GlslProgramCache::computeKey(_stages, getDriverIdentity());
+        if (loadProgramBinary(_buildState.cacheKey))
+        {
+            _buildState.fromCache = true;
+            _buildState.cacheKey.clear();
+            return;
+        }
+    }
+
+    // Compile and link without querying any status, so that drivers
+    // supporting parallel compilation can complete the work in the background.
+    _buildState.vertexShaderId = compileShader(GL_VERTEX_SHADER, _stages[Stage::VERTEX]);
+    _buildState.fragmentShaderId = compileShader(GL_FRAGMENT_SHADER, _stages[Stage::PIXEL]);
+
+    _programId = glCreateProgram();
+    if (!_buildState.cacheKey.empty())
+    {
+        glProgramParameteri(_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    for (GLuint shaderId : { _buildState.vertexShaderId, _buildState.fragmentShaderId })
+    {
+        if (shaderId > UNDEFINED_OPENGL_RESOURCE_ID)
+        {
+            glAttachShader(_programId, shaderId);
+        }
+    }
+    glLinkProgram(_programId);
+}
+
+bool GlslProgram::isParallelCompileSupported()
+{
+    // GL_KHR_parallel_shader_compile shares its tokens with the ARB extension,
+    // and drivers exposing one expose the other.
+    return GLEW_ARB_parallel_shader_compile == GL_TRUE;
+}
+
+bool GlslProgram::isBuildComplete() const
+{
+    if (!_buildState.pending || !isParallelCompileSupported())
+    {
+        return true;
+    }
+    GLint completionStatus = GL_TRUE;
+    glGetProgramiv(_programId, GL_COMPLETION_STATUS_ARB, &completionStatus);
+    return completionStatus == GL_TRUE;
+}
+
+unsigned int GlslProgram::finishBuild()
+{
+    if (!_buildState.pending)
+    {
+        return _programId;
+    }
+
+    ShaderValidationErrorList errors;
+    const std::string errorType("GLSL program creation error.");
 
     GLint GLStatus = GL_FALSE;
     int GLInfoLogLength = 0;
@@ -130,128 +250,160 @@ unsigned int GlslProgram::build()
             desiredStages++;
     }
 
-    // Create vertex shader
-    GLuint vertexShaderId = UNDEFINED_OPENGL_RESOURCE_ID;
-    std::string &vertexShaderSource = _stages[Stage::VERTEX];
-    if (vertexShaderSource.length())
+    // Check the stages, unless the program was loaded from the cache
+    if (!_buildState.fromCache)
     {
-        vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
-
-        // Compile vertex shader
-        const char* vertexChar = vertexShaderSource.c_str();
-        glShaderSource(vertexShaderId, 1, &vertexChar, NULL);
-        glCompileShader(vertexShaderId);
+        const std::pair<GLuint, const char*> shaders[] =
+        {
+            { _buildState.vertexShaderId, "vertex" },
+            { _buildState.fragmentShaderId, "fragment" }
+        };
+        for (const auto& shader : shaders)
+        {
+            if (shader.first == UNDEFINED_OPENGL_RESOURCE_ID)
+            {
+                continue;
+            }
+            glGetShaderiv(shader.first, GL_COMPILE_STATUS, &GLStatus);
+            if (GLStatus == GL_FALSE)
+            {
+                errors.push_back(string("Error in compiling ") + shader.second + " shader:");
+                glGetShaderiv(shader.first, GL_INFO_LOG_LENGTH, &GLInfoLogLength);
+                if (GLInfoLogLength > 0)
+                {
+                    std::vector<char> errorMessage(GLInfoLogLength + 1);
+                    glGetShaderInfoLog(shader.first, GLInfoLogLength, NULL,
+                        &errorMessage[0]);
+                    errors.push_back(&errorMessage[0]);
+                }
+            }
+            else
+            {
+                stagesBuilt++;
+            }
+        }
 
-        // Check Vertex Shader
-        glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &GLStatus);
-        if (GLStatus == GL_FALSE)
+        // Check the program
+        if (stagesBuilt == desiredStages)
         {
-            errors.push_back("Error in compiling vertex shader:");
-            glGetShaderiv(vertexShaderId, GL_INFO_LOG_LENGTH, &GLInfoLogLength);
-            if (GLInfoLogLength > 0)
+            glGetProgramiv(_programId, GL_LINK_STATUS, &GLStatus);
+            if (GLStatus == GL_FALSE)
             {
-                std::vector<char> vsErrorMessage(GLInfoLogLength + 1);
-                glGetShaderInfoLog(vertexShaderId, GLInfoLogLength, NULL,
-                    &vsErrorMessage[0]);
-                errors.push_back(&vsErrorMessage[0]);
+                errors.push_back("Error in linking program:");
+                glGetProgramiv(_programId, GL_INFO_LOG_LENGTH, &GLInfoLogLength);
+                if (GLInfoLogLength > 0)
+                {
+                    std::vector<char> ProgramErrorMessage(GLInfoLogLength + 1);
+                    glGetProgramInfoLog(_programId, GLInfoLogLength, NULL,
+                        &ProgramErrorMessage[0]);
+                    errors.push_back(&ProgramErrorMessage[0]);
+                }
             }
         }
         else
         {
-            stagesBuilt++;
+            errors.push_back("Failed to build all stages.");
         }
     }
 
-    // Create fragment shader
-    GLuint fragmentShaderId = UNDEFINED_OPENGL_RESOURCE_ID;
-    std::string& fragmentShaderSource = _stages[Stage::PIXEL];
-    if (fragmentShaderSource.length())
-    {
-        fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
-
-        // Compile fragment shader
-        const char *fragmentChar = fragmentShaderSource.c_str();
-        glShaderSource(fragmentShaderId, 1, &fragmentChar, NULL);
-        glCompileShader(fragmentShaderId);
+    // Cleanup
+    deleteBuildState();
 
-        // Check fragment shader
-        glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &GLStatus);
-        if (GLStatus == GL_FALSE)
-        {
-            errors.push_back("Error in compiling fragment shader:");
-            glGetShaderiv(fragmentShaderId, GL_INFO_LOG_LENGTH, &GLInfoLogLength);
-            if (GLInfoLogLength > 0)
-            {
-                std::vector<char> fsErrorMessage(GLInfoLogLength + 1);
-                glGetShaderInfoLog(fragmentShaderId, GLInfoLogLength, NULL,
-                    &fsErrorMessage[0]);
-                errors.push_back(&fsErrorMessage[0]);
-            }
-        }
-        else
+    // If we encountered any errors while trying to create return list
+    // of all errors. That is we collect all errors per stage plus any
+    // errors during linking and throw one exception for them all so that
+    // if there is a failure a complete set of issues is returned. We do
+    // this after cleanup so keep GL state clean.
+    if (errors.size())
+    {
+        if (stagesBuilt != desiredStages)
         {
-            stagesBuilt++;
+            glDeleteProgram(_programId);
+            _programId = UNDEFINED_OPENGL_RESOURCE_ID;
         }
+        _buildState.cacheKey.clear();
+        throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    // Link stages to a programs
-    if (stagesBuilt == desiredStages)
+    if (!_buildState.cacheKey.empty())
     {
-        _programId = glCreateProgram();
-        glAttachShader(_programId, vertexShaderId);
-        glAttachShader(_programId, fragmentShaderId);
-        glLinkProgram(_programId);
+        saveProgramBinary(_buildState.cacheKey);
+        _buildState.cacheKey.clear();
+    }
 
-        // Check the program
-        glGetProgramiv(_programId, GL_LINK_STATUS, &GLStatus);
-        if (GLStatus == GL_FALSE)
+    createUniformBuffers();
+
+    return _programId;
+}
+
+void GlslProgram::deleteBuildState()
+{
+    for (GLuint shaderId : { _buildState.vertexShaderId, _buildState.fragmentShaderId })
+    {
+        if (shaderId > UNDEFINED_OPENGL_RESOURCE_ID)
         {
-            errors.push_back("Error in linking program:");
-            glGetProgramiv(_programId, GL_INFO_LOG_LENGTH, &GLInfoLogLength);
-            if (GLInfoLogLength > 0)
+            if (_programId > UNDEFINED_OPENGL_RESOURCE_ID)
             {
-                std::vector<char> ProgramErrorMessage(GLInfoLogLength + 1);
-                glGetProgramInfoLog(_programId, GLInfoLogLength, NULL,
-                    &ProgramErrorMessage[0]);
-                errors.push_back(&ProgramErrorMessage[0]);
+                glDetachShader(_programId, shaderId);
             }
+            glDeleteShader(shaderId);
         }
     }
-    else
+    _buildState.vertexShaderId = UNDEFINED_OPENGL_RESOURCE_ID;
+    _buildState.fragmentShaderId = UNDEFINED_OPENGL_RESOURCE_ID;
+    _buildState.pending = false;
+    _buildState.fromCache = false;
+}
+
+bool GlslProgram::loadProgramBinary(const string& key)
+{
+    unsigned int format = 0;
+    vector<unsigned char> binary;
+    if (!_programCache->read(key, format, binary))
     {
-        errors.push_back("Failed to build all stages.");
-        throw ExceptionShaderValidationError(errorType, errors);
+        return false;
     }
 
-    // Cleanup
-    if (vertexShaderId > UNDEFINED_OPENGL_RESOURCE_ID)
+    _programId = glCreateProgram();
+    glProgramBinary(_programId, format, binary.data(), (GLsizei) binary.size());
+
+    // A binary may be rejected by the driver, for example after a driver
+    // update, in which case the program is rebuilt from source.
+    GLint GLStatus = GL_FALSE;
+    glGetProgramiv(_programId, GL_LINK_STATUS, &GLStatus);
+    if (GLStatus == GL_FALSE)
     {
-        if (_programId > UNDEFINED_OPENGL_RESOURCE_ID)
+        glDeleteProgram(_programId);
+        _programId = UNDEFINED_OPENGL_RESOURCE_ID;
+        while (glGetError() != GL_NO_ERROR)
         {
-            glDetachShader(_programId, vertexShaderId);
         }
-        glDeleteShader(vertexShaderId);
+        return false;
     }
-    if (fragmentShaderId > UNDEFINED_OPENGL_RESOURCE_ID)
+    return true;
+}
+
+void GlslProgram::saveProgramBinary(const string& key)
+{
+    GLint binaryLength = 0;
+    glGetProgramiv(_programId, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
     {
-        if (_programId > UNDEFINED_OPENGL_RESOURCE_ID)
-        {
-            glDetachShader(_programId, fragmentShaderId);
-        }
-        glDeleteShader(fragmentShaderId);
+        return;
     }
 
-    // If we encountered any errors while trying to create return list
-    // of all errors. That is we collect all errors per stage plus any
-    // errors during linking and throw one exception for them all so that
-    // if there is a failure a complete set of issues is returned. We do
-    // this after cleanup so keep GL state clean.
-    if (errors.size())
+    vector<unsigned char> binary(binaryLength);
+    GLenum format = 0;
+    GLsizei length = 0;
+    glGetProgramBinary(_programId, binaryLength, &length, &format, binary.data());
+    if (length <= 0)
     {
-        throw ExceptionShaderValidationError(errorType, errors);
+        return;
     }
+    binary.resize(length);
 
-    return _programId;
+    // Failure to write the cache is not an error, as the program is valid.
+    _programCache->write(key, format, binary);
 }
 
 bool GlslProgram::bind()
@@ -294,6 +446,7 @@ void GlslProgram::bindInputs(ViewHandlerPtr viewHandler,
     bindTextures(imageHandler);
     bindTimeAndFrame();
     bindLighting(lightHandler, imageHandler);
+    bindUniformBlocks();
 
     // Set up raster state for transparency as needed
     if (_shader->hasAttribute(HW::ATTR_TRANSPARENT))
@@ -337,6 +490,40 @@ void GlslProgram::bindAttribute(const MaterialX::GlslProgram::InputMap& inputs,
         int location = input.second->location;
         unsigned int index = input.second->value ? input.second->value->asA<int>() : 0;
 
+        if (_interleavedStreams)
+        {
+            MeshInterleavedBufferPtr interleavedBuffer = mesh->getInterleavedBuffer();
+            const MeshInterleavedBuffer::Attribute* attribute = interleavedBuffer->getAttribute(input.first);
+            if (!attribute || interleavedBuffer->getData().empty())
+            {
+                errors.push_back("Geometry buffer could not be retrieved for binding: " + input.first + ". Index: " + std::to_string(index));
+                throw ExceptionShaderValidationError(errorType, errors);
+            }
+
+            // All attributes of a mesh share a single buffer.
+            const std::string bufferKey = INTERLEAVED_BUFFER_PREFIX + mesh->getIdentifier();
+            auto bufferIt = _attributeBufferIds.find(bufferKey);
+            if (bufferIt == _attributeBufferIds.end())
+            {
+                const MeshFloatBuffer& bufferData = interleavedBuffer->getData();
+                unsigned int bufferId = MaterialX::GlslProgram::UNDEFINED_OPENGL_RESOURCE_ID;
+                glGenBuffers(1, &bufferId);
+                glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+                glBufferData(GL_ARRAY_BUFFER, bufferData.size() * FLOAT_SIZE, &bufferData[0], GL_STATIC_DRAW);
+                _attributeBufferIds[bufferKey] = bufferId;
+            }
+            else
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, bufferIt->second);
+            }
+
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, attribute->stream->getStride(), GL_FLOAT, GL_FALSE,
+                                  (GLsizei) (interleavedBuffer->getStride() * FLOAT_SIZE),
+                                  reinterpret_cast<const void*>(attribute->offset * FLOAT_SIZE));
+            continue;
+        }
+
         unsigned int stride = 0;
         MeshStreamPtr stream = mesh->getStream(input.first);
         if (!stream)
@@ -576,58 +763,77 @@ void GlslProgram::bindTextures(ImageHandlerPtr imageHandler)
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    // Bind textures based on uniforms found in the program
-    const MaterialX::GlslProgram::InputMap& uniformList = getUniformsList();
-    const std::string IMAGE_SEPERATOR("_");
-    for (auto uniform : uniformList)
+    // Bind textures based on the precomputed binding plan
+    for (const UniformBinding& binding : getBindingPlan())
+    {
+        bindTexture(binding.gltype, binding.location, binding.filePath, imageHandler, true, binding.samplingProperties);
+    }
+    checkErrors();
+}
+
+const GlslProgram::BindingPlan& GlslProgram::getBindingPlan()
+{
+    const InputMap& uniformList = getUniformsList();
+    if (!_bindingPlanValid)
     {
-        GLenum uniformType = uniform.second->gltype;
-        GLint uniformLocation = uniform.second->location;
-        if (uniformLocation >= 0 &&
-            uniformType >= GL_SAMPLER_1D && uniformType <= GL_SAMPLER_CUBE)
+        createBindingPlan(uniformList, _bindingPlan);
+        _bindingPlanValid = true;
+    }
+    return _bindingPlan;
+}
+
+void GlslProgram::createBindingPlan(const InputMap& uniformList, BindingPlan& plan)
+{
+    plan.clear();
+    for (const auto& uniform : uniformList)
+    {
+        const Input& input = *uniform.second;
+        if (input.location < 0 ||
+            input.gltype < GL_SAMPLER_1D || input.gltype > GL_SAMPLER_CUBE)
         {
-            const std::string fileName(uniform.second->value ? uniform.second->value->getValueString() : "");
+            continue;
+        }
 
-            // Skip binding if nothing to bind or if is a lighting texture.
-            // Lighting textures are handled in the bindLighting() call
-            if (!fileName.empty() &&
-                fileName != RADIANCE_ENV_UNIFORM_NAME &&
-                fileName != IRRADIANCE_ENV_UNIFORM_NAME)
-            {
-                // Get the additional texture parameters based on image uniform name
-                MaterialX::StringVec root = MaterialX::splitString(uniform.first, IMAGE_SEPERATOR);
-
-                ImageSamplingProperties samplingProperties;
-
-                const int INVALID_MAPPED_INT_VALUE = -1; // Any value < 0 is not considered to be invalid
-                const std::string uaddressModeStr = root[0] + UADDRESS_MODE_POST_FIX;
-                ValuePtr intValue = findUniformValue(uaddressModeStr, uniformList);
-                samplingProperties.uaddressMode = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
-
-                const std::string vaddressmodeStr = root[0] + VADDRESS_MODE_POST_FIX;
-                intValue = findUniformValue(vaddressmodeStr, uniformList);
-                samplingProperties.vaddressMode = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
-
-                const std::string filtertypeStr = root[0] + FILTER_TYPE_POST_FIX;
-                intValue = findUniformValue(filtertypeStr, uniformList);
-                samplingProperties.filterType = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
-
-                const std::string defaultColorStr = root[0] + DEFAULT_COLOR_POST_FIX;
-                ValuePtr colorValue = findUniformValue(defaultColorStr, uniformList);
-                Color4 defaultColor;
-                mapValueToColor(colorValue, defaultColor);
-                samplingProperties.defaultColor[0] = defaultColor[0];
-                samplingProperties.defaultColor[1] = defaultColor[1];
-                samplingProperties.defaultColor[2] = defaultColor[2];
-                samplingProperties.defaultColor[3] = defaultColor[3];
-                bindTexture(uniformType, uniformLocation, fileName, imageHandler, true, samplingProperties);
-            }
+        // Skip binding if nothing to bind or if is a lighting texture.
+        // Lighting textures are handled in the bindLighting() call
+        const std::string fileName(input.value ? input.value->getValueString() : EMPTY_STRING);
+        if (fileName.empty() ||
+            fileName == RADIANCE_ENV_UNIFORM_NAME ||
+            fileName == IRRADIANCE_ENV_UNIFORM_NAME)
+        {
+            continue;
         }
+
+        UniformBinding binding;
+        binding.location = input.location;
+        binding.gltype = input.gltype;
+        binding.filePath = fileName;
+
+        // Get the additional texture parameters based on image uniform name
+        const StringVec root = splitString(uniform.first, IMAGE_SEPARATOR);
+        const std::string& prefix = root.empty() ? EMPTY_STRING : root[0];
+        ImageSamplingProperties& samplingProperties = binding.samplingProperties;
+
+        const int INVALID_MAPPED_INT_VALUE = -1; // Any value < 0 is not considered to be invalid
+        ValuePtr intValue = findUniformValue(prefix + UADDRESS_MODE_POST_FIX, uniformList);
+        samplingProperties.uaddressMode = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
+        intValue = findUniformValue(prefix + VADDRESS_MODE_POST_FIX, uniformList);
+        samplingProperties.vaddressMode = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
+        intValue = findUniformValue(prefix + FILTER_TYPE_POST_FIX, uniformList);
+        samplingProperties.filterType = intValue && intValue->isA<int>() ? intValue->asA<int>() : INVALID_MAPPED_INT_VALUE;
+
+        ValuePtr colorValue = findUniformValue(prefix + DEFAULT_COLOR_POST_FIX, uniformList);
+        Color4 defaultColor;
+        mapValueToColor(colorValue, defaultColor);
+        samplingProperties.defaultColor[0] = defaultColor[0];
+        samplingProperties.defaultColor[1] = defaultColor[1];
+        samplingProperties.defaultColor[2] = defaultColor[2];
+        samplingProperties.defaultColor[3] = defaultColor[3];
+
+        plan.push_back(binding);
     }
-    checkErrors();
 }
 
-
 void GlslProgram::bindLighting(HwLightHandlerPtr lightHandler, ImageHandlerPtr imageHandler)
 {
     if (!lightHandler)
@@ -654,16 +860,17 @@ void GlslProgram::bindLighting(HwLightHandlerPtr lightHandler, ImageHandlerPtr i
 
     // Set the number of active light sources
     size_t lightCount = lightHandler->getLightSources().size();
+    const int32_t activeLightCount = int32_t(lightCount);
     auto input = uniformList.find("u_numActiveLightSources");
     if (input != uniformList.end())
     {
         location = input->second->location;
         if (location >= 0)
         {
-            glUniform1i(location, int(lightCount));
+            glUniform1i(location, activeLightCount);
         }
     }
-    else
+    else if (!setBlockUniformData("u_numActiveLightSources", &activeLightCount, sizeof(activeLightCount)))
     {
         // No lighting information so nothing further to do
         lightCount = 0;
@@ -853,30 +1060,9 @@ void GlslProgram::bindViewInformation(ViewHandlerPtr viewHandler)
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    GLint location = MaterialX::GlslProgram::UNDEFINED_OPENGL_PROGRAM_LOCATION;
-
     // Set view direction and position
-    const MaterialX::GlslProgram::InputMap& uniformList = getUniformsList();
-    auto Input = uniformList.find("u_viewPosition");
-    if (Input != uniformList.end())
-    {
-        location = Input->second->location;
-        if (location >= 0)
-        {
-            Vector3& viewPosition = viewHandler->viewPosition();
-            glUniform3f(location, viewPosition[0], viewPosition[1], viewPosition[2]);
-        }
-    }
-    Input = uniformList.find("u_viewDirection");
-    if (Input != uniformList.end())
-    {
-        location = Input->second->location;
-        if (location >= 0)
-        {
-            Vector3& viewDirection = viewHandler->viewDirection();
-            glUniform3f(location, viewDirection[0], viewDirection[1], viewDirection[2]);
-        }
-    }
+    bindUniformVector("u_viewPosition", viewHandler->viewPosition());
+    bindUniformVector("u_viewDirection", viewHandler->viewDirection());
 
     Matrix44& worldMatrix = viewHandler->worldMatrix();
     Matrix44& viewMatrix = viewHandler->viewMatrix();
@@ -895,15 +1081,7 @@ void GlslProgram::bindViewInformation(ViewHandlerPtr viewHandler)
     };
     for (auto worldMatrixVariable : worldMatrixVariables)
     {
-        Input = uniformList.find(worldMatrixVariable);
-        if (Input != uniformList.end())
-        {
-            location = Input->second->location;
-            if (location >= 0)
-            {
-                glUniformMatrix4fv(location, 1, false, &(worldMatrix[0][0]));
-            }
-        }
+        bindUniformMatrix(worldMatrixVariable, worldMatrix);
     }
 
     // Bind projection matrices
@@ -919,25 +1097,21 @@ void GlslProgram::bindViewInformation(ViewHandlerPtr viewHandler)
     bool computedInverse = false;
     for (auto projectionMatrixVariable : projectionMatrixVariables)
     {
-        Input = uniformList.find(projectionMatrixVariable);
-        if (Input != uniformList.end())
+        if (hasUniform(projectionMatrixVariable))
         {
-            location = Input->second->location;
-            if (location >= 0)
+            bool transpose = (projectionMatrixVariable.find("Transpose") != std::string::npos);
+            if (projectionMatrixVariable.find("Inverse") != std::string::npos)
             {
-                bool transpose = (projectionMatrixVariable.find("Transpose") != std::string::npos);
-                if (projectionMatrixVariable.find("Inverse") != std::string::npos)
-                {
-                    if (!computedInverse)
-                    {
-                        inverseProjection = projectionMatrix.getInverse();
-                    }
-                    glUniformMatrix4fv(location, 1, transpose, &(inverseProjection[0][0]));
-                }
-                else
+                if (!computedInverse)
                 {
-                    glUniformMatrix4fv(location, 1, transpose, &(projectionMatrix[0][0]));
+                    inverseProjection = projectionMatrix.getInverse();
+                    computedInverse = true;
                 }
+                bindUniformMatrix(projectionMatrixVariable, inverseProjection, transpose);
+            }
+            else
+            {
+                bindUniformMatrix(projectionMatrixVariable, projectionMatrix, transpose);
             }
         }
     }
@@ -954,25 +1128,21 @@ void GlslProgram::bindViewInformation(ViewHandlerPtr viewHandler)
     computedInverse = false;
     for (auto viewMatrixVariable : viewMatrixVariables)
     {
-        Input = uniformList.find(viewMatrixVariable);
-        if (Input != uniformList.end())
+        if (hasUniform(viewMatrixVariable))
         {
-            location = Input->second->location;
-            if (location >= 0)
+            bool transpose = (viewMatrixVariable.find("Transpose") != std::string::npos);
+            if (viewMatrixVariable.find("Inverse") != std::string::npos)
             {
-                bool transpose = (viewMatrixVariable.find("Transpose") != std::string::npos);
-                if (viewMatrixVariable.find("Inverse") != std::string::npos)
+                if (!computedInverse)
                 {
-                    if (!computedInverse)
-                    {
-                        inverseView = viewMatrix.getInverse();
-                    }
-                    glUniformMatrix4fv(location, 1, transpose, &(inverseView[0][0]));
-                }
-                else
-                {
-                    glUniformMatrix4fv(location, 1, transpose, &(viewMatrix[0][0]));
+                    inverseView = viewMatrix.getInverse();
+                    computedInverse = true;
                 }
+                bindUniformMatrix(viewMatrixVariable, inverseView, transpose);
+            }
+            else
+            {
+                bindUniformMatrix(viewMatrixVariable, viewMatrix, transpose);
             }
         }
     }
@@ -985,15 +1155,7 @@ void GlslProgram::bindViewInformation(ViewHandlerPtr viewHandler)
     };
     for (auto combinedMatrixVariable : combinedMatrixVariables)
     {
-        Input = uniformList.find(combinedMatrixVariable);
-        if (Input != uniformList.end())
-        {
-            location = Input->second->location;
-            if (location >= 0)
-            {
-                glUniformMatrix4fv(location, 1, GL_FALSE, &(viewProjection[0][0]));
-            }
-        }
+        bindUniformMatrix(combinedMatrixVariable, viewProjection);
     }
 
     checkErrors();
@@ -1010,32 +1172,186 @@ void GlslProgram::bindTimeAndFrame()
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    GLint location = MaterialX::GlslProgram::UNDEFINED_OPENGL_PROGRAM_LOCATION;
+    // Bind time and frame
+    bindUniformFloat("u_time", 1.0f);
+    bindUniformFloat("u_frame", 1.0f);
+}
 
-    // Bind time
-    const MaterialX::GlslProgram::InputMap& uniformList = getUniformsList();
-    auto Input = uniformList.find("u_time");
-    if (Input != uniformList.end())
+bool GlslProgram::setBlockUniform(const string& name, const Value& value)
+{
+    for (UniformBuffer& buffer : _uniformBuffers)
     {
-        location = Input->second->location;
-        if (location >= 0)
+        const UniformBlockLayout::Member* member = buffer.layout.findMember(name);
+        if (member)
         {
-            glUniform1f(location, 1.0f);
+            bool changed = false;
+            if (!UniformBlockLayout::packValue(*member, value, buffer.data.data(), &changed))
+            {
+                return false;
+            }
+            buffer.dirty = buffer.dirty || changed;
+            return true;
         }
     }
+    return false;
+}
 
-    // Bind frame
-    Input = uniformList.find("u_frame");
-    if (Input != uniformList.end())
+bool GlslProgram::setBlockUniformData(const string& name, const void* data, size_t size)
+{
+    for (UniformBuffer& buffer : _uniformBuffers)
     {
-        location = Input->second->location;
-        if (location >= 0)
+        const UniformBlockLayout::Member* member = buffer.layout.findMember(name);
+        if (member)
+        {
+            if (member->size != size)
+            {
+                return false;
+            }
+            unsigned char* dest = buffer.data.data() + member->offset;
+            if (std::memcmp(dest, data, size) != 0)
+            {
+                std::memcpy(dest, data, size);
+                buffer.dirty = true;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GlslProgram::hasUniform(const string& name)
+{
+    const InputMap& uniformList = getUniformsList();
+    auto input = uniformList.find(name);
+    if (input != uniformList.end() && input->second->location >= 0)
+    {
+        return true;
+    }
+    for (const UniformBuffer& buffer : _uniformBuffers)
+    {
+        if (buffer.layout.findMember(name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GlslProgram::bindUniformMatrix(const string& name, const Matrix44& matrix, bool transpose)
+{
+    const InputMap& uniformList = getUniformsList();
+    auto input = uniformList.find(name);
+    if (input != uniformList.end() && input->second->location >= 0)
+    {
+        glUniformMatrix4fv(input->second->location, 1, transpose, matrix.data());
+    }
+    else if (transpose)
+    {
+        Matrix44 transposed = matrix.getTranspose();
+        setBlockUniformData(name, transposed.data(), sizeof(Matrix44));
+    }
+    else
+    {
+        setBlockUniformData(name, matrix.data(), sizeof(Matrix44));
+    }
+}
+
+void GlslProgram::bindUniformVector(const string& name, const Vector3& vector)
+{
+    const InputMap& uniformList = getUniformsList();
+    auto input = uniformList.find(name);
+    if (input != uniformList.end() && input->second->location >= 0)
+    {
+        glUniform3f(input->second->location, vector[0], vector[1], vector[2]);
+    }
+    else
+    {
+        setBlockUniformData(name, vector.data(), sizeof(Vector3));
+    }
+}
+
+void GlslProgram::bindUniformFloat(const string& name, float value)
+{
+    const InputMap& uniformList = getUniformsList();
+    auto input = uniformList.find(name);
+    if (input != uniformList.end() && input->second->location >= 0)
+    {
+        glUniform1f(input->second->location, value);
+    }
+    else
+    {
+        setBlockUniformData(name, &value, sizeof(float));
+    }
+}
+
+void GlslProgram::bindUniformBlocks()
+{
+    for (size_t i = 0; i < _uniformBuffers.size(); i++)
+    {
+        UniformBuffer& buffer = _uniformBuffers[i];
+        if (buffer.dirty)
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer.bufferId);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, buffer.data.size(), buffer.data.data());
+            buffer.dirty = false;
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, GLuint(i), buffer.bufferId);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, UNDEFINED_OPENGL_RESOURCE_ID);
+    checkErrors();
+}
+
+void GlslProgram::createUniformBuffers()
+{
+    deleteUniformBuffers();
+    if (!_shader || !_shader->hasAttribute(HW::ATTR_UNIFORM_BLOCKS))
+    {
+        return;
+    }
+
+    // The packable uniforms of each block are shared between stages,
+    // so the layout can be taken from the pixel stage.
+    const ShaderStage& ps = _shader->getStage(Stage::PIXEL);
+    for (const string& blockName : { HW::PUBLIC_UNIFORMS, HW::PRIVATE_UNIFORMS })
+    {
+        // Skip blocks which are empty or have been optimized out.
+        GLuint blockIndex = glGetUniformBlockIndex(_programId, blockName.c_str());
+        if (blockIndex == GL_INVALID_INDEX)
         {
-            glUniform1f(location, 1.0f);
+            continue;
         }
+
+        UniformBuffer buffer;
+        buffer.layout = UniformBlockLayout(ps.getUniformBlock(blockName));
+        buffer.layout.packValues(buffer.data);
+        buffer.dirty = false;
+
+        // Allocate at least the size reported by the driver.
+        GLint blockSize = 0;
+        glGetActiveUniformBlockiv(_programId, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+        if (size_t(blockSize) > buffer.data.size())
+        {
+            buffer.data.resize(size_t(blockSize), 0);
+        }
+
+        glGenBuffers(1, &buffer.bufferId);
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer.bufferId);
+        glBufferData(GL_UNIFORM_BUFFER, buffer.data.size(), buffer.data.data(), GL_DYNAMIC_DRAW);
+        glUniformBlockBinding(_programId, blockIndex, GLuint(_uniformBuffers.size()));
+        _uniformBuffers.push_back(buffer);
     }
+    glBindBuffer(GL_UNIFORM_BUFFER, UNDEFINED_OPENGL_RESOURCE_ID);
+    checkErrors();
 }
 
+void GlslProgram::deleteUniformBuffers()
+{
+    for (const UniformBuffer& buffer : _uniformBuffers)
+    {
+        glDeleteBuffers(1, &buffer.bufferId);
+    }
+    _uniformBuffers.clear();
+}
 
 bool GlslProgram::haveActiveAttributes() const
 {
@@ -1057,6 +1373,8 @@ void GlslProgram::clearInputLists()
 {
     _uniformList.clear();
     _attributeList.clear();
+    _bindingPlan.clear();
+    _bindingPlanValid = false;
 }
 
 const GlslProgram::InputMap& GlslProgram::getUniformsList()
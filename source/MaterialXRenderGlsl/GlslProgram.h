@@ -10,6 +10,9 @@
 /// GLSL Program interfaces
 
 #include <MaterialXGenShader/Shader.h>
+#include <MaterialXGenShader/UniformBlockLayout.h>
+
+#include <MaterialXRenderGlsl/GlslProgramCache.h>
 
 #include <MaterialXRender/ShaderValidators/ExceptionShaderValidationError.h>
 #include <MaterialXRender/Handlers/ViewHandler.h>
@@ -65,6 +68,22 @@ class GlslProgram
     /// Clear out any existing stages
     void clearStages();
 
+    /// Set a cache of program binaries to use when building the program.
+    /// If the driver supports program binaries, build() reloads a previously
+    /// linked binary of the same stages from the cache when one exists, and
+    /// stores the result of each source build otherwise.
+    /// @param cache Program cache, or nullptr to always build from source.
+    void setProgramCache(GlslProgramCachePtr cache)
+    {
+        _programCache = cache;
+    }
+
+    /// Return the cache of program binaries, if any.
+    GlslProgramCachePtr getProgramCache() const
+    {
+        return _programCache;
+    }
+
     /// @}
     /// @name Program validation and introspection
     /// @{
@@ -75,6 +94,26 @@ class GlslProgram
     /// @return Program identifier. 
     unsigned int build();
 
+    /// Start creating the shader program from the stages specified, without
+    /// waiting for compilation or linking to complete. Equivalent to build()
+    /// when followed by finishBuild().
+    void startBuild();
+
+    /// Return true if the current context compiles and links programs in the
+    /// background, through GL_KHR_parallel_shader_compile or its ARB equivalent.
+    static bool isParallelCompileSupported();
+
+    /// Return true if a build started with startBuild() can be finished
+    /// without waiting on the driver. Always true if the driver does not
+    /// support parallel shader compilation.
+    bool isBuildComplete() const;
+
+    /// Finish a build started with startBuild(), waiting for the driver if required.
+    /// An exception is thrown if the program cannot be created.
+    /// The exception will contain a list of program creation errors.
+    /// @return Program identifier.
+    unsigned int finishBuild();
+
     /// Structure to hold information about program inputs
     /// The structure is populated by directly scanning the program so may not contain
     /// some inputs listed on any associated HwShader as those inputs may have been
@@ -125,6 +164,43 @@ class GlslProgram
     /// @return Program attributes list.
     const InputMap& getAttributesList();
 
+    /// Structure holding a precomputed binding of a sampler uniform.
+    /// Records are resolved once from the uniform list, so that textures can
+    /// be bound each frame without name lookups or string manipulation.
+    struct UniformBinding
+    {
+        /// Program location
+        int location;
+        /// OpenGL type of the uniform
+        int gltype;
+        /// File path to bind
+        FilePath filePath;
+        /// Sampling properties resolved from the associated uniforms
+        ImageSamplingProperties samplingProperties;
+    };
+    /// Program binding plan type
+    using BindingPlan = vector<UniformBinding>;
+
+    /// Get the binding plan for the program uniforms.
+    /// The plan is built from the uniform list on first use, and is rebuilt
+    /// whenever the uniform list is updated.
+    /// @return Program binding plan.
+    const BindingPlan& getBindingPlan();
+
+    /// Build a binding plan from a list of program uniforms.
+    /// Sampler uniforms with a valid location and a file value are recorded,
+    /// along with the address modes, filter type and default color found in the
+    /// list under the same uniform prefix. Lighting textures are excluded, as
+    /// these are bound by bindLighting().
+    /// @param uniformList List of program uniforms
+    /// @param plan Returned binding plan
+    static void createBindingPlan(const InputMap& uniformList, BindingPlan& plan);
+
+    /// Utility to map a MaterialX type to an OpenGL type
+    /// @param type MaterialX type
+    /// @return OpenGL type. INVALID_OPENGL_TYPE is returned if no mapping exists. For example strings have no OpenGL type.
+    static int mapTypeToOpenGLType(const TypeDesc* type);
+
     /// Find the locations in the program which starts with a given variable name
     /// @param variable Variable to search for
     /// @param variableList List of program inputs to search
@@ -158,6 +234,17 @@ class GlslProgram
     /// Assign a parameter value to a uniform
     void bindUniform(int location, const Value& value);
 
+    /// Assign a value to a uniform declared in a uniform block.
+    /// The block is uploaded on the next call to bindUniformBlocks(),
+    /// if the value changed its contents.
+    /// @return False if no uniform block member of the given name exists,
+    ///    or if the value does not match the type of the member.
+    bool setBlockUniform(const string& name, const Value& value);
+
+    /// Upload any modified uniform blocks, and bind all uniform blocks
+    /// of the program to their buffers.
+    void bindUniformBlocks();
+
     /// Bind attribute buffers to attribute inputs.
     /// A hardware buffer of the given attribute type is created and bound to the program locations
     /// for the input attribute.
@@ -171,6 +258,20 @@ class GlslProgram
     /// Bind input geometry streams
     void bindStreams(MeshPtr mesh);
 
+    /// Set whether geometry streams are bound from a single interleaved
+    /// vertex buffer, rather than from one buffer per stream. Defaults to false.
+    void setInterleavedStreams(bool interleaved)
+    {
+        _interleavedStreams = interleaved;
+    }
+
+    /// Return true if geometry streams are bound from a single interleaved
+    /// vertex buffer.
+    bool getInterleavedStreams() const
+    {
+        return _interleavedStreams;
+    }
+
     /// Unbind any bound geometry
     void unbindGeometry();
 
@@ -219,14 +320,9 @@ class GlslProgram
     /// Clear out any cached input lists
     void clearInputLists();   
 
-    /// Utility to map a MaterialX type to an OpenGL type
-    /// @param type MaterialX type
-    /// @return OpenGL type. INVALID_OPENGL_TYPE is returned if no mapping exists. For example strings have no OpenGL type.
-    static int mapTypeToOpenGLType(const TypeDesc* type);
-
     /// Utility to find a uniform value in an uniform list.
     /// If uniform cannot be found a null pointer will be return.
-    MaterialX::ValuePtr findUniformValue(const std::string& uniformName, const InputMap& uniformList);
+    static MaterialX::ValuePtr findUniformValue(const std::string& uniformName, const InputMap& uniformList);
 
     /// @}
     /// @name Utilities
@@ -236,6 +332,29 @@ class GlslProgram
     bool bindTexture(unsigned int uniformType, int uniformLocation, const FilePath& filePath,
                      ImageHandlerPtr imageHandler, bool generateMipMaps, const ImageSamplingProperties& imageProperties);
 
+    /// Create buffers for the uniform blocks declared by the hardware shader
+    void createUniformBuffers();
+
+    /// Delete any uniform block buffers
+    void deleteUniformBuffers();
+
+    /// Write packed data for a uniform stored in a uniform block
+    /// @return False if no uniform block member of the given name and size exists.
+    bool setBlockUniformData(const string& name, const void* data, size_t size);
+
+    /// Return true if a uniform with the given name is bound by location
+    /// or is stored in a uniform block
+    bool hasUniform(const string& name);
+
+    /// Assign a matrix to a uniform, bound either by location or within a uniform block
+    void bindUniformMatrix(const string& name, const Matrix44& matrix, bool transpose = false);
+
+    /// Assign a vector to a uniform, bound either by location or within a uniform block
+    void bindUniformVector(const string& name, const Vector3& vector);
+
+    /// Assign a float to a uniform, bound either by location or within a uniform block
+    void bindUniformFloat(const string& name, float value);
+
     /// Utility to check for OpenGL context errors.
     /// Will throw an ExceptionShaderValidationError exception which will list of the errors found
     /// if any errors encountered.
@@ -244,6 +363,16 @@ class GlslProgram
     /// Delete any currently created shader program
     void deleteProgram();
 
+    /// Delete the shaders of a pending build
+    void deleteBuildState();
+
+    /// Create the program from a binary in the program cache.
+    /// @return False if no usable binary was found for the given key.
+    bool loadProgramBinary(const string& key);
+
+    /// Store the binary of the linked program in the program cache.
+    void saveProgramBinary(const string& key);
+
     /// @}
 
   private:
@@ -254,14 +383,46 @@ class GlslProgram
     /// Generated program. A non-zero number indicates a valid shader program.
     unsigned int _programId;
 
+    /// State of a build started by startBuild()
+    struct BuildState
+    {
+        BuildState() :
+            pending(false),
+            fromCache(false),
+            vertexShaderId(0),
+            fragmentShaderId(0)
+        {
+        }
+
+        /// Is a build waiting to be finished
+        bool pending;
+        /// Was the program loaded from the program cache
+        bool fromCache;
+        /// Vertex shader resource handle
+        unsigned int vertexShaderId;
+        /// Fragment shader resource handle
+        unsigned int fragmentShaderId;
+        /// Key under which to store the linked program in the program cache
+        string cacheKey;
+    };
+    BuildState _buildState;
+
     /// List of program input uniforms
     InputMap _uniformList;
     /// List of program input attributes
     InputMap _attributeList;
 
+    /// Binding plan for program input uniforms
+    BindingPlan _bindingPlan;
+    /// Is the binding plan up to date with the uniform list
+    bool _bindingPlanValid;
+
     /// Hardware shader (if any) used for program creation
     ShaderPtr _shader;
 
+    /// Cache of program binaries (if any)
+    GlslProgramCachePtr _programCache;
+
     /// Attribute buffer resource handles
     /// for each attribute identifier in the program
     std::unordered_map<std::string, unsigned int> _attributeBufferIds;
@@ -274,8 +435,28 @@ class GlslProgram
     /// Attribute vertex array handle
     unsigned int _vertexArray;
 
+    /// Bind streams from an interleaved vertex buffer
+    bool _interleavedStreams;
+
     /// Program texture map
     std::unordered_map<std::string, unsigned int> _programTextures;
+
+    /// Buffer holding the packed values of a uniform block
+    struct UniformBuffer
+    {
+        /// Layout of the block
+        UniformBlockLayout layout;
+        /// Packed values of the block
+        vector<unsigned char> data;
+        /// Buffer resource handle
+        unsigned int bufferId;
+        /// Has the data changed since it was last uploaded
+        bool dirty;
+    };
+
+    /// Uniform block buffers. Each is bound to the binding point
+    /// matching its index.
+    vector<UniformBuffer> _uniformBuffers;
 };
 
 } // namespace MaterialX
@@ -0,0 +1,197 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRenderGlsl/GlslProgramCache.h>
+
+#include <MaterialXGenShader/Util.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace MaterialX
+{
+
+const string GlslProgramCache::EXTENSION = "mxglprog";
+
+namespace {
+
+const char FILE_MAGIC[8] = { 'M', 'X', 'G', 'L', 'P', 'R', 'O', 'G' };
+const uint32_t FILE_VERSION = 1;
+
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t format;
+    uint64_t binarySize;
+    uint64_t checksum;
+};
+
+// Accumulate a block of bytes into a 64-bit FNV-1a hash.
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Accumulate a string into a hash, including its length so that
+// adjacent strings cannot run into one another.
+uint64_t hashString(const string& str, uint64_t hash)
+{
+    uint64_t length = str.size();
+    hash = hashBytes(&length, sizeof(length), hash);
+    return hashBytes(str.data(), str.size(), hash);
+}
+
+} // anonymous namespace
+
+//
+// GlslProgramCache methods
+//
+
+string GlslProgramCache::computeKey(const StringMap& stages, const string& driverIdentity)
+{
+    // Hash stages in name order, as the iteration order of the map is unspecified.
+    StringVec names;
+    names.reserve(stages.size());
+    for (const auto& stage : stages)
+    {
+        if (!stage.second.empty())
+        {
+            names.push_back(stage.first);
+        }
+    }
+    std::sort(names.begin(), names.end());
+
+    uint64_t hash = hashString(driverIdentity, FNV_OFFSET_BASIS);
+    for (const string& name : names)
+    {
+        hash = hashString(name, hash);
+        hash = hashString(stages.at(name), hash);
+    }
+
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long) hash);
+    return string(key);
+}
+
+FilePath GlslProgramCache::getFilePath(const string& key) const
+{
+    return _directory / (key + "." + EXTENSION);
+}
+
+bool GlslProgramCache::read(const string& key, unsigned int& format, vector<unsigned char>& binary) const
+{
+    std::ifstream file(getFilePath(key).asString(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    std::streamoff fileSize = file.tellg();
+    if (fileSize < (std::streamoff) sizeof(FileHeader))
+    {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return false;
+    }
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        header.version != FILE_VERSION ||
+        header.binarySize == 0 ||
+        header.binarySize != (uint64_t) fileSize - sizeof(FileHeader))
+    {
+        return false;
+    }
+
+    binary.resize((size_t) header.binarySize);
+    if (!file.read(reinterpret_cast<char*>(binary.data()), (std::streamsize) binary.size()) ||
+        hashBytes(binary.data(), binary.size()) != header.checksum)
+    {
+        binary.clear();
+        return false;
+    }
+    format = header.format;
+    return true;
+}
+
+bool GlslProgramCache::write(const string& key, unsigned int format, const vector<unsigned char>& binary) const
+{
+    if (binary.empty())
+    {
+        return false;
+    }
+    if (!_directory.exists())
+    {
+        makeDirectory(_directory.asString());
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.format = format;
+    header.binarySize = binary.size();
+    header.checksum = hashBytes(binary.data(), binary.size());
+
+    // Write under a name unique to this process and thread, as the cache
+    // directory may be shared between processes, then move into place.
+#if defined(_WIN32)
+    const long processId = (long) _getpid();
+#else
+    const long processId = (long) getpid();
+#endif
+    string filePath = getFilePath(key).asString();
+    string tempPath = filePath + "." + std::to_string(processId) + "." +
+                      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data()), (std::streamsize) binary.size());
+        if (!file.good())
+        {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+#if defined(_WIN32)
+    std::remove(filePath.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace MaterialX
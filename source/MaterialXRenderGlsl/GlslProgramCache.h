@@ -0,0 +1,94 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_GLSLPROGRAMCACHE_H
+#define MATERIALX_GLSLPROGRAMCACHE_H
+
+/// @file
+/// On-disk cache of linked GLSL program binaries
+
+#include <MaterialXCore/Library.h>
+
+#include <MaterialXFormat/File.h>
+
+namespace MaterialX
+{
+
+/// Shared pointer to a GlslProgramCache
+using GlslProgramCachePtr = std::shared_ptr<class GlslProgramCache>;
+
+/// @class GlslProgramCache
+/// A directory of linked program binaries, as returned by glGetProgramBinary,
+/// which allows a GlslProgram to skip compiling and linking its stages when
+/// the same program has been built before.
+///
+/// Each binary is stored under a key derived from the source code of every
+/// stage and from the identity of the OpenGL driver, since binaries can only
+/// be reloaded by the driver which created them. Entries that cannot be read
+/// back, or whose contents do not match their stored checksum, are treated as
+/// missing so that the caller falls back to building from source.
+///
+class GlslProgramCache
+{
+  public:
+    /// File extension of cache entries
+    static const string EXTENSION;
+
+    /// Create a cache stored in the given directory. The directory is
+    /// created when the first entry is written.
+    static GlslProgramCachePtr create(const FilePath& directory)
+    {
+        return std::make_shared<GlslProgramCache>(directory);
+    }
+
+    /// Constructor
+    explicit GlslProgramCache(const FilePath& directory) :
+        _directory(directory)
+    {
+    }
+
+    /// Destructor
+    virtual ~GlslProgramCache() { }
+
+    /// Return the directory of the cache.
+    const FilePath& getDirectory() const
+    {
+        return _directory;
+    }
+
+    /// Return the key of a program built from the given stages.
+    /// @param stages Map of stage name to stage source code
+    /// @param driverIdentity String identifying the OpenGL driver, such as
+    ///    its vendor, renderer and version strings
+    /// @return Hexadecimal key which is independent of the iteration order of
+    ///    the stage map.
+    static string computeKey(const StringMap& stages, const string& driverIdentity);
+
+    /// Return the path of the cache entry for a given key.
+    FilePath getFilePath(const string& key) const;
+
+    /// Read a program binary from the cache.
+    /// @param key Key of the program
+    /// @param format Returned binary format of the program
+    /// @param binary Returned program binary
+    /// @return True if a valid entry was found.
+    bool read(const string& key, unsigned int& format, vector<unsigned char>& binary) const;
+
+    /// Write a program binary to the cache, replacing any existing entry.
+    /// The entry is written to a temporary file first, so that concurrent
+    /// readers never see a partially written entry.
+    /// @param key Key of the program
+    /// @param format Binary format of the program
+    /// @param binary Program binary
+    /// @return True if the entry was written successfully.
+    bool write(const string& key, unsigned int format, const vector<unsigned char>& binary) const;
+
+  private:
+    FilePath _directory;
+};
+
+} // namespace MaterialX
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
 
 namespace MaterialX
 {
@@ -38,8 +39,14 @@ GlslValidator::GlslValidator() :
     _initialized(false),
     _window(nullptr),
     _context(nullptr),
+    _headless(false),
     _orthographicView(true)
 {
+#if defined(OSLinux_) && defined(MATERIALX_BUILD_EGL)
+    const char* display = std::getenv("DISPLAY");
+    _headless = !display || !*display;
+#endif
+
     _program = GlslProgram::create();
 
     SampleObjLoaderPtr loader = SampleObjLoader::create();
@@ -70,20 +77,31 @@ void GlslValidator::initialize()
 
     if (!_initialized)
     {
-        // Create window
-        _window = SimpleWindow::create();
-
-        const char* windowName = "Validator Window";
-        bool created = _window->initialize(const_cast<char *>(windowName),
-                                          _frameBufferWidth, _frameBufferHeight,
-                                          nullptr);
-        if (!created)
+        if (_headless)
         {
-            errors.push_back("Failed to create window for testing.");
-            throw ExceptionShaderValidationError(errorType, errors);
+            // Create headless context, rendering only to the offscreen target
+            _context = GLUtilityContext::createHeadless();
+            if (!_context->isValid())
+            {
+                errors.push_back("Failed to create headless OpenGL context for testing.");
+                throw ExceptionShaderValidationError(errorType, errors);
+            }
         }
         else
         {
+            // Create window
+            _window = SimpleWindow::create();
+
+            const char* windowName = "Validator Window";
+            bool created = _window->initialize(const_cast<char *>(windowName),
+                                              _frameBufferWidth, _frameBufferHeight,
+                                              nullptr);
+            if (!created)
+            {
+                errors.push_back("Failed to create window for testing.");
+                throw ExceptionShaderValidationError(errorType, errors);
+            }
+
             // Create offscreen context
             _context = GLUtilityContext::create(_window->windowWrapper(), nullptr);
             if (!_context)
@@ -91,29 +109,27 @@ void GlslValidator::initialize()
                 errors.push_back("Failed to create OpenGL context for testing.");
                 throw ExceptionShaderValidationError(errorType, errors);
             }
-            else
-            {
-                if (_context->makeCurrent())
-                {
-                    // Initialize glew
-                    bool initializedFunctions = true;
+        }
 
-                    glewInit();
-                    if (!glewIsSupported("GL_VERSION_4_0"))
-                    {
-                        initializedFunctions = false;
-                        errors.push_back("OpenGL version 4.0 not supported");
-                        throw ExceptionShaderValidationError(errorType, errors);
-                    }
+        if (_context->makeCurrent())
+        {
+            // Initialize glew
+            bool initializedFunctions = true;
 
-                    if (initializedFunctions)
-                    {
-                        glClearColor(0.4f, 0.4f, 0.4f, 0.0f);
-                        glClearStencil(0);
+            glewInit();
+            if (!glewIsSupported("GL_VERSION_4_0"))
+            {
+                initializedFunctions = false;
+                errors.push_back("OpenGL version 4.0 not supported");
+                throw ExceptionShaderValidationError(errorType, errors);
+            }
 
-                        _initialized = true;
-                    }
-                }
+            if (initializedFunctions)
+            {
+                glClearColor(0.4f, 0.4f, 0.4f, 0.0f);
+                glClearStencil(0);
+
+                _initialized = true;
             }
         }
     }
@@ -494,6 +510,11 @@ void GlslValidator::save(const FilePath& filePath, bool floatingPoint)
         errors.push_back("No image handler specified.");
         throw ExceptionShaderValidationError(errorType, errors);
     }
+    if (!_context || !_context->makeCurrent())
+    {
+        errors.push_back("Cannot make OpenGL context current to read back from.");
+        throw ExceptionShaderValidationError(errorType, errors);
+    }
 
     size_t bufferSize = _frameBufferWidth * _frameBufferHeight * 4;
     float* buffer = new float[bufferSize];
@@ -56,6 +56,21 @@ class GlslValidator : public ShaderValidator
     /// The exception will contain a list of initialization errors.
     void initialize() override;
 
+    /// Set whether to render without a window, through a headless OpenGL
+    /// context which requires no display server. Must be set before
+    /// initialization. Headless rendering is supported on Linux builds with
+    /// MATERIALX_BUILD_EGL, where it is the default when no X display is set.
+    void setHeadless(bool headless)
+    {
+        _headless = headless;
+    }
+
+    /// Return whether to render without a window.
+    bool isHeadless() const
+    {
+        return _headless;
+    }
+
     /// @}
     /// @name Validation
     /// @{
@@ -151,6 +166,9 @@ class GlslValidator : public ShaderValidator
     /// Dummy OpenGL context for OpenGL usage
     GLUtilityContextPtr _context;
 
+    /// Flag to indicate if rendering is without a window
+    bool _headless;
+
     /// Whether to draw a flat quad or use 3d perspective view
     bool _orthographicView;
 };
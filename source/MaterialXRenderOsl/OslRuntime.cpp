@@ -0,0 +1,365 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXRenderOsl/OslRuntime.h>
+
+#include <OSL/oslcomp.h>
+#include <OSL/oslexec.h>
+#include <OSL/rendererservices.h>
+#include <OpenImageIO/errorhandler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+namespace {
+
+const string OSL_COMPILATION_ERROR("OSL compilation error.");
+const string OSL_RENDERING_ERROR("OSL rendering error.");
+
+// The OSL compiler keeps global parser state, so only one compilation
+// may run at a time within a process.
+std::mutex compilerMutex;
+
+// Error handler which records the errors reported on each thread separately,
+// so that concurrent jobs can each retrieve their own errors.
+class ErrorCollector : public OIIO::ErrorHandler
+{
+  public:
+    void operator()(int errcode, const std::string& msg) override
+    {
+        if (errcode < EH_ERROR || errcode >= EH_DEBUG)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _errors[std::this_thread::get_id()].push_back(msg);
+    }
+
+    // Move the errors recorded on the current thread to the given list.
+    void takeErrors(ShaderValidationErrorList& errors)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _errors.find(std::this_thread::get_id());
+        if (it != _errors.end())
+        {
+            errors.insert(errors.end(), it->second.begin(), it->second.end());
+            _errors.erase(it);
+        }
+    }
+
+  private:
+    std::mutex _mutex;
+    std::unordered_map<std::thread::id, StringVec> _errors;
+};
+
+// Renderer services for shading without a scene, in which all coordinate
+// systems coincide and no attributes or user data are available.
+class GridRendererServices : public OSL::RendererServices
+{
+  public:
+    bool get_matrix(OSL::ShaderGlobals*, OSL::Matrix44& result, OSL::TransformationPtr, float) override
+    {
+        result.makeIdentity();
+        return true;
+    }
+
+    bool get_matrix(OSL::ShaderGlobals*, OSL::Matrix44& result, OSL::ustring, float) override
+    {
+        result.makeIdentity();
+        return true;
+    }
+
+    bool get_matrix(OSL::ShaderGlobals*, OSL::Matrix44& result, OSL::TransformationPtr) override
+    {
+        result.makeIdentity();
+        return true;
+    }
+
+    bool get_matrix(OSL::ShaderGlobals*, OSL::Matrix44& result, OSL::ustring) override
+    {
+        result.makeIdentity();
+        return true;
+    }
+
+    bool get_attribute(OSL::ShaderGlobals*, bool, OSL::ustring, OSL::TypeDesc, OSL::ustring, void*) override
+    {
+        return false;
+    }
+
+    bool get_array_attribute(OSL::ShaderGlobals*, bool, OSL::ustring, OSL::TypeDesc, OSL::ustring, int, void*) override
+    {
+        return false;
+    }
+
+    bool get_userdata(bool, OSL::ustring, OSL::TypeDesc, OSL::ShaderGlobals*, void*) override
+    {
+        return false;
+    }
+};
+
+void throwErrors(const string& errorType, const string& message, ShaderValidationErrorList& errors)
+{
+    errors.insert(errors.begin(), message);
+    throw ExceptionShaderValidationError(errorType, errors);
+}
+
+} // anonymous namespace
+
+//
+// OslRuntime::Impl methods
+//
+
+class OslRuntime::Impl
+{
+  public:
+    Impl(const FilePath& includePath) :
+        includePath(includePath),
+        shadingSystem(new OSL::ShadingSystem(&rendererServices, nullptr, &errorHandler)),
+        shaderCount(0)
+    {
+    }
+
+    FilePath includePath;
+    GridRendererServices rendererServices;
+    ErrorCollector errorHandler;
+    std::unique_ptr<OSL::ShadingSystem> shadingSystem;
+
+    // Guards the loading of shaders and the building of shader groups.
+    std::mutex groupMutex;
+    unsigned int shaderCount;
+
+    // Names under which each distinct .oso buffer was loaded. The shading
+    // system never unloads shaders, so each buffer is loaded only once.
+    std::unordered_map<string, string> loadedShaders;
+};
+
+//
+// OslRuntime methods
+//
+
+OslRuntimePtr OslRuntime::create(const FilePath& includePath)
+{
+    return std::shared_ptr<OslRuntime>(new OslRuntime(includePath));
+}
+
+OslRuntime::OslRuntime(const FilePath& includePath) :
+    _impl(new Impl(includePath))
+{
+}
+
+OslRuntime::~OslRuntime()
+{
+}
+
+bool OslRuntime::isShadeableType(const string& outputType)
+{
+    static const StringSet SHADEABLE_TYPES = { "float", "color", "vector", "point", "normal" };
+    return SHADEABLE_TYPES.count(outputType) != 0;
+}
+
+string OslRuntime::compile(const string& shaderName, const string& source) const
+{
+    ErrorCollector errorHandler;
+    std::vector<std::string> options = { "-I" + _impl->includePath.asString() };
+    FilePath stdoslPath = _impl->includePath / FilePath("stdosl.h");
+
+    string oso;
+    bool compiled = false;
+    {
+        std::lock_guard<std::mutex> lock(compilerMutex);
+        OSL::OSLCompiler compiler(&errorHandler);
+        compiled = compiler.compile_buffer(source, oso, options, stdoslPath.asString());
+    }
+
+    ShaderValidationErrorList errors;
+    errorHandler.takeErrors(errors);
+    if (!compiled)
+    {
+        throwErrors(OSL_COMPILATION_ERROR, "Shader " + shaderName + " failed to compile:", errors);
+    }
+    return oso;
+}
+
+void OslRuntime::shade(const string& oso, const string& outputName, ImageDesc& image) const
+{
+    ShaderValidationErrorList errors;
+    if (image.channelCount != 4 || !image.floatingPoint || !image.width || !image.height || !image.resourceBuffer)
+    {
+        throwErrors(OSL_RENDERING_ERROR, "Shading requires a four channel floating point image buffer.", errors);
+    }
+
+    // Load each distinct shader once, under a unique name, as shader names
+    // need not be unique across the shaders processed by a runtime. The
+    // group built here is owned by this call, and released on return.
+    OSL::ShadingSystem* shadingSystem = _impl->shadingSystem.get();
+    OSL::ShaderGroupRef group;
+    {
+        std::lock_guard<std::mutex> lock(_impl->groupMutex);
+        auto loaded = _impl->loadedShaders.find(oso);
+        string loadName;
+        if (loaded != _impl->loadedShaders.end())
+        {
+            loadName = loaded->second;
+        }
+        else
+        {
+            const string newName = "mx_shader_" + std::to_string(_impl->shaderCount++);
+            if (shadingSystem->LoadMemoryCompiledShader(newName, oso))
+            {
+                loadName = newName;
+                _impl->loadedShaders[oso] = loadName;
+            }
+        }
+        if (!loadName.empty())
+        {
+            group = shadingSystem->ShaderGroupBegin(loadName + "_group");
+            shadingSystem->Shader("surface", loadName, "layer");
+            shadingSystem->ShaderGroupEnd();
+        }
+        if (group)
+        {
+            // Declaring the output keeps it from being optimized away.
+            OSL::ustring outputs[] = { OSL::ustring(outputName) };
+            shadingSystem->attribute(group.get(), "renderer_outputs", OSL::TypeDesc(OSL::TypeDesc::STRING, 1), outputs);
+        }
+    }
+    if (!group)
+    {
+        _impl->errorHandler.takeErrors(errors);
+        throwErrors(OSL_RENDERING_ERROR, "Shader failed to load:", errors);
+    }
+
+    // Shade the grid, with each point taking the position and texture
+    // coordinates of its location on the unit square.
+    OSL::PerThreadInfo* threadInfo = shadingSystem->create_thread_info();
+    OSL::ShadingContext* context = shadingSystem->get_context(threadInfo);
+    const OSL::ustring outputSymbol(outputName);
+    const float du = 1.0f / image.width;
+    const float dv = 1.0f / image.height;
+    float* pixels = static_cast<float*>(image.resourceBuffer);
+    bool shaded = true;
+    for (unsigned int y = 0; y < image.height && shaded; y++)
+    {
+        for (unsigned int x = 0; x < image.width; x++)
+        {
+            OSL::ShaderGlobals sg;
+            std::memset(&sg, 0, sizeof(sg));
+            sg.u = (x + 0.5f) * du;
+            sg.v = (y + 0.5f) * dv;
+            sg.dudx = du;
+            sg.dvdy = dv;
+            sg.P = OSL::Vec3(sg.u, sg.v, 1.0f);
+            sg.dPdx = OSL::Vec3(du, 0.0f, 0.0f);
+            sg.dPdy = OSL::Vec3(0.0f, dv, 0.0f);
+            sg.dPdu = OSL::Vec3(1.0f, 0.0f, 0.0f);
+            sg.dPdv = OSL::Vec3(0.0f, 1.0f, 0.0f);
+            sg.N = OSL::Vec3(0.0f, 0.0f, 1.0f);
+            sg.Ng = sg.N;
+            sg.I = OSL::Vec3(0.0f, 0.0f, -1.0f);
+            sg.surfacearea = 1.0f;
+            sg.raytype = shadingSystem->raytype_bit(OSL::ustring("camera"));
+
+            if (!shadingSystem->execute(*context, *group, sg))
+            {
+                shaded = false;
+                break;
+            }
+
+            OSL::TypeDesc type;
+            const float* value = static_cast<const float*>(shadingSystem->get_symbol(*context, outputSymbol, type));
+            if (!value || type.basetype != OSL::TypeDesc::FLOAT || type.arraylen != 0)
+            {
+                errors.push_back("Output " + outputName + " is not a float or triple.");
+                shaded = false;
+                break;
+            }
+
+            float* pixel = pixels + ((size_t) y * image.width + x) * 4;
+            bool isTriple = type.aggregate == OSL::TypeDesc::VEC3;
+            pixel[0] = value[0];
+            pixel[1] = isTriple ? value[1] : value[0];
+            pixel[2] = isTriple ? value[2] : value[0];
+            pixel[3] = 1.0f;
+        }
+    }
+    shadingSystem->release_context(context);
+    shadingSystem->destroy_thread_info(threadInfo);
+    group.reset();
+
+    _impl->errorHandler.takeErrors(errors);
+    if (!shaded)
+    {
+        throwErrors(OSL_RENDERING_ERROR, "Shader failed to render:", errors);
+    }
+}
+
+void OslRuntime::run(const vector<Job>& jobs, unsigned int width, unsigned int height,
+                     vector<Result>& results, unsigned int threadCount) const
+{
+    results.clear();
+    results.resize(jobs.size());
+    if (jobs.empty())
+    {
+        return;
+    }
+    if (!threadCount)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threadCount = (unsigned int) std::min((size_t) threadCount, jobs.size());
+
+    std::atomic<size_t> nextJob(0);
+    auto runJobs = [&]()
+    {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+            const Job& job = jobs[i];
+            Result& result = results[i];
+            try
+            {
+                result.oso = compile(job.shaderName, job.source);
+                if (!job.outputName.empty())
+                {
+                    result.pixels.resize((size_t) width * height * 4);
+                    ImageDesc image;
+                    image.width = width;
+                    image.height = height;
+                    image.channelCount = 4;
+                    image.resourceBuffer = result.pixels.data();
+                    shade(result.oso, job.outputName, image);
+                }
+            }
+            catch (ExceptionShaderValidationError& e)
+            {
+                result.pixels.clear();
+                result.errors = e.errorLog();
+                if (result.errors.empty())
+                {
+                    result.errors.push_back(e.what());
+                }
+            }
+        }
+    };
+
+    vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++)
+    {
+        threads.push_back(std::thread(runJobs));
+    }
+    runJobs();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // namespace MaterialX
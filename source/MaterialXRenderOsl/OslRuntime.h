@@ -0,0 +1,116 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_OSLRUNTIME_H
+#define MATERIALX_OSLRUNTIME_H
+
+/// @file
+/// In-process OSL compilation and shading
+
+#include <MaterialXRender/ShaderValidators/ExceptionShaderValidationError.h>
+#include <MaterialXRender/Handlers/ImageHandler.h>
+
+namespace MaterialX
+{
+
+/// Shared pointer to an OslRuntime
+using OslRuntimePtr = std::shared_ptr<class OslRuntime>;
+
+/// @class OslRuntime
+/// Compiles and shades OSL shaders within the current process, using the
+/// liboslcomp and liboslexec libraries, so that shaders can be validated
+/// without writing intermediate files or launching oslc and testshade.
+///
+/// Shaders are compiled from source strings into in-memory .oso buffers, and
+/// shaded over a grid of points as testshade does, with the output written
+/// directly into an image buffer. Only float and three component outputs can
+/// be shaded; closures and struct outputs require a renderer.
+///
+/// All methods may be called concurrently from multiple threads.
+///
+/// This class is only available if MaterialX was built with
+/// MATERIALX_BUILD_OSL_INPROCESS.
+///
+class OslRuntime
+{
+  public:
+    /// A shader to compile and shade as part of a batch
+    struct Job
+    {
+        /// Name of the shader
+        string shaderName;
+        /// OSL source code
+        string source;
+        /// Name of the shader output to shade. If empty the shader is
+        /// compiled but not shaded.
+        string outputName;
+    };
+
+    /// The outcome of a job
+    struct Result
+    {
+        /// Compiled .oso code. Empty if compilation failed.
+        string oso;
+        /// Shaded RGBA pixels, in rows of increasing v. Empty if the shader
+        /// was not shaded.
+        vector<float> pixels;
+        /// Compilation and shading errors. Empty if the job succeeded.
+        ShaderValidationErrorList errors;
+    };
+
+    /// Create a runtime.
+    /// @param includePath Include path for the OSL compiler. This should
+    ///    include the path to stdosl.h.
+    static OslRuntimePtr create(const FilePath& includePath);
+
+    /// Destructor
+    virtual ~OslRuntime();
+
+    /// Return true if the given OSL output type can be shaded.
+    static bool isShadeableType(const string& outputType);
+
+    /// Compile OSL source code.
+    /// An exception is thrown if the code cannot be compiled.
+    /// @param shaderName Name of the shader, used in error messages
+    /// @param source OSL source code
+    /// @return Compiled .oso code
+    string compile(const string& shaderName, const string& source) const;
+
+    /// Shade a compiled shader over a grid covering the unit square in u and v,
+    /// writing the given output of each point to an image. The grid has the
+    /// dimensions of the image, which must have four channels and a floating
+    /// point buffer of width * height * 4 values.
+    /// Each distinct .oso buffer is loaded into the shading system once and
+    /// reused by later calls, while the shader group built for shading is
+    /// released before returning.
+    /// An exception is thrown if the shader cannot be shaded, or if the image
+    /// is not a four channel floating point image.
+    /// @param oso Compiled .oso code
+    /// @param outputName Name of the shader output to write
+    /// @param image Image to write to
+    void shade(const string& oso, const string& outputName, ImageDesc& image) const;
+
+    /// Compile and shade a batch of shaders across multiple threads.
+    /// @param jobs Shaders to process
+    /// @param width Width of the shading grid
+    /// @param height Height of the shading grid
+    /// @param results Returned results, one per job and in the same order
+    /// @param threadCount Number of threads to use. If zero, one thread is
+    ///    used per hardware thread.
+    void run(const vector<Job>& jobs, unsigned int width, unsigned int height,
+             vector<Result>& results, unsigned int threadCount = 0) const;
+
+  protected:
+    /// Constructor
+    OslRuntime(const FilePath& includePath);
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+} // namespace MaterialX
+
+#endif
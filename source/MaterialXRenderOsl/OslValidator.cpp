@@ -9,7 +9,9 @@
 
 #include <MaterialXGenOsl/OslShaderGenerator.h>
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 
 namespace MaterialX
 {
@@ -17,6 +19,9 @@ namespace MaterialX
 // Statics
 string OslValidator::OSL_CLOSURE_COLOR_STRING("closure color");
 
+// Resolution of images shaded in process, matching that used with testrender
+static const unsigned int IN_PROCESS_IMAGE_SIZE = 512;
+
 //
 // Creator
 //
@@ -27,7 +32,8 @@ OslValidatorPtr OslValidator::create()
 
 OslValidator::OslValidator() :
     ShaderValidator(),
-    _useTestRender(true) // By default use testrender
+    _useTestRender(true), // By default use testrender
+    _useInProcess(true)
 {
 }
 
@@ -44,6 +50,16 @@ void OslValidator::initialize()
         errors.push_back("OSL validation include path is empty.");
         throw ExceptionShaderValidationError(errorType, errors);
     }
+
+#if defined(MATERIALX_BUILD_OSL_INPROCESS)
+    // Executables are not required when the in-process runtime is used.
+    _runtime = _useInProcess ? OslRuntime::create(_oslIncludePath) : nullptr;
+    if (_runtime)
+    {
+        return;
+    }
+#endif
+
     if (_oslTestShadeExecutable.isEmpty() && _oslCompilerExecutable.isEmpty())
     {
         errors.push_back("OSL validation executables not set.");
@@ -241,6 +257,15 @@ void OslValidator::shadeOSL(const FilePath& dirPath, const string& shaderName, c
 
 void OslValidator::compileOSL(const FilePath& oslFilePath)
 {
+    if (_runtime)
+    {
+        std::ifstream oslStream(oslFilePath.asString());
+        std::stringstream oslCode;
+        oslCode << oslStream.rdbuf();
+        compileOSLInProcess(oslCode.str(), removeExtension(oslFilePath.asString()) + ".oso");
+        return;
+    }
+
     // If no command and include path specified then skip checking.
     if (_oslCompilerExecutable.isEmpty() || _oslIncludePath.isEmpty())
     {
@@ -298,7 +323,7 @@ void OslValidator::validateCreation(const StageMap& stages)
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    bool haveCompiler = !_oslCompilerExecutable.isEmpty() && !_oslIncludePath.isEmpty();
+    bool haveCompiler = _runtime || (!_oslCompilerExecutable.isEmpty() && !_oslIncludePath.isEmpty());
     if (!haveCompiler)
     {
         errors.push_back("No OSL compiler specified for validation.");
@@ -324,6 +349,14 @@ void OslValidator::validateCreation(const StageMap& stages)
     spaceMap["\"object\""] = "\"world\"";
     string oslCode = replaceSubstrings(stages.begin()->second, spaceMap);
 
+    // Compile in memory, keeping a .oso file for testrender only when
+    // an output location is given.
+    if (_runtime)
+    {
+        compileOSLInProcess(oslCode, _oslOutputFilePath.isEmpty() ? FilePath() : FilePath(removeExtension(fileName) + ".oso"));
+        return;
+    }
+
     std::ofstream file;
     file.open(fileName);
     file << oslCode;
@@ -358,8 +391,14 @@ void OslValidator::validateRender(bool /*orthographicView*/)
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
+    // Shade in process, when the output does not require a renderer
+    if (_runtime && OslRuntime::isShadeableType(_oslShaderOutputType))
+    {
+        shadeOSLInProcess(_oslShaderOutputName);
+    }
+
     // Use testshade
-    if (!_useTestRender)
+    else if (!_useTestRender)
     {
         shadeOSL(_oslOutputFilePath, _oslShaderName, _oslShaderOutputName);
     }
@@ -376,9 +415,86 @@ void OslValidator::validateRender(bool /*orthographicView*/)
     }
 }
 
-void OslValidator::save(const FilePath& /*filePath*/, bool /*floatingPoint*/)
+void OslValidator::compileOSLInProcess(const string& oslCode, const FilePath& osoFilePath)
 {
-    // No-op: image save is done as part of rendering.
+    _osoCode.clear();
+    _osoCode = _runtime->compile(_oslShaderName, oslCode);
+
+    if (!osoFilePath.isEmpty())
+    {
+        std::ofstream osoStream(osoFilePath.asString());
+        osoStream << _osoCode;
+    }
+}
+
+void OslValidator::shadeOSLInProcess(const string& outputName)
+{
+    if (_osoCode.empty())
+    {
+        ShaderValidationErrorList errors;
+        errors.push_back("No compiled OSL code to shade.");
+        throw ExceptionShaderValidationError("OSL rendering error.", errors);
+    }
+
+    _renderPixels.assign(IN_PROCESS_IMAGE_SIZE * IN_PROCESS_IMAGE_SIZE * 4, 0.0f);
+    _renderImage = ImageDesc();
+    _renderImage.width = IN_PROCESS_IMAGE_SIZE;
+    _renderImage.height = IN_PROCESS_IMAGE_SIZE;
+    _renderImage.channelCount = 4;
+    _renderImage.floatingPoint = true;
+    _renderImage.resourceBuffer = _renderPixels.data();
+    try
+    {
+        _runtime->shade(_osoCode, outputName, _renderImage);
+    }
+    catch (ExceptionShaderValidationError&)
+    {
+        _renderPixels.clear();
+        _renderImage = ImageDesc();
+        throw;
+    }
+
+    // Write the image to the same location as testrender would
+    if (_imageLoader && !_oslOutputFilePath.isEmpty() && !_oslShaderName.empty())
+    {
+        save((_oslOutputFilePath / _oslShaderName).asString() + "_osl.png", false);
+    }
+}
+
+void OslValidator::save(const FilePath& filePath, bool /*floatingPoint*/)
+{
+    // Images rendered by the executables are saved as part of rendering.
+    if (!_renderImage.resourceBuffer || !_imageLoader)
+    {
+        return;
+    }
+
+    // Shaded pixels are floating point, so are quantized for formats other
+    // than HDR.
+    bool saved = false;
+    if (getFileExtension(filePath.asString()) == ImageLoader::HDR_EXTENSION)
+    {
+        saved = _imageLoader->saveImage(filePath, _renderImage);
+    }
+    else
+    {
+        vector<unsigned char> texels(_renderPixels.size());
+        for (size_t i = 0; i < _renderPixels.size(); i++)
+        {
+            float value = std::min(std::max(_renderPixels[i], 0.0f), 1.0f);
+            texels[i] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+        }
+        ImageDesc image = _renderImage;
+        image.floatingPoint = false;
+        image.resourceBuffer = texels.data();
+        saved = _imageLoader->saveImage(filePath, image);
+    }
+    if (!saved)
+    {
+        ShaderValidationErrorList errors;
+        errors.push_back("Failed to save to file:" + filePath.asString());
+        throw ExceptionShaderValidationError("OSL rendering error.", errors);
+    }
 }
 
 }
@@ -12,6 +12,7 @@
 #include <MaterialXRender/ShaderValidators/ShaderValidator.h>
 #include <MaterialXRender/ShaderValidators/ExceptionShaderValidationError.h>
 #include <MaterialXRender/Handlers/ImageHandler.h>
+#include <MaterialXRenderOsl/OslRuntime.h>
 #include <vector>
 #include <string>
 #include <map>
@@ -31,6 +32,10 @@ using OslValidatorPtr = std::shared_ptr<class OslValidator>;
 ///     - Render validation: Use of "testrender" to output rendered images. Assumes source compliation was success
 ///       as it depends on the existence of corresponding .oso files.
 ///
+/// If MaterialX was built with MATERIALX_BUILD_OSL_INPROCESS, compilation and the shading of
+/// non-closure outputs are instead performed within the process by an OslRuntime, and the
+/// executables are only used to render closures.
+///
 class OslValidator : public ShaderValidator
 {
   public:
@@ -92,8 +97,8 @@ class OslValidator : public ShaderValidator
     /// @{
 
     /// Save the current contents a rendering to disk. Note that this method
-    /// does not perform any action as validateRender() produces images as part if it's
-    /// execution.
+    /// only performs an action for images shaded in process, as the executables
+    /// produce images as part of the execution of validateRender().
     /// @param filePath Name of file to save rendered image to.
     /// @param floatingPoint Format of output image is floating point.
     void save(const FilePath& filePath, bool floatingPoint) override;
@@ -194,6 +199,21 @@ class OslValidator : public ShaderValidator
         _useTestRender = useTestRender;
     }
 
+    /// Used to toggle the use of the in-process OSL runtime, if MaterialX was built
+    /// with MATERIALX_BUILD_OSL_INPROCESS. Must be set before initialize() is called.
+    /// By default the runtime is used when available.
+    /// @param useInProcess Indicate whether to use the in-process runtime.
+    void useInProcess(bool useInProcess)
+    {
+        _useInProcess = useInProcess;
+    }
+
+    /// Return the in-process OSL runtime, or nullptr if it is not in use.
+    OslRuntimePtr getRuntime() const
+    {
+        return _runtime;
+    }
+
     ///
     /// Compile OSL code stored in a file. Will throw an exception if an error occurs.
     /// @param oslFilePath OSL file path.
@@ -216,6 +236,19 @@ class OslValidator : public ShaderValidator
     /// @param outputName Name of OSL shader output to use.
     void renderOSL(const FilePath& dirPath, const string& shaderName, const string& outputName);
 
+    ///
+    /// Compile OSL code with the in-process runtime, writing the compiled code to a .oso file
+    /// if a file path is given. Will throw an exception if an error occurs.
+    /// @param oslCode OSL source code.
+    /// @param osoFilePath Path of the .oso file to write. May be empty.
+    void compileOSLInProcess(const string& oslCode, const FilePath& osoFilePath);
+
+    ///
+    /// Shade the most recently compiled shader with the in-process runtime.
+    /// Will throw an exception if an error occurs.
+    /// @param outputName Name of OSL shader output to use.
+    void shadeOSLInProcess(const string& outputName);
+
     /// Constructor
     OslValidator();
 
@@ -245,6 +278,16 @@ class OslValidator : public ShaderValidator
     FilePath _oslUtilityOSOPath;
     /// Use "testshade" or "testender" for render validation
     bool _useTestRender;
+
+    /// Use the in-process runtime when available
+    bool _useInProcess;
+    /// In-process runtime, if in use
+    OslRuntimePtr _runtime;
+    /// Code compiled by the most recent in-process validation
+    string _osoCode;
+    /// Image and pixels shaded by the most recent in-process validation
+    ImageDesc _renderImage;
+    vector<float> _renderPixels;
 };
 
 } // namespace MaterialX
@@ -0,0 +1,163 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+#include <MaterialXTest/GenShaderUtil.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <MaterialXGenGlsl/GlslShaderGenerator.h>
+
+#include <MaterialXRender/ShaderValidators/BatchValidator.h>
+
+#include <cstdio>
+#include <thread>
+
+namespace mx = MaterialX;
+
+namespace
+{
+
+// Validator which records the shaders it is given, and fails to compile
+// shaders for trigonometric nodes.
+class RecordingValidator : public mx::ShaderValidator
+{
+  public:
+    void initialize() override { }
+
+    void validateCreation(const mx::ShaderPtr shader) override
+    {
+        threadIds.push_back(std::this_thread::get_id());
+        if (shader->getName().find("trig") != std::string::npos)
+        {
+            throw mx::ExceptionShaderValidationError("Compile error.", { "Stub error" });
+        }
+    }
+
+    void validateCreation(const StageMap&) override { }
+    void validateInputs() override { }
+    void validateRender(bool orthographicView) override
+    {
+        renderCount++;
+        orthographicCount += orthographicView ? 1 : 0;
+    }
+    void save(const mx::FilePath&, bool) override { }
+
+    std::vector<std::thread::id> threadIds;
+    size_t renderCount = 0;
+    size_t orthographicCount = 0;
+};
+
+// Validator which throws an exception that is not a std::exception, and so
+// escapes the batch validator.
+class ThrowingValidator : public RecordingValidator
+{
+  public:
+    void validateCreation(const mx::ShaderPtr) override
+    {
+        throw 0;
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Batch Validation", "[render]")
+{
+    mx::FilePath librariesPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    mx::DocumentPtr libraries = mx::createDocument();
+    GenShaderUtil::loadLibraries({ "stdlib" }, librariesPath, libraries);
+
+    mx::ShaderGeneratorPtr generator = mx::GlslShaderGenerator::create();
+    auto createContext = [&]()
+    {
+        mx::GenContextPtr context = std::make_shared<mx::GenContext>(generator);
+        context->registerSourceCodeSearchPath(librariesPath);
+        return context;
+    };
+
+    mx::FilePath testPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Materials/TestSuite/stdlib/math");
+    mx::StringVec documentPaths =
+    {
+        (testPath / mx::FilePath("math.mtlx")).asString(),
+        (testPath / mx::FilePath("trig.mtlx")).asString(),
+        (testPath / mx::FilePath("vector_math.mtlx")).asString(),
+        (testPath / mx::FilePath("missing.mtlx")).asString()
+    };
+
+    // Generate only.
+    mx::BatchValidatorPtr batch = mx::BatchValidator::create(createContext);
+    batch->setLibraries(libraries);
+    batch->setThreadCount(2);
+    mx::BatchValidator::Report generated;
+    batch->validate(documentPaths, generated);
+    REQUIRE(generated.threadCount == 2);
+    REQUIRE(generated.documents.size() == documentPaths.size());
+    REQUIRE(generated.documents[0].errors.empty());
+    REQUIRE(!generated.documents[3].errors.empty());
+    REQUIRE(!generated.elements.empty());
+    for (const mx::BatchValidator::ElementReport& element : generated.elements)
+    {
+        REQUIRE(element.errors.empty());
+        REQUIRE(element.compileTime == 0.0);
+    }
+    REQUIRE(generated.getFailureCount() == 1);
+
+    // Validate on the calling thread.
+    std::shared_ptr<RecordingValidator> validator = std::make_shared<RecordingValidator>();
+    batch = mx::BatchValidator::create(createContext, validator);
+    batch->setLibraries(libraries);
+    batch->setThreadCount(3);
+    mx::BatchValidator::Report validated;
+    batch->validate(documentPaths, validated);
+    REQUIRE(validated.elements.size() == generated.elements.size());
+    REQUIRE(validator->threadIds.size() == validated.elements.size());
+    for (std::thread::id threadId : validator->threadIds)
+    {
+        REQUIRE(threadId == std::this_thread::get_id());
+    }
+    size_t failedCount = 0;
+    for (size_t i = 0; i < validated.elements.size(); i++)
+    {
+        const mx::BatchValidator::ElementReport& element = validated.elements[i];
+        REQUIRE(element.elementPath == generated.elements[i].elementPath);
+        bool isTrig = element.documentPath == documentPaths[1];
+        REQUIRE(element.errors.empty() == !isTrig);
+        failedCount += isTrig ? 1 : 0;
+    }
+    REQUIRE(failedCount > 0);
+    REQUIRE(validator->renderCount == validated.elements.size() - failedCount);
+
+    // The math documents hold node graph outputs, which do not require
+    // shading, so are rendered with an orthographic view.
+    REQUIRE(validator->orthographicCount == validator->renderCount);
+
+    const std::string json = validated.asJson();
+    REQUIRE(json.find("\"stageTimes\"") != std::string::npos);
+    REQUIRE(json.find("Stub error") != std::string::npos);
+    REQUIRE(validated.writeJson(mx::FilePath("batchValidation.json")));
+    std::remove("batchValidation.json");
+
+    // Workers wait for space in a full queue, without changing the results.
+    validator = std::make_shared<RecordingValidator>();
+    batch = mx::BatchValidator::create(createContext, validator);
+    batch->setLibraries(libraries);
+    batch->setThreadCount(3);
+    REQUIRE(batch->getQueueCapacity() == mx::BatchValidator::DEFAULT_QUEUE_CAPACITY);
+    batch->setQueueCapacity(1);
+    REQUIRE(batch->getQueueCapacity() == 1);
+    mx::BatchValidator::Report bounded;
+    batch->validate(documentPaths, bounded);
+    REQUIRE(bounded.elements.size() == validated.elements.size());
+    REQUIRE(bounded.getFailureCount() == validated.getFailureCount());
+
+    // Exceptions escaping the validator stop and join the workers, including
+    // those waiting for space in the queue, before being rethrown.
+    batch = mx::BatchValidator::create(createContext, std::make_shared<ThrowingValidator>());
+    batch->setLibraries(libraries);
+    batch->setThreadCount(3);
+    batch->setQueueCapacity(1);
+    mx::BatchValidator::Report thrown;
+    REQUIRE_THROWS_AS(batch->validate(documentPaths, thrown), int);
+}
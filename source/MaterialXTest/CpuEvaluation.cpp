@@ -0,0 +1,529 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXTest/GenShaderUtil.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <MaterialXGenGlsl/GlslShaderGenerator.h>
+
+#include <MaterialXRender/Evaluators/CpuEvaluator.h>
+#include <MaterialXRender/Evaluators/TextureBaker.h>
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace mx = MaterialX;
+
+namespace
+{
+
+// Image handler which reads images without uploading them.
+class LoaderImageHandler : public mx::ImageHandler
+{
+  public:
+    LoaderImageHandler() :
+        mx::ImageHandler(mx::StbImageLoader::create())
+    {
+    }
+
+    bool bindImage(const std::string&, const mx::ImageSamplingProperties&) override
+    {
+        return false;
+    }
+
+  protected:
+    void deleteImage(mx::ImageDesc& imageDesc) override
+    {
+        free(imageDesc.resourceBuffer);
+        imageDesc.resourceBuffer = nullptr;
+    }
+};
+
+// Connect a new output of its graph to the given node, and evaluate it at
+// the given points.
+std::vector<float> evaluateNode(mx::NodePtr node, mx::GenContext& context, const mx::ShadingPoints& points)
+{
+    mx::NodeGraphPtr graph = node->getParent()->asA<mx::NodeGraph>();
+    mx::OutputPtr output = graph->addOutput(node->getName() + "_out", node->getType());
+    output->setConnectedNode(node);
+    std::vector<float> results;
+    mx::CpuEvaluator::create(output, context)->evaluate(points, results);
+    return results;
+}
+
+void checkResults(const std::vector<float>& results, const std::vector<float>& expected)
+{
+    REQUIRE(results.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        REQUIRE(std::abs(results[i] - expected[i]) < 1e-4f);
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("CPU Evaluation", "[render]")
+{
+    mx::FilePath searchPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    mx::DocumentPtr doc = mx::createDocument();
+    GenShaderUtil::loadLibraries({ "stdlib" }, searchPath, doc);
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+
+    // Math and channel nodes, over more points than fit in a batch.
+    mx::NodeGraphPtr mathGraph = doc->addNodeGraph("math_graph");
+    mx::NodePtr texcoord = mathGraph->addNode("texcoord", "texcoord1", "vector2");
+    mx::NodePtr swizzle = mathGraph->addNode("swizzle", "swizzle1", "float");
+    swizzle->setConnectedNode("in", texcoord);
+    swizzle->setParameterValue("channels", std::string("x"));
+    mx::NodePtr multiply = mathGraph->addNode("multiply", "multiply1", "float");
+    multiply->setConnectedNode("in1", swizzle);
+    multiply->setInputValue("in2", 2.0f);
+    mx::NodePtr add = mathGraph->addNode("add", "add1", "float");
+    add->setConnectedNode("in1", multiply);
+    add->setInputValue("in2", 0.5f);
+    mx::NodePtr convert = mathGraph->addNode("convert", "convert1", "color3");
+    convert->setConnectedNode("in", add);
+    mx::OutputPtr floatOutput = mathGraph->addOutput("float_out", "float");
+    floatOutput->setConnectedNode(add);
+    mx::OutputPtr colorOutput = mathGraph->addOutput("color_out", "color3");
+    colorOutput->setConnectedNode(convert);
+
+    mx::ShadingPoints points = mx::ShadingPoints::createGrid(16, 16);
+    REQUIRE(points.size() > mx::CpuEvaluator::BATCH_SIZE);
+    std::vector<float> results;
+    mx::CpuEvaluatorPtr evaluator = mx::CpuEvaluator::create(floatOutput, context);
+    REQUIRE(evaluator->getOutputType() == mx::Type::FLOAT);
+    evaluator->evaluate(points, results);
+    REQUIRE(results.size() == points.size());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        REQUIRE(results[i] == Approx(points.texcoord[0][i] * 2.0f + 0.5f));
+    }
+    evaluator = mx::CpuEvaluator::create(colorOutput, context);
+    REQUIRE(evaluator->getChannelCount() == 3);
+    evaluator->evaluate(points, results);
+    REQUIRE(results.size() == points.size() * 3);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            REQUIRE(results[i * 3 + c] == Approx(points.texcoord[0][i] * 2.0f + 0.5f));
+        }
+    }
+
+    // Noise is deterministic, bounded and varying.
+    mx::NodeGraphPtr noiseGraph = doc->addNodeGraph("noise_graph");
+    mx::NodePtr noise = noiseGraph->addNode("noise2d", "noise1", "float");
+    noise->setInputValue("texcoord", mx::Vector2(0.0f));
+    mx::NodePtr scale = noiseGraph->addNode("multiply", "multiply1", "vector2");
+    scale->setConnectedNode("in1", noiseGraph->addNode("texcoord", "texcoord1", "vector2"));
+    scale->setInputValue("in2", mx::Vector2(8.0f));
+    noise->setConnectedNode("texcoord", scale);
+    mx::OutputPtr noiseOutput = noiseGraph->addOutput("out", "float");
+    noiseOutput->setConnectedNode(noise);
+    evaluator = mx::CpuEvaluator::create(noiseOutput, context);
+    std::vector<float> noiseResults;
+    evaluator->evaluate(points, results);
+    evaluator->evaluate(points, noiseResults);
+    REQUIRE(results == noiseResults);
+    float minValue = results[0], maxValue = results[0];
+    for (float value : results)
+    {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+    REQUIRE(minValue >= -1.0f);
+    REQUIRE(maxValue <= 1.0f);
+    REQUIRE(maxValue - minValue > 0.5f);
+
+    // Textures, through the compound graph of a tiled image.
+    mx::FilePath imagePath = mx::FilePath::getCurrentPath() / mx::FilePath("cpuEvaluation.png");
+    unsigned char texels[] = { 255, 0, 0, 255, 0, 255, 0, 255 };
+    mx::ImageDesc imageDesc;
+    imageDesc.width = 2;
+    imageDesc.height = 1;
+    imageDesc.channelCount = 4;
+    imageDesc.floatingPoint = false;
+    imageDesc.resourceBuffer = texels;
+    REQUIRE(mx::StbImageLoader::create()->saveImage(imagePath, imageDesc));
+
+    mx::NodeGraphPtr imageGraph = doc->addNodeGraph("image_graph");
+    mx::NodePtr tiledImage = imageGraph->addNode("tiledimage", "tiledimage1", "color3");
+    tiledImage->setParameterValue("file", imagePath.asString(), mx::FILENAME_TYPE_STRING);
+    tiledImage->setParameterValue("filtertype", std::string("closest"));
+    tiledImage->setParameterValue("uvtiling", mx::Vector2(2.0f, 1.0f));
+    mx::NodePtr missingImage = imageGraph->addNode("image", "image1", "color3");
+    missingImage->setParameterValue("file", std::string("missing.png"), mx::FILENAME_TYPE_STRING);
+    missingImage->setParameterValue("default", mx::Color3(0.0f, 0.0f, 1.0f));
+    mx::NodePtr sum = imageGraph->addNode("add", "add1", "color3");
+    sum->setConnectedNode("in1", tiledImage);
+    sum->setConnectedNode("in2", missingImage);
+    mx::OutputPtr imageOutput = imageGraph->addOutput("out", "color3");
+    imageOutput->setConnectedNode(sum);
+
+    mx::ImageHandlerPtr imageHandler = std::make_shared<LoaderImageHandler>();
+    evaluator = mx::CpuEvaluator::create(imageOutput, context, imageHandler);
+    evaluator->evaluate(mx::ShadingPoints::createGrid(4, 1), results);
+    std::remove(imagePath.asString().c_str());
+    checkResults(results, { 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1 });
+
+    // Nodes without a CPU equivalent are rejected.
+    mx::NodeGraphPtr blurGraph = doc->addNodeGraph("blur_graph");
+    mx::NodePtr blur = blurGraph->addNode("blur", "blur1", "float");
+    blur->setInputValue("in", 0.5f);
+    mx::OutputPtr blurOutput = blurGraph->addOutput("out", "float");
+    blurOutput->setConnectedNode(blur);
+    REQUIRE_THROWS_AS(mx::CpuEvaluator::create(blurOutput, context), mx::ExceptionShaderGenError&);
+}
+
+TEST_CASE("CPU Evaluation of standard nodes", "[render]")
+{
+    mx::FilePath searchPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    mx::DocumentPtr doc = mx::createDocument();
+    GenShaderUtil::loadLibraries({ "stdlib" }, searchPath, doc);
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    const mx::ShadingPoints point = mx::ShadingPoints::createGrid(1, 1);
+    const mx::ShadingPoints row = mx::ShadingPoints::createGrid(4, 1);
+
+    // Compositing nodes follow the operand order and alpha handling of the
+    // genglsl implementations.
+    mx::NodeGraphPtr compositeGraph = doc->addNodeGraph("composite_graph");
+    const float fg[4] = { 0.2f, 0.4f, 0.6f, 0.5f };
+    const float bg[4] = { 0.8f, 0.6f, 0.4f, 0.25f };
+    const float mix = 0.5f;
+    auto addComposite = [&](const std::string& category)
+    {
+        mx::NodePtr node = compositeGraph->addNode(category, category + "1", "color4");
+        node->setInputValue("fg", mx::Color4(fg[0], fg[1], fg[2], fg[3]));
+        node->setInputValue("bg", mx::Color4(bg[0], bg[1], bg[2], bg[3]));
+        node->setInputValue("mix", mix);
+        return node;
+    };
+    auto expectComposite = [&](const std::string& category, const std::function<float(size_t)>& blend)
+    {
+        std::vector<float> expected;
+        for (size_t c = 0; c < 4; c++)
+        {
+            expected.push_back(mix * blend(c) + (1.0f - mix) * bg[c]);
+        }
+        checkResults(evaluateNode(addComposite(category), context, point), expected);
+    };
+    expectComposite("screen", [&](size_t c) { return (1.0f - (1.0f - fg[c])) * (1.0f - bg[c]); });
+    expectComposite("plus", [&](size_t c) { return bg[c] + fg[c]; });
+    expectComposite("minus", [&](size_t c) { return bg[c] - fg[c]; });
+    expectComposite("difference", [&](size_t c) { return std::abs(bg[c] - fg[c]); });
+    expectComposite("burn", [&](size_t c) { return 1.0f - (1.0f - bg[c]) / fg[c]; });
+    expectComposite("dodge", [&](size_t c) { return bg[c] / (1.0f - fg[c]); });
+    expectComposite("overlay", [&](size_t c)
+    {
+        return fg[c] < 0.5f ? 2.0f * fg[c] * bg[c] : 1.0f - (1.0f - fg[c]) * (1.0f - bg[c]);
+    });
+    expectComposite("in", [&](size_t c) { return fg[c] * bg[3]; });
+    expectComposite("out", [&](size_t c) { return fg[c] * (1.0f - bg[3]); });
+    expectComposite("mask", [&](size_t c) { return bg[c] * fg[3]; });
+    expectComposite("matte", [&](size_t c)
+    {
+        return c < 3 ? fg[c] * fg[3] + bg[c] * (1.0f - fg[3]) : fg[3] + bg[3] * (1.0f - fg[3]);
+    });
+    expectComposite("disjointover", [&](size_t c)
+    {
+        return c < 3 ? fg[c] + bg[c] : std::min(fg[3] + bg[3], 1.0f);
+    });
+
+    // The over node ignores its mix input.
+    std::vector<float> expected;
+    for (size_t c = 0; c < 4; c++)
+    {
+        expected.push_back(fg[c] + bg[c] * (1.0f - fg[3]));
+    }
+    checkResults(evaluateNode(addComposite("over"), context, point), expected);
+
+    // Conditionals, with intest equal to the cutoff at the second point.
+    mx::NodeGraphPtr conditionalGraph = doc->addNodeGraph("conditional_graph");
+    mx::NodePtr rowCoord = conditionalGraph->addNode("swizzle", "swizzle1", "float");
+    rowCoord->setConnectedNode("in", conditionalGraph->addNode("texcoord", "texcoord1", "vector2"));
+    rowCoord->setParameterValue("channels", std::string("x"));
+    mx::NodePtr compare = conditionalGraph->addNode("compare", "compare1", "float");
+    compare->setConnectedNode("intest", rowCoord);
+    compare->setParameterValue("cutoff", 0.375f);
+    compare->setInputValue("in1", 1.0f);
+    compare->setInputValue("in2", 2.0f);
+    checkResults(evaluateNode(compare, context, row), { 1, 1, 2, 2 });
+
+    // A constant which selects the input at its integer part.
+    for (int i = 0; i < 5; i++)
+    {
+        mx::NodePtr switchNode = conditionalGraph->addNode("switch", "switch" + std::to_string(i), "float");
+        for (int b = 1; b <= 5; b++)
+        {
+            switchNode->setInputValue("in" + std::to_string(b), 10.0f * b);
+        }
+        switchNode->setParameterValue("which", i + 0.5f);
+        checkResults(evaluateNode(switchNode, context, point), { 10.0f * (i + 1) });
+    }
+
+    // Ramps clamp their texture coordinates, and splits step at the center.
+    mx::NodeGraphPtr rampGraph = doc->addNodeGraph("ramp_graph");
+    mx::NodePtr wideCoord = rampGraph->addNode("multiply", "multiply1", "vector2");
+    wideCoord->setConnectedNode("in1", rampGraph->addNode("texcoord", "texcoord1", "vector2"));
+    wideCoord->setInputValue("in2", mx::Vector2(2.0f, 1.0f));
+    mx::NodePtr ramplr = rampGraph->addNode("ramplr", "ramplr1", "float");
+    ramplr->setParameterValue("valuel", 0.0f);
+    ramplr->setParameterValue("valuer", 1.0f);
+    ramplr->setConnectedNode("texcoord", wideCoord);
+    checkResults(evaluateNode(ramplr, context, row), { 0.25f, 0.75f, 1.0f, 1.0f });
+    mx::NodePtr ramptb = rampGraph->addNode("ramptb", "ramptb1", "float");
+    ramptb->setParameterValue("valuet", 1.0f);
+    ramptb->setParameterValue("valueb", 3.0f);
+    checkResults(evaluateNode(ramptb, context, row), { 2, 2, 2, 2 });
+    mx::NodePtr ramp4 = rampGraph->addNode("ramp4", "ramp41", "float");
+    ramp4->setParameterValue("valuetl", 0.0f);
+    ramp4->setParameterValue("valuetr", 1.0f);
+    ramp4->setParameterValue("valuebl", 2.0f);
+    ramp4->setParameterValue("valuebr", 3.0f);
+    checkResults(evaluateNode(ramp4, context, row), { 1.125f, 1.375f, 1.625f, 1.875f });
+    mx::NodePtr splitlr = rampGraph->addNode("splitlr", "splitlr1", "float");
+    splitlr->setParameterValue("valuel", 1.0f);
+    splitlr->setParameterValue("valuer", 2.0f);
+    splitlr->setParameterValue("center", 0.5f);
+    checkResults(evaluateNode(splitlr, context, row), { 1, 1, 2, 2 });
+    mx::NodePtr splittb = rampGraph->addNode("splittb", "splittb1", "float");
+    splittb->setParameterValue("valuet", 1.0f);
+    splittb->setParameterValue("valueb", 2.0f);
+    splittb->setParameterValue("center", 0.75f);
+    checkResults(evaluateNode(splittb, context, row), { 1, 1, 1, 1 });
+
+    // HSV conversions, whose color4 forms output an alpha of one.
+    mx::NodeGraphPtr hsvGraph = doc->addNodeGraph("hsv_graph");
+    mx::NodePtr rgbToHsv = hsvGraph->addNode("rgbtohsv", "rgbtohsv1", "color4");
+    rgbToHsv->setInputValue("in", mx::Color4(0.8f, 0.4f, 0.2f, 0.3f));
+    checkResults(evaluateNode(rgbToHsv, context, point), { 0.2f / 3.6f, 0.75f, 0.8f, 1.0f });
+    mx::NodePtr hsvToRgb = hsvGraph->addNode("hsvtorgb", "hsvtorgb1", "color4");
+    hsvToRgb->setInputValue("in", mx::Color4(0.2f / 3.6f, 0.75f, 0.8f, 0.3f));
+    checkResults(evaluateNode(hsvToRgb, context, point), { 0.8f, 0.4f, 0.2f, 1.0f });
+    mx::NodePtr roundTrip = hsvGraph->addNode("hsvtorgb", "hsvtorgb2", "color3");
+    mx::NodePtr toHsv = hsvGraph->addNode("rgbtohsv", "rgbtohsv2", "color3");
+    toHsv->setInputValue("in", mx::Color3(0.1f, 0.7f, 0.4f));
+    roundTrip->setConnectedNode("in", toHsv);
+    checkResults(evaluateNode(roundTrip, context, point), { 0.1f, 0.7f, 0.4f });
+
+    // Cell noise is constant within each cell and lies in the unit range.
+    mx::NodeGraphPtr cellGraph = doc->addNodeGraph("cell_graph");
+    mx::NodePtr cellCoord = cellGraph->addNode("multiply", "multiply1", "vector2");
+    cellCoord->setConnectedNode("in1", cellGraph->addNode("texcoord", "texcoord1", "vector2"));
+    cellCoord->setInputValue("in2", mx::Vector2(4.0f));
+    mx::NodePtr cellPosition = cellGraph->addNode("multiply", "multiply2", "vector3");
+    cellPosition->setConnectedNode("in1", cellGraph->addNode("position", "position1", "vector3"));
+    cellPosition->setInputValue("in2", mx::Vector3(4.0f));
+    mx::NodePtr cellNoise2d = cellGraph->addNode("cellnoise2d", "cellnoise2d1", "float");
+    cellNoise2d->setConnectedNode("texcoord", cellCoord);
+    mx::NodePtr cellNoise3d = cellGraph->addNode("cellnoise3d", "cellnoise3d1", "float");
+    cellNoise3d->setConnectedNode("position", cellPosition);
+    const mx::ShadingPoints cellPoints = mx::ShadingPoints::createGrid(8, 1);
+    for (mx::NodePtr cellNoise : { cellNoise2d, cellNoise3d })
+    {
+        std::vector<float> results = evaluateNode(cellNoise, context, cellPoints);
+        REQUIRE(results.size() == 8);
+        for (size_t i = 0; i < results.size(); i += 2)
+        {
+            REQUIRE(results[i] == results[i + 1]);
+        }
+        REQUIRE(std::count(results.begin(), results.end(), results[0]) < 8);
+        REQUIRE(*std::min_element(results.begin(), results.end()) >= 0.0f);
+        REQUIRE(*std::max_element(results.begin(), results.end()) <= 1.0f);
+    }
+
+    // The fourth channel of vector4 fractal noise is the fractal noise of an
+    // offset position, as in genglsl.
+    mx::NodeGraphPtr fractalGraph = doc->addNodeGraph("fractal_graph");
+    mx::NodePtr fractalPosition = fractalGraph->addNode("multiply", "multiply1", "vector3");
+    fractalPosition->setConnectedNode("in1", fractalGraph->addNode("position", "position1", "vector3"));
+    fractalPosition->setInputValue("in2", mx::Vector3(3.0f));
+    mx::NodePtr offsetPosition = fractalGraph->addNode("add", "add1", "vector3");
+    offsetPosition->setConnectedNode("in1", fractalPosition);
+    offsetPosition->setInputValue("in2", mx::Vector3(19.0f, 193.0f, 17.0f));
+    auto addFractal = [&](const std::string& type, mx::NodePtr position)
+    {
+        mx::NodePtr node = fractalGraph->addNode("fractal3d", "fractal3d_" + type, type);
+        node->setParameterValue("octaves", 2);
+        node->setConnectedNode("position", position);
+        return node;
+    };
+    const mx::ShadingPoints fractalPoints = mx::ShadingPoints::createGrid(8, 8);
+    std::vector<float> fractal4 = evaluateNode(addFractal("vector4", fractalPosition), context, fractalPoints);
+    std::vector<float> fractal3 = evaluateNode(addFractal("vector3", fractalPosition), context, fractalPoints);
+    std::vector<float> fractal1 = evaluateNode(addFractal("float", offsetPosition), context, fractalPoints);
+    REQUIRE(fractal4.size() == fractalPoints.size() * 4);
+    for (size_t i = 0; i < fractalPoints.size(); i++)
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            REQUIRE(std::abs(fractal4[i * 4 + c] - fractal3[i * 3 + c]) < 1e-4f);
+        }
+        REQUIRE(std::abs(fractal4[i * 4 + 3] - fractal1[i]) < 1e-4f);
+    }
+
+    // Geometric nodes read the attributes of the points.
+    mx::ShadingPoints geomPoints;
+    geomPoints.resize(2);
+    const float attributes[3] = { 0.25f, 0.5f, 0.75f };
+    for (size_t c = 0; c < 3; c++)
+    {
+        geomPoints.position[c][1] = attributes[c];
+        geomPoints.normal[c][1] = attributes[c];
+        geomPoints.tangent[c][1] = attributes[c];
+        geomPoints.bitangent[c][1] = attributes[c];
+        geomPoints.color[c][1] = attributes[c];
+    }
+    geomPoints.color[3][1] = 0.5f;
+    geomPoints.texcoord[0][1] = 0.25f;
+    geomPoints.texcoord[1][1] = 0.5f;
+    mx::NodeGraphPtr geomGraph = doc->addNodeGraph("geom_graph");
+    checkResults(evaluateNode(geomGraph->addNode("position", "position1", "vector3"), context, geomPoints),
+                 { 0, 0, 0, 0.25f, 0.5f, 0.75f });
+    checkResults(evaluateNode(geomGraph->addNode("normal", "normal1", "vector3"), context, geomPoints),
+                 { 0, 0, 1, 0.25f, 0.5f, 0.75f });
+    checkResults(evaluateNode(geomGraph->addNode("tangent", "tangent1", "vector3"), context, geomPoints),
+                 { 1, 0, 0, 0.25f, 0.5f, 0.75f });
+    checkResults(evaluateNode(geomGraph->addNode("bitangent", "bitangent1", "vector3"), context, geomPoints),
+                 { 0, 1, 0, 0.25f, 0.5f, 0.75f });
+    checkResults(evaluateNode(geomGraph->addNode("texcoord", "texcoord1", "vector2"), context, geomPoints),
+                 { 0, 0, 0.25f, 0.5f });
+    checkResults(evaluateNode(geomGraph->addNode("geomcolor", "geomcolor1", "color4"), context, geomPoints),
+                 { 1, 1, 1, 1, 0.25f, 0.5f, 0.75f, 0.5f });
+}
+
+TEST_CASE("Texture Baking", "[render]")
+{
+    mx::FilePath searchPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    mx::DocumentPtr doc = mx::createDocument();
+    GenShaderUtil::loadLibraries({ "stdlib" }, searchPath, doc);
+    doc->setColorManagementSystem("ocio");
+    doc->setColorSpace("lin_rec709");
+    mx::GenContextPtr context = std::make_shared<mx::GenContext>(mx::GlslShaderGenerator::create());
+    context->registerSourceCodeSearchPath(searchPath);
+
+    // Bind the color and float outputs of a procedural graph to shader
+    // inputs. The color varies along both axes, so that flipped images do
+    // not match, and the float lies outside the unit range.
+    mx::NodeGraphPtr graph = doc->addNodeGraph("procedural");
+    mx::NodePtr ramp = graph->addNode("ramp4", "ramp41", "color3");
+    ramp->setParameterValue("valuetl", mx::Color3(1.0f, 0.0f, 0.0f));
+    ramp->setParameterValue("valuetr", mx::Color3(0.0f, 0.0f, 1.0f));
+    ramp->setParameterValue("valuebl", mx::Color3(0.0f, 1.0f, 0.0f));
+    ramp->setParameterValue("valuebr", mx::Color3(1.0f, 1.0f, 1.0f));
+    mx::NodePtr floatRamp = graph->addNode("ramplr", "ramplr1", "float");
+    floatRamp->setParameterValue("valuel", 0.0f);
+    floatRamp->setParameterValue("valuer", 4.0f);
+    mx::NodePtr unused = graph->addNode("constant", "constant1", "float");
+    mx::OutputPtr output = graph->addOutput("out", "color3");
+    output->setConnectedNode(ramp);
+    mx::OutputPtr floatOutput = graph->addOutput("roughness", "float");
+    floatOutput->setConnectedNode(floatRamp);
+    mx::MaterialPtr material = doc->addMaterial("material1");
+    mx::ShaderRefPtr shaderRef = material->addShaderRef("shaderref1", "standard_surface");
+    shaderRef->addBindInput("base_color", "color3")->setConnectedOutput(output);
+    shaderRef->addBindInput("specular_roughness", "float")->setConnectedOutput(floatOutput);
+
+    std::vector<mx::OutputPtr> bakeable = mx::TextureBaker::findBakeableOutputs(doc);
+    REQUIRE(bakeable.size() == 2);
+    REQUIRE(bakeable[0] == output);
+    REQUIRE(bakeable[1] == floatOutput);
+
+    mx::ShadingPoints points = mx::ShadingPoints::createGrid(8, 4);
+    std::vector<float> expected, floatExpected;
+    mx::CpuEvaluator::create(output, *context)->evaluate(points, expected);
+    mx::CpuEvaluator::create(floatOutput, *context)->evaluate(points, floatExpected);
+
+    // Bake to UDIM tiles, leaving the document unchanged. Colors are baked
+    // to 8-bit images and floats to HDR images.
+    mx::FilePath bakePath = mx::FilePath::getCurrentPath() / mx::FilePath("textureBaking");
+    mx::TextureBakerPtr baker = mx::TextureBaker::create(context);
+    baker->setResolution(8, 4);
+    baker->setOutputPath(bakePath);
+    baker->setThreadCount(2);
+    baker->setUdims({ "1001", "1002" });
+    std::vector<mx::TextureBaker::BakedOutput> baked = baker->bake(bakeable);
+    REQUIRE(baked.size() == 2);
+    REQUIRE(mx::getFileExtension(baked[0].fileName) == mx::ImageLoader::PNG_EXTENSION);
+    REQUIRE(mx::getFileExtension(baked[1].fileName) == mx::ImageLoader::HDR_EXTENSION);
+    for (const mx::TextureBaker::BakedOutput& bakedOutput : baked)
+    {
+        REQUIRE(bakedOutput.errors.empty());
+        REQUIRE(bakedOutput.warnings.empty());
+        REQUIRE(bakedOutput.fileName.find(mx::UDIM_TOKEN) != std::string::npos);
+        for (const std::string udim : { "1001", "1002" })
+        {
+            mx::FilePath tilePath(mx::replaceSubstrings(bakedOutput.fileName, { { mx::UDIM_TOKEN, udim } }));
+            REQUIRE(tilePath.exists());
+            std::remove(tilePath.asString().c_str());
+        }
+    }
+    REQUIRE(baked[0].colorSpace == "lin_rec709");
+    REQUIRE(baked[1].colorSpace.empty());
+    REQUIRE(output->getConnectedNode() == ramp);
+    baker->setUdims({ "999" });
+    REQUIRE_THROWS(baker->bake(bakeable));
+
+    // Baking values outside the unit range to 8-bit images warns that they
+    // were clamped.
+    baker->setUdims({ });
+    baker->setFileExtension(mx::ImageLoader::PNG_EXTENSION);
+    std::vector<mx::TextureBaker::BakedOutput> clamped = baker->bake({ floatOutput });
+    REQUIRE(clamped.size() == 1);
+    REQUIRE(clamped[0].errors.empty());
+    REQUIRE(clamped[0].warnings.size() == 1);
+    std::remove(clamped[0].fileName.c_str());
+    baker->setFileExtension(mx::EMPTY_STRING);
+
+    // Bake a single tile and rewrite the document to read it.
+    baked = baker->bakeDocument(doc);
+    REQUIRE(baked.size() == 2);
+    REQUIRE(baked[0].errors.empty());
+    REQUIRE(baked[1].errors.empty());
+    mx::NodePtr image = output->getConnectedNode();
+    REQUIRE(image);
+    REQUIRE(image->getCategory() == "image");
+    REQUIRE(image->getParameterValue("file")->getValueString() == baked[0].fileName);
+    REQUIRE(image->getParameter("file")->getColorSpace() == "lin_rec709");
+    mx::NodePtr floatImage = floatOutput->getConnectedNode();
+    REQUIRE(floatImage);
+    REQUIRE(floatImage->getParameterValue("file")->getValueString() == baked[1].fileName);
+    REQUIRE(!floatImage->getParameter("file")->hasColorSpace());
+    REQUIRE(!graph->getNode(ramp->getName()));
+    REQUIRE(!graph->getNode(floatRamp->getName()));
+    REQUIRE(!graph->getNode(unused->getName()));
+    REQUIRE(graph->validate());
+
+    // The baked images reproduce the graph at texel centers, the float image
+    // within the precision of its shared exponents.
+    std::vector<float> results;
+    mx::CpuEvaluator::create(output, *context, std::make_shared<LoaderImageHandler>())->evaluate(points, results);
+    REQUIRE(results.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        REQUIRE(std::abs(results[i] - expected[i]) < 1.0f / 255.0f);
+    }
+    mx::CpuEvaluator::create(floatOutput, *context, std::make_shared<LoaderImageHandler>())->evaluate(points, results);
+    REQUIRE(results.size() == floatExpected.size());
+    REQUIRE(*std::max_element(results.begin(), results.end()) > 1.0f);
+    for (size_t i = 0; i < floatExpected.size(); i++)
+    {
+        REQUIRE(std::abs(results[i] - floatExpected[i]) < 1.0f / 32.0f);
+    }
+
+    std::remove(baked[0].fileName.c_str());
+    std::remove(baked[1].fileName.c_str());
+    std::remove(bakePath.asString().c_str());
+}
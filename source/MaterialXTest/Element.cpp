@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <thread>
+
 namespace mx = MaterialX;
 
 TEST_CASE("Element", "[element]")
@@ -66,3 +68,121 @@ TEST_CASE("Element", "[element]")
     }
     REQUIRE_THROWS_AS(orphan->getDocument(), mx::ExceptionOrphanedElement&);    
 }
+
+TEST_CASE("Element copy on write", "[element]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("graph");
+    mx::NodePtr constant = nodeGraph->addNode("constant", "node1", "color3");
+    constant->setParameterValue("value", mx::Color3(0.5f));
+    constant->setAttribute("xpos", "1");
+
+    // Copies share attribute storage with the original document.
+    mx::DocumentPtr doc2 = doc->copy();
+    mx::NodePtr constant2 = doc2->getNodeGraph("graph")->getNode("node1");
+    REQUIRE(*doc2 == *doc);
+    REQUIRE(constant2->getAttributeNames() == constant->getAttributeNames());
+
+    // Modifying a copy leaves the original unchanged.
+    constant2->setAttribute("xpos", "2");
+    constant2->getParameter("value")->setValueString("0.25, 0.25, 0.25");
+    REQUIRE(constant->getAttribute("xpos") == "1");
+    REQUIRE(constant->getParameterValue("value")->asA<mx::Color3>() == mx::Color3(0.5f));
+    REQUIRE(*doc2 != *doc);
+    constant2->setAttribute("xpos", "1");
+    constant2->getParameter("value")->setValueString(constant->getParameter("value")->getValueString());
+    REQUIRE(*doc2 == *doc);
+
+    // Modifying the original leaves the copy unchanged.
+    constant->removeAttribute("xpos");
+    REQUIRE(!constant->hasAttribute("xpos"));
+    REQUIRE(constant2->getAttribute("xpos") == "1");
+
+    // Cleared elements have no attributes.
+    constant2->clearContent();
+    REQUIRE(constant2->getAttributeNames().empty());
+    REQUIRE(constant->getType() == "color3");
+}
+
+TEST_CASE("Cached values", "[element]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodePtr constant = doc->addNode("constant", "node1", "color3");
+    mx::ParameterPtr param = constant->setParameterValue("value", mx::Color3(0.5f));
+
+    // Each call returns an independent copy of the cached value.
+    mx::ValuePtr value = param->getValue();
+    REQUIRE(value->asA<mx::Color3>() == mx::Color3(0.5f));
+    std::static_pointer_cast<mx::TypedValue<mx::Color3>>(value)->setData(mx::Color3(1.0f));
+    REQUIRE(param->getValue()->asA<mx::Color3>() == mx::Color3(0.5f));
+
+    // Changes to the value or type attributes are reflected.
+    param->setValueString("0.25, 0.25, 0.25");
+    REQUIRE(param->getValue()->asA<mx::Color3>() == mx::Color3(0.25f));
+    param->setValue(2.0f);
+    REQUIRE(param->getValue()->asA<float>() == 2.0f);
+    param->setType("string");
+    REQUIRE(param->getValue()->asA<std::string>() == "2");
+    param->setValueString("invalid");
+    param->setType("float");
+    REQUIRE(!param->getValue());
+    param->removeAttribute(mx::ValueElement::VALUE_ATTRIBUTE);
+    REQUIRE(!param->getValue());
+
+    // Copies share cached values until either element is modified.
+    param->setValue(mx::Color3(0.5f));
+    REQUIRE(param->getValue());
+    mx::DocumentPtr doc2 = doc->copy();
+    mx::ParameterPtr param2 = doc2->getNode("node1")->getParameter("value");
+    REQUIRE(param2->getValue()->asA<mx::Color3>() == mx::Color3(0.5f));
+    param2->setValue(mx::Color3(0.75f));
+    REQUIRE(param2->getValue()->asA<mx::Color3>() == mx::Color3(0.75f));
+    REQUIRE(param->getValue()->asA<mx::Color3>() == mx::Color3(0.5f));
+    param2->copyContentFrom(param);
+    REQUIRE(param2->getValue()->asA<mx::Color3>() == mx::Color3(0.5f));
+    param2->clearContent();
+    REQUIRE(!param2->getValue());
+}
+
+TEST_CASE("Cached values across threads", "[element]")
+{
+    // Create a document and a copy that shares its attribute storage.
+    const int PARAM_COUNT = 1000;
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodePtr constant = doc->addNode("constant", "node1", "float");
+    for (int i = 0; i < PARAM_COUNT; i++)
+    {
+        constant->setParameterValue("param" + std::to_string(i), (float) i);
+    }
+    mx::DocumentPtr doc2 = doc->copy();
+    std::vector<mx::ParameterPtr> params = doc->getNode("node1")->getParameters();
+    std::vector<mx::ParameterPtr> params2 = doc2->getNode("node1")->getParameters();
+    REQUIRE(params.size() == PARAM_COUNT);
+    REQUIRE(params2.size() == PARAM_COUNT);
+
+    // Read values from one document while the shared storage is duplicated
+    // by writes to the other.
+    bool valid = true;
+    std::thread reader([&params, &valid]()
+    {
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            mx::ValuePtr value = params[i]->getValue();
+            valid = valid && value && value->asA<float>() == (float) i;
+        }
+    });
+    bool valid2 = true;
+    for (size_t i = 0; i < params2.size(); i++)
+    {
+        params2[i]->setValue((float) i + 0.5f);
+        mx::ValuePtr value = params2[i]->getValue();
+        valid2 = valid2 && value && value->asA<float>() == (float) i + 0.5f;
+    }
+    reader.join();
+    REQUIRE(valid);
+    REQUIRE(valid2);
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        REQUIRE(params[i]->getValue()->asA<float>() == (float) i);
+    }
+}
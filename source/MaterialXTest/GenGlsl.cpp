@@ -15,6 +15,24 @@
 #include <MaterialXGenGlsl/GlslShaderGenerator.h>
 #include <MaterialXGenGlsl/GlslSyntax.h>
 
+#include <MaterialXGenShader/UniformBlockLayout.h>
+
+#ifdef MATERIALX_BUILD_RENDERGLSL
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+#include <MaterialXRenderGlsl/GlslCompileQueue.h>
+#include <MaterialXRenderGlsl/GlslProgram.h>
+#include <MaterialXRenderGlsl/GlslProgramCache.h>
+#include <MaterialXRenderGlsl/GlslValidator.h>
+#include <MaterialXRenderGlsl/GLTextureHandler.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <thread>
+
 namespace mx = MaterialX;
 
 TEST_CASE("GLSL Syntax Check", "[genglsl]")
@@ -133,3 +151,423 @@ TEST_CASE("GLSL Shader Generation", "[genglsl]")
 {
     generateGLSLCode();
 }
+
+namespace
+{
+
+// Generate a shader reading from the given number of images.
+mx::ShaderPtr generateImageShader(int imageCount, const mx::GenOptions& options = mx::GenOptions())
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::FilePath searchPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    GenShaderUtil::loadLibraries({ "stdlib" }, searchPath, doc);
+
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("image_graph");
+    mx::NodePtr sum;
+    for (int i = 0; i < imageCount; i++)
+    {
+        mx::NodePtr image = nodeGraph->addNode("image", "image" + std::to_string(i), "color3");
+        image->setParameterValue("file", "resources/Images/image" + std::to_string(i) + ".png", mx::FILENAME_TYPE_STRING);
+        image->setParameterValue("uaddressmode", std::string("clamp"));
+        image->setParameterValue("default", mx::Color3(0.5f));
+        if (sum)
+        {
+            mx::NodePtr add = nodeGraph->addNode("add", "add" + std::to_string(i), "color3");
+            add->setConnectedNode("in1", sum);
+            add->setConnectedNode("in2", image);
+            sum = add;
+        }
+        else
+        {
+            sum = image;
+        }
+    }
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(sum);
+
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    context.getOptions() = options;
+    return context.getShaderGenerator().generate("image_shader", output, context);
+}
+
+} // anonymous namespace
+
+TEST_CASE("GLSL Uniform Blocks", "[genglsl]")
+{
+    mx::GenOptions options;
+    options.hwUniformBlocks = true;
+    mx::ShaderPtr shader = generateImageShader(2, options);
+    REQUIRE(shader);
+    REQUIRE(shader->hasAttribute(mx::HW::ATTR_UNIFORM_BLOCKS));
+
+    // Packable uniforms are shared between stages, and declared in identical blocks.
+    const mx::ShaderStage& vs = shader->getStage(mx::Stage::VERTEX);
+    const mx::ShaderStage& ps = shader->getStage(mx::Stage::PIXEL);
+    for (const std::string& blockName : { mx::HW::PUBLIC_UNIFORMS, mx::HW::PRIVATE_UNIFORMS })
+    {
+        mx::UniformBlockLayout vsLayout(vs.getUniformBlock(blockName));
+        mx::UniformBlockLayout psLayout(ps.getUniformBlock(blockName));
+        REQUIRE(vsLayout.getSize() == psLayout.getSize());
+        REQUIRE(vsLayout.getMembers().size() == psLayout.getMembers().size());
+        for (size_t i = 0; i < vsLayout.getMembers().size(); i++)
+        {
+            REQUIRE(vsLayout.getMembers()[i].port->getVariable() == psLayout.getMembers()[i].port->getVariable());
+            REQUIRE(vsLayout.getMembers()[i].offset == psLayout.getMembers()[i].offset);
+        }
+    }
+    REQUIRE(ps.getUniformBlock(mx::HW::PRIVATE_UNIFORMS).find("u_worldMatrix"));
+    REQUIRE(vs.getUniformBlock(mx::HW::PUBLIC_UNIFORMS).find("image0_uaddressmode"));
+
+    for (const mx::ShaderStage* stage : { &vs, &ps })
+    {
+        const std::string& code = stage->getSourceCode();
+        REQUIRE(code.find("layout (std140) uniform PublicUniforms") != std::string::npos);
+        REQUIRE(code.find("layout (std140) uniform PrivateUniforms") != std::string::npos);
+        REQUIRE(code.find("uniform mat4 u_worldMatrix") == std::string::npos);
+    }
+
+    // Samplers remain loose uniforms of the pixel stage.
+    REQUIRE(ps.getSourceCode().find("uniform sampler2D image0_file") != std::string::npos);
+    REQUIRE(vs.getSourceCode().find("sampler2D") == std::string::npos);
+}
+
+#ifdef MATERIALX_BUILD_RENDERGLSL
+
+namespace
+{
+
+// Build a program uniform list from the pixel stage uniforms of a shader,
+// assigning sequential locations in place of program introspection.
+void createUniformsList(const mx::Shader& shader, mx::GlslProgram::InputMap& uniformList)
+{
+    const mx::ShaderStage& ps = shader.getStage(mx::Stage::PIXEL);
+    int location = 0;
+    for (auto uniformsIt : ps.getUniformBlocks())
+    {
+        const mx::VariableBlock& uniforms = *uniformsIt.second;
+        for (size_t i = 0; i < uniforms.size(); ++i)
+        {
+            const mx::ShaderPort* v = uniforms[i];
+            int gltype = mx::GlslProgram::mapTypeToOpenGLType(v->getType());
+            mx::GlslProgram::InputPtr input = std::make_shared<mx::GlslProgram::Input>(location++, gltype, 1, v->getPath());
+            input->value = v->getValue();
+            input->typeString = v->getType()->getName();
+            uniformList[v->getName()] = input;
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("GLSL Binding Plan", "[genglsl]")
+{
+    mx::ShaderPtr shader = generateImageShader(2);
+    REQUIRE(shader);
+
+    mx::GlslProgram::InputMap uniformList;
+    createUniformsList(*shader, uniformList);
+    mx::GlslProgram::BindingPlan plan;
+    mx::GlslProgram::createBindingPlan(uniformList, plan);
+    REQUIRE(plan.size() == 2);
+
+    for (const mx::GlslProgram::UniformBinding& binding : plan)
+    {
+        const std::string name = binding.filePath.getBaseName() == "image0.png" ? "image0" : "image1";
+        REQUIRE(binding.location == uniformList[name + "_file"]->location);
+        REQUIRE(binding.gltype == mx::GlslProgram::mapTypeToOpenGLType(mx::Type::FILENAME));
+        REQUIRE(binding.samplingProperties.uaddressMode == uniformList[name + "_uaddressmode"]->value->asA<int>());
+        REQUIRE(binding.samplingProperties.vaddressMode == uniformList[name + "_vaddressmode"]->value->asA<int>());
+        REQUIRE(binding.samplingProperties.defaultColor[0] == 0.5f);
+    }
+}
+
+TEST_CASE("GLSL Program Cache", "[genglsl]")
+{
+    mx::StringMap stages;
+    stages[mx::Stage::VERTEX] = "void main() { gl_Position = vec4(0.0); }";
+    stages[mx::Stage::PIXEL] = "void main() { gl_FragColor = vec4(1.0); }";
+    const std::string driver = "vendor\nrenderer\nversion\n";
+
+    // Keys depend on the source of every stage and on the driver, but
+    // not on empty stages.
+    const std::string key = mx::GlslProgramCache::computeKey(stages, driver);
+    REQUIRE(key.size() == 16);
+    REQUIRE(mx::GlslProgramCache::computeKey(stages, driver) == key);
+    REQUIRE(mx::GlslProgramCache::computeKey(stages, "other driver") != key);
+    mx::StringMap modified = stages;
+    modified[mx::Stage::PIXEL] += " ";
+    REQUIRE(mx::GlslProgramCache::computeKey(modified, driver) != key);
+    modified = stages;
+    std::swap(modified[mx::Stage::VERTEX], modified[mx::Stage::PIXEL]);
+    REQUIRE(mx::GlslProgramCache::computeKey(modified, driver) != key);
+    modified = stages;
+    modified["geometry"] = mx::EMPTY_STRING;
+    REQUIRE(mx::GlslProgramCache::computeKey(modified, driver) == key);
+
+    // Binaries round trip through the cache.
+    mx::GlslProgramCachePtr cache = mx::GlslProgramCache::create(mx::FilePath("glslProgramCache"));
+    std::remove(cache->getFilePath(key).asString().c_str());
+    unsigned int format = 0;
+    std::vector<unsigned char> binary;
+    REQUIRE(!cache->read(key, format, binary));
+
+    std::vector<unsigned char> original(1000);
+    for (size_t i = 0; i < original.size(); i++)
+    {
+        original[i] = (unsigned char) (i * 7);
+    }
+    REQUIRE(!cache->write(key, 0x1234, std::vector<unsigned char>()));
+    REQUIRE(cache->write(key, 0x1234, original));
+    REQUIRE(cache->read(key, format, binary));
+    REQUIRE(format == 0x1234);
+    REQUIRE(binary == original);
+
+    // Corrupt entries are reported as missing.
+    {
+        std::fstream file(cache->getFilePath(key).asString(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put((char) (original.back() + 1));
+    }
+    REQUIRE(!cache->read(key, format, binary));
+    REQUIRE(cache->write(key, 0x1234, original));
+    REQUIRE(cache->read(key, format, binary));
+    REQUIRE(binary == original);
+    std::remove(cache->getFilePath(key).asString().c_str());
+}
+
+#endif
+
+#if defined(MATERIALX_BUILD_RENDERGLSL) && defined(MATERIALX_BUILD_EGL)
+TEST_CASE("GLSL Headless Validation", "[genglsl]")
+{
+    mx::FilePath searchPath = mx::FilePath::getCurrentPath() / mx::FilePath("libraries");
+    mx::DocumentPtr doc = mx::createDocument();
+    GenShaderUtil::loadLibraries({ "stdlib" }, searchPath, doc);
+    mx::ShaderGeneratorPtr generator = mx::GlslShaderGenerator::create();
+
+    // Render a constant color with an independent headless validator, and
+    // return the color at the center of the saved image.
+    auto renderColor = [&](const mx::Color3& color, const std::string& name)
+    {
+        mx::NodeGraphPtr graph = doc->addNodeGraph(name);
+        mx::NodePtr constant = graph->addNode("constant", "constant1", "color3");
+        constant->setParameterValue("value", color);
+        mx::OutputPtr output = graph->addOutput("out", "color3");
+        output->setConnectedNode(constant);
+
+        mx::GenContext context(generator);
+        context.registerSourceCodeSearchPath(searchPath);
+        mx::ShaderPtr shader = generator->generate(name, output, context);
+
+        mx::GlslValidatorPtr validator = mx::GlslValidator::create();
+        validator->setHeadless(true);
+        validator->initialize();
+        validator->setImageHandler(mx::GLTextureHandler::create(mx::StbImageLoader::create()));
+        validator->setLightHandler(nullptr);
+        validator->getGeometryHandler().loadGeometry(mx::FilePath::getCurrentPath() / mx::FilePath("resources/Geometry/plane.obj"));
+        validator->validateCreation(shader);
+        validator->validateInputs();
+        validator->validateRender(true);
+
+        const mx::FilePath imagePath(name + ".png");
+        validator->save(imagePath, false);
+        mx::ImageDesc desc;
+        mx::StbImageLoaderPtr loader = mx::StbImageLoader::create();
+        if (!loader->acquireImage(imagePath, desc, false))
+        {
+            throw mx::Exception("Failed to load " + imagePath.asString());
+        }
+        const unsigned char* texel = (unsigned char*) desc.resourceBuffer +
+            ((desc.height / 2) * desc.width + desc.width / 2) * desc.channelCount;
+        mx::Color3 result(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f);
+        free(desc.resourceBuffer);
+        std::remove(imagePath.asString().c_str());
+        return result;
+    };
+
+    // Skip if no headless context is available on this machine.
+    mx::GLUtilityContextPtr probe = mx::GLUtilityContext::createHeadless();
+    if (!probe->isValid())
+    {
+        WARN("Skipping headless validation, as no EGL display is available.");
+        return;
+    }
+    REQUIRE(probe->isHeadless());
+    probe = nullptr;
+
+    // Render with two validators, the second on its own thread.
+    const mx::Color3 first(0.2f, 0.6f, 0.8f);
+    const mx::Color3 second(0.9f, 0.1f, 0.3f);
+    mx::Color3 firstResult = renderColor(first, "headless1");
+    mx::Color3 secondResult;
+    std::exception_ptr secondError;
+    std::thread thread([&]()
+    {
+        try
+        {
+            secondResult = renderColor(second, "headless2");
+        }
+        catch (...)
+        {
+            secondError = std::current_exception();
+        }
+    });
+    thread.join();
+    if (secondError)
+    {
+        std::rethrow_exception(secondError);
+    }
+    for (size_t i = 0; i < 3; i++)
+    {
+        REQUIRE(std::abs(firstResult[i] - first[i]) < 2.0f / 255.0f);
+        REQUIRE(std::abs(secondResult[i] - second[i]) < 2.0f / 255.0f);
+    }
+}
+
+TEST_CASE("GLSL Compile Queue", "[genglsl]")
+{
+    // Skip if no headless context is available on this machine.
+    mx::GLUtilityContextPtr probe = mx::GLUtilityContext::createHeadless();
+    if (!probe->isValid())
+    {
+        WARN("Skipping compile queue test, as no EGL display is available.");
+        return;
+    }
+    probe = nullptr;
+
+    // Initialize a headless validator, whose context is used for building.
+    mx::GlslValidatorPtr validator = mx::GlslValidator::create();
+    validator->setHeadless(true);
+    validator->initialize();
+
+    const std::string vertexSource =
+        "#version 400\n"
+        "in vec3 i_position;\n"
+        "void main() { gl_Position = vec4(i_position, 1.0); }\n";
+    auto createProgram = [&vertexSource](const std::string& pixelBody)
+    {
+        mx::GlslProgramPtr program = mx::GlslProgram::create();
+        program->addStage(mx::Stage::VERTEX, vertexSource);
+        program->addStage(mx::Stage::PIXEL,
+            "#version 400\n"
+            "out vec4 out_color;\n" + pixelBody);
+        return program;
+    };
+
+    // Build a single program in steps.
+    mx::GlslProgramPtr single = createProgram("uniform vec3 u_color;\nvoid main() { out_color = vec4(u_color, 1.0); }\n");
+    single->startBuild();
+    while (!single->isBuildComplete())
+    {
+        std::this_thread::yield();
+    }
+    unsigned int programId = single->finishBuild();
+    REQUIRE(programId > 0);
+    REQUIRE(single->isBuildComplete());
+    REQUIRE(single->finishBuild() == programId);
+    REQUIRE(single->getUniformsList().count("u_color"));
+
+    // Build several programs through the queue, one of which fails to compile.
+    const size_t PROGRAM_COUNT = 6;
+    const size_t FAILING_INDEX = 3;
+    std::vector<mx::GlslProgramPtr> programs;
+    mx::GlslCompileQueuePtr queue = mx::GlslCompileQueue::create();
+    for (size_t i = 0; i < PROGRAM_COUNT; i++)
+    {
+        const std::string uniformName = "u_color" + std::to_string(i);
+        const std::string value = (i == FAILING_INDEX) ? "undeclared_color" : uniformName;
+        programs.push_back(createProgram("uniform vec3 " + uniformName + ";\n"
+                                         "void main() { out_color = vec4(" + value + ", 1.0); }\n"));
+        queue->submit(programs.back());
+    }
+    REQUIRE(queue->getPendingCount() == PROGRAM_COUNT);
+
+    // Collect results as builds complete, and then wait for the remainder.
+    mx::GlslCompileQueue::ResultList results;
+    while (queue->poll(results) > PROGRAM_COUNT / 2)
+    {
+        std::this_thread::yield();
+    }
+    queue->wait(results);
+    REQUIRE(queue->getPendingCount() == 0);
+    REQUIRE(results.size() == PROGRAM_COUNT);
+
+    // Each program is reported once, with errors only for the failing one.
+    for (size_t i = 0; i < PROGRAM_COUNT; i++)
+    {
+        mx::GlslProgramPtr program = programs[i];
+        auto isProgram = [&program](const mx::GlslCompileQueue::Result& result)
+        {
+            return result.program == program;
+        };
+        auto it = std::find_if(results.begin(), results.end(), isProgram);
+        REQUIRE(it != results.end());
+        REQUIRE(std::count_if(results.begin(), results.end(), isProgram) == 1);
+        REQUIRE(program->isBuildComplete());
+        if (i == FAILING_INDEX)
+        {
+            REQUIRE(!it->errors.empty());
+            REQUIRE(it->errors[0].find("fragment") != std::string::npos);
+        }
+        else
+        {
+            REQUIRE(it->errors.empty());
+            REQUIRE(program->finishBuild() > 0);
+            REQUIRE(program->getUniformsList().count("u_color" + std::to_string(i)));
+        }
+    }
+
+    // Build programs on worker threads, in contexts which share objects with
+    // the context in which the programs are used.
+    mx::GLUtilityContextPtr mainContext = mx::GLUtilityContext::createHeadless();
+    REQUIRE(mainContext->isValid());
+    std::vector<mx::GLUtilityContextPtr> workerContexts;
+    for (size_t i = 0; i < 2; i++)
+    {
+        workerContexts.push_back(mx::GLUtilityContext::createHeadless(mainContext));
+        REQUIRE(workerContexts.back()->isValid());
+    }
+    REQUIRE(mainContext->makeCurrent());
+    std::vector<mx::GlslProgramPtr> workerPrograms;
+    mx::GlslCompileQueue::ResultList workerResults;
+    {
+        mx::GlslCompileQueuePtr workerQueue = mx::GlslCompileQueue::create(workerContexts);
+        for (size_t i = 0; i < PROGRAM_COUNT; i++)
+        {
+            const std::string uniformName = "u_color" + std::to_string(i);
+            const std::string value = (i == FAILING_INDEX) ? "undeclared_color" : uniformName;
+            workerPrograms.push_back(createProgram("uniform vec3 " + uniformName + ";\n"
+                                                   "void main() { out_color = vec4(" + value + ", 1.0); }\n"));
+            workerQueue->submit(workerPrograms.back());
+        }
+        workerQueue->wait(workerResults);
+        REQUIRE(workerQueue->getPendingCount() == 0);
+    }
+    REQUIRE(workerResults.size() == PROGRAM_COUNT);
+    for (const mx::GlslCompileQueue::Result& result : workerResults)
+    {
+        size_t index = std::find(workerPrograms.begin(), workerPrograms.end(), result.program) - workerPrograms.begin();
+        REQUIRE(index < PROGRAM_COUNT);
+        REQUIRE(result.errors.empty() == (index != FAILING_INDEX));
+        if (index != FAILING_INDEX)
+        {
+            // Programs built by a worker are usable in the shared context.
+            REQUIRE(result.program->finishBuild() > 0);
+            REQUIRE(result.program->getUniformsList().count("u_color" + std::to_string(index)));
+        }
+    }
+
+    // Workers whose context cannot be made current report an error for
+    // each program, rather than building in the wrong context.
+    mx::GlslCompileQueue::ResultList fallbackResults;
+    {
+        mx::GlslCompileQueuePtr fallbackQueue = mx::GlslCompileQueue::create({ mx::GLUtilityContextPtr() });
+        fallbackQueue->submit(createProgram("void main() { out_color = vec4(1.0); }\n"));
+        fallbackQueue->wait(fallbackResults);
+    }
+    REQUIRE(fallbackResults.size() == 1);
+    REQUIRE(fallbackResults[0].errors.size() == 1);
+    REQUIRE(fallbackResults[0].errors[0].find("worker context") != std::string::npos);
+}
+#endif
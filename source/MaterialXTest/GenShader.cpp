@@ -14,11 +14,13 @@
 #include <MaterialXGenShader/HwShaderGenerator.h>
 #include <MaterialXGenShader/Nodes/SwizzleNode.h>
 #include <MaterialXGenShader/TypeDesc.h>
+#include <MaterialXGenShader/UniformBlockLayout.h>
 #include <MaterialXGenShader/Util.h>
 
 #include <MaterialXTest/GenShaderUtil.h>
 
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -85,6 +87,60 @@ TEST_CASE("GenShader TypeDesc Check", "[genshader]")
     REQUIRE_THROWS(mx::TypeDesc::get("bar"));
 }
 
+TEST_CASE("GenShader Uniform Block Layout", "[genshader]")
+{
+    mx::VariableBlock block("Uniforms", "u");
+    block.add(mx::Type::FLOAT, "u_float", mx::Value::createValue(0.5f));
+    block.add(mx::Type::VECTOR3, "u_vector3", mx::Value::createValue(mx::Vector3(1.0f, 2.0f, 3.0f)));
+    block.add(mx::Type::BOOLEAN, "u_boolean", mx::Value::createValue(true));
+    block.add(mx::Type::COLOR2, "u_color2");
+    block.add(mx::Type::FILENAME, "u_file");
+    block.add(mx::Type::MATRIX33, "u_matrix33", mx::Value::createValue(mx::Matrix33::IDENTITY));
+
+    // Members are ordered by std140 alignment, then by name.
+    mx::UniformBlockLayout layout(block);
+    const std::vector<mx::UniformBlockLayout::Member>& members = layout.getMembers();
+    REQUIRE(members.size() == 5);
+    REQUIRE(members[0].port->getName() == "u_matrix33");
+    REQUIRE(members[0].offset == 0);
+    REQUIRE(members[0].size == 48);
+    REQUIRE(members[1].port->getName() == "u_vector3");
+    REQUIRE(members[1].offset == 48);
+    REQUIRE(members[2].port->getName() == "u_color2");
+    REQUIRE(members[2].offset == 64);
+    REQUIRE(members[3].port->getName() == "u_boolean");
+    REQUIRE(members[3].offset == 72);
+    REQUIRE(members[4].port->getName() == "u_float");
+    REQUIRE(members[4].offset == 76);
+    REQUIRE(layout.getSize() == 80);
+    REQUIRE(!layout.findMember("u_file"));
+
+    // Pack default values.
+    std::vector<unsigned char> buffer;
+    layout.packValues(buffer);
+    REQUIRE(buffer.size() == layout.getSize());
+    float floats[4];
+    std::memcpy(floats, &buffer[16], sizeof(floats));
+    REQUIRE((floats[0] == 0.0f && floats[1] == 1.0f && floats[2] == 0.0f && floats[3] == 0.0f));
+    std::memcpy(floats, &buffer[48], sizeof(floats));
+    REQUIRE((floats[0] == 1.0f && floats[1] == 2.0f && floats[2] == 3.0f));
+    std::memcpy(floats, &buffer[76], sizeof(float));
+    REQUIRE(floats[0] == 0.5f);
+
+    // Packing reports type mismatches, and whether the buffer changed.
+    const mx::UniformBlockLayout::Member* member = layout.findMember("u_float");
+    REQUIRE(member);
+    bool changed = true;
+    REQUIRE(mx::UniformBlockLayout::packValue(*member, *mx::Value::createValue(0.5f), buffer.data(), &changed));
+    REQUIRE(!changed);
+    REQUIRE(mx::UniformBlockLayout::packValue(*member, *mx::Value::createValue(0.25f), buffer.data(), &changed));
+    REQUIRE(changed);
+    REQUIRE(!mx::UniformBlockLayout::packValue(*member, *mx::Value::createValue(1), buffer.data(), &changed));
+    REQUIRE(!changed);
+    std::memcpy(floats, &buffer[76], sizeof(float));
+    REQUIRE(floats[0] == 0.25f);
+}
+
 TEST_CASE("OSL Reference Implementation Check", "[genshader]")
 {
     mx::DocumentPtr doc = mx::createDocument();
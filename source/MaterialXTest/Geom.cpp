@@ -22,6 +22,20 @@ TEST_CASE("Geom strings", "[geom]")
     // Test that one path contains another.
     REQUIRE(mx::geomStringsMatch("/", "/robot1", true));
     REQUIRE(!mx::geomStringsMatch("/robot1", "/", true));
+
+    // Test that compiled matchers agree with geometry string matching.
+    mx::StringVec geoms = { "", "/", "/robot1", "/robot2", "/robot1/left_arm",
+                            "/robot1/left_arm/hand", "/robot1, /robot2", "robot1//left_arm" };
+    for (const std::string& geom1 : geoms)
+    {
+        mx::GeomStringMatcher matcher(geom1);
+        REQUIRE(matcher.isEmpty() == geom1.empty());
+        for (const std::string& geom2 : geoms)
+        {
+            REQUIRE(matcher.matchesGeomString(geom2) == mx::geomStringsMatch(geom1, geom2));
+            REQUIRE(matcher.matchesGeomString(geom2, true) == mx::geomStringsMatch(geom1, geom2, true));
+        }
+    }
 }
 
 TEST_CASE("Geom elements", "[geom]")
@@ -73,9 +87,23 @@ TEST_CASE("Geom elements", "[geom]")
     REQUIRE(collection2->matchesGeomString("/scene1/sphere1"));
     REQUIRE(!collection2->matchesGeomString("/scene1/sphere2"));
 
+    // Test compiled collections.
+    collection2->setIncludeGeom("/scene2");
+    collection2->setExcludeGeom("/scene2/cube1, /scene1/sphere3");
+    mx::CompiledCollectionPtr compiled2 = mx::CompiledCollection::create(collection2);
+    mx::StringVec geoms = { "/", "/scene1", "/scene1/sphere1", "/scene1/sphere2", "/scene1/sphere3",
+                            "/scene2/cube1", "/scene2/cube2", "/scene3", "/scene2/cube2, /scene3" };
+    for (const std::string& geom : geoms)
+    {
+        REQUIRE(compiled2->matchesGeomString(geom) == collection2->matchesGeomString(geom));
+    }
+    collection2->removeAttribute(mx::Collection::INCLUDE_GEOM_ATTRIBUTE);
+    collection2->removeAttribute(mx::Collection::EXCLUDE_GEOM_ATTRIBUTE);
+
     // Create and test an include cycle.
     collection1->setIncludeCollection(collection2);
     REQUIRE(!doc->validate());
+    REQUIRE_THROWS_AS(mx::CompiledCollection::create(collection1), mx::ExceptionFoundCycle&);
     collection1->setIncludeCollection(nullptr);
     REQUIRE(doc->validate());
 
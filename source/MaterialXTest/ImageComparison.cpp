@@ -0,0 +1,190 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXRender/Handlers/ImageComparator.h>
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Image Comparison", "[render]")
+{
+    // Images spanning several bands of rows, with distinct rows so that
+    // flipped images do not compare as equal.
+    const unsigned int width = 37;
+    const unsigned int height = 53;
+    std::vector<unsigned char> reference(width * height * 4);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            unsigned char* texel = &reference[(y * width + x) * 4];
+            texel[0] = (unsigned char) (x * 6);
+            texel[1] = (unsigned char) (y * 4);
+            texel[2] = 128;
+            texel[3] = 255;
+        }
+    }
+    auto createDesc = [&](std::vector<unsigned char>& texels)
+    {
+        mx::ImageDesc desc;
+        desc.width = width;
+        desc.height = height;
+        desc.channelCount = 4;
+        desc.floatingPoint = false;
+        desc.resourceBuffer = texels.data();
+        return desc;
+    };
+    const float pixelCount = (float) (width * height);
+
+    // Identical images.
+    mx::ImageComparatorPtr comparator = mx::ImageComparator::create();
+    mx::ImageDifference difference = comparator->compare(createDesc(reference), createDesc(reference));
+    REQUIRE(difference.rmse.size() == 4);
+    REQUIRE(difference.getMaxRmse() == 0.0f);
+    REQUIRE(difference.getMaxError() == 0.0f);
+    REQUIRE(difference.maxDeltaE == 0.0f);
+    REQUIRE(comparator->isWithinTolerance(difference));
+
+    // A small difference everywhere is measured but imperceptible.
+    std::vector<unsigned char> image = reference;
+    for (size_t i = 0; i < image.size(); i += 4)
+    {
+        image[i + 2] += 1;
+    }
+    difference = comparator->compare(createDesc(image), createDesc(reference));
+    REQUIRE(std::abs(difference.rmse[2] - 1.0f / 255.0f) < 1e-6f);
+    REQUIRE(difference.rmse[0] == 0.0f);
+    REQUIRE(difference.meanDeltaE > 0.0f);
+    REQUIRE(difference.perceptibleFraction == 0.0f);
+    REQUIRE(comparator->isWithinTolerance(difference));
+
+    // A large difference at one pixel is perceptible, and independent of
+    // the number of threads.
+    image = reference;
+    image[(7 * width + 5) * 4] += 51;
+    comparator->setCreateDifferenceImage(true);
+    comparator->setThreadCount(1);
+    difference = comparator->compare(createDesc(image), createDesc(reference));
+    REQUIRE(std::abs(difference.maxError[0] - 0.2f) < 1e-6f);
+    REQUIRE(std::abs(difference.rmse[0] - 0.2f / std::sqrt(pixelCount)) < 1e-6f);
+    REQUIRE(difference.maxDeltaE > 2.3f);
+    REQUIRE(difference.perceptibleFraction == 1.0f / pixelCount);
+    REQUIRE(difference.differenceImage.size() == reference.size());
+    REQUIRE(difference.differenceImage[(7 * width + 5) * 4] == 255);
+    REQUIRE(difference.differenceImage[(7 * width + 6) * 4] == 0);
+    comparator->setThreadCount(4);
+    mx::ImageDifference threaded = comparator->compare(createDesc(image), createDesc(reference));
+    REQUIRE(threaded.rmse == difference.rmse);
+    REQUIRE(threaded.meanDeltaE == difference.meanDeltaE);
+    REQUIRE(threaded.differenceImage == difference.differenceImage);
+    mx::ImageComparator::Tolerance tolerance;
+    tolerance.maxError = 0.1f;
+    comparator->setTolerance(tolerance);
+    REQUIRE(!comparator->isWithinTolerance(difference));
+    comparator->setTolerance(mx::ImageComparator::Tolerance());
+
+    // Floating-point images compare with 8-bit images in the unit range.
+    std::vector<float> floats(reference.size());
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        floats[i] = reference[i] / 255.0f;
+    }
+    mx::ImageDesc floatDesc = createDesc(reference);
+    floatDesc.floatingPoint = true;
+    floatDesc.resourceBuffer = floats.data();
+    difference = comparator->compare(floatDesc, createDesc(reference));
+    REQUIRE(difference.getMaxError() < 1e-6f);
+    REQUIRE(difference.maxDeltaE < 1e-3f);
+    REQUIRE(difference.perceptibleFraction == 0.0f);
+    comparator->setSrgbEncoded(false);
+    difference = comparator->compare(floatDesc, createDesc(reference));
+    REQUIRE(difference.maxDeltaE < 1e-3f);
+    comparator->setSrgbEncoded(true);
+
+    // Mismatched resolutions cannot be compared.
+    mx::ImageDesc smallDesc = createDesc(reference);
+    smallDesc.height = height - 1;
+    REQUIRE_THROWS(comparator->compare(smallDesc, createDesc(reference)));
+
+    // Golden images are reported missing until written, then compared.
+    mx::FilePath rootPath = mx::FilePath::getCurrentPath() / mx::FilePath("goldenImages");
+    mx::FilePath differencePath = mx::FilePath::getCurrentPath() / mx::FilePath("goldenDifferences");
+    mx::GoldenImageStorePtr store = mx::GoldenImageStore::create(rootPath);
+    store->setDifferencePath(differencePath);
+    const std::string name = "suite/gradient";
+    REQUIRE(store->getGoldenPath(name) == rootPath / mx::FilePath("suite") / mx::FilePath("gradient.png"));
+    REQUIRE(store->compare(name, createDesc(reference)).status == mx::GoldenImageStore::MISSING);
+    store->setUpdate(true);
+    REQUIRE(store->compare(name, createDesc(reference)).status == mx::GoldenImageStore::UPDATED);
+    REQUIRE(store->getGoldenPath(name).exists());
+    store->setUpdate(false);
+    REQUIRE(store->compare(name, createDesc(reference)).status == mx::GoldenImageStore::PASSED);
+
+    std::vector<unsigned char> changed = reference;
+    for (size_t i = 0; i < changed.size() / 2; i += 4)
+    {
+        changed[i + 1] = 255 - changed[i + 1];
+    }
+    mx::GoldenImageStore::Result result = store->compare(name, createDesc(changed));
+    REQUIRE(result.status == mx::GoldenImageStore::FAILED);
+    REQUIRE(result.message.find(name) != std::string::npos);
+    REQUIRE(result.differencePath == differencePath / mx::FilePath("suite") / mx::FilePath("gradient_diff.png"));
+    REQUIRE(result.differencePath.exists());
+
+    // Rendered image files are compared, and written when updating. The
+    // rendered image is written with its rows reversed, as 8-bit images are
+    // flipped vertically on load.
+    std::vector<unsigned char> rendered(changed.size());
+    for (unsigned int y = 0; y < height; y++)
+    {
+        std::copy(changed.begin() + (height - 1 - y) * width * 4, changed.begin() + (height - y) * width * 4,
+                  rendered.begin() + y * width * 4);
+    }
+    mx::FilePath renderPath = mx::FilePath::getCurrentPath() / mx::FilePath("goldenRender.png");
+    REQUIRE(mx::StbImageLoader::create()->saveImage(renderPath, createDesc(rendered)));
+    REQUIRE(store->compare(name, renderPath).status == mx::GoldenImageStore::FAILED);
+    store->setUpdate(true);
+    REQUIRE(store->compare(name, renderPath).status == mx::GoldenImageStore::UPDATED);
+    store->setUpdate(false);
+    REQUIRE(store->compare(name, renderPath).status == mx::GoldenImageStore::PASSED);
+    REQUIRE(store->compare(name, createDesc(changed)).status == mx::GoldenImageStore::PASSED);
+
+    // Floating-point image files are re-encoded in the format of the store
+    // when updating, and HDR files are not flipped on load.
+    for (size_t i = 0; i < changed.size(); i++)
+    {
+        floats[i] = changed[i] / 255.0f;
+    }
+    mx::FilePath hdrPath = mx::FilePath::getCurrentPath() / mx::FilePath("goldenRender.hdr");
+    REQUIRE(mx::StbImageLoader::create()->saveImage(hdrPath, floatDesc));
+    const std::string hdrName = "suite/hdr";
+    store->setUpdate(true);
+    REQUIRE(store->compare(hdrName, hdrPath).status == mx::GoldenImageStore::UPDATED);
+    store->setUpdate(false);
+    std::ifstream goldenFile(store->getGoldenPath(hdrName).asString(), std::ios::binary);
+    char signature[4] = { 0, 0, 0, 0 };
+    goldenFile.read(signature, 4);
+    goldenFile.close();
+    REQUIRE(std::string(signature + 1, 3) == "PNG");
+    REQUIRE(store->compare(hdrName, hdrPath).status == mx::GoldenImageStore::PASSED);
+    REQUIRE(store->compare(hdrName, createDesc(changed)).status == mx::GoldenImageStore::PASSED);
+
+    std::remove(renderPath.asString().c_str());
+    std::remove(hdrPath.asString().c_str());
+    std::remove(store->getGoldenPath(hdrName).asString().c_str());
+    std::remove(result.differencePath.asString().c_str());
+    std::remove((differencePath / mx::FilePath("suite")).asString().c_str());
+    std::remove(differencePath.asString().c_str());
+    std::remove(store->getGoldenPath(name).asString().c_str());
+    std::remove((rootPath / mx::FilePath("suite")).asString().c_str());
+    std::remove(rootPath.asString().c_str());
+}
@@ -37,6 +37,16 @@ TEST_CASE("Look", "[look]")
     REQUIRE(material->getGeometryBindings("/robot2/right_arm").size() == 1);
     REQUIRE(material->getGeometryBindings("/robot2/left_arm").size() == 0);
 
+    // Resolve material assignments for a batch of geometry strings.
+    mx::StringVec geoms = { "/robot1", "/robot2/right_arm", "/robot2/left_arm", "/robot1, /robot2", "/robot3" };
+    std::vector<std::vector<mx::MaterialAssignPtr>> geomAssigns = look->getGeometryMaterialAssigns(geoms);
+    REQUIRE(geomAssigns.size() == geoms.size());
+    REQUIRE(geomAssigns[0] == std::vector<mx::MaterialAssignPtr>({ matAssign1 }));
+    REQUIRE(geomAssigns[1] == std::vector<mx::MaterialAssignPtr>({ matAssign2 }));
+    REQUIRE(geomAssigns[2].empty());
+    REQUIRE(geomAssigns[3] == std::vector<mx::MaterialAssignPtr>({ matAssign1, matAssign2 }));
+    REQUIRE(geomAssigns[4].empty());
+
     // Create a property assignment.
     mx::PropertyAssignPtr propertyAssign = look->addPropertyAssign("twosided");
     propertyAssign->setGeom("/robot1");
@@ -89,3 +99,103 @@ TEST_CASE("Look", "[look]")
     REQUIRE(look2->getActivePropertySetAssigns().empty());
     REQUIRE(look2->getActiveVisibilities().empty());
 }
+
+TEST_CASE("Look resolver", "[look]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::MaterialPtr material1 = doc->addMaterial("material1");
+    mx::MaterialPtr material2 = doc->addMaterial("material2");
+    mx::CollectionPtr collection = doc->addCollection("collection");
+    collection->setIncludeGeom("/robot2");
+    collection->setExcludeGeom("/robot2/left_arm");
+
+    // Create a base look and an inherited look.
+    mx::LookPtr baseLook = doc->addLook("baseLook");
+    mx::MaterialAssignPtr matAssign1 = baseLook->addMaterialAssign("matAssign1", material1->getName());
+    matAssign1->setGeom("/robot1");
+    mx::VisibilityPtr visibility = baseLook->addVisibility("visibility");
+    visibility->setCollection(collection);
+    mx::LookPtr look = doc->addLook("look");
+    look->setInheritsFrom(baseLook);
+    mx::MaterialAssignPtr matAssign2 = look->addMaterialAssign("matAssign2", material2->getName());
+    matAssign2->setCollection(collection);
+    mx::PropertyAssignPtr propAssign = look->addPropertyAssign("twosided");
+    propAssign->setGeom("/robot1/left_arm, /robot2/left_arm");
+    propAssign->setValue(true);
+    mx::PropertySetPtr propertySet = doc->addPropertySet();
+    mx::PropertySetAssignPtr propSetAssign = look->addPropertySetAssign(propertySet->getName());
+    propSetAssign->setGeom("/");
+    mx::VariantAssignPtr variantAssign = look->addVariantAssign();
+
+    // Resolve the look for a set of geometries.
+    mx::LookResolverPtr resolver = mx::LookResolver::create(look);
+    mx::StringVec geoms = { "/robot1", "/robot1/left_arm", "/robot2/right_arm", "/robot2/left_arm", "/robot3" };
+    resolver->setGeometries(geoms);
+    resolver->setThreadCount(2);
+    REQUIRE(resolver->update() == 5);
+    REQUIRE(resolver->getGeometryCount() == geoms.size());
+    REQUIRE(resolver->getMaterialAssign(0) == matAssign1);
+    REQUIRE(resolver->getMaterialAssign(1) == matAssign1);
+    REQUIRE(resolver->getMaterialAssign(2) == matAssign2);
+    REQUIRE(!resolver->getMaterialAssign(3));
+    REQUIRE(!resolver->getMaterialAssign(4));
+    REQUIRE(resolver->getPropertyAssigns(1) == std::vector<mx::PropertyAssignPtr>({ propAssign }));
+    REQUIRE(resolver->getPropertyAssigns(2).empty());
+    REQUIRE(resolver->getPropertySetAssigns(4) == std::vector<mx::PropertySetAssignPtr>({ propSetAssign }));
+    REQUIRE(resolver->getVisibilities(2) == std::vector<mx::VisibilityPtr>({ visibility }));
+    REQUIRE(resolver->getVisibilities(3).empty());
+    REQUIRE(resolver->getVariantAssigns() == std::vector<mx::VariantAssignPtr>({ variantAssign }));
+
+    // The resolved table matches per-geometry queries.
+    std::vector<std::vector<mx::MaterialAssignPtr>> geomAssigns = look->getGeometryMaterialAssigns(geoms);
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        REQUIRE(resolver->getMaterialAssigns(i) == geomAssigns[i]);
+    }
+
+    // Indices outside the table have no assignments.
+    REQUIRE(!resolver->getMaterialAssign(geoms.size()));
+    REQUIRE(!resolver->getMaterialAssign(1000));
+    REQUIRE(resolver->getMaterialAssigns(1000).empty());
+    REQUIRE(resolver->getVisibilities(geoms.size()).empty());
+
+    // Only modified assignments are resolved on update.
+    REQUIRE(resolver->update() == 0);
+    matAssign1->setMaterial(material2->getName());
+    REQUIRE(resolver->update() == 0);
+    collection->setExcludeGeom("/robot2/right_arm");
+    REQUIRE(resolver->update() == 2);
+    REQUIRE(!resolver->getMaterialAssign(2));
+    REQUIRE(resolver->getMaterialAssign(3) == matAssign2);
+    REQUIRE(resolver->getVisibilities(3) == std::vector<mx::VisibilityPtr>({ visibility }));
+    mx::MaterialAssignPtr matAssign3 = look->addMaterialAssign("matAssign3", material1->getName());
+    matAssign3->setGeom("/robot3");
+    REQUIRE(resolver->update() == 1);
+    REQUIRE(resolver->getMaterialAssign(4) == matAssign3);
+    look->removeMaterialAssign(matAssign2->getName());
+    REQUIRE(resolver->update() == 0);
+    REQUIRE(!resolver->getMaterialAssign(3));
+
+    // Changes to look inheritance are reflected on update.
+    look->setInheritsFrom(nullptr);
+    REQUIRE(resolver->update() == 0);
+    REQUIRE(!resolver->getMaterialAssign(0));
+    REQUIRE(resolver->getVisibilities(3).empty());
+
+    // Include cycles are reported.
+    mx::CollectionPtr collection2 = doc->addCollection("collection2");
+    collection2->setIncludeCollection(collection);
+    collection->setIncludeCollection(collection2);
+    propSetAssign->setCollection(collection);
+    REQUIRE_THROWS_AS(resolver->update(), mx::ExceptionFoundCycle&);
+    collection->setIncludeCollection(nullptr);
+    REQUIRE(resolver->update() == 3);
+
+    // Setting geometries clears the table until the next update.
+    mx::StringVec moreGeoms(100, "/robot3");
+    resolver->setGeometries(moreGeoms);
+    REQUIRE(!resolver->getMaterialAssign(99));
+    REQUIRE(resolver->update() == 3);
+    REQUIRE(resolver->getMaterialAssign(99) == matAssign3);
+    REQUIRE(!resolver->getMaterialAssign(100));
+}
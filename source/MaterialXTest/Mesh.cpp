@@ -0,0 +1,625 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXRender/Handlers/BinaryMeshLoader.h>
+#include <MaterialXRender/Handlers/MeshOptimizer.h>
+#include <MaterialXRender/Handlers/ParallelObjLoader.h>
+#include <MaterialXRender/Handlers/SampleObjLoader.h>
+#include <MaterialXRender/Handlers/TinyObjLoader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace mx = MaterialX;
+
+namespace
+{
+
+void compareMeshes(mx::MeshPtr mesh1, mx::MeshPtr mesh2)
+{
+    REQUIRE(mesh1->getIdentifier() == mesh2->getIdentifier());
+    REQUIRE(mesh1->getVertexCount() == mesh2->getVertexCount());
+    REQUIRE(mesh1->getMinimumBounds() == mesh2->getMinimumBounds());
+    REQUIRE(mesh1->getMaximumBounds() == mesh2->getMaximumBounds());
+    REQUIRE(mesh1->getStreams().size() == mesh2->getStreams().size());
+    for (mx::MeshStreamPtr stream1 : mesh1->getStreams())
+    {
+        mx::MeshStreamPtr stream2 = mesh2->getStream(stream1->getName());
+        REQUIRE(stream2);
+        REQUIRE(stream1->getType() == stream2->getType());
+        REQUIRE(stream1->getIndex() == stream2->getIndex());
+        REQUIRE(stream1->getStride() == stream2->getStride());
+        REQUIRE(stream1->getData() == stream2->getData());
+    }
+    REQUIRE(mesh1->getPartitionCount() == mesh2->getPartitionCount());
+    for (size_t p = 0; p < mesh1->getPartitionCount(); p++)
+    {
+        mx::MeshPartitionPtr part1 = mesh1->getPartition(p);
+        mx::MeshPartitionPtr part2 = mesh2->getPartition(p);
+        REQUIRE(part1->getIdentifier() == part2->getIdentifier());
+        REQUIRE(part1->getFaceCount() == part2->getFaceCount());
+        REQUIRE(part1->getIndices() == part2->getIndices());
+    }
+}
+
+// Create a rippled grid mesh with two triangles per cell.
+mx::MeshPtr createGridMesh(size_t resolution)
+{
+    mx::MeshPtr mesh = mx::Mesh::create("grid");
+    mx::MeshStreamPtr positionStream = mx::MeshStream::create("i_" + mx::MeshStream::POSITION_ATTRIBUTE, mx::MeshStream::POSITION_ATTRIBUTE, 0);
+    mx::MeshStreamPtr normalStream = mx::MeshStream::create("i_" + mx::MeshStream::NORMAL_ATTRIBUTE, mx::MeshStream::NORMAL_ATTRIBUTE, 0);
+    mx::MeshStreamPtr texcoordStream = mx::MeshStream::create("i_" + mx::MeshStream::TEXCOORD_ATTRIBUTE + "_0", mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+    texcoordStream->setStride(2);
+    mesh->addStream(positionStream);
+    mesh->addStream(normalStream);
+    mesh->addStream(texcoordStream);
+
+    size_t vertexCount = (resolution + 1) * (resolution + 1);
+    mesh->setVertexCount(vertexCount);
+    mx::MeshFloatBuffer& positions = positionStream->getData();
+    mx::MeshFloatBuffer& normals = normalStream->getData();
+    mx::MeshFloatBuffer& texcoords = texcoordStream->getData();
+    for (size_t y = 0; y <= resolution; y++)
+    {
+        for (size_t x = 0; x <= resolution; x++)
+        {
+            float u = (float) x / (float) resolution;
+            float v = (float) y / (float) resolution;
+            float h = 0.05f * std::sin(20.0f * u) * std::cos(15.0f * v);
+            positions.insert(positions.end(), { u, h, v });
+            normals.insert(normals.end(), { 0.0f, 1.0f, 0.0f });
+            texcoords.insert(texcoords.end(), { u + 0.1f * v, v });
+        }
+    }
+
+    mx::MeshPartitionPtr part = mx::MeshPartition::create();
+    part->setIdentifier("grid");
+    mx::MeshIndexBuffer& indices = part->getIndices();
+    for (size_t y = 0; y < resolution; y++)
+    {
+        for (size_t x = 0; x < resolution; x++)
+        {
+            unsigned int i0 = (unsigned int) (y * (resolution + 1) + x);
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + (unsigned int) resolution + 1;
+            unsigned int i3 = i2 + 1;
+            indices.insert(indices.end(), { i0, i1, i2, i1, i3, i2 });
+        }
+    }
+    part->setFaceCount(indices.size() / 3);
+    mesh->addPartition(part);
+    return mesh;
+}
+
+void compareStreams(mx::MeshStreamPtr stream1, mx::MeshStreamPtr stream2, float tolerance)
+{
+    const mx::MeshFloatBuffer& data1 = stream1->getData();
+    const mx::MeshFloatBuffer& data2 = stream2->getData();
+    REQUIRE(data1.size() == data2.size());
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < data1.size(); i++)
+    {
+        maxDiff = std::max(maxDiff, std::abs(data1[i] - data2[i]));
+    }
+    REQUIRE(maxDiff <= tolerance);
+}
+
+// Return the sorted list of faces of a mesh, with each face given by the
+// position data of its corners.
+std::vector<std::vector<float>> getSortedFaces(mx::MeshPtr mesh)
+{
+    mx::MeshStreamPtr positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+    const mx::MeshFloatBuffer& data = positions->getData();
+    unsigned int stride = positions->getStride();
+    std::vector<std::vector<float>> faces;
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        mx::MeshPartitionPtr part = mesh->getPartition(p);
+        for (size_t f = 0; f < part->getFaceCount(); f++)
+        {
+            std::vector<float> face;
+            for (size_t k = 0; k < 3; k++)
+            {
+                unsigned int index = part->getIndices()[f * 3 + k];
+                face.insert(face.end(), data.begin() + index * stride, data.begin() + (index + 1) * stride);
+            }
+            faces.push_back(face);
+        }
+    }
+    std::sort(faces.begin(), faces.end());
+    return faces;
+}
+
+// Write a mesh to an OBJ file, with a single shared index for all attributes.
+void writeObjFile(mx::MeshPtr mesh, const mx::FilePath& filePath)
+{
+    std::ofstream file(filePath.asString());
+    const mx::MeshFloatBuffer& positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0)->getData();
+    const mx::MeshFloatBuffer& normals = mesh->getStream(mx::MeshStream::NORMAL_ATTRIBUTE, 0)->getData();
+    const mx::MeshFloatBuffer& texcoords = mesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0)->getData();
+    for (size_t v = 0; v < mesh->getVertexCount(); v++)
+    {
+        file << "v " << positions[v * 3] << " " << positions[v * 3 + 1] << " " << positions[v * 3 + 2] << "\n";
+        file << "vt " << texcoords[v * 2] << " " << texcoords[v * 2 + 1] << "\n";
+        file << "vn " << normals[v * 3] << " " << normals[v * 3 + 1] << " " << normals[v * 3 + 2] << "\n";
+    }
+    for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+    {
+        mx::MeshPartitionPtr part = mesh->getPartition(p);
+        file << "g " << part->getIdentifier() << "\n";
+        const mx::MeshIndexBuffer& indices = part->getIndices();
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            file << "f";
+            for (size_t k = 0; k < 3; k++)
+            {
+                unsigned int index = indices[i + k] + 1;
+                file << " " << index << "/" << index << "/" << index;
+            }
+            file << "\n";
+        }
+    }
+}
+
+// Compare meshes loaded from the same OBJ file by different loader settings.
+// Tangents are accumulated in a thread-dependent order, so are compared with
+// a tolerance.
+void compareObjMeshes(mx::MeshPtr mesh1, mx::MeshPtr mesh2)
+{
+    REQUIRE(mesh1->getVertexCount() == mesh2->getVertexCount());
+    REQUIRE(mesh1->getMinimumBounds() == mesh2->getMinimumBounds());
+    REQUIRE(mesh1->getMaximumBounds() == mesh2->getMaximumBounds());
+    REQUIRE(mesh1->getStreams().size() == mesh2->getStreams().size());
+    for (mx::MeshStreamPtr stream1 : mesh1->getStreams())
+    {
+        mx::MeshStreamPtr stream2 = mesh2->getStream(stream1->getName());
+        REQUIRE(stream2);
+        if (stream1->getType() == mx::MeshStream::TANGENT_ATTRIBUTE)
+        {
+            compareStreams(stream1, stream2, 1.0e-5f);
+        }
+        else
+        {
+            REQUIRE(stream1->getData() == stream2->getData());
+        }
+    }
+    REQUIRE(mesh1->getPartitionCount() == mesh2->getPartitionCount());
+    for (size_t p = 0; p < mesh1->getPartitionCount(); p++)
+    {
+        mx::MeshPartitionPtr part1 = mesh1->getPartition(p);
+        mx::MeshPartitionPtr part2 = mesh2->getPartition(p);
+        REQUIRE(part1->getIdentifier() == part2->getIdentifier());
+        REQUIRE(part1->getFaceCount() == part2->getFaceCount());
+        REQUIRE(part1->getIndices() == part2->getIndices());
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("Binary mesh cache", "[geometry]")
+{
+    mx::FilePath geometryPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Geometry/teapot.obj");
+
+    mx::GeometryHandler objHandler;
+    objHandler.addLoader(mx::TinyObjLoader::create());
+    REQUIRE(objHandler.loadGeometry(geometryPath));
+    const mx::MeshList& objMeshes = objHandler.getMeshes();
+    REQUIRE(!objMeshes.empty());
+
+    // Round trip through the binary format.
+    mx::GeometryHandler binaryHandler;
+    binaryHandler.addLoader(mx::BinaryMeshLoader::create());
+    mx::FilePath binaryPath("teapot." + mx::BinaryMeshLoader::EXTENSION);
+    REQUIRE(binaryHandler.saveGeometry(binaryPath, objMeshes));
+    REQUIRE(binaryHandler.loadGeometry(binaryPath));
+    const mx::MeshList& binaryMeshes = binaryHandler.getMeshes();
+    REQUIRE(binaryMeshes.size() == objMeshes.size());
+    for (size_t i = 0; i < objMeshes.size(); i++)
+    {
+        compareMeshes(objMeshes[i], binaryMeshes[i]);
+        REQUIRE(binaryMeshes[i]->getSourceUri() == binaryPath.asString());
+    }
+    REQUIRE(binaryHandler.getMinimumBounds() == objHandler.getMinimumBounds());
+    REQUIRE(binaryHandler.getMaximumBounds() == objHandler.getMaximumBounds());
+
+    // Saving is not supported by the OBJ loader.
+    REQUIRE(!objHandler.saveGeometry(mx::FilePath("teapot_copy.obj"), objMeshes));
+
+    // Write the sidecar cache on the first load, and read from it on the second.
+    mx::FilePath cachePath = mx::GeometryHandler::getMeshCachePath(geometryPath);
+    std::remove(cachePath.asString().c_str());
+    mx::GeometryHandler cachedHandler;
+    cachedHandler.addLoader(mx::TinyObjLoader::create());
+    cachedHandler.setMeshCacheEnabled(true);
+    REQUIRE(cachedHandler.loadGeometry(geometryPath));
+    REQUIRE(cachePath.exists());
+    mx::BinaryMeshLoaderPtr cacheLoader = mx::BinaryMeshLoader::create();
+    const std::string cacheKey = mx::TinyObjLoader::create()->getCacheIdentifier();
+    mx::MeshList cachedMeshes;
+    REQUIRE(cacheLoader->loadCache(cachePath, geometryPath, cacheKey, cachedMeshes));
+    REQUIRE(!cacheLoader->loadCache(cachePath, binaryPath, cacheKey, cachedMeshes));
+
+    // Caches written by a different loader are not reused.
+    REQUIRE(cacheKey != cacheLoader->getCacheIdentifier());
+    REQUIRE(!cacheLoader->loadCache(cachePath, geometryPath, cacheLoader->getCacheIdentifier(), cachedMeshes));
+
+    mx::GeometryHandler reloadHandler;
+    reloadHandler.addLoader(mx::TinyObjLoader::create());
+    reloadHandler.setMeshCacheEnabled(true);
+    REQUIRE(reloadHandler.loadGeometry(geometryPath));
+    REQUIRE(reloadHandler.hasGeometry(geometryPath));
+    REQUIRE(reloadHandler.getMeshes().size() == objMeshes.size());
+    for (size_t i = 0; i < objMeshes.size(); i++)
+    {
+        compareMeshes(objMeshes[i], reloadHandler.getMeshes()[i]);
+    }
+
+    // Truncated files are rejected without modifying the mesh list.
+    mx::MeshList truncatedMeshes;
+    mx::FilePath truncatedPath("truncated." + mx::BinaryMeshLoader::EXTENSION);
+    {
+        std::ifstream input(binaryPath.asString(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        std::ofstream output(truncatedPath.asString(), std::ios::binary);
+        output.write(contents.data(), contents.size() / 2);
+    }
+    REQUIRE(!cacheLoader->load(truncatedPath, truncatedMeshes));
+    REQUIRE(truncatedMeshes.empty());
+
+    // Caches with indices beyond the vertex count are rejected, so that the
+    // mesh is reloaded from its source file.
+    mx::MeshPtr corruptMesh = createGridMesh(2);
+    corruptMesh->getPartition(0)->getIndices()[0] = (uint32_t) corruptMesh->getVertexCount();
+    REQUIRE(cacheLoader->saveCache(cachePath, geometryPath, cacheKey, { corruptMesh }));
+    mx::MeshList corruptMeshes;
+    REQUIRE(!cacheLoader->loadCache(cachePath, geometryPath, cacheKey, corruptMeshes));
+    REQUIRE(corruptMeshes.empty());
+    mx::GeometryHandler recoverHandler;
+    recoverHandler.addLoader(mx::TinyObjLoader::create());
+    recoverHandler.setMeshCacheEnabled(true);
+    REQUIRE(recoverHandler.loadGeometry(geometryPath));
+    REQUIRE(recoverHandler.getMeshes().size() == objMeshes.size());
+    REQUIRE(cacheLoader->loadCache(cachePath, geometryPath, cacheKey, corruptMeshes));
+
+    std::remove(cachePath.asString().c_str());
+    std::remove(binaryPath.asString().c_str());
+    std::remove(truncatedPath.asString().c_str());
+}
+
+TEST_CASE("Tangent generation", "[geometry]")
+{
+    // Split the mesh into several partitions, so that thread ranges span partition boundaries.
+    mx::MeshPtr mesh = createGridMesh(200);
+    mx::MeshPartitionPtr sourcePart = mesh->getPartition(0);
+    const mx::MeshIndexBuffer& sourceIndices = sourcePart->getIndices();
+    mx::MeshPtr splitMesh = mx::Mesh::create("split");
+    for (mx::MeshStreamPtr stream : mesh->getStreams())
+    {
+        splitMesh->addStream(stream);
+    }
+    const size_t SPLIT_COUNT = 3;
+    size_t facesPerSplit = sourcePart->getFaceCount() / SPLIT_COUNT + 1;
+    for (size_t face = 0; face < sourcePart->getFaceCount(); face += facesPerSplit)
+    {
+        size_t faceEnd = std::min(face + facesPerSplit, sourcePart->getFaceCount());
+        mx::MeshPartitionPtr part = mx::MeshPartition::create();
+        part->getIndices().assign(sourceIndices.begin() + face * 3, sourceIndices.begin() + faceEnd * 3);
+        part->setFaceCount(faceEnd - face);
+        splitMesh->addPartition(part);
+    }
+
+    mx::MeshStreamPtr positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+    mx::MeshStreamPtr texcoords = mesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+    mx::MeshStreamPtr normals = mesh->getStream(mx::MeshStream::NORMAL_ATTRIBUTE, 0);
+
+    mx::MeshStreamPtr serialTangents = mx::MeshStream::create("serialTangents", mx::MeshStream::TANGENT_ATTRIBUTE, 0);
+    mx::MeshStreamPtr serialBitangents = mx::MeshStream::create("serialBitangents", mx::MeshStream::BITANGENT_ATTRIBUTE, 0);
+    REQUIRE(mesh->generateTangents(positions, texcoords, normals, serialTangents, serialBitangents, 1));
+
+    for (unsigned int threadCount : { 2u, 4u, 0u })
+    {
+        mx::MeshStreamPtr tangents = mx::MeshStream::create("tangents", mx::MeshStream::TANGENT_ATTRIBUTE, 0);
+        mx::MeshStreamPtr bitangents = mx::MeshStream::create("bitangents", mx::MeshStream::BITANGENT_ATTRIBUTE, 0);
+        REQUIRE(splitMesh->generateTangents(positions, texcoords, normals, tangents, bitangents, threadCount));
+        compareStreams(serialTangents, tangents, 1.0e-5f);
+        compareStreams(serialBitangents, bitangents, 1.0e-5f);
+    }
+}
+
+TEST_CASE("Mesh optimization", "[geometry]")
+{
+    // Expand a grid mesh to one vertex per face corner, as OBJ loaders do.
+    const size_t RESOLUTION = 64;
+    mx::MeshPtr mesh = createGridMesh(RESOLUTION);
+    mx::MeshPartitionPtr part = mesh->getPartition(0);
+    mx::MeshIndexBuffer& indices = part->getIndices();
+    for (mx::MeshStreamPtr stream : mesh->getStreams())
+    {
+        unsigned int stride = stream->getStride();
+        mx::MeshFloatBuffer expanded;
+        for (unsigned int index : indices)
+        {
+            expanded.insert(expanded.end(), stream->getData().begin() + index * stride,
+                            stream->getData().begin() + (index + 1) * stride);
+        }
+        stream->getData().swap(expanded);
+    }
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        indices[i] = (unsigned int) i;
+    }
+    mesh->setVertexCount(indices.size());
+    std::vector<std::vector<float>> facesBefore = getSortedFaces(mesh);
+
+    mx::MeshOptimizerPtr optimizer = mx::MeshOptimizer::create();
+    mx::MeshOptimizer::Statistics stats = optimizer->optimize(mesh);
+    REQUIRE(stats.vertexCountBefore == RESOLUTION * RESOLUTION * 6);
+    REQUIRE(stats.vertexCountAfter == (RESOLUTION + 1) * (RESOLUTION + 1));
+    REQUIRE(mesh->getVertexCount() == stats.vertexCountAfter);
+    REQUIRE(stats.acmrBefore == 3.0f);
+    REQUIRE(stats.acmrAfter < 1.0f);
+    REQUIRE(getSortedFaces(mesh) == facesBefore);
+
+    // Vertices are in first-use order after optimization.
+    unsigned int nextVertex = 0;
+    bool firstUseOrder = true;
+    for (unsigned int index : part->getIndices())
+    {
+        firstUseOrder = firstUseOrder && index <= nextVertex;
+        if (index == nextVertex)
+        {
+            nextVertex++;
+        }
+    }
+    REQUIRE(firstUseOrder);
+
+    // Apply the optimizer to meshes from a geometry loader.
+    mx::FilePath geometryPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Geometry/sphere.obj");
+    mx::GeometryHandler handler;
+    handler.addLoader(mx::SampleObjLoader::create());
+    REQUIRE(handler.loadGeometry(geometryPath));
+    mx::MeshPtr sphere = handler.getMeshes()[0];
+    std::vector<std::vector<float>> sphereFaces = getSortedFaces(sphere);
+    float sphereACMR = optimizer->computeACMR(sphere);
+    size_t sphereVertexCount = sphere->getVertexCount();
+
+    mx::GeometryHandler optimizedHandler;
+    optimizedHandler.addLoader(mx::SampleObjLoader::create());
+    optimizedHandler.setMeshOptimizer(optimizer);
+    REQUIRE(optimizedHandler.loadGeometry(geometryPath));
+    mx::MeshPtr optimizedSphere = optimizedHandler.getMeshes()[0];
+    REQUIRE(optimizedSphere->getVertexCount() < sphereVertexCount);
+    REQUIRE(optimizer->computeACMR(optimizedSphere) < sphereACMR);
+    REQUIRE(getSortedFaces(optimizedSphere) == sphereFaces);
+
+    // Sidecar caches written without the optimizer are not reused with it.
+    mx::FilePath cachePath = mx::GeometryHandler::getMeshCachePath(geometryPath);
+    std::remove(cachePath.asString().c_str());
+    mx::GeometryHandler cachedHandler;
+    cachedHandler.addLoader(mx::SampleObjLoader::create());
+    cachedHandler.setMeshCacheEnabled(true);
+    REQUIRE(cachedHandler.loadGeometry(geometryPath));
+    REQUIRE(cachedHandler.getMeshes()[0]->getVertexCount() == sphereVertexCount);
+    mx::GeometryHandler optimizedCacheHandler;
+    optimizedCacheHandler.addLoader(mx::SampleObjLoader::create());
+    optimizedCacheHandler.setMeshCacheEnabled(true);
+    optimizedCacheHandler.setMeshOptimizer(optimizer);
+    REQUIRE(optimizedCacheHandler.loadGeometry(geometryPath));
+    REQUIRE(optimizedCacheHandler.getMeshes()[0]->getVertexCount() == optimizedSphere->getVertexCount());
+    std::remove(cachePath.asString().c_str());
+}
+
+TEST_CASE("Interleaved buffer", "[geometry]")
+{
+    mx::MeshPtr mesh = createGridMesh(4);
+    const mx::MeshStreamList& streams = mesh->getStreams();
+    mx::MeshInterleavedBufferPtr buffer = mesh->getInterleavedBuffer();
+    REQUIRE(buffer);
+    REQUIRE(buffer == mesh->getInterleavedBuffer());
+    REQUIRE(buffer->getVertexCount() == mesh->getVertexCount());
+    REQUIRE(buffer->getAttributes().size() == streams.size());
+
+    // Each stream is stored at its attribute offset within every vertex.
+    unsigned int stride = 0;
+    for (mx::MeshStreamPtr stream : streams)
+    {
+        const mx::MeshInterleavedBuffer::Attribute* attribute = buffer->getAttribute(stream->getName());
+        REQUIRE(attribute);
+        REQUIRE(attribute->stream == stream);
+        REQUIRE(attribute->offset == stride);
+        stride += stream->getStride();
+    }
+    REQUIRE(buffer->getStride() == stride);
+    REQUIRE(buffer->getData().size() == stride * mesh->getVertexCount());
+    REQUIRE(!buffer->getAttribute("unknown"));
+
+    for (const mx::MeshInterleavedBuffer::Attribute& attribute : buffer->getAttributes())
+    {
+        const mx::MeshFloatBuffer& data = attribute.stream->getData();
+        unsigned int streamStride = attribute.stream->getStride();
+        bool match = true;
+        for (size_t v = 0; v < mesh->getVertexCount(); v++)
+        {
+            for (unsigned int c = 0; c < streamStride; c++)
+            {
+                match = match && buffer->getData()[v * stride + attribute.offset + c] == data[v * streamStride + c];
+            }
+        }
+        REQUIRE(match);
+    }
+
+    // Adding a stream invalidates the cached buffer.
+    mx::MeshStreamPtr colors = mx::MeshStream::create("i_color_0", mx::MeshStream::COLOR_ATTRIBUTE, 0);
+    colors->setStride(4);
+    colors->getData().resize(mesh->getVertexCount() * 4, 1.0f);
+    mesh->addStream(colors);
+    mx::MeshInterleavedBufferPtr extendedBuffer = mesh->getInterleavedBuffer();
+    REQUIRE(extendedBuffer != buffer);
+    REQUIRE(extendedBuffer->getStride() == stride + 4);
+
+    // Optimization invalidates the cached buffer.
+    mx::MeshOptimizer::create()->optimize(mesh);
+    REQUIRE(mesh->getInterleavedBuffer() != extendedBuffer);
+    REQUIRE(mesh->getInterleavedBuffer()->getVertexCount() == mesh->getVertexCount());
+
+    // Streams with mismatched vertex counts produce an empty buffer.
+    mx::MeshStreamPtr shortStream = mx::MeshStream::create("i_short", mx::MeshStream::TEXCOORD_ATTRIBUTE, 1);
+    shortStream->setStride(2);
+    shortStream->getData().resize(2);
+    mx::MeshStreamList mismatchedStreams = streams;
+    mismatchedStreams.push_back(shortStream);
+    mx::MeshInterleavedBufferPtr emptyBuffer = mx::MeshInterleavedBuffer::create(mismatchedStreams);
+    REQUIRE(emptyBuffer->getData().empty());
+    REQUIRE(emptyBuffer->getAttributes().empty());
+}
+
+TEST_CASE("Parallel OBJ loading", "[geometry]")
+{
+    mx::ParallelObjLoaderPtr serialLoader = mx::ParallelObjLoader::create();
+    serialLoader->setThreadCount(1);
+    mx::ParallelObjLoaderPtr parallelLoader = mx::ParallelObjLoader::create();
+    parallelLoader->setThreadCount(7);
+    parallelLoader->setChunkSize(256);
+
+    // Results are independent of the number of threads, and match the face
+    // count and bounds of the TinyObj loader.
+    mx::FilePath geometryPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Geometry");
+    for (const char* filename : { "teapot.obj", "shaderball.obj", "sphere.obj" })
+    {
+        mx::MeshList serialMeshes, parallelMeshes, tinyMeshes;
+        REQUIRE(serialLoader->load(geometryPath / mx::FilePath(filename), serialMeshes));
+        REQUIRE(parallelLoader->load(geometryPath / mx::FilePath(filename), parallelMeshes));
+        REQUIRE(mx::TinyObjLoader::create()->load(geometryPath / mx::FilePath(filename), tinyMeshes));
+        REQUIRE(serialMeshes.size() == 1);
+        REQUIRE(parallelMeshes.size() == 1);
+        compareObjMeshes(serialMeshes[0], parallelMeshes[0]);
+        REQUIRE(getSortedFaces(serialMeshes[0]).size() == getSortedFaces(tinyMeshes[0]).size());
+        REQUIRE(serialMeshes[0]->getMinimumBounds() == tinyMeshes[0]->getMinimumBounds());
+        REQUIRE(serialMeshes[0]->getMaximumBounds() == tinyMeshes[0]->getMaximumBounds());
+    }
+
+    // Polygons, relative indices, groups and CRLF line endings.
+    const std::string objString =
+        "# Test file\n"
+        "o quad\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1.0e0 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "f 1/1 2/2 3/3 4/4\n"
+        "g tri\n"
+        "v 2.5 0 -0.5\n"
+        "vn 0 0 -1\n"
+        "f -1//1 -4//-1 -3//1\n"
+        "g empty\n"
+        "g pentagon\n"
+        "f 1 2 3 4 5\n"
+        "l 1 2\n";
+    std::string crlfString;
+    for (char c : objString)
+    {
+        crlfString += (c == '\n') ? "\r\n" : std::string(1, c);
+    }
+    mx::FilePath objPath("parallel_test.obj");
+    mx::FilePath crlfPath("parallel_test_crlf.obj");
+    std::ofstream(objPath.asString(), std::ios::binary) << objString;
+    std::ofstream(crlfPath.asString(), std::ios::binary) << crlfString;
+
+    mx::MeshList meshes;
+    REQUIRE(serialLoader->load(objPath, meshes));
+    REQUIRE(parallelLoader->load(crlfPath, meshes));
+    REQUIRE(meshes.size() == 2);
+    compareObjMeshes(meshes[0], meshes[1]);
+    mx::MeshPtr mesh = meshes[0];
+    REQUIRE(mesh->getVertexCount() == 18);
+    REQUIRE(mesh->getMinimumBounds() == mx::Vector3(0.0f, 0.0f, -0.5f));
+    REQUIRE(mesh->getMaximumBounds() == mx::Vector3(2.5f, 1.0f, 0.0f));
+    REQUIRE(mesh->getPartitionCount() == 3);
+    REQUIRE(mesh->getPartition(0)->getIdentifier() == "quad");
+    REQUIRE(mesh->getPartition(0)->getFaceCount() == 2);
+    REQUIRE(mesh->getPartition(1)->getIdentifier() == "tri");
+    REQUIRE(mesh->getPartition(1)->getFaceCount() == 1);
+    REQUIRE(mesh->getPartition(2)->getIdentifier() == "pentagon");
+    REQUIRE(mesh->getPartition(2)->getFaceCount() == 3);
+
+    // The relative face references the last position and the first normal.
+    const mx::MeshFloatBuffer& positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0)->getData();
+    const mx::MeshFloatBuffer& normals = mesh->getStream(mx::MeshStream::NORMAL_ATTRIBUTE, 0)->getData();
+    unsigned int triIndex = mesh->getPartition(1)->getIndices()[0];
+    REQUIRE(positions[triIndex * 3] == 2.5f);
+    REQUIRE(normals[triIndex * 3 + 2] == -1.0f);
+
+    // Faces without normals use the face normal.
+    unsigned int quadIndex = mesh->getPartition(0)->getIndices()[0];
+    REQUIRE(normals[quadIndex * 3 + 2] == 1.0f);
+
+    // Files which share a single index for all attributes are indexed directly.
+    mx::MeshPtr grid = createGridMesh(8);
+    mx::FilePath gridPath("parallel_grid.obj");
+    writeObjFile(grid, gridPath);
+    mx::MeshList gridMeshes;
+    REQUIRE(parallelLoader->load(gridPath, gridMeshes));
+    REQUIRE(gridMeshes[0]->getVertexCount() == grid->getVertexCount());
+    REQUIRE(gridMeshes[0]->getPartitionCount() == 1);
+    REQUIRE(gridMeshes[0]->getPartition(0)->getIndices() == grid->getPartition(0)->getIndices());
+    compareStreams(gridMeshes[0]->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0),
+                   grid->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0), 1.0e-5f);
+
+    // Indexed files may contain more texcoords than vertices when no face
+    // references them, in which case the texcoords are left at zero.
+    std::ofstream(objPath.asString(), std::ios::binary) <<
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "vn 0 0 1\nvn 0 0 1\nvn 0 0 1\n"
+        "vt 0.1 0.2\nvt 0.3 0.4\nvt 0.5 0.6\nvt 0.7 0.8\n"
+        "f 1//1 2//2 3//3\n";
+    mx::MeshList unusedTexcoordMeshes;
+    REQUIRE(serialLoader->load(objPath, unusedTexcoordMeshes));
+    REQUIRE(unusedTexcoordMeshes[0]->getVertexCount() == 3);
+    REQUIRE(unusedTexcoordMeshes[0]->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0)->getData() == mx::MeshFloatBuffer(6, 0.0f));
+
+    // Faces with and without texcoords may be mixed, in which case each face
+    // corner receives its own texcoord, or zero if it has none.
+    std::ofstream(objPath.asString(), std::ios::binary) <<
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+        "vn 0 0 1\nvn 0 0 1\nvn 0 0 1\nvn 0 0 1\n"
+        "vt 0.1 0.2\nvt 0.3 0.4\nvt 0.5 0.6\n"
+        "f 1/1/1 2/2/2 3/3/3\n"
+        "f 2//2 4//4 3//3\n";
+    mx::MeshList mixedMeshes;
+    REQUIRE(serialLoader->load(objPath, mixedMeshes));
+    REQUIRE(parallelLoader->load(objPath, mixedMeshes));
+    compareObjMeshes(mixedMeshes[0], mixedMeshes[1]);
+    mx::MeshPtr mixedMesh = mixedMeshes[0];
+    REQUIRE(mixedMesh->getVertexCount() == 6);
+    const mx::MeshFloatBuffer& mixedTexcoords = mixedMesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0)->getData();
+    const mx::MeshIndexBuffer& mixedIndices = mixedMesh->getPartition(0)->getIndices();
+    const float expectedTexcoords[6][2] = { { 0.1f, 0.2f }, { 0.3f, 0.4f }, { 0.5f, 0.6f },
+                                            { 0.0f, 0.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+    for (size_t i = 0; i < mixedIndices.size(); i++)
+    {
+        REQUIRE(mixedTexcoords[mixedIndices[i] * 2] == expectedTexcoords[i][0]);
+        REQUIRE(mixedTexcoords[mixedIndices[i] * 2 + 1] == expectedTexcoords[i][1]);
+    }
+
+    // Malformed files are rejected without modifying the mesh list.
+    mx::MeshList invalidMeshes;
+    for (const char* invalidString : { "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n",
+                                              "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 x\n",
+                                              "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 -4\n",
+                                              "v 0 0 0\nv 1 0 0\n" })
+    {
+        std::ofstream(objPath.asString(), std::ios::binary) << invalidString;
+        REQUIRE(!serialLoader->load(objPath, invalidMeshes));
+    }
+    REQUIRE(invalidMeshes.empty());
+    REQUIRE(!serialLoader->load(mx::FilePath("missing.obj"), invalidMeshes));
+
+    std::remove(objPath.asString().c_str());
+    std::remove(crlfPath.asString().c_str());
+    std::remove(gridPath.asString().c_str());
+}
@@ -31,6 +31,57 @@ bool isTopologicalOrder(const std::vector<mx::ElementPtr>& elems)
     return true;
 }
 
+mx::DocumentPtr loadBxdfLibraries()
+{
+    mx::FilePath librariesPath("libraries");
+    mx::DocumentPtr libraries = mx::createDocument();
+    for (const char* filename : { "stdlib/stdlib_defs.mtlx", "stdlib/stdlib_ng.mtlx",
+                                  "pbrlib/pbrlib_defs.mtlx", "pbrlib/pbrlib_ng.mtlx",
+                                  "bxdf/standard_surface.mtlx" })
+    {
+        mx::DocumentPtr library = mx::createDocument();
+        mx::readFromXmlFile(library, librariesPath / mx::FilePath(filename));
+        libraries->importLibrary(library);
+    }
+    return libraries;
+}
+
+// Add a standard_surface node and output to the given graph for each
+// shader reference of the bxdf library materials.
+void addBxdfMaterialNodes(mx::GraphElementPtr graph, const std::string& suffix = mx::EMPTY_STRING)
+{
+    mx::FilePath materialsPath("resources/Materials/TestSuite/pbrlib/materials");
+    for (const char* filename : { "standard_surface_brass_tiled.mtlx", "standard_surface_carpaint.mtlx",
+                                  "standard_surface_chrome.mtlx", "standard_surface_copper.mtlx",
+                                  "standard_surface_default.mtlx", "standard_surface_gold.mtlx",
+                                  "standard_surface_jade.mtlx", "standard_surface_marble_solid.mtlx",
+                                  "standard_surface_plastic.mtlx", "standard_surface_wood_tiled.mtlx" })
+    {
+        mx::DocumentPtr materialDoc = mx::createDocument();
+        mx::readFromXmlFile(materialDoc, materialsPath / mx::FilePath(filename));
+        for (mx::MaterialPtr material : materialDoc->getMaterials())
+        {
+            for (mx::ShaderRefPtr shaderRef : material->getShaderRefs())
+            {
+                if (shaderRef->getNodeString() != "standard_surface")
+                {
+                    continue;
+                }
+                mx::NodePtr node = graph->addNode("standard_surface", shaderRef->getName() + suffix, "surfaceshader");
+                for (mx::BindInputPtr bindInput : shaderRef->getBindInputs())
+                {
+                    if (bindInput->hasValueString())
+                    {
+                        node->setInputValue(bindInput->getName(), bindInput->getValueString(), bindInput->getType());
+                    }
+                }
+                mx::OutputPtr output = graph->addOutput("out_" + shaderRef->getName() + suffix, "surfaceshader");
+                output->setConnectedNode(node);
+            }
+        }
+    }
+}
+
 TEST_CASE("Node", "[node]")
 {
     // Create a document.
@@ -135,6 +186,64 @@ TEST_CASE("Node", "[node]")
     REQUIRE(doc->getOutputs().empty());
 }
 
+TEST_CASE("Flattened interface", "[node]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a base nodedef and an inherited nodedef that overrides one input.
+    mx::NodeDefPtr baseDef = doc->addNodeDef("ND_base", "color3", "base");
+    mx::InputPtr baseIn1 = baseDef->setInputValue("in1", mx::Color3(0.0f));
+    mx::InputPtr baseIn2 = baseDef->setInputValue("in2", mx::Color3(0.0f));
+    mx::ParameterPtr baseParam = baseDef->setParameterValue("param", 1.0f);
+    mx::NodeDefPtr derivedDef = doc->addNodeDef("ND_derived", "color3", "derived");
+    derivedDef->setInheritsFrom(baseDef);
+    mx::InputPtr derivedIn1 = derivedDef->setInputValue("in1", mx::Color3(1.0f));
+    mx::TokenPtr derivedToken = derivedDef->setTokenValue("token", "value");
+
+    // Flattened interfaces match inheritance traversal.
+    mx::ConstFlattenedInterfacePtr flattened = derivedDef->getFlattenedInterface();
+    REQUIRE(flattened->getInheritanceChain() == std::vector<mx::ConstElementPtr>({ derivedDef, baseDef }));
+    REQUIRE(flattened->getInputs() == std::vector<mx::InputPtr>({ derivedIn1, baseIn1, baseIn2 }));
+    REQUIRE(flattened->getParameters() == std::vector<mx::ParameterPtr>({ baseParam }));
+    REQUIRE(flattened->getTokens() == std::vector<mx::TokenPtr>({ derivedToken }));
+    REQUIRE(flattened->getValueElements().size() == 5);
+    REQUIRE(flattened->getInput("in1") == derivedIn1);
+    REQUIRE(flattened->getInput("in2") == baseIn2);
+    REQUIRE(!flattened->getInput("param"));
+    REQUIRE(flattened->getValueElement("param") == baseParam);
+    REQUIRE(derivedDef->getActiveInputs() == flattened->getInputs());
+    REQUIRE(derivedDef->getActiveInput("in2") == baseIn2);
+    REQUIRE(derivedDef->getActiveValueElement("token") == derivedToken);
+
+    // Flattened interfaces are cached until the document is modified.
+    REQUIRE(derivedDef->getFlattenedInterface() == flattened);
+    mx::InputPtr baseIn3 = baseDef->addInput("in3", "color3");
+    REQUIRE(derivedDef->getFlattenedInterface() != flattened);
+    REQUIRE(derivedDef->getActiveInputs().size() == 4);
+    REQUIRE(derivedDef->getActiveInput("in3") == baseIn3);
+    derivedDef->setInheritsFrom(nullptr);
+    REQUIRE(derivedDef->getActiveInputs() == std::vector<mx::InputPtr>({ derivedIn1 }));
+    REQUIRE(!derivedDef->getActiveInput("in2"));
+
+    // Inheritance cycles are reported.
+    derivedDef->setInheritsFrom(baseDef);
+    baseDef->setInheritsFrom(derivedDef);
+    REQUIRE_THROWS_AS(derivedDef->getFlattenedInterface(), mx::ExceptionFoundCycle&);
+    REQUIRE_THROWS_AS(derivedDef->getActiveInputs(), mx::ExceptionFoundCycle&);
+    baseDef->setInheritsFrom(nullptr);
+    REQUIRE(derivedDef->getActiveInputs().size() == 4);
+
+    // Flattened interfaces of a document do not keep it alive.
+    mx::DocumentPtr graphDoc = mx::createDocument();
+    mx::OutputPtr docOutput = graphDoc->addOutput("out", "color3");
+    REQUIRE(graphDoc->getActiveOutputs() == std::vector<mx::OutputPtr>({ docOutput }));
+    REQUIRE(graphDoc->getFlattenedInterface(graphDoc)->getOutputs() == std::vector<mx::OutputPtr>({ docOutput }));
+    std::weak_ptr<mx::Document> weakDoc = graphDoc;
+    graphDoc = nullptr;
+    docOutput = nullptr;
+    REQUIRE(weakDoc.expired());
+}
+
 TEST_CASE("Flatten", "[nodegraph]")
 {
     std::string searchPath = "resources/Materials/Examples" + mx::PATH_LIST_SEPARATOR + "libraries/stdlib";
@@ -178,6 +287,47 @@ TEST_CASE("Flatten", "[nodegraph]")
         }
     }
     REQUIRE(totalNodeCount == 15);
+
+    // Flatten instances of a library material, whose graph implementation
+    // contains nested graph-based nodes.
+    mx::DocumentPtr libraries = loadBxdfLibraries();
+    std::vector<mx::DocumentPtr> flatDocs;
+    for (int i = 0; i < 2; i++)
+    {
+        mx::DocumentPtr flatDoc = mx::createDocument();
+        flatDoc->importLibrary(libraries);
+        mx::NodeGraphPtr materialGraph = flatDoc->addNodeGraph("materials");
+        addBxdfMaterialNodes(materialGraph);
+        size_t outputCount = materialGraph->getOutputs().size();
+        REQUIRE(outputCount > 0);
+        materialGraph->flattenSubgraphs();
+        REQUIRE(materialGraph->validate());
+
+        std::set<std::string> nodeNames;
+        for (mx::NodePtr node : materialGraph->getNodes())
+        {
+            mx::InterfaceElementPtr implement = node->getImplementation();
+            REQUIRE((!implement || !implement->isA<mx::NodeGraph>()));
+            REQUIRE(nodeNames.insert(node->getName()).second);
+            for (mx::InputPtr input : node->getInputs())
+            {
+                REQUIRE((!input->hasNodeName() || input->getConnectedNode()));
+            }
+        }
+        REQUIRE(materialGraph->getOutputs().size() == outputCount);
+        REQUIRE(materialGraph->getOutputCount() == outputCount);
+        for (mx::OutputPtr output : materialGraph->getOutputs())
+        {
+            mx::NodePtr upstream = output->getConnectedNode();
+            REQUIRE(upstream);
+            REQUIRE(upstream->getType() == "surfaceshader");
+        }
+        REQUIRE(materialGraph->topologicalSort().size() == materialGraph->getChildren().size());
+        flatDocs.push_back(flatDoc);
+    }
+
+    // Flattening is deterministic.
+    REQUIRE(*flatDocs[0] == *flatDocs[1]);
 }
 
 TEST_CASE("Topological sort", "[nodegraph]")
@@ -229,6 +379,39 @@ TEST_CASE("Topological sort", "[nodegraph]")
     std::vector<mx::ElementPtr> elemOrder = nodeGraph->topologicalSort();
     REQUIRE(elemOrder.size() == nodeGraph->getChildren().size());
     REQUIRE(isTopologicalOrder(elemOrder));
+
+    // Validate the connections of the compiled graph.
+    mx::ConstCompiledGraphPtr graph = nodeGraph->getCompiledGraph();
+    REQUIRE(graph == nodeGraph->getCompiledGraph());
+    REQUIRE(graph->getElementCount() == nodeGraph->getChildren().size());
+    REQUIRE(graph->getPortCount() == 12);
+    REQUIRE(!graph->hasCycle());
+    size_t mixId = graph->getElementId(mix);
+    REQUIRE(graph->getElement(mixId) == mix);
+    REQUIRE(graph->getUpstream(mixId).size() == 3);
+    REQUIRE(graph->getDownstream(mixId).size() == 1);
+    REQUIRE(graph->getElement(graph->getDownstream(mixId).begin()->element) == output);
+    REQUIRE(graph->getPort(graph->getDownstream(mixId).begin()->port) == output);
+    size_t add1Id = graph->getElementId(add1);
+    for (const mx::CompiledGraph::Connection& connection : graph->getDownstream(add1Id))
+    {
+        mx::PortElementPtr port = graph->getPort(connection.port);
+        REQUIRE(port->getParent() == graph->getElement(connection.element));
+        REQUIRE(port->getConnectedNode() == add1);
+    }
+    REQUIRE(graph->getDownstream(add1Id).size() == 2);
+    REQUIRE(graph->getElementId(doc->addNode("constant")) == mx::CompiledGraph::INVALID_ID);
+
+    // Modifying the document invalidates the compiled graph.
+    REQUIRE(nodeGraph->getCompiledGraph() != graph);
+    graph = nodeGraph->getCompiledGraph();
+    add1->setConnectedNode("in1", mix);
+    REQUIRE(nodeGraph->getCompiledGraph() != graph);
+    REQUIRE(nodeGraph->getCompiledGraph()->hasCycle());
+    REQUIRE_THROWS_AS(nodeGraph->topologicalSort(), mx::ExceptionFoundCycle&);
+    add1->setConnectedNode("in1", constant1);
+    REQUIRE(!nodeGraph->getCompiledGraph()->hasCycle());
+    REQUIRE(isTopologicalOrder(nodeGraph->topologicalSort()));
 }
 
 TEST_CASE("New nodegraph from output", "[nodegraph]")
@@ -154,3 +154,230 @@ TEST_CASE("Observer", "[observer]")
     mx::readFromXmlString(doc, xmlString);
     testObserver->verifyCountsDisabled();
 }
+
+TEST_CASE("Observer transactions", "[observer]")
+{
+    class ChangeObserver : public mx::Observer
+    {
+      public:
+        ChangeObserver() :
+            commitCount(0),
+            beginUpdateCount(0),
+            endUpdateCount(0),
+            addElementCount(0),
+            removeElementCount(0),
+            setAttributeCount(0),
+            removeAttributeCount(0),
+            throwOnCommit(false)
+        {
+        }
+
+        void onCommitTransaction(const mx::ChangeSet& changes) override
+        {
+            commitCount++;
+            lastChanges = changes;
+            if (throwOnCommit)
+            {
+                throw mx::Exception("Commit failed");
+            }
+            mx::Observer::onCommitTransaction(changes);
+        }
+        void onBeginUpdate() override { beginUpdateCount++; }
+        void onEndUpdate() override { endUpdateCount++; }
+        void onAddElement(mx::ElementPtr, mx::ElementPtr) override { addElementCount++; }
+        void onRemoveElement(mx::ElementPtr, mx::ElementPtr elem) override
+        {
+            removeElementCount++;
+            callbacks.push_back("removeElement " + elem->getName());
+        }
+        void onSetAttribute(mx::ElementPtr, const std::string& attrib, const std::string& value) override
+        {
+            setAttributeCount++;
+            callbacks.push_back("setAttribute " + attrib + " " + value);
+        }
+        void onRemoveAttribute(mx::ElementPtr, const std::string& attrib) override
+        {
+            removeAttributeCount++;
+            callbacks.push_back("removeAttribute " + attrib);
+        }
+
+        void clear()
+        {
+            commitCount = 0;
+            beginUpdateCount = 0;
+            endUpdateCount = 0;
+            addElementCount = 0;
+            removeElementCount = 0;
+            setAttributeCount = 0;
+            removeAttributeCount = 0;
+            lastChanges.clear();
+            callbacks.clear();
+        }
+
+      public:
+        unsigned int commitCount;
+        unsigned int beginUpdateCount;
+        unsigned int endUpdateCount;
+        unsigned int addElementCount;
+        unsigned int removeElementCount;
+        unsigned int setAttributeCount;
+        unsigned int removeAttributeCount;
+        bool throwOnCommit;
+        mx::ChangeSet lastChanges;
+        std::vector<std::string> callbacks;
+    };
+
+    mx::ObservedDocumentPtr doc = mx::Document::createDocument<mx::ObservedDocument>();
+    std::shared_ptr<ChangeObserver> observer = std::make_shared<ChangeObserver>();
+    doc->addObserver("observer", observer);
+
+    // Create some existing content outside of a transaction.
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("graph");
+    mx::NodePtr existing = nodeGraph->addNode("constant", "existing", "color3");
+    mx::NodePtr doomed = nodeGraph->addNode("constant", "doomed", "color3");
+    observer->clear();
+
+    // Make a set of changes within nested transactions.
+    REQUIRE(doc->getTransactionDepth() == 0);
+    doc->beginTransaction();
+    {
+        mx::ScopedTransaction transaction(doc);
+        REQUIRE(doc->getTransactionDepth() == 2);
+        for (int i = 0; i < 10; i++)
+        {
+            mx::NodePtr node = nodeGraph->addNode("constant", "node" + std::to_string(i), "color3");
+            node->setParameterValue("value", mx::Color3(0.5f));
+            node->setParameterValue("value", mx::Color3(1.0f));
+        }
+        mx::NodePtr temporary = nodeGraph->addNode("constant", "temporary", "color3");
+        temporary->setParameterValue("value", mx::Color3(0.0f));
+        nodeGraph->removeNode(temporary->getName());
+        existing->setAttribute("xpos", "1");
+        existing->setAttribute("xpos", "2");
+        existing->setAttribute("ypos", "3");
+        existing->removeAttribute("ypos");
+        nodeGraph->removeNode(doomed->getName());
+    }
+    REQUIRE(doc->getTransactionDepth() == 1);
+    REQUIRE(observer->commitCount == 0);
+    REQUIRE(observer->beginUpdateCount == 0);
+    REQUIRE(observer->addElementCount == 0);
+    doc->commitTransaction();
+    REQUIRE(doc->getTransactionDepth() == 0);
+
+    // Verify the coalesced change set.
+    const std::vector<mx::ChangeSet::Change>& changes = observer->lastChanges.getChanges();
+    REQUIRE(observer->commitCount == 1);
+    REQUIRE(changes.size() == 23);
+    for (size_t i = 0; i < 20; i++)
+    {
+        REQUIRE(changes[i].type == mx::ChangeSet::ChangeAddElement);
+    }
+    REQUIRE(changes[0].parent == nodeGraph);
+    REQUIRE(changes[0].elem == nodeGraph->getNode("node0"));
+    REQUIRE(changes[20].type == mx::ChangeSet::ChangeSetAttribute);
+    REQUIRE(changes[20].elem == existing);
+    REQUIRE(changes[20].attrib == "xpos");
+    REQUIRE(changes[20].value == "2");
+    REQUIRE(changes[21].type == mx::ChangeSet::ChangeRemoveAttribute);
+    REQUIRE(changes[21].attrib == "ypos");
+    REQUIRE(changes[21].value == "3");
+    REQUIRE(changes[22].type == mx::ChangeSet::ChangeRemoveElement);
+    REQUIRE(changes[22].elem == doomed);
+
+    // Verify that the change set was reported through the default callbacks.
+    REQUIRE(observer->beginUpdateCount == 1);
+    REQUIRE(observer->endUpdateCount == 1);
+    REQUIRE(observer->addElementCount == 20);
+    REQUIRE(observer->removeElementCount == 1);
+    REQUIRE(observer->setAttributeCount == 1);
+    REQUIRE(observer->removeAttributeCount == 1);
+    std::vector<std::string> callbacks = { "setAttribute xpos 2", "removeAttribute ypos", "removeElement doomed" };
+    REQUIRE(observer->callbacks == callbacks);
+
+    // Document lookups within a transaction reflect its changes.
+    observer->clear();
+    {
+        mx::ScopedTransaction transaction(doc);
+        mx::NodePtr upstream = nodeGraph->addNode("constant", "upstream", "color3");
+        mx::NodePtr downstream = nodeGraph->addNode("add", "downstream", "color3");
+        downstream->setConnectedNode("in1", upstream);
+        REQUIRE(upstream->getDownstreamPorts().size() == 1);
+    }
+    REQUIRE(observer->commitCount == 1);
+
+    // Transactions with no changes are not reported.
+    observer->clear();
+    {
+        mx::ScopedTransaction transaction(doc);
+    }
+    REQUIRE(observer->commitCount == 0);
+
+    // Exceptions thrown while committing are propagated by an explicit
+    // commit, and are discarded when committing on destruction.
+    observer->clear();
+    observer->throwOnCommit = true;
+    {
+        mx::ScopedTransaction transaction(doc);
+        existing->setAttribute("xpos", "3");
+        REQUIRE_THROWS_AS(transaction.commit(), mx::Exception&);
+        REQUIRE_THROWS_AS(transaction.commit(), mx::Exception&);
+    }
+    REQUIRE(doc->getTransactionDepth() == 0);
+    {
+        mx::ScopedTransaction transaction(doc);
+        existing->setAttribute("xpos", "4");
+    }
+    REQUIRE(doc->getTransactionDepth() == 0);
+    REQUIRE(observer->commitCount == 2);
+    observer->throwOnCommit = false;
+
+    // Committing without an open transaction is an error.
+    REQUIRE_THROWS_AS(doc->commitTransaction(), mx::Exception&);
+}
+
+TEST_CASE("Observed document caches", "[observer]")
+{
+    mx::ObservedDocumentPtr doc = mx::Document::createDocument<mx::ObservedDocument>();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("graph");
+    mx::NodePtr constant1 = nodeGraph->addNode("constant", "constant1", "color3");
+    mx::NodePtr constant2 = nodeGraph->addNode("constant", "constant2", "color3");
+    mx::NodePtr add = nodeGraph->addNode("add", "add", "color3");
+    mx::InputPtr in1 = add->setConnectedNode("in1", constant1);
+
+    mx::NodeDefPtr baseDef1 = doc->addNodeDef("ND_base1", "color3", "base");
+    baseDef1->addInput("base1In", "color3");
+    mx::NodeDefPtr baseDef2 = doc->addNodeDef("ND_base2", "color3", "base");
+    baseDef2->addInput("base2In", "color3");
+    mx::NodeDefPtr derivedDef = doc->addNodeDef("ND_derived", "color3", "derived");
+    derivedDef->setInheritsFrom(baseDef1);
+
+    // Populate the cached compiled graph and flattened interface.
+    mx::ConstCompiledGraphPtr graph = nodeGraph->getCompiledGraph();
+    REQUIRE(graph->getDownstream(graph->getElementId(constant1)).size() == 1);
+    REQUIRE(graph->getDownstream(graph->getElementId(constant2)).empty());
+    REQUIRE(derivedDef->getFlattenedInterface()->getInput("base1In"));
+
+    // Copying content replaces attributes without per-attribute callbacks,
+    // and must still invalidate the document caches.
+    mx::DocumentPtr source = mx::createDocument();
+    mx::InputPtr sourceInput = source->addNodeGraph("graph")->addNode("add", "add", "color3")->addInput("in1", "color3");
+    sourceInput->setNodeName("constant2");
+    in1->copyContentFrom(sourceInput);
+    graph = nodeGraph->getCompiledGraph();
+    REQUIRE(graph->getDownstream(graph->getElementId(constant1)).empty());
+    REQUIRE(graph->getDownstream(graph->getElementId(constant2)).size() == 1);
+
+    mx::NodeDefPtr sourceDef = source->addNodeDef("ND_derived", "color3", "derived");
+    sourceDef->setInheritString("ND_base2");
+    derivedDef->copyContentFrom(sourceDef);
+    REQUIRE(!derivedDef->getFlattenedInterface()->getInput("base1In"));
+    REQUIRE(derivedDef->getFlattenedInterface()->getInput("base2In"));
+
+    // Clearing content must also invalidate the document caches.
+    derivedDef->clearContent();
+    REQUIRE(!derivedDef->getFlattenedInterface()->getInput("base2In"));
+    in1->clearContent();
+    graph = nodeGraph->getCompiledGraph();
+    REQUIRE(graph->getDownstream(graph->getElementId(constant2)).empty());
+}
@@ -21,6 +21,8 @@
 #include <MaterialXGenShader/HwShaderGenerator.h>
 #include <MaterialXGenShader/DefaultColorManagementSystem.h>
 #include <MaterialXRender/Handlers/HwLightHandler.h>
+#include <MaterialXRender/Handlers/ImageComparator.h>
+#include <MaterialXRender/ShaderValidators/BatchValidator.h>
 
 #ifdef MATERIALX_BUILD_RENDERGLSL
 #include <MaterialXGenGlsl/GlslShaderGenerator.h>
@@ -202,6 +204,9 @@ public:
         output << "\tGLSL Shader Geometry: " << glslShaderGeometry.asString() << std::endl;
         output << "\tRadiance IBL File Path " << radianceIBLPath.asString() << std::endl;
         output << "\tIrradiance IBL File Path: " << irradianceIBLPath.asString() << std::endl;
+        output << "\tGolden Image Path: " << goldenImagePath.asString() << std::endl;
+        output << "\tUpdate Golden Images: " << updateGoldenImages << std::endl;
+        output << "\tBatch Thread Count: " << batchThreadCount << std::endl;
     }
 
     // Filter list of files to only run validation on.
@@ -257,6 +262,18 @@ public:
 
     // IradianceIBL file
     MaterialX::FilePath irradianceIBLPath;
+
+    // Directory of golden images to compare saved images against.
+    // Comparison is disabled if empty.
+    MaterialX::FilePath goldenImagePath;
+
+    // Replace missing and differing golden images with saved images
+    bool updateGoldenImages = false;
+
+    // Number of threads on which GLSL shaders are generated ahead of their
+    // validation by a batch validator. If zero, GLSL shaders are generated
+    // and validated serially.
+    int batchThreadCount = 0;
 };
 
 // Per language profile times
@@ -485,6 +502,43 @@ static void runOGSFXValidation(const std::string& shaderName, mx::TypedElementPt
 #endif
 
 #ifdef MATERIALX_BUILD_RENDERGLSL
+// Compare a saved image against its golden image, named by the path of the
+// image within the test suite. Returns false if the images differ.
+static bool compareGoldenImage(const mx::FilePath& imagePath, const ShaderValidTestOptions& testOptions, std::ostream& log)
+{
+    if (testOptions.goldenImagePath.isEmpty())
+    {
+        return true;
+    }
+
+    const mx::FilePath suitePath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Materials/TestSuite");
+    const std::string suitePrefix = suitePath.asString(mx::FilePath::FormatPosix) + "/";
+    std::string name = mx::removeExtension(imagePath.asString(mx::FilePath::FormatPosix));
+    if (name.compare(0, suitePrefix.size(), suitePrefix) == 0)
+    {
+        name = name.substr(suitePrefix.size());
+    }
+    else
+    {
+        name = mx::removeExtension(imagePath.getBaseName());
+    }
+
+    mx::FilePath goldenPath = testOptions.goldenImagePath;
+    if (!goldenPath.isAbsolute())
+    {
+        goldenPath = mx::FilePath::getCurrentPath() / goldenPath;
+    }
+    mx::GoldenImageStorePtr store = mx::GoldenImageStore::create(goldenPath);
+    store->setUpdate(testOptions.updateGoldenImages);
+    store->setDifferencePath(suitePath);
+    mx::GoldenImageStore::Result result = store->compare(name, imagePath);
+    if (result.status != mx::GoldenImageStore::PASSED)
+    {
+        log << ">> " << result.message << std::endl;
+    }
+    return result.status != mx::GoldenImageStore::FAILED;
+}
+
 // Test by connecting it to a supplied element
 // 1. Create the shader and checks for source generation
 // 2. Writes doc to disk if valid
@@ -725,6 +779,7 @@ static void runGLSLValidation(const std::string& shaderName, mx::TypedElementPtr
                         AdditiveScopedTimer ioTimer(profileTimes.glslTimes.imageSaveTime, "GLSL image save time");
                         std::string fileName = shaderPath + "_glsl.png";
                         validator.save(fileName, false);
+                        CHECK(compareGoldenImage(fileName, testOptions, log));
                     }
                 }
 
@@ -751,6 +806,96 @@ static void runGLSLValidation(const std::string& shaderName, mx::TypedElementPtr
         }
     }
 }
+
+// Validate the GLSL shaders of a set of documents with a batch validator,
+// which generates shaders on worker threads while this thread compiles,
+// renders and saves them. All elements are rendered with the shader
+// geometry, and images are saved to the "batch" directory of the test suite.
+static void runGLSLBatchValidation(const mx::StringVec& documentPaths, mx::DocumentPtr dependLib,
+                                   mx::GlslValidatorPtr validator, const mx::HwLightHandlerPtr lightHandler,
+                                   const mx::FilePath& searchPath, const mx::FileSearchPath& imageSearchPath,
+                                   std::ostream& log, const ShaderValidTestOptions& testOptions,
+                                   ShaderValidProfileTimes& profileTimes)
+{
+    AdditiveScopedTimer totalGLSLTime(profileTimes.glslTimes.totalTime, "GLSL total time");
+
+    // Each worker uses a generator of its own, whose color management
+    // system reads a copy of the libraries of its own.
+    auto createContext = [&]() -> mx::GenContextPtr
+    {
+        mx::DocumentPtr libraries = dependLib->copy();
+        mx::ShaderGeneratorPtr generator = mx::GlslShaderGenerator::create();
+        mx::ColorManagementSystemPtr colorManagementSystem = mx::DefaultColorManagementSystem::create(generator->getLanguage());
+        colorManagementSystem->loadLibrary(libraries);
+        generator->setColorManagementSystem(colorManagementSystem);
+
+        mx::GenContextPtr context = std::make_shared<mx::GenContext>(generator);
+        context->registerSourceCodeSearchPath(searchPath);
+        context->getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_COMPLETE;
+        if (lightHandler)
+        {
+            lightHandler->registerLights(libraries, lightHandler->getLightSources(), *context);
+        }
+        return context;
+    };
+
+    mx::FilePath geomPath = testOptions.glslShaderGeometry.isEmpty() ? mx::FilePath("shaderball.obj") : testOptions.glslShaderGeometry;
+    if (!geomPath.isAbsolute())
+    {
+        geomPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Geometry") / geomPath;
+    }
+    mx::GeometryHandler& geomHandler = validator->getGeometryHandler();
+    if (!geomHandler.hasGeometry(geomPath))
+    {
+        geomHandler.clearGeometry();
+        geomHandler.loadGeometry(geomPath);
+    }
+    validator->setLightHandler(lightHandler);
+    validator->getImageHandler()->setSearchPath(imageSearchPath);
+
+    const mx::FilePath outputPath = mx::FilePath::getCurrentPath() / mx::FilePath("resources/Materials/TestSuite/batch");
+    mx::BatchValidatorPtr batch = mx::BatchValidator::create(createContext, testOptions.compileCode ? validator : nullptr);
+    batch->setLibraries(dependLib);
+    batch->setThreadCount(static_cast<unsigned int>(testOptions.batchThreadCount));
+    if (testOptions.saveImages)
+    {
+        batch->setOutputPath(outputPath);
+    }
+
+    mx::BatchValidator::Report report;
+    batch->validate(documentPaths, report);
+    report.writeJson(mx::FilePath("genglsl_batch_render_report.json"));
+
+    for (const mx::BatchValidator::DocumentReport& document : report.documents)
+    {
+        for (const std::string& error : document.errors)
+        {
+            log << ">> " << document.path << ": " << error << std::endl;
+        }
+        CHECK(document.errors.empty());
+    }
+    for (const mx::BatchValidator::ElementReport& element : report.elements)
+    {
+        profileTimes.elementsTested++;
+        profileTimes.glslTimes.generationTime += element.generateTime / 1000.0;
+        profileTimes.glslTimes.compileTime += element.compileTime / 1000.0;
+        profileTimes.glslTimes.renderTime += element.renderTime / 1000.0;
+        profileTimes.glslTimes.imageSaveTime += element.saveTime / 1000.0;
+
+        log << "------------ Run GLSL batch validation with element: " << element.elementPath <<
+               " in " << element.documentPath << "-------------------" << std::endl;
+        for (const std::string& error : element.errors)
+        {
+            log << ">> " << error << std::endl;
+        }
+        bool validated = element.errors.empty();
+        if (validated && testOptions.saveImages)
+        {
+            CHECK(compareGoldenImage(outputPath / mx::FilePath(element.shaderName + ".png"), testOptions, log));
+        }
+        CHECK(validated);
+    }
+}
 #endif
 
 #ifdef MATERIALX_BUILD_RENDEROSL
@@ -966,6 +1111,9 @@ bool getTestOptions(const std::string& optionFile, ShaderValidTestOptions& optio
     const std::string GLSL_SHADER_GEOMETRY_STRING("glslShaderGeometry");
     const std::string RADIANCE_IBL_PATH_STRING("radianceIBLPath");
     const std::string IRRADIANCE_IBL_PATH_STRING("irradianceIBLPath");
+    const std::string GOLDEN_IMAGE_PATH_STRING("goldenImagePath");
+    const std::string UPDATE_GOLDEN_IMAGES_STRING("updateGoldenImages");
+    const std::string BATCH_THREAD_COUNT_STRING("batchThreadCount");
 
     options.overrideFiles.clear();
     options.dumpGeneratedCode = false;
@@ -1051,6 +1199,18 @@ bool getTestOptions(const std::string& optionFile, ShaderValidTestOptions& optio
                     {
                         options.irradianceIBLPath = p->getValueString();
                     }
+                    else if (name == GOLDEN_IMAGE_PATH_STRING)
+                    {
+                        options.goldenImagePath = p->getValueString();
+                    }
+                    else if (name == UPDATE_GOLDEN_IMAGES_STRING)
+                    {
+                        options.updateGoldenImages = val->asA<bool>();
+                    }
+                    else if (name == BATCH_THREAD_COUNT_STRING)
+                    {
+                        options.batchThreadCount = val->asA<int>();
+                    }
                 }
             }
         }
@@ -1387,6 +1547,14 @@ TEST_CASE("Render TestSuite", "[render]")
 
     mx::StringSet usedImpls;
 
+#ifdef MATERIALX_BUILD_RENDERGLSL
+    // Documents whose GLSL shaders are validated as a batch once all
+    // documents have been visited.
+    const bool batchGLSL = options.runGLSLTests && options.batchThreadCount > 0;
+    mx::StringVec batchDocumentPaths;
+    mx::FileSearchPath batchImageSearchPath;
+#endif
+
     const std::string MTLX_EXTENSION("mtlx");
     const std::string OPTIONS_FILENAME("_options.mtlx");
     for (auto dir : dirs)
@@ -1425,7 +1593,12 @@ TEST_CASE("Render TestSuite", "[render]")
             validateTimer.startTimer();
             std::cout << "Validating MTLX file: " << filename << std::endl;
 #ifdef MATERIALX_BUILD_RENDERGLSL
-            if (options.runGLSLTests)
+            if (batchGLSL)
+            {
+                batchDocumentPaths.push_back(filename);
+                batchImageSearchPath.append(mx::FilePath(dir));
+            }
+            else if (options.runGLSLTests)
                 glslLog << "MTLX Filename: " << filename << std::endl;
 #ifdef MATERIALX_BUILD_GEN_OGSFX
             if (options.runOGSFXTests)
@@ -1493,7 +1666,10 @@ TEST_CASE("Render TestSuite", "[render]")
                                 mx::InterfaceElementPtr nodeGraphImpl = nodeGraph ? nodeGraph->getImplementation() : nullptr;
                                 usedImpls.insert(nodeGraphImpl ? nodeGraphImpl->getName() : impl->getName());
                             }
-                            runGLSLValidation(elementName, element, *glslValidator, glslContext, glslLightHandler, doc, glslLog, options, profileTimes, imageSearchPath, outputPath);
+                            if (!batchGLSL)
+                            {
+                                runGLSLValidation(elementName, element, *glslValidator, glslContext, glslLightHandler, doc, glslLog, options, profileTimes, imageSearchPath, outputPath);
+                            }
                         }
                     }
 #endif
@@ -1538,6 +1714,14 @@ TEST_CASE("Render TestSuite", "[render]")
         }
     }
 
+#ifdef MATERIALX_BUILD_RENDERGLSL
+    if (batchGLSL)
+    {
+        runGLSLBatchValidation(batchDocumentPaths, dependLib, glslValidator, glslLightHandler, searchPath,
+                               batchImageSearchPath, glslLog, options, profileTimes);
+    }
+#endif
+
     // Dump out profiling information
     totalTime.endTimer();
     printRunLog(profileTimes, options, usedImpls, profilingLog, dependLib
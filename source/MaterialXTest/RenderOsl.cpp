@@ -0,0 +1,199 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#if defined(MATERIALX_BUILD_RENDEROSL) && defined(MATERIALX_BUILD_OSL_INPROCESS)
+
+#include <MaterialXFormat/File.h>
+
+#include <MaterialXGenShader/ShaderStage.h>
+
+#include <MaterialXRender/Handlers/StbImageLoader.h>
+
+#include <MaterialXRenderOsl/OslValidator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace mx = MaterialX;
+
+namespace {
+
+// Image handler which reads and writes images without uploading them.
+class LoaderImageHandler : public mx::ImageHandler
+{
+  public:
+    LoaderImageHandler() :
+        mx::ImageHandler(mx::StbImageLoader::create())
+    {
+    }
+
+    bool bindImage(const std::string&, const mx::ImageSamplingProperties&) override
+    {
+        return false;
+    }
+
+  protected:
+    void deleteImage(mx::ImageDesc& imageDesc) override
+    {
+        free(imageDesc.resourceBuffer);
+        imageDesc.resourceBuffer = nullptr;
+    }
+};
+
+unsigned char quantize(float value)
+{
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<unsigned char>(value * 255.0f + 0.5f);
+}
+
+} // anonymous namespace
+
+TEST_CASE("OSL In-Process Shading", "[renderosl]")
+{
+    const std::string shaderName("inprocess_uv");
+    const std::string source =
+        "shader inprocess_uv(output color out = 0)\n"
+        "{\n"
+        "    out = color(u, v, 0.5);\n"
+        "}\n";
+    mx::ShaderValidator::StageMap stages = { { mx::Stage::PIXEL, source } };
+    const mx::FilePath includePath(MATERIALX_OSL_INCLUDE_PATH);
+    const mx::FilePath outputPath = mx::FilePath::getCurrentPath();
+    const std::string shaderPath = (outputPath / shaderName).asString();
+
+    // Shade in process, at the resolution used by testshade.
+    const unsigned int IMAGE_SIZE = 256;
+    mx::OslRuntimePtr runtime = mx::OslRuntime::create(includePath);
+    const std::string oso = runtime->compile(shaderName, source);
+    REQUIRE(!oso.empty());
+    std::vector<float> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+    mx::ImageDesc image;
+    image.width = IMAGE_SIZE;
+    image.height = IMAGE_SIZE;
+    image.channelCount = 4;
+    image.floatingPoint = true;
+    image.resourceBuffer = pixels.data();
+    runtime->shade(oso, "out", image);
+
+    // Each pixel takes the texture coordinates of its center.
+    const float* centerPixel = &pixels[((IMAGE_SIZE / 2) * IMAGE_SIZE + IMAGE_SIZE / 2) * 4];
+    REQUIRE(std::abs(centerPixel[0] - (IMAGE_SIZE / 2 + 0.5f) / IMAGE_SIZE) < 1e-5f);
+    REQUIRE(std::abs(centerPixel[1] - (IMAGE_SIZE / 2 + 0.5f) / IMAGE_SIZE) < 1e-5f);
+    REQUIRE(centerPixel[2] == 0.5f);
+    REQUIRE(centerPixel[3] == 1.0f);
+
+    // Shading the same shader again reuses the loaded shader.
+    std::vector<float> repeatPixels(pixels.size());
+    image.resourceBuffer = repeatPixels.data();
+    runtime->shade(oso, "out", image);
+    REQUIRE(repeatPixels == pixels);
+
+    // Images which are not floating point are rejected.
+    std::vector<unsigned char> bytePixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+    mx::ImageDesc byteImage = image;
+    byteImage.floatingPoint = false;
+    byteImage.resourceBuffer = bytePixels.data();
+    REQUIRE_THROWS_AS(runtime->shade(oso, "out", byteImage), mx::ExceptionShaderValidationError&);
+
+    // Shade in process through the validator, which writes the image
+    // where testrender would.
+    mx::OslValidatorPtr validator = mx::OslValidator::create();
+    validator->setOslIncludePath(includePath);
+    validator->setOslOutputFilePath(outputPath);
+    validator->setOslShaderName(shaderName);
+    validator->setOslShaderOutput("out", "color");
+    validator->setImageHandler(std::make_shared<LoaderImageHandler>());
+    validator->initialize();
+    REQUIRE(validator->getRuntime());
+    validator->validateCreation(stages);
+    validator->validateRender();
+
+    mx::StbImageLoaderPtr loader = mx::StbImageLoader::create();
+    const std::string renderPath = shaderPath + "_osl.png";
+    mx::ImageDesc renderImage;
+    REQUIRE(loader->acquireImage(renderPath, renderImage, false));
+    REQUIRE(!renderImage.floatingPoint);
+    REQUIRE(renderImage.channelCount == 4);
+    const unsigned char* renderTexel = static_cast<unsigned char*>(renderImage.resourceBuffer) +
+        ((renderImage.height / 2) * renderImage.width + renderImage.width / 2) * 4;
+    for (unsigned int c = 0; c < 3; c++)
+    {
+        REQUIRE(std::abs((int) renderTexel[c] - 128) <= 1);
+    }
+    free(renderImage.resourceBuffer);
+
+    // Compare against the image shaded by oslc and testshade, when testshade
+    // is installed alongside oslc.
+    std::string testShadeExecutable(MATERIALX_OSLC_EXECUTABLE);
+    size_t compilerPos = testShadeExecutable.rfind("oslc");
+    if (compilerPos != std::string::npos)
+    {
+        testShadeExecutable.replace(compilerPos, 4, "testshade");
+    }
+    if (compilerPos == std::string::npos || !mx::FilePath(testShadeExecutable).exists())
+    {
+        WARN("Skipping comparison with testshade, which was not found alongside oslc.");
+    }
+    else
+    {
+        mx::OslValidatorPtr executableValidator = mx::OslValidator::create();
+        executableValidator->useInProcess(false);
+        executableValidator->useTestRender(false);
+        executableValidator->setOslCompilerExecutable(mx::FilePath(MATERIALX_OSLC_EXECUTABLE));
+        executableValidator->setOslTestShadeExecutable(testShadeExecutable);
+        executableValidator->setOslIncludePath(includePath);
+        executableValidator->setOslOutputFilePath(outputPath);
+        executableValidator->setOslShaderName(shaderName);
+        executableValidator->setOslShaderOutput("out", "color");
+        executableValidator->initialize();
+        REQUIRE(!executableValidator->getRuntime());
+        executableValidator->validateCreation(stages);
+        executableValidator->validateRender();
+
+        // testshade writes the first row of the grid at the top of the image,
+        // while 8-bit images are flipped vertically on load.
+        mx::ImageDesc testShadeImage;
+        REQUIRE(loader->acquireImage(shaderPath + ".testshade.png", testShadeImage, false));
+        REQUIRE(testShadeImage.width == IMAGE_SIZE);
+        REQUIRE(testShadeImage.height == IMAGE_SIZE);
+        REQUIRE(testShadeImage.channelCount >= 3);
+        const unsigned char* texels = static_cast<unsigned char*>(testShadeImage.resourceBuffer);
+        int maxError = 0;
+        for (unsigned int y = 0; y < IMAGE_SIZE; y++)
+        {
+            for (unsigned int x = 0; x < IMAGE_SIZE; x++)
+            {
+                const unsigned char* texel = texels + (y * IMAGE_SIZE + x) * testShadeImage.channelCount;
+                const float* pixel = &pixels[((IMAGE_SIZE - 1 - y) * IMAGE_SIZE + x) * 4];
+                for (unsigned int c = 0; c < 3; c++)
+                {
+                    maxError = std::max(maxError, std::abs((int) texel[c] - (int) quantize(pixel[c])));
+                }
+            }
+        }
+        free(testShadeImage.resourceBuffer);
+        REQUIRE(maxError <= 2);
+    }
+
+    const std::string outputFiles[] =
+    {
+        shaderPath + ".osl",
+        shaderPath + ".oso",
+        shaderPath + ".osl_compile_errors.txt",
+        shaderPath + "_shade_errors.txt",
+        shaderPath + ".testshade.png",
+        renderPath
+    };
+    for (const std::string& file : outputFiles)
+    {
+        std::remove(file.c_str());
+    }
+}
+
+#endif
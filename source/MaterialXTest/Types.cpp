@@ -8,7 +8,9 @@
 #include <MaterialXCore/Types.h>
 #include <MaterialXCore/Value.h>
 
+#include <algorithm>
 #include <cmath>
+#include <random>
 
 namespace mx = MaterialX;
 
@@ -123,3 +125,85 @@ TEST_CASE("Matrices", "[types]")
     REQUIRE((rotX * rotZ).isEquivalent(mx::Matrix44::createScale({-1, 1, -1}), EPSILON));
     REQUIRE((rotY * rotZ).isEquivalent(mx::Matrix44::createScale({1, -1, -1}), EPSILON));
 }
+
+TEST_CASE("Matrix transformations", "[types]")
+{
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    auto maxElement = [](const mx::Matrix44& m)
+    {
+        float res = 0;
+        for (size_t i = 0; i < 4; i++)
+            for (size_t j = 0; j < 4; j++)
+                res = std::max(res, std::abs(m[i][j]));
+        return res;
+    };
+    auto randomMatrix = [&]()
+    {
+        mx::Matrix44 m(mx::Uninit{});
+        for (size_t i = 0; i < 4; i++)
+            for (size_t j = 0; j < 4; j++)
+                m[i][j] = dist(rng);
+        return m;
+    };
+
+    for (int iter = 0; iter < 100; iter++)
+    {
+        mx::Matrix44 m1 = randomMatrix();
+        mx::Matrix44 m2 = randomMatrix();
+
+        // Compare the matrix product to a scalar reference.
+        mx::Matrix44 prod = m1 * m2;
+        mx::Matrix44 refProd;
+        for (size_t i = 0; i < 4; i++)
+            for (size_t j = 0; j < 4; j++)
+                for (size_t k = 0; k < 4; k++)
+                    refProd[i][j] += m1[i][k] * m2[k][j];
+        REQUIRE(prod.isEquivalent(refProd, EPSILON));
+
+        // Compare the inverse to the adjugate and determinant.
+        mx::Matrix44 inv = m1.getInverse();
+        mx::Matrix44 refInv = m1.getAdjugate() / m1.getDeterminant();
+        REQUIRE(inv.isEquivalent(refInv, EPSILON * maxElement(refInv)));
+        REQUIRE((m1 * inv).isEquivalent(mx::Matrix44::IDENTITY, EPSILON));
+
+        // Compare vector transformations to the matrix product.
+        mx::Vector4 v(dist(rng), dist(rng), dist(rng), dist(rng));
+        mx::Matrix44 row(v[0], v[1], v[2], v[3],
+                         0, 0, 0, 0,
+                         0, 0, 0, 0,
+                         0, 0, 0, 0);
+        mx::Matrix44 rowProd = row * m1;
+        mx::Vector4 res = m1.multiply(v);
+        for (size_t j = 0; j < 4; j++)
+        {
+            REQUIRE(std::abs(res[j] - rowProd[0][j]) < EPSILON);
+        }
+        mx::Vector3 p(v[0], v[1], v[2]);
+        mx::Vector4 point = m1.multiply(mx::Vector4(p[0], p[1], p[2], 1));
+        mx::Vector4 dir = m1.multiply(mx::Vector4(p[0], p[1], p[2], 0));
+        REQUIRE(m1.transformPoint(p) == mx::Vector3(point[0], point[1], point[2]));
+        REQUIRE(m1.transformVector(p) == mx::Vector3(dir[0], dir[1], dir[2]));
+
+        // Compare the affine inverse to the general inverse.
+        mx::Matrix44 affine = m1;
+        affine[0][3] = affine[1][3] = affine[2][3] = 0;
+        affine[3][3] = 1;
+        mx::Matrix44 affineInv = affine.getInverse();
+        REQUIRE(affine.getAffineInverse().isEquivalent(affineInv, EPSILON * maxElement(affineInv)));
+    }
+
+    // Batch transformations match individual transformations, including
+    // when applied in place.
+    mx::Matrix44 m = mx::Matrix44::createRotationX(0.5f) * mx::Matrix44::createTranslation(mx::Vector3(1, 2, 3));
+    std::vector<mx::Vector3> points = { mx::Vector3(1, 0, 0), mx::Vector3(0, 1, 0), mx::Vector3(0, 0, 1), mx::Vector3(1, 2, 3) };
+    std::vector<mx::Vector3> transformed(points.size());
+    m.transformPoints(points.data(), transformed.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        REQUIRE(transformed[i] == m.transformPoint(points[i]));
+    }
+    m.transformVectors(points.data(), points.data(), points.size());
+    REQUIRE(points[3] == m.transformVector(mx::Vector3(1, 2, 3)));
+    REQUIRE((m.getAffineInverse().transformPoint(transformed[3]) - mx::Vector3(1, 2, 3)).getMagnitude() < EPSILON);
+}
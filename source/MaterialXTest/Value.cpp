@@ -8,6 +8,9 @@
 #include <MaterialXCore/Util.h>
 #include <MaterialXCore/Value.h>
 
+#include <locale>
+#include <thread>
+
 namespace mx = MaterialX;
 
 template<class T> void testTypedValue(const T& v1, const T& v2)
@@ -66,6 +69,15 @@ TEST_CASE("Value strings", "[value]")
         REQUIRE(mx::toValueString(0.1234f) == "0.12");
     }
 
+    // Float formatting is a per-thread setting.
+    {
+        mx::Value::ScopedFloatFormatting fmt(mx::Value::FloatFormatFixed, 3);
+        std::string threadString;
+        std::thread([&threadString]() { threadString = mx::toValueString(1.0f); }).join();
+        REQUIRE(threadString == "1");
+        REQUIRE(mx::toValueString(1.0f) == "1.000");
+    }
+
     // Convert from value strings to data values.
     REQUIRE(mx::fromValueString<int>("1") == 1);
     REQUIRE(mx::fromValueString<float>("1") == 1.0f);
@@ -79,6 +91,20 @@ TEST_CASE("Value strings", "[value]")
     REQUIRE_THROWS_AS(mx::fromValueString<float>("text"), mx::ExceptionTypeError&);
     REQUIRE_THROWS_AS(mx::fromValueString<bool>("1"), mx::ExceptionTypeError&);
     REQUIRE_THROWS_AS(mx::fromValueString<mx::Color3>("1"), mx::ExceptionTypeError&);
+
+    // Verify that conversions are independent of the global locale.
+    struct CommaNumPunct : public std::numpunct<char>
+    {
+        char do_decimal_point() const override { return ','; }
+        char do_thousands_sep() const override { return '.'; }
+        std::string do_grouping() const override { return "\3"; }
+    };
+    std::locale previousLocale = std::locale::global(std::locale(std::locale::classic(), new CommaNumPunct));
+    REQUIRE(mx::toValueString(0.5f) == "0.5");
+    REQUIRE(mx::toValueString(12345) == "12345");
+    REQUIRE(mx::fromValueString<float>("0.5") == 0.5f);
+    REQUIRE(mx::fromValueString<mx::Color3>("0.5, 0.25, 1e-3") == mx::Color3(0.5f, 0.25f, 0.001f));
+    std::locale::global(previousLocale);
 }
 
 TEST_CASE("Typed values", "[value]")
@@ -25,6 +25,10 @@ void bindPyDocument(py::module& mod)
         .def("getNodeGraphs", &mx::Document::getNodeGraphs)
         .def("removeNodeGraph", &mx::Document::removeNodeGraph)
         .def("getMatchingPorts", &mx::Document::getMatchingPorts)
+        .def("getCompiledGraph", [](const mx::Document& doc, mx::ConstGraphElementPtr graph)
+            {
+                return std::const_pointer_cast<mx::CompiledGraph>(doc.getCompiledGraph(graph));
+            })
         .def("addMaterial", &mx::Document::addMaterial,
             py::arg("name") = mx::EMPTY_STRING)
         .def("getMaterial", &mx::Document::getMaterial)
@@ -80,5 +84,8 @@ void bindPyDocument(py::module& mod)
         .def("getColorManagementSystem", &mx::Document::getColorManagementSystem)
         .def("setColorManagementConfig", &mx::Document::setColorManagementConfig)
         .def("hasColorManagementConfig", &mx::Document::hasColorManagementConfig)
-        .def("getColorManagementConfig", &mx::Document::getColorManagementConfig);
+        .def("getColorManagementConfig", &mx::Document::getColorManagementConfig)
+        .def("beginTransaction", &mx::Document::beginTransaction)
+        .def("commitTransaction", &mx::Document::commitTransaction)
+        .def("getTransactionDepth", &mx::Document::getTransactionDepth);
 }
@@ -85,5 +85,16 @@ void bindPyGeom(py::module& mod)
         .def("matchesGeomString", &mx::Collection::matchesGeomString)
         .def_readonly_static("CATEGORY", &mx::Collection::CATEGORY);
 
+    py::class_<mx::GeomStringMatcher>(mod, "GeomStringMatcher")
+        .def(py::init<const std::string&>(), py::arg("geom") = mx::EMPTY_STRING)
+        .def("addGeomString", &mx::GeomStringMatcher::addGeomString)
+        .def("isEmpty", &mx::GeomStringMatcher::isEmpty)
+        .def("matchesGeomString", &mx::GeomStringMatcher::matchesGeomString,
+            py::arg("geom"), py::arg("contains") = false);
+
+    py::class_<mx::CompiledCollection, mx::CompiledCollectionPtr>(mod, "CompiledCollection")
+        .def_static("create", &mx::CompiledCollection::create)
+        .def("matchesGeomString", &mx::CompiledCollection::matchesGeomString);
+
     mod.def("geomStringsMatch", &mx::geomStringsMatch);
 }
@@ -21,6 +21,7 @@ void bindPyLook(py::module& mod)
         .def("getMaterialAssign", &mx::Look::getMaterialAssign)
         .def("getMaterialAssigns", &mx::Look::getMaterialAssigns)
         .def("getActiveMaterialAssigns", &mx::Look::getActiveMaterialAssigns)
+        .def("getGeometryMaterialAssigns", &mx::Look::getGeometryMaterialAssigns)
         .def("removeMaterialAssign", &mx::Look::removeMaterialAssign)
         .def("addPropertyAssign", &mx::Look::addPropertyAssign,
             py::arg("name") = mx::EMPTY_STRING)
@@ -70,4 +71,20 @@ void bindPyLook(py::module& mod)
         .def("setVisible", &mx::Visibility::setVisible)
         .def("getVisible", &mx::Visibility::getVisible)
         .def_readonly_static("CATEGORY", &mx::Visibility::CATEGORY);
+
+    py::class_<mx::LookResolver, mx::LookResolverPtr>(mod, "LookResolver")
+        .def_static("create", &mx::LookResolver::create)
+        .def("getLook", &mx::LookResolver::getLook)
+        .def("setGeometries", &mx::LookResolver::setGeometries)
+        .def("getGeometries", &mx::LookResolver::getGeometries)
+        .def("setThreadCount", &mx::LookResolver::setThreadCount)
+        .def("getThreadCount", &mx::LookResolver::getThreadCount)
+        .def("update", &mx::LookResolver::update)
+        .def("getGeometryCount", &mx::LookResolver::getGeometryCount)
+        .def("getMaterialAssign", &mx::LookResolver::getMaterialAssign)
+        .def("getMaterialAssigns", &mx::LookResolver::getMaterialAssigns)
+        .def("getPropertyAssigns", &mx::LookResolver::getPropertyAssigns)
+        .def("getPropertySetAssigns", &mx::LookResolver::getPropertySetAssigns)
+        .def("getVisibilities", &mx::LookResolver::getVisibilities)
+        .def("getVariantAssigns", &mx::LookResolver::getVariantAssigns);
 }
@@ -37,6 +37,10 @@ void bindPyNode(py::module& mod)
         .def("flattenSubgraphs", &mx::NodeGraph::flattenSubgraphs,
             py::arg("target") = mx::EMPTY_STRING)
         .def("topologicalSort", &mx::NodeGraph::topologicalSort)
+        .def("getCompiledGraph", [](const mx::GraphElement& graph)
+            {
+                return std::const_pointer_cast<mx::CompiledGraph>(graph.getCompiledGraph());
+            })
         .def("asStringDot", &mx::NodeGraph::asStringDot);
 
     py::class_<mx::NodeGraph, mx::NodeGraphPtr, mx::GraphElement>(mod, "NodeGraph")
@@ -12,6 +12,28 @@ namespace mx = MaterialX;
 
 void bindPyObserver(py::module& mod)
 {
+    py::class_<mx::ChangeSet> changeSet(mod, "ChangeSet");
+
+    py::enum_<mx::ChangeSet::ChangeType>(changeSet, "ChangeType")
+        .value("ChangeAddElement", mx::ChangeSet::ChangeType::ChangeAddElement)
+        .value("ChangeRemoveElement", mx::ChangeSet::ChangeType::ChangeRemoveElement)
+        .value("ChangeSetAttribute", mx::ChangeSet::ChangeType::ChangeSetAttribute)
+        .value("ChangeRemoveAttribute", mx::ChangeSet::ChangeType::ChangeRemoveAttribute)
+        .value("ChangeCopyContent", mx::ChangeSet::ChangeType::ChangeCopyContent)
+        .value("ChangeClearContent", mx::ChangeSet::ChangeType::ChangeClearContent)
+        .export_values();
+
+    py::class_<mx::ChangeSet::Change>(changeSet, "Change")
+        .def_readonly("type", &mx::ChangeSet::Change::type)
+        .def_readonly("parent", &mx::ChangeSet::Change::parent)
+        .def_readonly("elem", &mx::ChangeSet::Change::elem)
+        .def_readonly("attrib", &mx::ChangeSet::Change::attrib)
+        .def_readonly("value", &mx::ChangeSet::Change::value);
+
+    changeSet
+        .def("getChanges", &mx::ChangeSet::getChanges)
+        .def("empty", &mx::ChangeSet::empty);
+
     py::class_<mx::Observer, std::shared_ptr<mx::Observer> >(mod, "Observer")
         .def("onAddElement", &mx::Observer::onAddElement)
         .def("onRemoveElement", &mx::Observer::onRemoveElement)
@@ -22,7 +44,8 @@ void bindPyObserver(py::module& mod)
         .def("onRead", &mx::Observer::onRead)
         .def("onWrite", &mx::Observer::onWrite)
         .def("onBeginUpdate", &mx::Observer::onBeginUpdate)
-        .def("onEndUpdate", &mx::Observer::onEndUpdate);
+        .def("onEndUpdate", &mx::Observer::onEndUpdate)
+        .def("onCommitTransaction", &mx::Observer::onCommitTransaction);
 }
 
 void bindPyObservedDocument(py::module& mod)
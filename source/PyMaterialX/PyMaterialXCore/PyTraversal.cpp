@@ -68,5 +68,30 @@ void bindPyTraversal(py::module& mod)
                 return *it;
             });
 
+    py::class_<mx::CompiledGraph, mx::CompiledGraphPtr>(mod, "CompiledGraph")
+        .def_static("create", &mx::CompiledGraph::create)
+        .def("getElementCount", &mx::CompiledGraph::getElementCount)
+        .def("getElement", &mx::CompiledGraph::getElement)
+        .def("getElementId", &mx::CompiledGraph::getElementId)
+        .def("getPortCount", &mx::CompiledGraph::getPortCount)
+        .def("getPort", &mx::CompiledGraph::getPort)
+        .def("getUpstream", [](const mx::CompiledGraph& graph, size_t id)
+            {
+                std::vector<std::pair<size_t, size_t>> connections;
+                for (const mx::CompiledGraph::Connection& connection : graph.getUpstream(id))
+                    connections.emplace_back(connection.element, connection.port);
+                return connections;
+            })
+        .def("getDownstream", [](const mx::CompiledGraph& graph, size_t id)
+            {
+                std::vector<std::pair<size_t, size_t>> connections;
+                for (const mx::CompiledGraph::Connection& connection : graph.getDownstream(id))
+                    connections.emplace_back(connection.element, connection.port);
+                return connections;
+            })
+        .def("hasCycle", &mx::CompiledGraph::hasCycle)
+        .def("getTopologicalOrder", &mx::CompiledGraph::getTopologicalOrder)
+        .def_readonly_static("INVALID_ID", &mx::CompiledGraph::INVALID_ID);
+
     py::register_exception<mx::ExceptionFoundCycle>(mod, "ExceptionFoundCycle");
 }
@@ -27,6 +27,7 @@ void bindPyHwShaderGenerator(py::module& mod)
     mod.attr("HW_LIGHT_DIR") = mx::HW::LIGHT_DIR;
     mod.attr("HW_VIEW_DIR") = mx::HW::VIEW_DIR;
     mod.attr("HW_ATTR_TRANSPARENT") =  mx::HW::ATTR_TRANSPARENT;
+    mod.attr("HW_ATTR_UNIFORM_BLOCKS") =  mx::HW::ATTR_UNIFORM_BLOCKS;
 
     py::class_<mx::HwShaderGenerator, mx::ShaderGenerator, mx::HwShaderGeneratorPtr>(mod, "HwShaderGenerator")
         .def("getNodeClosureContexts", &mx::HwShaderGenerator::getNodeClosureContexts)
@@ -0,0 +1,61 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/ShaderValidators/BatchValidator.h>
+
+#include <pybind11/functional.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyBatchValidator(py::module& mod)
+{
+    py::class_<mx::BatchValidator, mx::BatchValidatorPtr> batchValidator(mod, "BatchValidator");
+
+    py::class_<mx::BatchValidator::DocumentReport>(batchValidator, "DocumentReport")
+        .def(py::init<>())
+        .def_readwrite("path", &mx::BatchValidator::DocumentReport::path)
+        .def_readwrite("loadTime", &mx::BatchValidator::DocumentReport::loadTime)
+        .def_readwrite("errors", &mx::BatchValidator::DocumentReport::errors);
+
+    py::class_<mx::BatchValidator::ElementReport>(batchValidator, "ElementReport")
+        .def(py::init<>())
+        .def_readwrite("documentPath", &mx::BatchValidator::ElementReport::documentPath)
+        .def_readwrite("elementPath", &mx::BatchValidator::ElementReport::elementPath)
+        .def_readwrite("shaderName", &mx::BatchValidator::ElementReport::shaderName)
+        .def_readwrite("generateTime", &mx::BatchValidator::ElementReport::generateTime)
+        .def_readwrite("compileTime", &mx::BatchValidator::ElementReport::compileTime)
+        .def_readwrite("renderTime", &mx::BatchValidator::ElementReport::renderTime)
+        .def_readwrite("saveTime", &mx::BatchValidator::ElementReport::saveTime)
+        .def_readwrite("errors", &mx::BatchValidator::ElementReport::errors);
+
+    py::class_<mx::BatchValidator::Report>(batchValidator, "Report")
+        .def(py::init<>())
+        .def_readwrite("documents", &mx::BatchValidator::Report::documents)
+        .def_readwrite("elements", &mx::BatchValidator::Report::elements)
+        .def_readwrite("threadCount", &mx::BatchValidator::Report::threadCount)
+        .def_readwrite("totalTime", &mx::BatchValidator::Report::totalTime)
+        .def("getFailureCount", &mx::BatchValidator::Report::getFailureCount)
+        .def("asJson", &mx::BatchValidator::Report::asJson)
+        .def("writeJson", &mx::BatchValidator::Report::writeJson);
+
+    batchValidator
+        .def_static("create", &mx::BatchValidator::create,
+            py::arg("contextCreator"), py::arg("validator") = (mx::ShaderValidatorPtr) nullptr)
+        .def("setLibraries", &mx::BatchValidator::setLibraries)
+        .def("getLibraries", &mx::BatchValidator::getLibraries)
+        .def("setThreadCount", &mx::BatchValidator::setThreadCount)
+        .def("getThreadCount", &mx::BatchValidator::getThreadCount)
+        .def("setOutputPath", &mx::BatchValidator::setOutputPath)
+        .def("getOutputPath", &mx::BatchValidator::getOutputPath)
+        .def("validate", [](mx::BatchValidator& self, const mx::StringVec& documentPaths)
+        {
+            mx::BatchValidator::Report report;
+            self.validate(documentPaths, report);
+            return report;
+        });
+}
@@ -0,0 +1,22 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/Handlers/BinaryMeshLoader.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyBinaryMeshLoader(py::module& mod)
+{
+    py::class_<mx::BinaryMeshLoader, mx::BinaryMeshLoaderPtr, mx::GeometryLoader>(mod, "BinaryMeshLoader")
+        .def_static("create", &mx::BinaryMeshLoader::create)
+        .def(py::init<>())
+        .def("load", &mx::BinaryMeshLoader::load)
+        .def("save", &mx::BinaryMeshLoader::save)
+        .def("loadCache", &mx::BinaryMeshLoader::loadCache)
+        .def("saveCache", &mx::BinaryMeshLoader::saveCache);
+}
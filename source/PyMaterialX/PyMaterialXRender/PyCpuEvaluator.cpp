@@ -0,0 +1,66 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/Evaluators/CpuEvaluator.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+namespace
+{
+
+// Bind an attribute of shading points as a property holding a list of
+// arrays, one per component.
+template <size_t N> void defAttribute(py::class_<mx::ShadingPoints>& points, const char* name,
+                                      std::vector<float> (mx::ShadingPoints::*attribute)[N])
+{
+    points.def_property(name,
+        [attribute](const mx::ShadingPoints& self)
+        {
+            return std::vector<std::vector<float>>(self.*attribute, self.*attribute + N);
+        },
+        [attribute](mx::ShadingPoints& self, const std::vector<std::vector<float>>& values)
+        {
+            if (values.size() != N)
+            {
+                throw py::value_error("Expected " + std::to_string(N) + " components");
+            }
+            std::copy(values.begin(), values.end(), self.*attribute);
+        });
+}
+
+} // anonymous namespace
+
+void bindPyCpuEvaluator(py::module& mod)
+{
+    py::class_<mx::ShadingPoints> points(mod, "ShadingPoints");
+    points
+        .def(py::init<>())
+        .def("resize", &mx::ShadingPoints::resize)
+        .def("size", &mx::ShadingPoints::size)
+        .def_static("createGrid", &mx::ShadingPoints::createGrid)
+        .def_readwrite("frame", &mx::ShadingPoints::frame)
+        .def_readwrite("viewPosition", &mx::ShadingPoints::viewPosition);
+    defAttribute(points, "position", &mx::ShadingPoints::position);
+    defAttribute(points, "normal", &mx::ShadingPoints::normal);
+    defAttribute(points, "tangent", &mx::ShadingPoints::tangent);
+    defAttribute(points, "bitangent", &mx::ShadingPoints::bitangent);
+    defAttribute(points, "texcoord", &mx::ShadingPoints::texcoord);
+    defAttribute(points, "color", &mx::ShadingPoints::color);
+
+    py::class_<mx::CpuEvaluator, mx::CpuEvaluatorPtr>(mod, "CpuEvaluator")
+        .def_static("create", &mx::CpuEvaluator::create,
+            py::arg("element"), py::arg("context"), py::arg("imageHandler") = (mx::ImageHandlerPtr) nullptr)
+        .def("getOutputType", &mx::CpuEvaluator::getOutputType, py::return_value_policy::reference)
+        .def("getChannelCount", &mx::CpuEvaluator::getChannelCount)
+        .def("evaluate", [](const mx::CpuEvaluator& self, const mx::ShadingPoints& points)
+        {
+            std::vector<float> results;
+            self.evaluate(points, results);
+            return results;
+        });
+}
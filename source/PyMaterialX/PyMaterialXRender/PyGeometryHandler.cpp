@@ -35,7 +35,8 @@ void bindPyGeometryHandler(py::module& mod)
     py::class_<mx::GeometryLoader, PyGeometryLoader, mx::GeometryLoaderPtr>(mod, "GeometryLoader")
         .def(py::init<>())
         .def("supportedExtensions", &mx::GeometryLoader::supportedExtensions)
-        .def("load", &mx::GeometryLoader::load);
+        .def("load", &mx::GeometryLoader::load)
+        .def("save", &mx::GeometryLoader::save);
 
     py::class_<mx::GeometryHandler, mx::GeometryHandlerPtr>(mod, "GeometryHandler")
         .def(py::init<>())
@@ -45,6 +46,12 @@ void bindPyGeometryHandler(py::module& mod)
         .def("getGeometry", &mx::GeometryHandler::getGeometry)
         .def("clearGeometry", static_cast<void (mx::GeometryHandler::*)(const std::string&)>(&mx::GeometryHandler::clearGeometry))
         .def("loadGeometry", &mx::GeometryHandler::loadGeometry)
+        .def("saveGeometry", &mx::GeometryHandler::saveGeometry)
+        .def("setMeshCacheEnabled", &mx::GeometryHandler::setMeshCacheEnabled)
+        .def("getMeshCacheEnabled", &mx::GeometryHandler::getMeshCacheEnabled)
+        .def_static("getMeshCachePath", &mx::GeometryHandler::getMeshCachePath)
+        .def("setMeshOptimizer", &mx::GeometryHandler::setMeshOptimizer)
+        .def("getMeshOptimizer", &mx::GeometryHandler::getMeshOptimizer)
         .def("getMeshes", &mx::GeometryHandler::getMeshes)
         .def("getMinimumBounds", &mx::GeometryHandler::getMinimumBounds)
         .def("getMaximumBounds", &mx::GeometryHandler::getMaximumBounds);
@@ -0,0 +1,83 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/Handlers/ImageComparator.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyImageComparator(py::module& mod)
+{
+    py::class_<mx::ImageDifference>(mod, "ImageDifference")
+        .def(py::init<>())
+        .def("getMaxRmse", &mx::ImageDifference::getMaxRmse)
+        .def("getMaxError", &mx::ImageDifference::getMaxError)
+        .def("getDifferenceImageDesc", &mx::ImageDifference::getDifferenceImageDesc)
+        .def_readwrite("rmse", &mx::ImageDifference::rmse)
+        .def_readwrite("maxError", &mx::ImageDifference::maxError)
+        .def_readwrite("meanDeltaE", &mx::ImageDifference::meanDeltaE)
+        .def_readwrite("maxDeltaE", &mx::ImageDifference::maxDeltaE)
+        .def_readwrite("perceptibleFraction", &mx::ImageDifference::perceptibleFraction)
+        .def_readwrite("width", &mx::ImageDifference::width)
+        .def_readwrite("height", &mx::ImageDifference::height)
+        .def_readwrite("differenceImage", &mx::ImageDifference::differenceImage);
+
+    py::class_<mx::ImageComparator, mx::ImageComparatorPtr> imageComparator(mod, "ImageComparator");
+
+    py::class_<mx::ImageComparator::Tolerance>(imageComparator, "Tolerance")
+        .def(py::init<>())
+        .def_readwrite("rmse", &mx::ImageComparator::Tolerance::rmse)
+        .def_readwrite("maxError", &mx::ImageComparator::Tolerance::maxError)
+        .def_readwrite("perceptibleFraction", &mx::ImageComparator::Tolerance::perceptibleFraction);
+
+    imageComparator
+        .def_static("create", &mx::ImageComparator::create)
+        .def("setTolerance", &mx::ImageComparator::setTolerance)
+        .def("getTolerance", &mx::ImageComparator::getTolerance)
+        .def("setPerceptualThreshold", &mx::ImageComparator::setPerceptualThreshold)
+        .def("getPerceptualThreshold", &mx::ImageComparator::getPerceptualThreshold)
+        .def("setCreateDifferenceImage", &mx::ImageComparator::setCreateDifferenceImage)
+        .def("getCreateDifferenceImage", &mx::ImageComparator::getCreateDifferenceImage)
+        .def("setDifferenceScale", &mx::ImageComparator::setDifferenceScale)
+        .def("getDifferenceScale", &mx::ImageComparator::getDifferenceScale)
+        .def("setThreadCount", &mx::ImageComparator::setThreadCount)
+        .def("getThreadCount", &mx::ImageComparator::getThreadCount)
+        .def("compare", &mx::ImageComparator::compare)
+        .def("isWithinTolerance", &mx::ImageComparator::isWithinTolerance);
+
+    py::class_<mx::GoldenImageStore, mx::GoldenImageStorePtr> goldenImageStore(mod, "GoldenImageStore");
+
+    py::enum_<mx::GoldenImageStore::Status>(goldenImageStore, "Status")
+        .value("PASSED", mx::GoldenImageStore::PASSED)
+        .value("FAILED", mx::GoldenImageStore::FAILED)
+        .value("MISSING", mx::GoldenImageStore::MISSING)
+        .value("UPDATED", mx::GoldenImageStore::UPDATED)
+        .export_values();
+
+    py::class_<mx::GoldenImageStore::Result>(goldenImageStore, "Result")
+        .def(py::init<>())
+        .def_readwrite("status", &mx::GoldenImageStore::Result::status)
+        .def_readwrite("difference", &mx::GoldenImageStore::Result::difference)
+        .def_readwrite("message", &mx::GoldenImageStore::Result::message)
+        .def_readwrite("differencePath", &mx::GoldenImageStore::Result::differencePath);
+
+    goldenImageStore
+        .def_static("create", &mx::GoldenImageStore::create,
+            py::arg("rootPath"), py::arg("imageLoader") = (mx::ImageLoaderPtr) nullptr)
+        .def("getRootPath", &mx::GoldenImageStore::getRootPath)
+        .def("setComparator", &mx::GoldenImageStore::setComparator)
+        .def("getComparator", &mx::GoldenImageStore::getComparator)
+        .def("setFileExtension", &mx::GoldenImageStore::setFileExtension)
+        .def("getFileExtension", &mx::GoldenImageStore::getFileExtension)
+        .def("setUpdate", &mx::GoldenImageStore::setUpdate)
+        .def("getUpdate", &mx::GoldenImageStore::getUpdate)
+        .def("setDifferencePath", &mx::GoldenImageStore::setDifferencePath)
+        .def("getDifferencePath", &mx::GoldenImageStore::getDifferencePath)
+        .def("getGoldenPath", &mx::GoldenImageStore::getGoldenPath)
+        .def("compare", static_cast<mx::GoldenImageStore::Result (mx::GoldenImageStore::*)(const std::string&, const mx::ImageDesc&) const>(&mx::GoldenImageStore::compare))
+        .def("compare", static_cast<mx::GoldenImageStore::Result (mx::GoldenImageStore::*)(const std::string&, const mx::FilePath&) const>(&mx::GoldenImageStore::compare));
+}
@@ -41,6 +41,18 @@ void bindPyMesh(py::module& mod)
         .def("getFaceCount", &mx::MeshPartition::getFaceCount)
         .def("setFaceCount", &mx::MeshPartition::setFaceCount);
 
+    py::class_<mx::MeshInterleavedBuffer::Attribute>(mod, "MeshInterleavedAttribute")
+        .def_readonly("stream", &mx::MeshInterleavedBuffer::Attribute::stream)
+        .def_readonly("offset", &mx::MeshInterleavedBuffer::Attribute::offset);
+
+    py::class_<mx::MeshInterleavedBuffer, mx::MeshInterleavedBufferPtr>(mod, "MeshInterleavedBuffer")
+        .def_static("create", &mx::MeshInterleavedBuffer::create)
+        .def("getData", &mx::MeshInterleavedBuffer::getData)
+        .def("getStride", &mx::MeshInterleavedBuffer::getStride)
+        .def("getVertexCount", &mx::MeshInterleavedBuffer::getVertexCount)
+        .def("getAttributes", &mx::MeshInterleavedBuffer::getAttributes)
+        .def("getAttribute", &mx::MeshInterleavedBuffer::getAttribute, py::return_value_policy::reference_internal);
+
     py::class_<mx::Mesh, mx::MeshPtr>(mod, "Mesh")
         .def_static("create", &mx::Mesh::create)
         .def(py::init<const std::string&>())
@@ -51,6 +63,9 @@ void bindPyMesh(py::module& mod)
         .def("getStream", static_cast<mx::MeshStreamPtr (mx::Mesh::*)(const std::string&) const>(&mx::Mesh::getStream))
         .def("getStream", static_cast<mx::MeshStreamPtr (mx::Mesh::*)(const std::string&, unsigned int) const> (&mx::Mesh::getStream))
         .def("addStream", &mx::Mesh::addStream)
+        .def("getStreams", &mx::Mesh::getStreams)
+        .def("getInterleavedBuffer", &mx::Mesh::getInterleavedBuffer)
+        .def("clearInterleavedBuffer", &mx::Mesh::clearInterleavedBuffer)
         .def("setVertexCount", &mx::Mesh::setVertexCount)
         .def("getVertexCount", &mx::Mesh::getVertexCount)
         .def("setMinimumBounds", &mx::Mesh::setMinimumBounds)
@@ -0,0 +1,32 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/Handlers/MeshOptimizer.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyMeshOptimizer(py::module& mod)
+{
+    py::class_<mx::MeshOptimizer::Statistics>(mod, "MeshOptimizerStatistics")
+        .def(py::init<>())
+        .def_readwrite("vertexCountBefore", &mx::MeshOptimizer::Statistics::vertexCountBefore)
+        .def_readwrite("vertexCountAfter", &mx::MeshOptimizer::Statistics::vertexCountAfter)
+        .def_readwrite("acmrBefore", &mx::MeshOptimizer::Statistics::acmrBefore)
+        .def_readwrite("acmrAfter", &mx::MeshOptimizer::Statistics::acmrAfter);
+
+    py::class_<mx::MeshOptimizer, mx::MeshOptimizerPtr>(mod, "MeshOptimizer")
+        .def_static("create", &mx::MeshOptimizer::create)
+        .def(py::init<>())
+        .def("setCacheSize", &mx::MeshOptimizer::setCacheSize)
+        .def("getCacheSize", &mx::MeshOptimizer::getCacheSize)
+        .def("optimize", &mx::MeshOptimizer::optimize)
+        .def("weldVertices", &mx::MeshOptimizer::weldVertices)
+        .def("optimizeVertexCache", &mx::MeshOptimizer::optimizeVertexCache)
+        .def("optimizeVertexFetch", &mx::MeshOptimizer::optimizeVertexFetch)
+        .def("computeACMR", &mx::MeshOptimizer::computeACMR);
+}
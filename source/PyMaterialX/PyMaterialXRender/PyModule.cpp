@@ -8,6 +8,7 @@
 namespace py = pybind11;
 
 void bindPyMesh(py::module& mod);
+void bindPyMeshOptimizer(py::module& mod);
 void bindPyGeometryHandler(py::module& mod);
 void bindPyHwLightHandler(py::module& mod);
 void bindPyImageHandler(py::module& mod);
@@ -16,16 +17,23 @@ void bindPyStbImageLoader(py::module& mod);
 void bindPyOiioImageLoader(py::module& mod);
 #endif
 void bindPySampleObjLoader(py::module& mod);
+void bindPyBinaryMeshLoader(py::module& mod);
 void bindPyTinyObjLoader(py::module& mod);
+void bindPyParallelObjLoader(py::module& mod);
 void bindPyViewHandler(py::module& mod);
 void bindPyExceptionShaderValidationError(py::module& mod);
 void bindPyShaderValidator(py::module& mod);
+void bindPyBatchValidator(py::module& mod);
+void bindPyCpuEvaluator(py::module& mod);
+void bindPyTextureBaker(py::module& mod);
+void bindPyImageComparator(py::module& mod);
 
 PYBIND11_MODULE(PyMaterialXRender, mod)
 {
     mod.doc() = "Module containing Python bindings for the MaterialXRender library";
 
     bindPyMesh(mod);
+    bindPyMeshOptimizer(mod);
     bindPyGeometryHandler(mod);
     bindPyHwLightHandler(mod);
     bindPyImageHandler(mod);
@@ -34,8 +42,14 @@ PYBIND11_MODULE(PyMaterialXRender, mod)
     bindPyOiioImageLoader(mod);
 #endif
     bindPySampleObjLoader(mod);
+    bindPyBinaryMeshLoader(mod);
     bindPyTinyObjLoader(mod);
+    bindPyParallelObjLoader(mod);
     bindPyViewHandler(mod);
     bindPyExceptionShaderValidationError(mod);
     bindPyShaderValidator(mod);
+    bindPyBatchValidator(mod);
+    bindPyCpuEvaluator(mod);
+    bindPyTextureBaker(mod);
+    bindPyImageComparator(mod);
 }
@@ -0,0 +1,45 @@
+//
+// TM & (c) 2019 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXRender/Evaluators/TextureBaker.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyTextureBaker(py::module& mod)
+{
+    py::class_<mx::TextureBaker, mx::TextureBakerPtr> textureBaker(mod, "TextureBaker");
+
+    py::class_<mx::TextureBaker::BakedOutput>(textureBaker, "BakedOutput")
+        .def(py::init<>())
+        .def_readwrite("output", &mx::TextureBaker::BakedOutput::output)
+        .def_readwrite("fileName", &mx::TextureBaker::BakedOutput::fileName)
+        .def_readwrite("colorSpace", &mx::TextureBaker::BakedOutput::colorSpace)
+        .def_readwrite("errors", &mx::TextureBaker::BakedOutput::errors)
+        .def_readwrite("warnings", &mx::TextureBaker::BakedOutput::warnings);
+
+    textureBaker
+        .def_static("create", &mx::TextureBaker::create,
+            py::arg("context"), py::arg("imageHandler") = (mx::ImageHandlerPtr) nullptr)
+        .def("setResolution", &mx::TextureBaker::setResolution)
+        .def("getWidth", &mx::TextureBaker::getWidth)
+        .def("getHeight", &mx::TextureBaker::getHeight)
+        .def("setUdims", &mx::TextureBaker::setUdims)
+        .def("getUdims", &mx::TextureBaker::getUdims)
+        .def("setOutputPath", &mx::TextureBaker::setOutputPath)
+        .def("getOutputPath", &mx::TextureBaker::getOutputPath)
+        .def("setFileExtension", &mx::TextureBaker::setFileExtension)
+        .def("getFileExtension", &mx::TextureBaker::getFileExtension)
+        .def("setImageLoader", &mx::TextureBaker::setImageLoader)
+        .def("getImageLoader", &mx::TextureBaker::getImageLoader)
+        .def("setThreadCount", &mx::TextureBaker::setThreadCount)
+        .def("getThreadCount", &mx::TextureBaker::getThreadCount)
+        .def_static("findBakeableOutputs", &mx::TextureBaker::findBakeableOutputs)
+        .def("bake", &mx::TextureBaker::bake)
+        .def("bakeDocument", &mx::TextureBaker::bakeDocument)
+        .def_static("replaceWithImage", &mx::TextureBaker::replaceWithImage);
+}
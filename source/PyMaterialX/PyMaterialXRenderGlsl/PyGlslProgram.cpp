@@ -20,7 +20,13 @@ void bindPyGlslProgram(py::module& mod)
         .def("addStage", &mx::GlslProgram::addStage)
         .def("getStageSourceCode", &mx::GlslProgram::getStageSourceCode)
         .def("clearStages", &mx::GlslProgram::clearStages)
+        .def("setProgramCache", &mx::GlslProgram::setProgramCache)
+        .def("getProgramCache", &mx::GlslProgram::getProgramCache)
         .def("build", &mx::GlslProgram::build)
+        .def("startBuild", &mx::GlslProgram::startBuild)
+        .def_static("isParallelCompileSupported", &mx::GlslProgram::isParallelCompileSupported)
+        .def("isBuildComplete", &mx::GlslProgram::isBuildComplete)
+        .def("finishBuild", &mx::GlslProgram::finishBuild)
         .def("getUniformsList", &mx::GlslProgram::getUniformsList)
         .def("getAttributesList", &mx::GlslProgram::getAttributesList)
         .def("findInputs", &mx::GlslProgram::findInputs)
@@ -32,6 +38,8 @@ void bindPyGlslProgram(py::module& mod)
         .def("bindAttribute", &mx::GlslProgram::bindAttribute)
         .def("bindPartition", &mx::GlslProgram::bindPartition)
         .def("bindStreams", &mx::GlslProgram::bindStreams)
+        .def("setInterleavedStreams", &mx::GlslProgram::setInterleavedStreams)
+        .def("getInterleavedStreams", &mx::GlslProgram::getInterleavedStreams)
         .def("unbindGeometry", &mx::GlslProgram::unbindGeometry)
         .def("bindTextures", &mx::GlslProgram::bindTextures)
         .def("unbindTextures", &mx::GlslProgram::unbindTextures)
@@ -50,4 +58,11 @@ void bindPyGlslProgram(py::module& mod)
         .def_readwrite("isConstant", &mx::GlslProgram::Input::isConstant)
         .def_readwrite("path", &mx::GlslProgram::Input::path)
         .def(py::init<int, int, int, std::string>());
+
+    py::class_<mx::GlslProgramCache, mx::GlslProgramCachePtr>(mod, "GlslProgramCache")
+        .def_readonly_static("EXTENSION", &mx::GlslProgramCache::EXTENSION)
+        .def_static("create", &mx::GlslProgramCache::create)
+        .def_static("computeKey", &mx::GlslProgramCache::computeKey)
+        .def("getDirectory", &mx::GlslProgramCache::getDirectory)
+        .def("getFilePath", &mx::GlslProgramCache::getFilePath);
 }
@@ -15,6 +15,8 @@ void bindPyGlslValidator(py::module& mod)
     py::class_<mx::GlslValidator, mx::ShaderValidator, mx::GlslValidatorPtr>(mod, "GlslValidator")
         .def_static("create", &mx::GlslValidator::create)
         .def("initialize", &mx::GlslValidator::initialize)
+        .def("setHeadless", &mx::GlslValidator::setHeadless)
+        .def("isHeadless", &mx::GlslValidator::isHeadless)
         .def("validateCreation", static_cast<void (mx::GlslValidator::*)(const mx::ShaderPtr)>(&mx::GlslValidator::validateCreation))
         .def("validateCreation", static_cast<void (mx::GlslValidator::*)(const mx::GlslValidator::StageMap&)>(&mx::GlslValidator::validateCreation))
         .def("validateInputs", &mx::GlslValidator::validateInputs)
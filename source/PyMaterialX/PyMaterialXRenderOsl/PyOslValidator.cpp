@@ -32,5 +32,6 @@ void bindPyOslValidator(py::module& mod)
         .def("setOslShaderName", &mx::OslValidator::setOslShaderName)
         .def("setOslUtilityOSOPath", &mx::OslValidator::setOslUtilityOSOPath)
         .def("useTestRender", &mx::OslValidator::useTestRender)
+        .def("useInProcess", &mx::OslValidator::useInProcess)
         .def("compileOSL", &mx::OslValidator::compileOSL);
 }